@@ -0,0 +1,560 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Copyright (C) 2010 Gael Guennebaud <gael.guennebaud@inria.fr>
+//
+// Eigen is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// Alternatively, you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation; either version 2 of
+// the License, or (at your option) any later version.
+//
+// Eigen is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License or the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License and a copy of the GNU General Public License along with
+// Eigen. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef EIGEN_BUNCHKAUFMANLDLT_H
+#define EIGEN_BUNCHKAUFMANLDLT_H
+
+/** \ingroup cholesky_Module
+  *
+  * \class BunchKaufmanLDLT
+  *
+  * \brief LDLT decomposition of a selfadjoint indefinite matrix with Bunch-Kaufman pivoting
+  *
+  * \param MatrixType the type of the matrix of which to compute the decomposition
+  * \param UpLo the triangular part of the input matrix which is referenced, either Lower or Upper
+  *
+  * Performs a decomposition of a selfadjoint, possibly indefinite, matrix \f$ A \f$ such that
+  * \f$ A = P^T L D L^* P \f$, where P is a permutation matrix, L is lower triangular with a unit
+  * diagonal, and D is block diagonal with blocks of size 1x1 and 2x2.
+  *
+  * Unlike LDLT, which requires a semidefinite matrix, this decomposition is stable for any
+  * selfadjoint matrix, including matrices with zeros on the diagonal such as saddle point
+  * problems. The 2x2 blocks of D are selected using the partial pivoting strategy of Bunch and
+  * Kaufman. The factorization is blocked: the columns of a panel are factorized in a left-looking
+  * fashion, and the trailing matrix is then updated using selfadjoint rank-k products.
+  *
+  * The diagonal of D is returned by vectorD(), while its sub-diagonal, which is zero everywhere
+  * but in the 2x2 blocks, is returned by subDiagonalD().
+  *
+  * \sa class LDLT
+  */
+template<typename _MatrixType, int _UpLo> class BunchKaufmanLDLT
+{
+  public:
+    typedef _MatrixType MatrixType;
+    enum {
+      RowsAtCompileTime = MatrixType::RowsAtCompileTime,
+      ColsAtCompileTime = MatrixType::ColsAtCompileTime,
+      Options = MatrixType::Options & ~RowMajorBit, // these are the options for the TmpMatrixType, we need a ColMajor matrix here!
+      MaxRowsAtCompileTime = MatrixType::MaxRowsAtCompileTime,
+      MaxColsAtCompileTime = MatrixType::MaxColsAtCompileTime,
+      UpLo = _UpLo
+    };
+    typedef typename MatrixType::Scalar Scalar;
+    typedef typename NumTraits<typename MatrixType::Scalar>::Real RealScalar;
+    typedef typename MatrixType::Index Index;
+    typedef Matrix<Scalar, RowsAtCompileTime, 1, Options, MaxRowsAtCompileTime, 1> TmpMatrixType;
+    typedef Matrix<Scalar, RowsAtCompileTime, 2, Options, MaxRowsAtCompileTime, 2> WorkspaceType;
+
+    typedef Transpositions<RowsAtCompileTime, MaxRowsAtCompileTime> TranspositionType;
+
+    typedef TriangularView<MatrixType, UnitLower> MatrixL;
+    typedef TriangularView<typename MatrixType::AdjointReturnType, UnitUpper> MatrixU;
+
+    /** \brief Default Constructor.
+      *
+      * The default constructor is useful in cases in which the user intends to
+      * perform decompositions via BunchKaufmanLDLT::compute(const MatrixType&).
+      */
+    BunchKaufmanLDLT() : m_matrix(), m_transpositions(), m_isInitialized(false) {}
+
+    /** \brief Default Constructor with memory preallocation
+      *
+      * Like the default constructor but with preallocation of the internal data
+      * according to the specified problem \a size.
+      * \sa BunchKaufmanLDLT()
+      */
+    BunchKaufmanLDLT(Index size)
+      : m_matrix(size, size),
+        m_subDiagonal(size),
+        m_transpositions(size),
+        m_temporary(size),
+        m_workspace(size, 2),
+        m_isInitialized(false)
+    {}
+
+    BunchKaufmanLDLT(const MatrixType& matrix)
+      : m_matrix(matrix.rows(), matrix.cols()),
+        m_subDiagonal(matrix.rows()),
+        m_transpositions(matrix.rows()),
+        m_temporary(matrix.rows()),
+        m_workspace(matrix.rows(), 2),
+        m_isInitialized(false)
+    {
+      compute(matrix);
+    }
+
+    /** \returns a view of the upper triangular matrix U = L^* */
+    inline MatrixU matrixU() const
+    {
+      ei_assert(m_isInitialized && "BunchKaufmanLDLT is not initialized.");
+      return m_matrix.adjoint();
+    }
+
+    /** \returns a view of the lower triangular matrix L */
+    inline MatrixL matrixL() const
+    {
+      ei_assert(m_isInitialized && "BunchKaufmanLDLT is not initialized.");
+      return m_matrix;
+    }
+
+    /** \returns the permutation matrix P as a transposition sequence.
+      */
+    inline const TranspositionType& transpositionsP() const
+    {
+      ei_assert(m_isInitialized && "BunchKaufmanLDLT is not initialized.");
+      return m_transpositions;
+    }
+
+    /** \returns the diagonal coefficients of the block diagonal matrix D */
+    inline Diagonal<MatrixType,0> vectorD(void) const
+    {
+      ei_assert(m_isInitialized && "BunchKaufmanLDLT is not initialized.");
+      return m_matrix.diagonal();
+    }
+
+    /** \returns the sub-diagonal coefficients of the block diagonal matrix D. The i-th coefficient
+      * is non zero if and only if the rows i and i+1 belong to the same 2x2 block of D. The last
+      * coefficient is always zero. */
+    inline const TmpMatrixType& subDiagonalD(void) const
+    {
+      ei_assert(m_isInitialized && "BunchKaufmanLDLT is not initialized.");
+      return m_subDiagonal;
+    }
+
+    /** \returns a solution x of \f$ A x = b \f$ using the current decomposition of A.
+      *
+      * \note_about_checking_solutions
+      *
+      * \sa solveInPlace()
+      */
+    template<typename Rhs>
+    inline const ei_solve_retval<BunchKaufmanLDLT, Rhs>
+    solve(const MatrixBase<Rhs>& b) const
+    {
+      ei_assert(m_isInitialized && "BunchKaufmanLDLT is not initialized.");
+      ei_assert(m_matrix.rows()==b.rows()
+                && "BunchKaufmanLDLT::solve(): invalid number of rows of the right hand side matrix b");
+      return ei_solve_retval<BunchKaufmanLDLT, Rhs>(*this, b.derived());
+    }
+
+    template<typename Derived>
+    bool solveInPlace(MatrixBase<Derived> &bAndX) const;
+
+    BunchKaufmanLDLT& compute(const MatrixType& matrix);
+
+    /** \returns the internal decomposition matrix: the strict lower part stores the coefficients
+      * of L, and the diagonal stores the diagonal of D. The strict upper part is not referenced.
+      */
+    inline const MatrixType& matrixLDLT() const
+    {
+      ei_assert(m_isInitialized && "BunchKaufmanLDLT is not initialized.");
+      return m_matrix;
+    }
+
+    MatrixType reconstructedMatrix() const;
+
+    inline Index rows() const { return m_matrix.rows(); }
+    inline Index cols() const { return m_matrix.cols(); }
+
+  protected:
+    MatrixType m_matrix;
+    TmpMatrixType m_subDiagonal;
+    TranspositionType m_transpositions;
+    TmpMatrixType m_temporary;
+    WorkspaceType m_workspace;
+    bool m_isInitialized;
+};
+
+struct ei_bunch_kaufman_inplace
+{
+  /** \internal
+    * Applies to \a col, which stores the rows \a k to size-1 of the column \a c of the trailing
+    * matrix, the contributions of the columns \a k0 to \a k-1 of the current panel.
+    */
+  template<typename MatrixType, typename SubDiagType, typename Workspace, typename ColType>
+  static void updateColumn(const MatrixType& mat, const SubDiagType& subdiag, Workspace& temp, ColType col,
+                           typename MatrixType::Index k0, typename MatrixType::Index k, typename MatrixType::Index c)
+  {
+    typedef typename MatrixType::Scalar Scalar;
+    typedef typename MatrixType::Index Index;
+    const Index pk = k - k0;
+    const Index rs = mat.rows() - k;
+    if(pk==0)
+      return;
+
+    // temp = D * L(c,k0:k)^*, where D is the block diagonal of the panel
+    for(Index j = 0; j < pk;)
+    {
+      Index jj = k0 + j;
+      if(j+1<pk && subdiag.coeff(jj)!=Scalar(0))
+      {
+        Scalar l1 = ei_conj(mat.coeff(c,jj)), l2 = ei_conj(mat.coeff(c,jj+1));
+        temp.coeffRef(j)   = ei_real(mat.coeff(jj,jj)) * l1 + ei_conj(subdiag.coeff(jj)) * l2;
+        temp.coeffRef(j+1) = subdiag.coeff(jj) * l1 + ei_real(mat.coeff(jj+1,jj+1)) * l2;
+        j += 2;
+      }
+      else
+      {
+        temp.coeffRef(j) = ei_real(mat.coeff(jj,jj)) * ei_conj(mat.coeff(c,jj));
+        j += 1;
+      }
+    }
+    col.head(rs).noalias() -= mat.block(k,k0,rs,pk) * temp.head(pk);
+  }
+
+  /** \internal
+    * Factorizes at least \a bs columns of \a mat starting at \a k0, assuming that the contributions
+    * of the columns on the left of \a k0 have already been applied to the trailing matrix. The panel
+    * is extended by one column when its last pivot is a 2x2 block.
+    *
+    * \returns the number of factorized columns
+    */
+  template<typename MatrixType, typename SubDiagType, typename TranspositionType, typename Workspace, typename Temporary>
+  static typename MatrixType::Index panel(MatrixType& mat, SubDiagType& subdiag, TranspositionType& transpositions,
+                                          Workspace& w, Temporary& temp,
+                                          typename MatrixType::Index k0, typename MatrixType::Index bs)
+  {
+    typedef typename MatrixType::Scalar Scalar;
+    typedef typename MatrixType::RealScalar RealScalar;
+    typedef typename MatrixType::Index Index;
+    const Index size = mat.rows();
+    const RealScalar alpha = (RealScalar(1) + ei_sqrt(RealScalar(17))) / RealScalar(8);
+
+    Index k = k0;
+    while(k < k0+bs)
+    {
+      const Index rs = size - k;
+
+      // the current column, updated with the previous columns of the panel
+      w.col(0).head(rs) = mat.col(k).tail(rs);
+      updateColumn(mat, subdiag, temp, w.col(0), k0, k, k);
+
+      RealScalar absakk = ei_abs(ei_real(w.coeff(0,0)));
+      Index imax = 0;
+      RealScalar colmax = rs>1 ? w.col(0).segment(1,rs-1).cwiseAbs().maxCoeff(&imax) : RealScalar(0);
+      imax += k+1;
+
+      Index kstep = 1, kp = k;
+      if(absakk < alpha*colmax)
+      {
+        // the candidate column imax, updated with the previous columns of the panel
+        Index r = imax - k;
+        w.col(1).head(r) = mat.row(imax).segment(k,r).adjoint();
+        w.col(1).segment(r,size-imax) = mat.col(imax).tail(size-imax);
+        updateColumn(mat, subdiag, temp, w.col(1), k0, k, imax);
+
+        RealScalar rowmax = w.col(1).head(r).cwiseAbs().maxCoeff();
+        if(imax<size-1)
+          rowmax = std::max(rowmax, w.col(1).segment(r+1,size-imax-1).cwiseAbs().maxCoeff());
+
+        if(absakk*rowmax >= alpha*colmax*colmax)
+        {
+          // no interchange, 1x1 pivot
+        }
+        else if(ei_abs(ei_real(w.coeff(r,1))) >= alpha*rowmax)
+        {
+          // interchange k and imax, 1x1 pivot
+          kp = imax;
+          w.col(0).head(rs) = w.col(1).head(rs);
+        }
+        else
+        {
+          // interchange k+1 and imax, 2x2 pivot
+          kp = imax;
+          kstep = 2;
+        }
+      }
+
+      const Index kk = k + kstep - 1;
+      for(Index i = k; i < kk; ++i)
+        transpositions.coeffRef(i) = i;
+      transpositions.coeffRef(kk) = kp;
+      if(kp != kk)
+      {
+        // apply the transposition while taking care to consider only
+        // the lower triangular part
+        Index s = size-kp-1; // trailing size after the pivot
+        mat.row(kk).head(kk).swap(mat.row(kp).head(kk));
+        mat.col(kk).tail(s).swap(mat.col(kp).tail(s));
+        std::swap(mat.coeffRef(kk,kk),mat.coeffRef(kp,kp));
+        for(Index i=kk+1;i<kp;++i)
+        {
+          Scalar tmp = mat.coeffRef(i,kk);
+          mat.coeffRef(i,kk) = ei_conj(mat.coeffRef(kp,i));
+          mat.coeffRef(kp,i) = ei_conj(tmp);
+        }
+        if(NumTraits<Scalar>::IsComplex)
+          mat.coeffRef(kp,kk) = ei_conj(mat.coeff(kp,kk));
+
+        for(Index j = 0; j < kstep; ++j)
+          std::swap(w.coeffRef(kk-k,j), w.coeffRef(kp-k,j));
+      }
+
+      if(kstep==1)
+      {
+        RealScalar d = ei_real(w.coeff(0,0));
+        mat.coeffRef(k,k) = d;
+        subdiag.coeffRef(k) = Scalar(0);
+        if(d!=RealScalar(0))
+          mat.col(k).tail(rs-1) = w.col(0).segment(1,rs-1) / d;
+        else
+          mat.col(k).tail(rs-1).setZero();
+      }
+      else
+      {
+        // L(k+2:size,k:k+1) = W(k+2:size,k:k+1) * D^-1, where D is the 2x2 pivot
+        RealScalar d11 = ei_real(w.coeff(0,0));
+        RealScalar d22 = ei_real(w.coeff(1,1));
+        Scalar d21 = w.coeff(1,0);
+        RealScalar det = d11*d22 - ei_abs2(d21);
+        Index r2 = rs - 2;
+        mat.col(k).tail(r2)   = (d22 * w.col(0).segment(2,r2) - d21 * w.col(1).segment(2,r2)) / det;
+        mat.col(k+1).tail(r2) = (d11 * w.col(1).segment(2,r2) - ei_conj(d21) * w.col(0).segment(2,r2)) / det;
+        mat.coeffRef(k,k) = d11;
+        mat.coeffRef(k+1,k+1) = d22;
+        mat.coeffRef(k+1,k) = Scalar(0);
+        subdiag.coeffRef(k) = d21;
+        subdiag.coeffRef(k+1) = Scalar(0);
+      }
+      k += kstep;
+    }
+    return k - k0;
+  }
+
+  template<typename MatrixType, typename SubDiagType, typename TranspositionType, typename Workspace, typename Temporary>
+  static void blocked(MatrixType& mat, SubDiagType& subdiag, TranspositionType& transpositions, Workspace& w, Temporary& temp)
+  {
+    typedef typename MatrixType::Scalar Scalar;
+    typedef typename MatrixType::RealScalar RealScalar;
+    typedef typename MatrixType::Index Index;
+    ei_assert(mat.rows()==mat.cols());
+    const Index size = mat.rows();
+    if(size<64)
+    {
+      panel(mat, subdiag, transpositions, w, temp, 0, size);
+      return;
+    }
+
+    Index blockSize = size/8;
+    blockSize = (blockSize/16)*16;
+    blockSize = std::min(std::max(blockSize,Index(16)), Index(128));
+
+    Matrix<Scalar,Dynamic,Dynamic> W(size, blockSize+1);
+    Matrix<Scalar,2,2> D;
+
+    for(Index k=0; k<size;)
+    {
+      Index bs = panel(mat, subdiag, transpositions, w, temp, k, std::min(blockSize, size-k));
+
+      // A22 -= L21 D1 L21^*, through the selfadjoint rank-k product: the 2x2 blocks of D1 are
+      // diagonalized by Jacobi rotations applied to the corresponding columns of L21, the columns
+      // are scaled by the square roots of the absolute values of the resulting diagonal, and the
+      // positive and negative parts are processed by two separate updates.
+      Index rs = size - k - bs;
+      if(rs>0)
+      {
+        Block<MatrixType,Dynamic,Dynamic> L21(mat,k+bs,k,rs,bs);
+        Block<MatrixType,Dynamic,Dynamic> A22(mat,k+bs,k+bs,rs,rs);
+        Block<Matrix<Scalar,Dynamic,Dynamic>,Dynamic,Dynamic> W21(W,0,0,rs,bs);
+        W21 = L21;
+        Matrix<RealScalar,Dynamic,1> d = mat.diagonal().segment(k,bs).real();
+        for(Index j = 0; j < bs; ++j)
+        {
+          if(j+1<bs && subdiag.coeff(k+j)!=Scalar(0))
+          {
+            D << d.coeff(j), ei_conj(subdiag.coeff(k+j)),
+                 subdiag.coeff(k+j), d.coeff(j+1);
+            PlanarRotation<Scalar> J;
+            J.makeJacobi(D, 0, 1);
+            D.applyOnTheLeft(0, 1, J.adjoint());
+            D.applyOnTheRight(0, 1, J);
+            d.coeffRef(j) = ei_real(D.coeff(0,0));
+            d.coeffRef(j+1) = ei_real(D.coeff(1,1));
+            W21.applyOnTheRight(j, j+1, J);
+            ++j;
+          }
+        }
+
+        // move the columns of positive weight first
+        Index nbPositive = 0;
+        for(Index j = 0; j < bs; ++j)
+        {
+          W21.col(j) *= ei_sqrt(ei_abs(d.coeff(j)));
+          if(d.coeff(j) >= RealScalar(0))
+          {
+            if(j != nbPositive)
+              W21.col(j).swap(W21.col(nbPositive));
+            ++nbPositive;
+          }
+        }
+
+        if(nbPositive>0)
+          A22.template selfadjointView<Lower>().rankUpdate(W21.leftCols(nbPositive), -1);
+        if(nbPositive<bs)
+          A22.template selfadjointView<Lower>().rankUpdate(W21.rightCols(bs-nbPositive), 1);
+      }
+      k += bs;
+    }
+  }
+};
+
+/** Computes / recomputes the decomposition A = P^T L D L^* P of \a a, where only the triangular
+  * part \a UpLo of \a a is referenced.
+  */
+template<typename MatrixType, int _UpLo>
+BunchKaufmanLDLT<MatrixType,_UpLo>& BunchKaufmanLDLT<MatrixType,_UpLo>::compute(const MatrixType& a)
+{
+  ei_assert(a.rows()==a.cols());
+  const Index size = a.rows();
+
+  // the factorization works on the lower triangular part
+  if(UpLo==Lower)
+    m_matrix = a;
+  else
+    m_matrix = a.adjoint();
+
+  m_subDiagonal.resize(size);
+  m_transpositions.resize(size);
+  m_isInitialized = false;
+  m_temporary.resize(size);
+  m_workspace.resize(size, 2);
+
+  ei_bunch_kaufman_inplace::blocked(m_matrix, m_subDiagonal, m_transpositions, m_workspace, m_temporary);
+
+  m_isInitialized = true;
+  return *this;
+}
+
+template<typename _MatrixType, int _UpLo, typename Rhs>
+struct ei_solve_retval<BunchKaufmanLDLT<_MatrixType,_UpLo>, Rhs>
+  : ei_solve_retval_base<BunchKaufmanLDLT<_MatrixType,_UpLo>, Rhs>
+{
+  typedef BunchKaufmanLDLT<_MatrixType,_UpLo> LDLTType;
+  EIGEN_MAKE_SOLVE_HELPERS(LDLTType,Rhs)
+
+  template<typename Dest> void evalTo(Dest& dst) const
+  {
+    typedef typename LDLTType::RealScalar RealScalar;
+    const Index size = dec().matrixLDLT().rows();
+    ei_assert(rhs().rows() == size);
+    // dst = P b
+    dst = dec().transpositionsP() * rhs();
+
+    // dst = L^-1 (P b)
+    dec().matrixL().solveInPlace(dst);
+
+    // dst = D^-1 (L^-1 P b), the rows corresponding to the zero 1x1 blocks of a singular D are zeroed
+    for(Index k = 0; k < size;)
+    {
+      Scalar d21 = dec().subDiagonalD().coeff(k);
+      if(d21 != Scalar(0))
+      {
+        RealScalar d11 = ei_real(dec().vectorD().coeff(k));
+        RealScalar d22 = ei_real(dec().vectorD().coeff(k+1));
+        RealScalar det = d11*d22 - ei_abs2(d21);
+        for(Index j = 0; j < dst.cols(); ++j)
+        {
+          Scalar x1 = dst.coeff(k,j), x2 = dst.coeff(k+1,j);
+          dst.coeffRef(k,j)   = (d22 * x1 - ei_conj(d21) * x2) / det;
+          dst.coeffRef(k+1,j) = (d11 * x2 - d21 * x1) / det;
+        }
+        k += 2;
+      }
+      else
+      {
+        RealScalar d = ei_real(dec().vectorD().coeff(k));
+        if(d != RealScalar(0))
+          dst.row(k) /= d;
+        else
+          dst.row(k).setZero();
+        k += 1;
+      }
+    }
+
+    // dst = L^-* (D^-1 L^-1 P b)
+    dec().matrixU().solveInPlace(dst);
+
+    // dst = P^-1 (L^-* D^-1 L^-1 P b) = A^-1 b
+    dst = dec().transpositionsP().transpose() * dst;
+  }
+};
+
+/** This is the \em in-place version of solve().
+  *
+  * \param bAndX represents both the right-hand side matrix b and result x.
+  *
+  * \returns true always! If you need to check for existence of solutions, use another decomposition like LU, QR, or SVD.
+  *
+  * This version avoids a copy when the right hand side matrix b is not
+  * needed anymore.
+  *
+  * \sa BunchKaufmanLDLT::solve()
+  */
+template<typename MatrixType,int _UpLo>
+template<typename Derived>
+bool BunchKaufmanLDLT<MatrixType,_UpLo>::solveInPlace(MatrixBase<Derived> &bAndX) const
+{
+  ei_assert(m_isInitialized && "BunchKaufmanLDLT is not initialized.");
+  ei_assert(m_matrix.rows() == bAndX.rows());
+
+  bAndX = this->solve(bAndX);
+
+  return true;
+}
+
+/** \returns the matrix represented by the decomposition,
+ * i.e., it returns the product: P^T L D L^* P.
+ * This function is provided for debug purpose. */
+template<typename MatrixType, int _UpLo>
+MatrixType BunchKaufmanLDLT<MatrixType,_UpLo>::reconstructedMatrix() const
+{
+  ei_assert(m_isInitialized && "BunchKaufmanLDLT is not initialized.");
+  const Index size = m_matrix.rows();
+  MatrixType res(size,size), D(size,size);
+
+  D.setZero();
+  D.diagonal() = vectorD();
+  if(size>1)
+  {
+    D.diagonal(-1) = m_subDiagonal.head(size-1);
+    D.diagonal(1) = m_subDiagonal.head(size-1).conjugate();
+  }
+
+  // P
+  res.setIdentity();
+  res = transpositionsP() * res;
+  // L^* P
+  res = matrixU() * res;
+  // D(L^*P)
+  res = D * res;
+  // L(DL^*P)
+  res = matrixL() * res;
+  // P^T (LDL^*P)
+  res = transpositionsP().transpose() * res;
+
+  return res;
+}
+
+#endif // EIGEN_BUNCHKAUFMANLDLT_H
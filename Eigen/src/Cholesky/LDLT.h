@@ -203,30 +203,32 @@ template<int UpLo> struct ei_ldlt_inplace;
 
 template<> struct ei_ldlt_inplace<Lower>
 {
-  template<typename MatrixType, typename TranspositionType, typename Workspace>
-  static bool unblocked(MatrixType& mat, TranspositionType& transpositions, Workspace& temp, int* sign=0)
+  /** \internal
+    * Factorizes the columns \a k0 to \a k0+bs-1 of \a mat, assuming that the contributions of the
+    * columns on the left of \a k0 have already been applied to the trailing matrix. The contributions
+    * of the columns of the panel are applied to each column before it is factorized.
+    *
+    * The diagonal of the trailing matrix is always kept up to date in \a diag, which is used for the
+    * pivoting, and which may either be the diagonal of \a mat or a separate vector.
+    *
+    * \returns the number of factorized columns, which is smaller than \a bs if the remaining
+    * diagonal entries are negligible, in which case the decomposition is over.
+    */
+  template<typename MatrixType, typename DiagonalType, typename TranspositionType, typename Workspace>
+  static typename MatrixType::Index panel(MatrixType& mat, DiagonalType& diag, TranspositionType& transpositions, Workspace& temp,
+                                          typename MatrixType::Index k0, typename MatrixType::Index bs,
+                                          typename MatrixType::RealScalar& cutoff, int* sign)
   {
     typedef typename MatrixType::Scalar Scalar;
     typedef typename MatrixType::RealScalar RealScalar;
     typedef typename MatrixType::Index Index;
-    ei_assert(mat.rows()==mat.cols());
     const Index size = mat.rows();
 
-    if (size <= 1)
-    {
-      transpositions.setIdentity();
-      if(sign)
-        *sign = ei_real(mat.coeff(0,0))>0 ? 1:-1;
-      return true;
-    }
-
-    RealScalar cutoff = 0, biggest_in_corner;
-
-    for (Index k = 0; k < size; ++k)
+    for (Index k = k0; k < k0+bs; ++k)
     {
       // Find largest diagonal element
       Index index_of_biggest_in_corner;
-      biggest_in_corner = mat.diagonal().tail(size-k).cwiseAbs().maxCoeff(&index_of_biggest_in_corner);
+      RealScalar biggest_in_corner = diag.tail(size-k).cwiseAbs().maxCoeff(&index_of_biggest_in_corner);
       index_of_biggest_in_corner += k;
 
       if(k == 0)
@@ -237,14 +239,14 @@ template<> struct ei_ldlt_inplace<Lower>
         cutoff = ei_abs(NumTraits<Scalar>::epsilon() * biggest_in_corner);
 
         if(sign)
-          *sign = ei_real(mat.diagonal().coeff(index_of_biggest_in_corner)) > 0 ? 1 : -1;
+          *sign = ei_real(diag.coeff(index_of_biggest_in_corner)) > 0 ? 1 : -1;
       }
 
       // Finish early if the matrix is not full rank.
       if(biggest_in_corner < cutoff)
       {
         for(Index i = k; i < size; i++) transpositions.coeffRef(i) = i;
-        break;
+        return k-k0;
       }
 
       transpositions.coeffRef(k) = index_of_biggest_in_corner;
@@ -255,7 +257,7 @@ template<> struct ei_ldlt_inplace<Lower>
         Index s = size-index_of_biggest_in_corner-1; // trailing size after the biggest element
         mat.row(k).head(k).swap(mat.row(index_of_biggest_in_corner).head(k));
         mat.col(k).tail(s).swap(mat.col(index_of_biggest_in_corner).tail(s));
-        std::swap(mat.coeffRef(k,k),mat.coeffRef(index_of_biggest_in_corner,index_of_biggest_in_corner));
+        std::swap(diag.coeffRef(k),diag.coeffRef(index_of_biggest_in_corner));
         for(int i=k+1;i<index_of_biggest_in_corner;++i)
         {
           Scalar tmp = mat.coeffRef(i,k);
@@ -270,22 +272,106 @@ template<> struct ei_ldlt_inplace<Lower>
       //       A00 |  -  |  -
       // lu  = A10 | A11 |  -
       //       A20 | A21 | A22
+      // where only the columns k0 to k-1 of A10 and A20 have to be considered
       Index rs = size - k - 1;
+      Index pk = k - k0;
       Block<MatrixType,Dynamic,1> A21(mat,k+1,k,rs,1);
-      Block<MatrixType,1,Dynamic> A10(mat,k,0,1,k);
-      Block<MatrixType,Dynamic,Dynamic> A20(mat,k+1,0,rs,k);
+      Block<MatrixType,1,Dynamic> A10(mat,k,k0,1,pk);
+      Block<MatrixType,Dynamic,Dynamic> A20(mat,k+1,k0,rs,pk);
 
-      if(k>0)
+      if(pk>0 && rs>0)
+      {
+        temp.head(pk) = diag.segment(k0,pk).asDiagonal() * A10.adjoint();
+        A21.noalias() -= A20 * temp.head(pk);
+      }
+      mat.coeffRef(k,k) = diag.coeff(k);
+      if((rs>0) && (ei_abs(diag.coeff(k)) > cutoff))
       {
-        temp.head(k) = mat.diagonal().head(k).asDiagonal() * A10.adjoint();
-        mat.coeffRef(k,k) -= (A10 * temp.head(k)).value();
-        if(rs>0)
-          A21.noalias() -= A20 * temp.head(k);
+        A21 /= diag.coeff(k);
+
+        // update the diagonal of the trailing matrix
+        RealScalar d = ei_real(diag.coeff(k));
+        for(Index i = 0; i < rs; ++i)
+          diag.coeffRef(k+1+i) -= d * ei_abs2(A21.coeff(i));
       }
-      if((rs>0) && (ei_abs(mat.coeffRef(k,k)) > cutoff))
-        A21 /= mat.coeffRef(k,k);
     }
+    return bs;
+  }
+
+  template<typename MatrixType, typename TranspositionType, typename Workspace>
+  static bool unblocked(MatrixType& mat, TranspositionType& transpositions, Workspace& temp, int* sign=0)
+  {
+    typedef typename MatrixType::RealScalar RealScalar;
+    ei_assert(mat.rows()==mat.cols());
+
+    if (mat.rows() <= 1)
+    {
+      transpositions.setIdentity();
+      if(sign)
+        *sign = ei_real(mat.coeff(0,0))>0 ? 1:-1;
+      return true;
+    }
+
+    RealScalar cutoff = 0;
+    Diagonal<MatrixType,0> diag(mat);
+    panel(mat, diag, transpositions, temp, 0, mat.rows(), cutoff, sign);
+    return true;
+  }
+
+  template<typename MatrixType, typename TranspositionType, typename Workspace>
+  static bool blocked(MatrixType& mat, TranspositionType& transpositions, Workspace& temp, int* sign=0)
+  {
+    typedef typename MatrixType::Scalar Scalar;
+    typedef typename MatrixType::RealScalar RealScalar;
+    typedef typename MatrixType::Index Index;
+    ei_assert(mat.rows()==mat.cols());
+    const Index size = mat.rows();
+    if(size<64)
+      return unblocked(mat, transpositions, temp, sign);
+
+    Index blockSize = size/8;
+    blockSize = (blockSize/16)*16;
+    blockSize = std::min(std::max(blockSize,Index(16)), Index(128));
+
+    // the diagonal of the trailing matrix is stored contiguously for the pivoting
+    Matrix<Scalar,Dynamic,1> diag = mat.diagonal();
+    Matrix<Scalar,Dynamic,Dynamic> W(size, blockSize);
+    RealScalar cutoff = 0;
 
+    for (Index k=0; k<size; k+=blockSize)
+    {
+      Index bs = std::min(blockSize, size-k);
+      Index done = panel(mat, diag, transpositions, temp, k, bs, cutoff, sign);
+      if(done < bs)
+      {
+        mat.diagonal().tail(size-k-done) = diag.tail(size-k-done);
+        break;
+      }
+
+      // A22 -= L21 D1 L21^*, through the selfadjoint rank-k product: L21 is scaled by the square
+      // roots of |D1|, and the columns corresponding to positive and negative entries of D1
+      // are processed by two separate updates.
+      Index rs = size - k - bs;
+      if(rs==0)
+        break;
+      Block<MatrixType,Dynamic,Dynamic> L21(mat,k+bs,k,rs,bs);
+      Block<MatrixType,Dynamic,Dynamic> A22(mat,k+bs,k+bs,rs,rs);
+      Index nbPositive = 0;
+      for(Index j = 0; j < bs; ++j)
+        if(ei_real(mat.coeff(k+j,k+j)) >= RealScalar(0))
+          ++nbPositive;
+      Index pos = 0, neg = nbPositive;
+      for(Index j = 0; j < bs; ++j)
+      {
+        RealScalar d = ei_real(mat.coeff(k+j,k+j));
+        W.col(d >= RealScalar(0) ? pos++ : neg++).head(rs) = ei_sqrt(ei_abs(d)) * L21.col(j);
+      }
+
+      if(nbPositive>0)
+        A22.template selfadjointView<Lower>().rankUpdate(W.block(0,0,rs,nbPositive), -1);
+      if(nbPositive<bs)
+        A22.template selfadjointView<Lower>().rankUpdate(W.block(0,nbPositive,rs,bs-nbPositive), 1);
+    }
     return true;
   }
 };
@@ -298,6 +384,12 @@ template<> struct ei_ldlt_inplace<Upper>
     Transpose<MatrixType> matt(mat);
     return ei_ldlt_inplace<Lower>::unblocked(matt, transpositions, temp, sign);
   }
+  template<typename MatrixType, typename TranspositionType, typename Workspace>
+  static EIGEN_STRONG_INLINE bool blocked(MatrixType& mat, TranspositionType& transpositions, Workspace& temp, int* sign=0)
+  {
+    Transpose<MatrixType> matt(mat);
+    return ei_ldlt_inplace<Lower>::blocked(matt, transpositions, temp, sign);
+  }
 };
 
 template<typename MatrixType> struct LDLT_Traits<MatrixType,Lower>
@@ -330,7 +422,7 @@ LDLT<MatrixType,_UpLo>& LDLT<MatrixType,_UpLo>::compute(const MatrixType& a)
   m_isInitialized = false;
   m_temporary.resize(size);
 
-  ei_ldlt_inplace<UpLo>::unblocked(m_matrix, m_transpositions, m_temporary, &m_sign);
+  ei_ldlt_inplace<UpLo>::blocked(m_matrix, m_transpositions, m_temporary, &m_sign);
 
   m_isInitialized = true;
   return *this;
@@ -110,6 +110,18 @@ public:
               : int(NoUnrolling)
   };
 
+  enum {
+    // large dynamic-size assignments with a linear traversal may be split among threads, see ParallelCoeffwise.h,
+    // except if the coefficients of the source cannot be evaluated concurrently, like Random()
+#if defined(EIGEN_PARALLELIZE_COEFFWISE) && !defined(EIGEN_DONT_PARALLELIZE)
+    MayParallelize = int(Derived::SizeAtCompileTime) == Dynamic
+                  && (int(Traversal) == int(LinearVectorizedTraversal) || int(Traversal) == int(LinearTraversal))
+                  && !(int(OtherDerived::Flags) & EvalBeforeNestingBit)
+#else
+    MayParallelize = 0
+#endif
+  };
+
 #ifdef EIGEN_DEBUG_ASSIGN
   static void debug()
   {
@@ -130,6 +142,7 @@ public:
     EIGEN_DEBUG_VAR(MayUnrollCompletely)
     EIGEN_DEBUG_VAR(MayUnrollInner)
     EIGEN_DEBUG_VAR(Unrolling)
+    EIGEN_DEBUG_VAR(MayParallelize)
   }
 #endif
 };
@@ -483,6 +496,20 @@ struct ei_assign_impl<Derived1, Derived2, SliceVectorizedTraversal, NoUnrolling>
   }
 };
 
+/**************************
+*** Parallel evaluation ***
+**************************/
+
+/** \internal Evaluates dst = src by chunks, possibly in parallel, when it is large enough.
+  * \returns false if the assignment has to be performed by ei_assign_impl.
+  * This default version is used when MayParallelize is false, the other one is implemented in ParallelCoeffwise.h.
+  */
+template<typename Derived1, typename Derived2, bool MayParallelize = ei_assign_traits<Derived1, Derived2>::MayParallelize>
+struct ei_parallel_assign_impl
+{
+  EIGEN_STRONG_INLINE static bool run(Derived1 &, const Derived2 &) { return false; }
+};
+
 /***************************************************************************
 * Part 4 : implementation of DenseBase methods
 ***************************************************************************/
@@ -505,8 +532,10 @@ EIGEN_STRONG_INLINE Derived& DenseBase<Derived>
   ei_assign_traits<Derived, OtherDerived>::debug();
 #endif
   ei_assert(rows() == other.rows() && cols() == other.cols());
-  ei_assign_impl<Derived, OtherDerived, int(SameType) ? int(ei_assign_traits<Derived, OtherDerived>::Traversal)
-                                                      : int(InvalidTraversal)>::run(derived(),other.derived());
+  if(!ei_parallel_assign_impl<Derived, OtherDerived, SameType && ei_assign_traits<Derived, OtherDerived>::MayParallelize>
+        ::run(derived(),other.derived()))
+    ei_assign_impl<Derived, OtherDerived, int(SameType) ? int(ei_assign_traits<Derived, OtherDerived>::Traversal)
+                                                        : int(InvalidTraversal)>::run(derived(),other.derived());
 #ifndef EIGEN_NO_DEBUG
   checkTransposeAliasing(other.derived());
 #endif
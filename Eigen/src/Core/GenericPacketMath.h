@@ -171,6 +171,26 @@ ei_ploadu(const typename ei_unpacket_traits<Packet>::type* from) { return *from;
 template<typename Packet> inline Packet
 ei_ploaddup(const typename ei_unpacket_traits<Packet>::type* from) { return *from; }
 
+/** \internal default implementation of ei_pgather() going through a temporary buffer */
+template<typename Packet> struct ei_pgather_impl
+{
+  typedef typename ei_unpacket_traits<Packet>::type Scalar;
+  enum { Size = ei_unpacket_traits<Packet>::size };
+  template<typename Index> static inline Packet run(const Scalar* from, const Index* indices)
+  {
+    Scalar tmp[Size];
+    for(int k=0; k<Size; ++k)
+      tmp[k] = from[indices[k]];
+    return ei_ploadu<Packet>(tmp);
+  }
+};
+
+/** \internal \returns a packet made of the coefficients of \a from at the positions \a indices,
+  * e.g.: (from[indices[0]],from[indices[1]],from[indices[2]],from[indices[3]]) */
+template<typename Packet, typename Index> inline Packet
+ei_pgather(const typename ei_unpacket_traits<Packet>::type* from, const Index* indices)
+{ return ei_pgather_impl<Packet>::run(from, indices); }
+
 /** \internal \returns a packet with constant coefficients \a a, e.g.: (a,a,a,a) */
 template<typename Packet> inline Packet
 ei_pset1(const typename ei_unpacket_traits<Packet>::type& a) { return a; }
@@ -0,0 +1,350 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Copyright (C) 2010 Gael Guennebaud <gael.guennebaud@inria.fr>
+//
+// Eigen is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// Alternatively, you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation; either version 2 of
+// the License, or (at your option) any later version.
+//
+// Eigen is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License or the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License and a copy of the GNU General Public License along with
+// Eigen. If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef EIGEN_PARALLEL_COEFFWISE_H
+#define EIGEN_PARALLEL_COEFFWISE_H
+
+/***************************************************************************
+* Parallel evaluation of large coefficient-wise assignments, reductions
+* and visitors. It is enabled by defining EIGEN_PARALLELIZE_COEFFWISE.
+*
+* The expressions having at least EIGEN_TUNE_PARALLEL_COEFFWISE_THRESHOLD
+* coefficients are split into chunks of EIGEN_TUNE_PARALLEL_COEFFWISE_CHUNK
+* consecutive coefficients, which are evaluated by the ThreadPool if any,
+* or by OpenMP. The partial results of the chunks are then combined in a
+* fixed order, such that the result only depends on the size of the
+* expression, and not on the number of threads nor on their scheduling.
+***************************************************************************/
+
+/** \internal \returns the number of chunks a coefficient-wise evaluation of \a size coefficients
+  * is split into, or 0 if it has to be evaluated at once. */
+template<typename Index>
+inline Index ei_coeffwise_chunks(Index size)
+{
+  if(size < EIGEN_TUNE_PARALLEL_COEFFWISE_THRESHOLD)
+    return 0;
+  Index chunks = (size + EIGEN_TUNE_PARALLEL_COEFFWISE_CHUNK - 1) / EIGEN_TUNE_PARALLEL_COEFFWISE_CHUNK;
+  return chunks > 1 ? chunks : 0;
+}
+
+/** \internal Runs a contiguous range of the chunks of a coefficient-wise evaluation on each thread */
+template<typename Kernel, typename Index>
+class ei_coeffwise_task
+{
+  public:
+    ei_coeffwise_task(const Kernel& kernel, Index chunks, int threads)
+      : m_kernel(kernel), m_chunks(chunks), m_threads(threads)
+    {}
+
+    void operator()(int id) const
+    {
+      const Index end = (m_chunks*(id+1))/m_threads;
+      for(Index c = (m_chunks*id)/m_threads; c < end; ++c)
+        m_kernel(c);
+    }
+
+  protected:
+    const Kernel& m_kernel;
+    Index m_chunks;
+    int m_threads;
+};
+
+/** \internal Calls \a kernel(c) for each of the \a chunks chunks of a coefficient-wise evaluation
+  * of \a size coefficients.
+  *
+  * The chunks are split among the threads of the ThreadPool if any, or of OpenMP, each thread
+  * processing at least EIGEN_TUNE_PARALLEL_THREAD_COST coefficients. The kernel must write its
+  * results in a place which only depends on \a c.
+  */
+template<typename Kernel, typename Index>
+void ei_run_coeffwise_chunks(const Kernel& kernel, Index chunks, Index size)
+{
+  int threads = int(std::min<double>(ei_parallel_threads(double(size)), double(chunks)));
+  if(threads<=1)
+  {
+    for(Index c = 0; c < chunks; ++c)
+      kernel(c);
+    return;
+  }
+  ei_parallel_for(0, threads, ei_coeffwise_task<Kernel,Index>(kernel, chunks, threads));
+}
+
+/** \internal \returns the index of the first coefficient of \a m in [\a begin, \a end) which is well aligned
+  * for vectorization, for the expressions handled by ei_first_aligned(const Derived&). */
+template<typename Derived, bool JustReturnBegin = (Derived::Flags & AlignedBit) || !(Derived::Flags & DirectAccessBit)>
+struct ei_first_aligned_in_range
+{
+  typedef typename Derived::Index Index;
+  inline static Index run(const Derived&, Index begin, Index)
+  { return begin; }
+};
+
+template<typename Derived>
+struct ei_first_aligned_in_range<Derived, false>
+{
+  typedef typename Derived::Index Index;
+  inline static Index run(const Derived& m, Index begin, Index end)
+  {
+    return begin + ei_first_aligned(&m.const_cast_derived().coeffRef(begin), end-begin);
+  }
+};
+
+/***************************************************************************
+* Assignment
+***************************************************************************/
+
+/** \internal Performs the assignment of the coefficients [\a begin, \a end) of a linear traversal */
+template<typename Derived1, typename Derived2, int Traversal = ei_assign_traits<Derived1, Derived2>::Traversal>
+struct ei_assign_range_impl
+{
+  typedef typename Derived1::Index Index;
+  inline static void run(Derived1 &dst, const Derived2 &src, Index begin, Index end)
+  {
+    for(Index index = begin; index < end; ++index)
+      dst.copyCoeff(index, src);
+  }
+};
+
+template<typename Derived1, typename Derived2>
+struct ei_assign_range_impl<Derived1, Derived2, LinearVectorizedTraversal>
+{
+  typedef typename Derived1::Index Index;
+  inline static void run(Derived1 &dst, const Derived2 &src, Index begin, Index end)
+  {
+    typedef ei_packet_traits<typename Derived1::Scalar> PacketTraits;
+    enum {
+      packetSize = PacketTraits::size,
+      dstAlignment = PacketTraits::AlignedOnScalar ? Aligned : int(ei_assign_traits<Derived1,Derived2>::DstIsAligned) ,
+      srcAlignment = ei_assign_traits<Derived1,Derived2>::JointAlignment
+    };
+    // begin is a multiple of the chunk size, and hence of the packet size
+    EIGEN_STATIC_ASSERT(EIGEN_TUNE_PARALLEL_COEFFWISE_CHUNK % packetSize == 0,
+                        EIGEN_TUNE_PARALLEL_COEFFWISE_CHUNK_MUST_BE_A_MULTIPLE_OF_THE_PACKET_SIZE)
+    const Index alignedStart = ei_first_aligned_in_range<Derived1>::run(dst, begin, end);
+    const Index alignedEnd = alignedStart + ((end-alignedStart)/packetSize)*packetSize;
+
+    ei_unaligned_assign_impl<ei_assign_traits<Derived1,Derived2>::DstIsAligned!=0>::run(src,dst,begin,alignedStart);
+
+    for(Index index = alignedStart; index < alignedEnd; index += packetSize)
+      dst.template copyPacket<Derived2, dstAlignment, srcAlignment>(index, src);
+
+    ei_unaligned_assign_impl<>::run(src,dst,alignedEnd,end);
+  }
+};
+
+template<typename Derived1, typename Derived2>
+struct ei_assign_chunk_kernel
+{
+  typedef typename Derived1::Index Index;
+  ei_assign_chunk_kernel(Derived1& dst, const Derived2& src) : m_dst(dst), m_src(src) {}
+
+  void operator()(Index c) const
+  {
+    const Index begin = c * EIGEN_TUNE_PARALLEL_COEFFWISE_CHUNK;
+    const Index end = std::min<Index>(begin + EIGEN_TUNE_PARALLEL_COEFFWISE_CHUNK, m_dst.size());
+    ei_assign_range_impl<Derived1, Derived2>::run(m_dst, m_src, begin, end);
+  }
+
+  Derived1& m_dst;
+  const Derived2& m_src;
+};
+
+template<typename Derived1, typename Derived2>
+struct ei_parallel_assign_impl<Derived1, Derived2, true>
+{
+  typedef typename Derived1::Index Index;
+  static bool run(Derived1 &dst, const Derived2 &src)
+  {
+    const Index size = dst.size();
+    const Index chunks = ei_coeffwise_chunks(size);
+    if(chunks==0)
+      return false;
+    ei_assign_chunk_kernel<Derived1, Derived2> kernel(dst, src);
+    ei_run_coeffwise_chunks(kernel, chunks, size);
+    return true;
+  }
+};
+
+/***************************************************************************
+* Reduction
+***************************************************************************/
+
+/** \internal \returns the reduction of the coefficients [\a begin, \a end) of an expression with linear access */
+template<typename Func, typename Derived, int Traversal = ei_redux_traits<Func, Derived>::Traversal>
+struct ei_redux_range_impl
+{
+  typedef typename Derived::Scalar Scalar;
+  typedef typename Derived::Index Index;
+  inline static Scalar run(const Derived& mat, const Func& func, Index begin, Index end)
+  {
+    Scalar res = mat.coeff(begin);
+    for(Index index = begin+1; index < end; ++index)
+      res = func(res,mat.coeff(index));
+    return res;
+  }
+};
+
+template<typename Func, typename Derived>
+struct ei_redux_range_impl<Func, Derived, LinearVectorizedTraversal>
+{
+  typedef typename Derived::Scalar Scalar;
+  typedef typename ei_packet_traits<Scalar>::type PacketScalar;
+  typedef typename Derived::Index Index;
+
+  static Scalar run(const Derived& mat, const Func& func, Index begin, Index end)
+  {
+    EIGEN_STATIC_ASSERT(EIGEN_TUNE_PARALLEL_COEFFWISE_CHUNK % ei_packet_traits<Scalar>::size == 0,
+                        EIGEN_TUNE_PARALLEL_COEFFWISE_CHUNK_MUST_BE_A_MULTIPLE_OF_THE_PACKET_SIZE)
+    const Index packetSize = ei_packet_traits<Scalar>::size;
+    const Index alignedStart = ei_first_aligned_in_range<Derived>::run(mat, begin, end);
+    enum {
+      alignment = (Derived::Flags & DirectAccessBit) || (Derived::Flags & AlignedBit)
+                ? Aligned : Unaligned
+    };
+    const Index alignedEnd = alignedStart + ((end-alignedStart)/packetSize)*packetSize;
+    if(alignedEnd==alignedStart)
+      return ei_redux_range_impl<Func, Derived, DefaultTraversal>::run(mat, func, begin, end);
+
+    PacketScalar packet_res = mat.template packet<alignment>(alignedStart);
+    for(Index index = alignedStart + packetSize; index < alignedEnd; index += packetSize)
+      packet_res = func.packetOp(packet_res, mat.template packet<alignment>(index));
+    Scalar res = func.predux(packet_res);
+
+    for(Index index = begin; index < alignedStart; ++index)
+      res = func(res,mat.coeff(index));
+
+    for(Index index = alignedEnd; index < end; ++index)
+      res = func(res,mat.coeff(index));
+    return res;
+  }
+};
+
+template<typename Func, typename Derived>
+struct ei_redux_chunk_kernel
+{
+  typedef typename Derived::Scalar Scalar;
+  typedef typename Derived::Index Index;
+  ei_redux_chunk_kernel(const Derived& mat, const Func& func, Scalar* partials)
+    : m_mat(mat), m_func(func), m_partials(partials) {}
+
+  void operator()(Index c) const
+  {
+    const Index begin = c * EIGEN_TUNE_PARALLEL_COEFFWISE_CHUNK;
+    const Index end = std::min<Index>(begin + EIGEN_TUNE_PARALLEL_COEFFWISE_CHUNK, m_mat.size());
+    m_partials[c] = ei_redux_range_impl<Func, Derived>::run(m_mat, m_func, begin, end);
+  }
+
+  const Derived& m_mat;
+  const Func& m_func;
+  Scalar* m_partials;
+};
+
+template<typename Func, typename Derived>
+struct ei_parallel_redux_impl<Func, Derived, true>
+{
+  typedef typename Derived::Scalar Scalar;
+  typedef typename Derived::Index Index;
+  static bool run(const Derived& mat, const Func& func, Scalar& res)
+  {
+    const Index size = mat.size();
+    const Index chunks = ei_coeffwise_chunks(size);
+    if(chunks==0)
+      return false;
+
+    Scalar* partials = ei_aligned_stack_new(Scalar, chunks);
+    ei_redux_chunk_kernel<Func, Derived> kernel(mat, func, partials);
+    ei_run_coeffwise_chunks(kernel, chunks, size);
+
+    // combine the partial results with a pairwise tree which only depends on the number of chunks
+    for(Index step = 1; step < chunks; step *= 2)
+      for(Index c = 0; c + step < chunks; c += 2*step)
+        partials[c] = func(partials[c], partials[c+step]);
+    res = partials[0];
+
+    ei_aligned_stack_delete(Scalar, partials, chunks);
+    return true;
+  }
+};
+
+/***************************************************************************
+* Visitors
+***************************************************************************/
+
+template<typename Visitor, typename Derived>
+struct ei_visitor_chunk_kernel
+{
+  typedef typename Derived::Index Index;
+  ei_visitor_chunk_kernel(const Derived& mat, Visitor* visitors) : m_mat(mat), m_visitors(visitors) {}
+
+  void operator()(Index c) const
+  {
+    // the chunks are ranges of coefficients in column-major order, like in ei_visitor_impl
+    const Index rows = m_mat.rows();
+    const Index begin = c * EIGEN_TUNE_PARALLEL_COEFFWISE_CHUNK;
+    const Index end = std::min<Index>(begin + EIGEN_TUNE_PARALLEL_COEFFWISE_CHUNK, m_mat.size());
+    Index i = begin % rows, j = begin / rows;
+    Visitor& visitor = m_visitors[c];
+    visitor.init(m_mat.coeff(i, j), i, j);
+    for(Index k = begin+1; k < end; ++k)
+    {
+      if(++i == rows)
+      {
+        i = 0;
+        ++j;
+      }
+      visitor(m_mat.coeff(i, j), i, j);
+    }
+  }
+
+  const Derived& m_mat;
+  Visitor* m_visitors;
+};
+
+template<typename Visitor, typename Derived>
+struct ei_parallel_visitor_impl<Visitor, Derived, true>
+{
+  typedef typename Derived::Index Index;
+  static bool run(const Derived& mat, Visitor& visitor)
+  {
+    const Index size = mat.size();
+    const Index chunks = ei_coeffwise_chunks(size);
+    if(chunks==0)
+      return false;
+
+    Visitor* visitors = ei_aligned_stack_new(Visitor, chunks);
+    ei_visitor_chunk_kernel<Visitor, Derived> kernel(mat, visitors);
+    ei_run_coeffwise_chunks(kernel, chunks, size);
+
+    // merge the chunks in order
+    visitor = visitors[0];
+    for(Index c = 1; c < chunks; ++c)
+      visitor.merge(visitors[c]);
+
+    ei_aligned_stack_delete(Visitor, visitors, chunks);
+    return true;
+  }
+};
+
+#endif // EIGEN_PARALLEL_COEFFWISE_H
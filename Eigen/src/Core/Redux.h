@@ -76,6 +76,16 @@ public:
               ? CompleteUnrolling
               : NoUnrolling
   };
+
+  enum {
+    // large dynamic-size expressions with linear access may be reduced in parallel, see ParallelCoeffwise.h
+#if defined(EIGEN_PARALLELIZE_COEFFWISE) && !defined(EIGEN_DONT_PARALLELIZE)
+    MayParallelize = int(Derived::SizeAtCompileTime) == Dynamic && (int(Derived::Flags)&LinearAccessBit)
+                  && !(int(Derived::Flags) & EvalBeforeNestingBit)
+#else
+    MayParallelize = 0
+#endif
+  };
 };
 
 /***************************************************************************
@@ -305,6 +315,17 @@ struct ei_redux_impl<Func, Derived, LinearVectorizedTraversal, CompleteUnrolling
 };
 
 
+/** \internal Reduces \a mat by chunks, possibly in parallel, when it is large enough, and stores the result in \a res.
+  * \returns false if the reduction has to be performed by ei_redux_impl.
+  * This default version is used when MayParallelize is false, the other one is implemented in ParallelCoeffwise.h.
+  */
+template<typename Func, typename Derived, bool MayParallelize = ei_redux_traits<Func, Derived>::MayParallelize>
+struct ei_parallel_redux_impl
+{
+  typedef typename Derived::Scalar Scalar;
+  static EIGEN_STRONG_INLINE bool run(const Derived&, const Func&, Scalar&) { return false; }
+};
+
 /** \returns the result of a full redux operation on the whole matrix or vector using \a func
   *
   * The template parameter \a BinaryOp is the type of the functor \a func which must be
@@ -318,6 +339,9 @@ EIGEN_STRONG_INLINE typename ei_result_of<Func(typename ei_traits<Derived>::Scal
 DenseBase<Derived>::redux(const Func& func) const
 {
   typedef typename ei_cleantype<typename Derived::Nested>::type ThisNested;
+  Scalar res;
+  if(ei_parallel_redux_impl<Func, ThisNested>::run(derived(), func, res))
+    return res;
   return ei_redux_impl<Func, ThisNested>
             ::run(derived(), func);
 }
@@ -136,7 +136,8 @@ template<typename BinaryOp, typename Lhs, typename Rhs> class SelfCwiseBinaryOp
       ei_assign_traits<SelfCwiseBinaryOp, RhsDerived>::debug();
     #endif
       ei_assert(rows() == rhs.rows() && cols() == rhs.cols());
-      ei_assign_impl<SelfCwiseBinaryOp, RhsDerived>::run(*this,rhs.derived());
+      if(!ei_parallel_assign_impl<SelfCwiseBinaryOp, RhsDerived>::run(*this,rhs.derived()))
+        ei_assign_impl<SelfCwiseBinaryOp, RhsDerived>::run(*this,rhs.derived());
     #ifndef EIGEN_NO_DEBUG
       this->checkTransposeAliasing(rhs.derived());
     #endif
@@ -64,6 +64,32 @@ struct ei_visitor_impl<Visitor, Derived, Dynamic>
   }
 };
 
+/** \internal Visitors whose results on two consecutive ranges of coefficients can be combined
+  * specialize this class with Mergeable = 1 and implement a merge(const Visitor& other) method,
+  * \a other having visited the coefficients following the ones visited by *this in column-major order.
+  */
+template<typename Visitor>
+struct ei_visitor_traits
+{
+  enum { Mergeable = 0 };
+};
+
+/** \internal Visits \a mat by chunks, possibly in parallel, when it is large enough, and merges the results into \a visitor.
+  * \returns false if the visit has to be performed by ei_visitor_impl.
+  * This default version is used when MayParallelize is false, the other one is implemented in ParallelCoeffwise.h.
+  */
+template<typename Visitor, typename Derived,
+#if defined(EIGEN_PARALLELIZE_COEFFWISE) && !defined(EIGEN_DONT_PARALLELIZE)
+         bool MayParallelize = int(Derived::SizeAtCompileTime)==Dynamic && ei_visitor_traits<Visitor>::Mergeable
+                            && !(int(Derived::Flags) & EvalBeforeNestingBit)
+#else
+         bool MayParallelize = false
+#endif
+        >
+struct ei_parallel_visitor_impl
+{
+  inline static bool run(const Derived&, Visitor&) { return false; }
+};
 
 /** Applies the visitor \a visitor to the whole coefficients of the matrix or vector.
   *
@@ -91,6 +117,8 @@ void DenseBase<Derived>::visit(Visitor& visitor) const
                    && (SizeAtCompileTime == 1 || ei_functor_traits<Visitor>::Cost != Dynamic)
                    && SizeAtCompileTime * CoeffReadCost + (SizeAtCompileTime-1) * ei_functor_traits<Visitor>::Cost
                       <= EIGEN_UNROLLING_LIMIT };
+  if(ei_parallel_visitor_impl<Visitor, Derived>::run(derived(), visitor))
+    return;
   return ei_visitor_impl<Visitor, Derived,
       unroll ? int(SizeAtCompileTime) : Dynamic
     >::run(derived(), visitor);
@@ -133,6 +161,11 @@ struct ei_min_coeff_visitor : ei_coeff_visitor<Derived>
       this->col = j;
     }
   }
+  void merge(const ei_min_coeff_visitor& other)
+  {
+    if(other.res < this->res)
+      *this = other;
+  }
 };
 
 template<typename Scalar>
@@ -142,6 +175,11 @@ struct ei_functor_traits<ei_min_coeff_visitor<Scalar> > {
   };
 };
 
+template<typename Derived>
+struct ei_visitor_traits<ei_min_coeff_visitor<Derived> > {
+  enum { Mergeable = 1 };
+};
+
 /** \internal
   * \brief Visitor computing the max coefficient with its value and coordinates
   *
@@ -161,6 +199,11 @@ struct ei_max_coeff_visitor : ei_coeff_visitor<Derived>
       this->col = j;
     }
   }
+  void merge(const ei_max_coeff_visitor& other)
+  {
+    if(other.res > this->res)
+      *this = other;
+  }
 };
 
 template<typename Scalar>
@@ -170,6 +213,11 @@ struct ei_functor_traits<ei_max_coeff_visitor<Scalar> > {
   };
 };
 
+template<typename Derived>
+struct ei_visitor_traits<ei_max_coeff_visitor<Derived> > {
+  enum { Mergeable = 1 };
+};
+
 /** \returns the minimum of all coefficients of *this
   * and puts in *row and *col its location.
   *
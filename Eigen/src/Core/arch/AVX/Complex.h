@@ -0,0 +1,359 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Copyright (C) 2010 Gael Guennebaud <gael.guennebaud@inria.fr>
+//
+// Eigen is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// Alternatively, you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation; either version 2 of
+// the License, or (at your option) any later version.
+//
+// Eigen is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License or the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License and a copy of the GNU General Public License along with
+// Eigen. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef EIGEN_COMPLEX_AVX_H
+#define EIGEN_COMPLEX_AVX_H
+
+//---------- float ----------
+struct Packet4cf
+{
+  EIGEN_STRONG_INLINE Packet4cf() {}
+  EIGEN_STRONG_INLINE explicit Packet4cf(const __m256& a) : v(a) {}
+  __m256  v;
+};
+
+template<> struct ei_packet_traits<std::complex<float> >  : ei_default_packet_traits
+{
+  typedef Packet4cf type;
+  enum {
+    Vectorizable = 1,
+    AlignedOnScalar = 1,
+    size = 4,
+
+    HasAdd    = 1,
+    HasSub    = 1,
+    HasMul    = 1,
+    HasDiv    = 1,
+    HasNegate = 1,
+    HasAbs    = 0,
+    HasAbs2   = 0,
+    HasMin    = 0,
+    HasMax    = 0,
+    HasSetLinear = 0
+  };
+};
+
+template<> struct ei_unpacket_traits<Packet4cf> { typedef std::complex<float> type; enum {size=4}; };
+
+template<> EIGEN_STRONG_INLINE Packet4cf ei_padd<Packet4cf>(const Packet4cf& a, const Packet4cf& b) { return Packet4cf(_mm256_add_ps(a.v,b.v)); }
+template<> EIGEN_STRONG_INLINE Packet4cf ei_psub<Packet4cf>(const Packet4cf& a, const Packet4cf& b) { return Packet4cf(_mm256_sub_ps(a.v,b.v)); }
+template<> EIGEN_STRONG_INLINE Packet4cf ei_pnegate(const Packet4cf& a) { return Packet4cf(ei_pnegate(a.v)); }
+template<> EIGEN_STRONG_INLINE Packet4cf ei_pconj(const Packet4cf& a)
+{
+  const __m256 mask = _mm256_castsi256_ps(_mm256_setr_epi32(0x00000000,0x80000000,0x00000000,0x80000000,
+                                                            0x00000000,0x80000000,0x00000000,0x80000000));
+  return Packet4cf(_mm256_xor_ps(a.v,mask));
+}
+
+template<> EIGEN_STRONG_INLINE Packet4cf ei_pmul<Packet4cf>(const Packet4cf& a, const Packet4cf& b)
+{
+  // (a_r b_r - a_i b_i, a_r b_i + a_i b_r)
+  __m256 tmp = _mm256_mul_ps(_mm256_movehdup_ps(a.v), _mm256_permute_ps(b.v, 0xB1));
+  #ifdef EIGEN_VECTORIZE_FMA
+  return Packet4cf(_mm256_fmaddsub_ps(_mm256_moveldup_ps(a.v), b.v, tmp));
+  #else
+  return Packet4cf(_mm256_addsub_ps(_mm256_mul_ps(_mm256_moveldup_ps(a.v), b.v), tmp));
+  #endif
+}
+
+template<> EIGEN_STRONG_INLINE Packet4cf ei_pand   <Packet4cf>(const Packet4cf& a, const Packet4cf& b) { return Packet4cf(_mm256_and_ps(a.v,b.v)); }
+template<> EIGEN_STRONG_INLINE Packet4cf ei_por    <Packet4cf>(const Packet4cf& a, const Packet4cf& b) { return Packet4cf(_mm256_or_ps(a.v,b.v)); }
+template<> EIGEN_STRONG_INLINE Packet4cf ei_pxor   <Packet4cf>(const Packet4cf& a, const Packet4cf& b) { return Packet4cf(_mm256_xor_ps(a.v,b.v)); }
+template<> EIGEN_STRONG_INLINE Packet4cf ei_pandnot<Packet4cf>(const Packet4cf& a, const Packet4cf& b) { return Packet4cf(_mm256_andnot_ps(a.v,b.v)); }
+
+template<> EIGEN_STRONG_INLINE Packet4cf ei_pload <Packet4cf>(const std::complex<float>* from) { EIGEN_DEBUG_ALIGNED_LOAD return Packet4cf(ei_pload<Packet8f>(&ei_real_ref(*from))); }
+template<> EIGEN_STRONG_INLINE Packet4cf ei_ploadu<Packet4cf>(const std::complex<float>* from) { EIGEN_DEBUG_UNALIGNED_LOAD return Packet4cf(ei_ploadu<Packet8f>(&ei_real_ref(*from))); }
+
+template<> EIGEN_STRONG_INLINE void ei_pstore <std::complex<float> >(std::complex<float> *   to, const Packet4cf& from) { EIGEN_DEBUG_ALIGNED_STORE ei_pstore(&ei_real_ref(*to), from.v); }
+template<> EIGEN_STRONG_INLINE void ei_pstoreu<std::complex<float> >(std::complex<float> *   to, const Packet4cf& from) { EIGEN_DEBUG_UNALIGNED_STORE ei_pstoreu(&ei_real_ref(*to), from.v); }
+
+template<> EIGEN_STRONG_INLINE Packet4cf ei_pset1<Packet4cf>(const std::complex<float>&  from)
+{
+  // a std::complex<float> has the size of a double: broadcast it as such
+  return Packet4cf(_mm256_castpd_ps(_mm256_broadcast_sd(reinterpret_cast<const double*>(&from))));
+}
+
+template<> EIGEN_STRONG_INLINE std::complex<float>  ei_pfirst<Packet4cf>(const Packet4cf& a)
+{
+  return ei_pfirst(Packet2cf(ei_vec8f_low(a.v)));
+}
+
+template<> EIGEN_STRONG_INLINE Packet4cf ei_preverse(const Packet4cf& a) { return Packet4cf(_mm256_castpd_ps(ei_preverse(_mm256_castps_pd(a.v)))); }
+
+template<> EIGEN_STRONG_INLINE std::complex<float> ei_predux<Packet4cf>(const Packet4cf& a)
+{
+  return ei_predux(Packet2cf(_mm_add_ps(ei_vec8f_low(a.v), ei_vec8f_high(a.v))));
+}
+
+template<> EIGEN_STRONG_INLINE Packet4cf ei_preduxp<Packet4cf>(const Packet4cf* vecs)
+{
+  Packet2cf halves[4];
+  for(int i=0; i<4; ++i)
+    halves[i] = Packet2cf(_mm_add_ps(ei_vec8f_low(vecs[i].v), ei_vec8f_high(vecs[i].v)));
+  return Packet4cf(ei_vec8f_combine(ei_preduxp(halves).v, ei_preduxp(halves+2).v));
+}
+
+template<> EIGEN_STRONG_INLINE std::complex<float> ei_predux_mul<Packet4cf>(const Packet4cf& a)
+{
+  return ei_predux_mul(ei_pmul(Packet2cf(ei_vec8f_low(a.v)), Packet2cf(ei_vec8f_high(a.v))));
+}
+
+template<int Offset>
+struct ei_palign_impl<Offset,Packet4cf>
+{
+  EIGEN_STRONG_INLINE static void run(Packet4cf& first, const Packet4cf& second)
+  {
+    // a std::complex<float> has the size of a double
+    Packet4d tmp = _mm256_castps_pd(first.v);
+    ei_palign_impl<Offset,Packet4d>::run(tmp, _mm256_castps_pd(second.v));
+    first.v = _mm256_castpd_ps(tmp);
+  }
+};
+
+template<> struct ei_conj_helper<Packet4cf, Packet4cf, false,true>
+{
+  EIGEN_STRONG_INLINE Packet4cf pmadd(const Packet4cf& x, const Packet4cf& y, const Packet4cf& c) const
+  { return ei_padd(pmul(x,y),c); }
+
+  EIGEN_STRONG_INLINE Packet4cf pmul(const Packet4cf& a, const Packet4cf& b) const
+  {
+    return ei_pmul(a, ei_pconj(b));
+  }
+};
+
+template<> struct ei_conj_helper<Packet4cf, Packet4cf, true,false>
+{
+  EIGEN_STRONG_INLINE Packet4cf pmadd(const Packet4cf& x, const Packet4cf& y, const Packet4cf& c) const
+  { return ei_padd(pmul(x,y),c); }
+
+  EIGEN_STRONG_INLINE Packet4cf pmul(const Packet4cf& a, const Packet4cf& b) const
+  {
+    return ei_pmul(ei_pconj(a), b);
+  }
+};
+
+template<> struct ei_conj_helper<Packet4cf, Packet4cf, true,true>
+{
+  EIGEN_STRONG_INLINE Packet4cf pmadd(const Packet4cf& x, const Packet4cf& y, const Packet4cf& c) const
+  { return ei_padd(pmul(x,y),c); }
+
+  EIGEN_STRONG_INLINE Packet4cf pmul(const Packet4cf& a, const Packet4cf& b) const
+  {
+    return ei_pconj(ei_pmul(a, b));
+  }
+};
+
+template<> struct ei_conj_helper<Packet8f, Packet4cf, false,false>
+{
+  EIGEN_STRONG_INLINE Packet4cf pmadd(const Packet8f& x, const Packet4cf& y, const Packet4cf& c) const
+  { return Packet4cf(ei_pmadd(x, y.v, c.v)); }
+
+  EIGEN_STRONG_INLINE Packet4cf pmul(const Packet8f& x, const Packet4cf& y) const
+  { return Packet4cf(ei_pmul(x, y.v)); }
+};
+
+template<> struct ei_conj_helper<Packet4cf, Packet8f, false,false>
+{
+  EIGEN_STRONG_INLINE Packet4cf pmadd(const Packet4cf& x, const Packet8f& y, const Packet4cf& c) const
+  { return Packet4cf(ei_pmadd(x.v, y, c.v)); }
+
+  EIGEN_STRONG_INLINE Packet4cf pmul(const Packet4cf& x, const Packet8f& y) const
+  { return Packet4cf(ei_pmul(x.v, y)); }
+};
+
+template<> EIGEN_STRONG_INLINE Packet4cf ei_pdiv<Packet4cf>(const Packet4cf& a, const Packet4cf& b)
+{
+  Packet4cf res = ei_conj_helper<Packet4cf,Packet4cf,false,true>().pmul(a,b);
+  __m256 s = _mm256_mul_ps(b.v,b.v);
+  return Packet4cf(_mm256_div_ps(res.v,_mm256_add_ps(s,_mm256_permute_ps(s, 0xB1))));
+}
+
+EIGEN_STRONG_INLINE Packet4cf ei_pcplxflip/*<Packet4cf>*/(const Packet4cf& x)
+{
+  return Packet4cf(_mm256_permute_ps(x.v, 0xB1));
+}
+
+
+//---------- double ----------
+struct Packet2cd
+{
+  EIGEN_STRONG_INLINE Packet2cd() {}
+  EIGEN_STRONG_INLINE explicit Packet2cd(const __m256d& a) : v(a) {}
+  __m256d  v;
+};
+
+template<> struct ei_packet_traits<std::complex<double> >  : ei_default_packet_traits
+{
+  typedef Packet2cd type;
+  enum {
+    Vectorizable = 1,
+    AlignedOnScalar = 0,
+    size = 2,
+
+    HasAdd    = 1,
+    HasSub    = 1,
+    HasMul    = 1,
+    HasDiv    = 1,
+    HasNegate = 1,
+    HasAbs    = 0,
+    HasAbs2   = 0,
+    HasMin    = 0,
+    HasMax    = 0,
+    HasSetLinear = 0
+  };
+};
+
+template<> struct ei_unpacket_traits<Packet2cd> { typedef std::complex<double> type; enum {size=2}; };
+
+template<> EIGEN_STRONG_INLINE Packet2cd ei_padd<Packet2cd>(const Packet2cd& a, const Packet2cd& b) { return Packet2cd(_mm256_add_pd(a.v,b.v)); }
+template<> EIGEN_STRONG_INLINE Packet2cd ei_psub<Packet2cd>(const Packet2cd& a, const Packet2cd& b) { return Packet2cd(_mm256_sub_pd(a.v,b.v)); }
+template<> EIGEN_STRONG_INLINE Packet2cd ei_pnegate(const Packet2cd& a) { return Packet2cd(ei_pnegate(a.v)); }
+template<> EIGEN_STRONG_INLINE Packet2cd ei_pconj(const Packet2cd& a)
+{
+  const __m256d mask = _mm256_setr_pd(0.0,-0.0,0.0,-0.0);
+  return Packet2cd(_mm256_xor_pd(a.v,mask));
+}
+
+template<> EIGEN_STRONG_INLINE Packet2cd ei_pmul<Packet2cd>(const Packet2cd& a, const Packet2cd& b)
+{
+  __m256d tmp = _mm256_mul_pd(_mm256_permute_pd(a.v, 0xF), _mm256_permute_pd(b.v, 0x5));
+  #ifdef EIGEN_VECTORIZE_FMA
+  return Packet2cd(_mm256_fmaddsub_pd(_mm256_movedup_pd(a.v), b.v, tmp));
+  #else
+  return Packet2cd(_mm256_addsub_pd(_mm256_mul_pd(_mm256_movedup_pd(a.v), b.v), tmp));
+  #endif
+}
+
+template<> EIGEN_STRONG_INLINE Packet2cd ei_pand   <Packet2cd>(const Packet2cd& a, const Packet2cd& b) { return Packet2cd(_mm256_and_pd(a.v,b.v)); }
+template<> EIGEN_STRONG_INLINE Packet2cd ei_por    <Packet2cd>(const Packet2cd& a, const Packet2cd& b) { return Packet2cd(_mm256_or_pd(a.v,b.v)); }
+template<> EIGEN_STRONG_INLINE Packet2cd ei_pxor   <Packet2cd>(const Packet2cd& a, const Packet2cd& b) { return Packet2cd(_mm256_xor_pd(a.v,b.v)); }
+template<> EIGEN_STRONG_INLINE Packet2cd ei_pandnot<Packet2cd>(const Packet2cd& a, const Packet2cd& b) { return Packet2cd(_mm256_andnot_pd(a.v,b.v)); }
+
+template<> EIGEN_STRONG_INLINE Packet2cd ei_pload <Packet2cd>(const std::complex<double>* from)
+{ EIGEN_DEBUG_ALIGNED_LOAD return Packet2cd(ei_pload<Packet4d>((const double*)from)); }
+template<> EIGEN_STRONG_INLINE Packet2cd ei_ploadu<Packet2cd>(const std::complex<double>* from)
+{ EIGEN_DEBUG_UNALIGNED_LOAD return Packet2cd(ei_ploadu<Packet4d>((const double*)from)); }
+template<> EIGEN_STRONG_INLINE Packet2cd ei_pset1<Packet2cd>(const std::complex<double>&  from)
+{ return Packet2cd(_mm256_broadcast_pd(reinterpret_cast<const __m128d*>(&from))); }
+
+template<> EIGEN_STRONG_INLINE void ei_pstore <std::complex<double> >(std::complex<double> *   to, const Packet2cd& from) { EIGEN_DEBUG_ALIGNED_STORE ei_pstore((double*)to, from.v); }
+template<> EIGEN_STRONG_INLINE void ei_pstoreu<std::complex<double> >(std::complex<double> *   to, const Packet2cd& from) { EIGEN_DEBUG_UNALIGNED_STORE ei_pstoreu((double*)to, from.v); }
+
+template<> EIGEN_STRONG_INLINE std::complex<double>  ei_pfirst<Packet2cd>(const Packet2cd& a)
+{
+  return ei_pfirst(Packet1cd(ei_vec4d_low(a.v)));
+}
+
+template<> EIGEN_STRONG_INLINE Packet2cd ei_preverse(const Packet2cd& a) { return Packet2cd(_mm256_permute2f128_pd(a.v,a.v,0x1)); }
+
+template<> EIGEN_STRONG_INLINE std::complex<double> ei_predux<Packet2cd>(const Packet2cd& a)
+{
+  return ei_pfirst(Packet1cd(_mm_add_pd(ei_vec4d_low(a.v), ei_vec4d_high(a.v))));
+}
+
+template<> EIGEN_STRONG_INLINE Packet2cd ei_preduxp<Packet2cd>(const Packet2cd* vecs)
+{
+  return Packet2cd(_mm256_add_pd(_mm256_permute2f128_pd(vecs[0].v,vecs[1].v,0x20),
+                                 _mm256_permute2f128_pd(vecs[0].v,vecs[1].v,0x31)));
+}
+
+template<> EIGEN_STRONG_INLINE std::complex<double> ei_predux_mul<Packet2cd>(const Packet2cd& a)
+{
+  return ei_pfirst(ei_pmul(Packet1cd(ei_vec4d_low(a.v)), Packet1cd(ei_vec4d_high(a.v))));
+}
+
+template<int Offset>
+struct ei_palign_impl<Offset,Packet2cd>
+{
+  EIGEN_STRONG_INLINE static void run(Packet2cd& first, const Packet2cd& second)
+  {
+    if (Offset==1)
+      first.v = _mm256_permute2f128_pd(first.v, second.v, 0x21);
+  }
+};
+
+template<> struct ei_conj_helper<Packet2cd, Packet2cd, false,true>
+{
+  EIGEN_STRONG_INLINE Packet2cd pmadd(const Packet2cd& x, const Packet2cd& y, const Packet2cd& c) const
+  { return ei_padd(pmul(x,y),c); }
+
+  EIGEN_STRONG_INLINE Packet2cd pmul(const Packet2cd& a, const Packet2cd& b) const
+  {
+    return ei_pmul(a, ei_pconj(b));
+  }
+};
+
+template<> struct ei_conj_helper<Packet2cd, Packet2cd, true,false>
+{
+  EIGEN_STRONG_INLINE Packet2cd pmadd(const Packet2cd& x, const Packet2cd& y, const Packet2cd& c) const
+  { return ei_padd(pmul(x,y),c); }
+
+  EIGEN_STRONG_INLINE Packet2cd pmul(const Packet2cd& a, const Packet2cd& b) const
+  {
+    return ei_pmul(ei_pconj(a), b);
+  }
+};
+
+template<> struct ei_conj_helper<Packet2cd, Packet2cd, true,true>
+{
+  EIGEN_STRONG_INLINE Packet2cd pmadd(const Packet2cd& x, const Packet2cd& y, const Packet2cd& c) const
+  { return ei_padd(pmul(x,y),c); }
+
+  EIGEN_STRONG_INLINE Packet2cd pmul(const Packet2cd& a, const Packet2cd& b) const
+  {
+    return ei_pconj(ei_pmul(a, b));
+  }
+};
+
+template<> struct ei_conj_helper<Packet4d, Packet2cd, false,false>
+{
+  EIGEN_STRONG_INLINE Packet2cd pmadd(const Packet4d& x, const Packet2cd& y, const Packet2cd& c) const
+  { return Packet2cd(ei_pmadd(x, y.v, c.v)); }
+
+  EIGEN_STRONG_INLINE Packet2cd pmul(const Packet4d& x, const Packet2cd& y) const
+  { return Packet2cd(ei_pmul(x, y.v)); }
+};
+
+template<> struct ei_conj_helper<Packet2cd, Packet4d, false,false>
+{
+  EIGEN_STRONG_INLINE Packet2cd pmadd(const Packet2cd& x, const Packet4d& y, const Packet2cd& c) const
+  { return Packet2cd(ei_pmadd(x.v, y, c.v)); }
+
+  EIGEN_STRONG_INLINE Packet2cd pmul(const Packet2cd& x, const Packet4d& y) const
+  { return Packet2cd(ei_pmul(x.v, y)); }
+};
+
+template<> EIGEN_STRONG_INLINE Packet2cd ei_pdiv<Packet2cd>(const Packet2cd& a, const Packet2cd& b)
+{
+  Packet2cd res = ei_conj_helper<Packet2cd,Packet2cd,false,true>().pmul(a,b);
+  __m256d s = _mm256_mul_pd(b.v,b.v);
+  return Packet2cd(_mm256_div_pd(res.v, _mm256_add_pd(s,_mm256_permute_pd(s, 0x5))));
+}
+
+EIGEN_STRONG_INLINE Packet2cd ei_pcplxflip/*<Packet2cd>*/(const Packet2cd& x)
+{
+  return Packet2cd(_mm256_permute_pd(x.v, 0x5));
+}
+
+#endif // EIGEN_COMPLEX_AVX_H
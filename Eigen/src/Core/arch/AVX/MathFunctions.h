@@ -0,0 +1,56 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Copyright (C) 2010 Gael Guennebaud <gael.guennebaud@inria.fr>
+//
+// Eigen is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// Alternatively, you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation; either version 2 of
+// the License, or (at your option) any later version.
+//
+// Eigen is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License or the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License and a copy of the GNU General Public License along with
+// Eigen. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef EIGEN_MATH_FUNCTIONS_AVX_H
+#define EIGEN_MATH_FUNCTIONS_AVX_H
+
+/* The transcendental functions do not have native AVX implementations yet:
+ * they apply the SSE versions to each half of the packet.
+ */
+
+#define EIGEN_AVX_MATH_FUNCTION_FROM_SSE(FUNC) \
+  template<> EIGEN_DEFINE_FUNCTION_ALLOWING_MULTIPLE_DEFINITIONS EIGEN_UNUSED \
+  Packet8f FUNC<Packet8f>(const Packet8f& _x) \
+  { return ei_vec8f_combine(FUNC<Packet4f>(ei_vec8f_low(_x)), FUNC<Packet4f>(ei_vec8f_high(_x))); }
+
+EIGEN_AVX_MATH_FUNCTION_FROM_SSE(ei_plog)
+EIGEN_AVX_MATH_FUNCTION_FROM_SSE(ei_pexp)
+EIGEN_AVX_MATH_FUNCTION_FROM_SSE(ei_psin)
+EIGEN_AVX_MATH_FUNCTION_FROM_SSE(ei_pcos)
+
+#undef EIGEN_AVX_MATH_FUNCTION_FROM_SSE
+
+template<> EIGEN_DEFINE_FUNCTION_ALLOWING_MULTIPLE_DEFINITIONS EIGEN_UNUSED
+Packet8f ei_psqrt<Packet8f>(const Packet8f& _x)
+{
+  return _mm256_sqrt_ps(_x);
+}
+
+template<> EIGEN_DEFINE_FUNCTION_ALLOWING_MULTIPLE_DEFINITIONS EIGEN_UNUSED
+Packet4d ei_psqrt<Packet4d>(const Packet4d& _x)
+{
+  return _mm256_sqrt_pd(_x);
+}
+
+#endif // EIGEN_MATH_FUNCTIONS_AVX_H
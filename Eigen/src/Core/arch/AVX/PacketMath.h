@@ -0,0 +1,305 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Copyright (C) 2010 Gael Guennebaud <gael.guennebaud@inria.fr>
+//
+// Eigen is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// Alternatively, you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation; either version 2 of
+// the License, or (at your option) any later version.
+//
+// Eigen is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License or the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License and a copy of the GNU General Public License along with
+// Eigen. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef EIGEN_PACKET_MATH_AVX_H
+#define EIGEN_PACKET_MATH_AVX_H
+
+/* The AVX packets extend the SSE ones: this file is included after arch/SSE/PacketMath.h
+ * which still provides the 128 bits packets (Packet4f, Packet2d, Packet4i). Those are used
+ * to implement the horizontal operations on each half of a 256 bits packet, and Packet4i
+ * remains the packet type of int.
+ *
+ * Eigen only guarantees a 16 bytes alignment for fixed size objects, while the aligned AVX
+ * load and store instructions require 32 bytes. Therefore the "aligned" loads and stores
+ * below are implemented with their unaligned counterparts, which are as fast as the aligned
+ * ones on data which happen to be aligned.
+ */
+
+typedef __m256  Packet8f;
+typedef __m256d Packet4d;
+
+template<> struct ei_is_arithmetic<__m256>  { enum { ret = true }; };
+template<> struct ei_is_arithmetic<__m256d> { enum { ret = true }; };
+
+#define ei_vec8f_low(a)   (_mm256_castps256_ps128(a))
+#define ei_vec8f_high(a)  (_mm256_extractf128_ps((a),1))
+#define ei_vec8f_combine(lo,hi) (_mm256_insertf128_ps(_mm256_castps128_ps256(lo),(hi),1))
+
+#define ei_vec4d_low(a)   (_mm256_castpd256_pd128(a))
+#define ei_vec4d_high(a)  (_mm256_extractf128_pd((a),1))
+#define ei_vec4d_combine(lo,hi) (_mm256_insertf128_pd(_mm256_castpd128_pd256(lo),(hi),1))
+
+template<> struct ei_packet_traits<float>  : ei_default_packet_traits
+{
+  typedef Packet8f type;
+  enum {
+    Vectorizable = 1,
+    AlignedOnScalar = 1,
+    size=8,
+
+    HasDiv    = 1,
+    HasSin  = EIGEN_FAST_MATH,
+    HasCos  = EIGEN_FAST_MATH,
+    HasLog  = 1,
+    HasExp  = 1,
+    HasSqrt = 1
+  };
+};
+template<> struct ei_packet_traits<double> : ei_default_packet_traits
+{
+  typedef Packet4d type;
+  enum {
+    Vectorizable = 1,
+    AlignedOnScalar = 1,
+    size=4,
+
+    HasDiv    = 1,
+    HasSqrt   = 1
+  };
+};
+
+template<> struct ei_unpacket_traits<Packet8f> { typedef float  type; enum {size=8}; };
+template<> struct ei_unpacket_traits<Packet4d> { typedef double type; enum {size=4}; };
+
+template<> EIGEN_STRONG_INLINE Packet8f ei_pset1<Packet8f>(const float&  from) { return _mm256_set1_ps(from); }
+template<> EIGEN_STRONG_INLINE Packet4d ei_pset1<Packet4d>(const double& from) { return _mm256_set1_pd(from); }
+
+template<> EIGEN_STRONG_INLINE Packet8f ei_plset<float>(const float& a) { return _mm256_add_ps(ei_pset1<Packet8f>(a), _mm256_set_ps(7,6,5,4,3,2,1,0)); }
+template<> EIGEN_STRONG_INLINE Packet4d ei_plset<double>(const double& a) { return _mm256_add_pd(ei_pset1<Packet4d>(a), _mm256_set_pd(3,2,1,0)); }
+
+template<> EIGEN_STRONG_INLINE Packet8f ei_padd<Packet8f>(const Packet8f& a, const Packet8f& b) { return _mm256_add_ps(a,b); }
+template<> EIGEN_STRONG_INLINE Packet4d ei_padd<Packet4d>(const Packet4d& a, const Packet4d& b) { return _mm256_add_pd(a,b); }
+
+template<> EIGEN_STRONG_INLINE Packet8f ei_psub<Packet8f>(const Packet8f& a, const Packet8f& b) { return _mm256_sub_ps(a,b); }
+template<> EIGEN_STRONG_INLINE Packet4d ei_psub<Packet4d>(const Packet4d& a, const Packet4d& b) { return _mm256_sub_pd(a,b); }
+
+template<> EIGEN_STRONG_INLINE Packet8f ei_pnegate(const Packet8f& a)
+{
+  return _mm256_xor_ps(a,_mm256_set1_ps(-0.0f));
+}
+template<> EIGEN_STRONG_INLINE Packet4d ei_pnegate(const Packet4d& a)
+{
+  return _mm256_xor_pd(a,_mm256_set1_pd(-0.0));
+}
+
+template<> EIGEN_STRONG_INLINE Packet8f ei_pconj(const Packet8f& a) { return a; }
+template<> EIGEN_STRONG_INLINE Packet4d ei_pconj(const Packet4d& a) { return a; }
+
+template<> EIGEN_STRONG_INLINE Packet8f ei_pmul<Packet8f>(const Packet8f& a, const Packet8f& b) { return _mm256_mul_ps(a,b); }
+template<> EIGEN_STRONG_INLINE Packet4d ei_pmul<Packet4d>(const Packet4d& a, const Packet4d& b) { return _mm256_mul_pd(a,b); }
+
+template<> EIGEN_STRONG_INLINE Packet8f ei_pdiv<Packet8f>(const Packet8f& a, const Packet8f& b) { return _mm256_div_ps(a,b); }
+template<> EIGEN_STRONG_INLINE Packet4d ei_pdiv<Packet4d>(const Packet4d& a, const Packet4d& b) { return _mm256_div_pd(a,b); }
+
+#ifdef EIGEN_VECTORIZE_FMA
+template<> EIGEN_STRONG_INLINE Packet8f ei_pmadd(const Packet8f& a, const Packet8f& b, const Packet8f& c) { return _mm256_fmadd_ps(a,b,c); }
+template<> EIGEN_STRONG_INLINE Packet4d ei_pmadd(const Packet4d& a, const Packet4d& b, const Packet4d& c) { return _mm256_fmadd_pd(a,b,c); }
+#endif
+
+template<> EIGEN_STRONG_INLINE Packet8f ei_pmin<Packet8f>(const Packet8f& a, const Packet8f& b) { return _mm256_min_ps(a,b); }
+template<> EIGEN_STRONG_INLINE Packet4d ei_pmin<Packet4d>(const Packet4d& a, const Packet4d& b) { return _mm256_min_pd(a,b); }
+
+template<> EIGEN_STRONG_INLINE Packet8f ei_pmax<Packet8f>(const Packet8f& a, const Packet8f& b) { return _mm256_max_ps(a,b); }
+template<> EIGEN_STRONG_INLINE Packet4d ei_pmax<Packet4d>(const Packet4d& a, const Packet4d& b) { return _mm256_max_pd(a,b); }
+
+template<> EIGEN_STRONG_INLINE Packet8f ei_pand<Packet8f>(const Packet8f& a, const Packet8f& b) { return _mm256_and_ps(a,b); }
+template<> EIGEN_STRONG_INLINE Packet4d ei_pand<Packet4d>(const Packet4d& a, const Packet4d& b) { return _mm256_and_pd(a,b); }
+
+template<> EIGEN_STRONG_INLINE Packet8f ei_por<Packet8f>(const Packet8f& a, const Packet8f& b) { return _mm256_or_ps(a,b); }
+template<> EIGEN_STRONG_INLINE Packet4d ei_por<Packet4d>(const Packet4d& a, const Packet4d& b) { return _mm256_or_pd(a,b); }
+
+template<> EIGEN_STRONG_INLINE Packet8f ei_pxor<Packet8f>(const Packet8f& a, const Packet8f& b) { return _mm256_xor_ps(a,b); }
+template<> EIGEN_STRONG_INLINE Packet4d ei_pxor<Packet4d>(const Packet4d& a, const Packet4d& b) { return _mm256_xor_pd(a,b); }
+
+template<> EIGEN_STRONG_INLINE Packet8f ei_pandnot<Packet8f>(const Packet8f& a, const Packet8f& b) { return _mm256_andnot_ps(a,b); }
+template<> EIGEN_STRONG_INLINE Packet4d ei_pandnot<Packet4d>(const Packet4d& a, const Packet4d& b) { return _mm256_andnot_pd(a,b); }
+
+// see the note at the top of this file about alignment
+template<> EIGEN_STRONG_INLINE Packet8f ei_pload<Packet8f>(const float*   from) { EIGEN_DEBUG_ALIGNED_LOAD return _mm256_loadu_ps(from); }
+template<> EIGEN_STRONG_INLINE Packet4d ei_pload<Packet4d>(const double*  from) { EIGEN_DEBUG_ALIGNED_LOAD return _mm256_loadu_pd(from); }
+
+template<> EIGEN_STRONG_INLINE Packet8f ei_ploadu<Packet8f>(const float*  from) { EIGEN_DEBUG_UNALIGNED_LOAD return _mm256_loadu_ps(from); }
+template<> EIGEN_STRONG_INLINE Packet4d ei_ploadu<Packet4d>(const double* from) { EIGEN_DEBUG_UNALIGNED_LOAD return _mm256_loadu_pd(from); }
+
+template<> EIGEN_STRONG_INLINE Packet8f ei_ploaddup<Packet8f>(const float*   from)
+{
+  Packet4f tmp = _mm_loadu_ps(from);
+  return ei_vec8f_combine(_mm_unpacklo_ps(tmp,tmp), _mm_unpackhi_ps(tmp,tmp));
+}
+template<> EIGEN_STRONG_INLINE Packet4d ei_ploaddup<Packet4d>(const double*  from)
+{
+  return ei_vec4d_combine(ei_pset1<Packet2d>(from[0]), ei_pset1<Packet2d>(from[1]));
+}
+
+template<> struct ei_pgather_impl<Packet8f>
+{
+  template<typename Index> static EIGEN_STRONG_INLINE Packet8f run(const float* from, const Index* indices)
+  {
+    return _mm256_setr_ps(from[indices[0]], from[indices[1]], from[indices[2]], from[indices[3]],
+                          from[indices[4]], from[indices[5]], from[indices[6]], from[indices[7]]);
+  }
+};
+template<> struct ei_pgather_impl<Packet4d>
+{
+  template<typename Index> static EIGEN_STRONG_INLINE Packet4d run(const double* from, const Index* indices)
+  { return _mm256_setr_pd(from[indices[0]], from[indices[1]], from[indices[2]], from[indices[3]]); }
+};
+
+template<> EIGEN_STRONG_INLINE void ei_pstore<float>(float*   to, const Packet8f& from) { EIGEN_DEBUG_ALIGNED_STORE _mm256_storeu_ps(to, from); }
+template<> EIGEN_STRONG_INLINE void ei_pstore<double>(double* to, const Packet4d& from) { EIGEN_DEBUG_ALIGNED_STORE _mm256_storeu_pd(to, from); }
+
+template<> EIGEN_STRONG_INLINE void ei_pstoreu<float>(float*   to, const Packet8f& from) { EIGEN_DEBUG_UNALIGNED_STORE _mm256_storeu_ps(to, from); }
+template<> EIGEN_STRONG_INLINE void ei_pstoreu<double>(double* to, const Packet4d& from) { EIGEN_DEBUG_UNALIGNED_STORE _mm256_storeu_pd(to, from); }
+
+template<> EIGEN_STRONG_INLINE float  ei_pfirst<Packet8f>(const Packet8f& a) { return _mm_cvtss_f32(ei_vec8f_low(a)); }
+template<> EIGEN_STRONG_INLINE double ei_pfirst<Packet4d>(const Packet4d& a) { return _mm_cvtsd_f64(ei_vec4d_low(a)); }
+
+template<> EIGEN_STRONG_INLINE Packet8f ei_preverse(const Packet8f& a)
+{
+  Packet8f tmp = _mm256_shuffle_ps(a,a,0x1B);
+  return _mm256_permute2f128_ps(tmp,tmp,0x1);
+}
+template<> EIGEN_STRONG_INLINE Packet4d ei_preverse(const Packet4d& a)
+{
+  Packet4d tmp = _mm256_shuffle_pd(a,a,0x5);
+  return _mm256_permute2f128_pd(tmp,tmp,0x1);
+}
+
+template<> EIGEN_STRONG_INLINE Packet8f ei_pabs(const Packet8f& a)
+{
+  return _mm256_andnot_ps(_mm256_set1_ps(-0.0f),a);
+}
+template<> EIGEN_STRONG_INLINE Packet4d ei_pabs(const Packet4d& a)
+{
+  return _mm256_andnot_pd(_mm256_set1_pd(-0.0),a);
+}
+
+template<> EIGEN_STRONG_INLINE Packet8f ei_preduxp<Packet8f>(const Packet8f* vecs)
+{
+  // after the two hadd passes, each 128 bits lane holds partial sums of 4 of the input packets
+  Packet8f sum0 = _mm256_hadd_ps(_mm256_hadd_ps(vecs[0],vecs[1]), _mm256_hadd_ps(vecs[2],vecs[3]));
+  Packet8f sum1 = _mm256_hadd_ps(_mm256_hadd_ps(vecs[4],vecs[5]), _mm256_hadd_ps(vecs[6],vecs[7]));
+  return _mm256_add_ps(_mm256_permute2f128_ps(sum0,sum1,0x21), _mm256_blend_ps(sum0,sum1,0xF0));
+}
+template<> EIGEN_STRONG_INLINE Packet4d ei_preduxp<Packet4d>(const Packet4d* vecs)
+{
+  Packet4d sum0 = _mm256_hadd_pd(vecs[0],vecs[1]);
+  Packet4d sum1 = _mm256_hadd_pd(vecs[2],vecs[3]);
+  return _mm256_add_pd(_mm256_permute2f128_pd(sum0,sum1,0x21), _mm256_blend_pd(sum0,sum1,0xC));
+}
+
+// The other reductions first fold the two halves of the packet and then rely on the SSE versions
+
+template<> EIGEN_STRONG_INLINE float ei_predux<Packet8f>(const Packet8f& a)
+{
+  return ei_predux(_mm_add_ps(ei_vec8f_low(a),ei_vec8f_high(a)));
+}
+template<> EIGEN_STRONG_INLINE double ei_predux<Packet4d>(const Packet4d& a)
+{
+  return ei_predux(_mm_add_pd(ei_vec4d_low(a),ei_vec4d_high(a)));
+}
+
+template<> EIGEN_STRONG_INLINE float ei_predux_mul<Packet8f>(const Packet8f& a)
+{
+  return ei_predux_mul(_mm_mul_ps(ei_vec8f_low(a),ei_vec8f_high(a)));
+}
+template<> EIGEN_STRONG_INLINE double ei_predux_mul<Packet4d>(const Packet4d& a)
+{
+  return ei_predux_mul(_mm_mul_pd(ei_vec4d_low(a),ei_vec4d_high(a)));
+}
+
+template<> EIGEN_STRONG_INLINE float ei_predux_min<Packet8f>(const Packet8f& a)
+{
+  return ei_predux_min(_mm_min_ps(ei_vec8f_low(a),ei_vec8f_high(a)));
+}
+template<> EIGEN_STRONG_INLINE double ei_predux_min<Packet4d>(const Packet4d& a)
+{
+  return ei_predux_min(_mm_min_pd(ei_vec4d_low(a),ei_vec4d_high(a)));
+}
+
+template<> EIGEN_STRONG_INLINE float ei_predux_max<Packet8f>(const Packet8f& a)
+{
+  return ei_predux_max(_mm_max_ps(ei_vec8f_low(a),ei_vec8f_high(a)));
+}
+template<> EIGEN_STRONG_INLINE double ei_predux_max<Packet4d>(const Packet4d& a)
+{
+  return ei_predux_max(_mm_max_pd(ei_vec4d_low(a),ei_vec4d_high(a)));
+}
+
+template<int Offset>
+struct ei_palign_impl<Offset,Packet8f>
+{
+  EIGEN_STRONG_INLINE static void run(Packet8f& first, const Packet8f& second)
+  {
+    if (Offset==0)
+      return;
+    // (high half of first, low half of second)
+    Packet8f mid = _mm256_permute2f128_ps(first,second,0x21);
+    if (Offset==4)
+    {
+      first = mid;
+      return;
+    }
+    #ifdef EIGEN_VECTORIZE_AVX2
+    // _mm256_alignr_epi8 shifts each 128 bits lane independently
+    if (Offset<4)
+      first = _mm256_castsi256_ps(_mm256_alignr_epi8(_mm256_castps_si256(mid), _mm256_castps_si256(first), (Offset&3)*4));
+    else
+      first = _mm256_castsi256_ps(_mm256_alignr_epi8(_mm256_castps_si256(second), _mm256_castps_si256(mid), (Offset&3)*4));
+    #else
+    Packet4f lo, hi;
+    if (Offset<4)
+    {
+      lo = ei_vec8f_low(first);
+      hi = ei_vec8f_low(mid);
+      ei_palign<Offset&3>(lo, hi);
+      ei_palign<Offset&3>(hi, ei_vec8f_high(mid));
+    }
+    else
+    {
+      lo = ei_vec8f_low(mid);
+      hi = ei_vec8f_high(mid);
+      ei_palign<Offset&3>(lo, hi);
+      ei_palign<Offset&3>(hi, ei_vec8f_high(second));
+    }
+    first = ei_vec8f_combine(lo,hi);
+    #endif
+  }
+};
+
+template<int Offset>
+struct ei_palign_impl<Offset,Packet4d>
+{
+  EIGEN_STRONG_INLINE static void run(Packet4d& first, const Packet4d& second)
+  {
+    if (Offset==1)
+      first = _mm256_shuffle_pd(first, _mm256_permute2f128_pd(first,second,0x21), 0x5);
+    else if (Offset==2)
+      first = _mm256_permute2f128_pd(first,second,0x21);
+    else if (Offset==3)
+      first = _mm256_shuffle_pd(_mm256_permute2f128_pd(first,second,0x21), second, 0x5);
+  }
+};
+
+#endif // EIGEN_PACKET_MATH_AVX_H
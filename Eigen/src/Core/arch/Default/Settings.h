@@ -62,6 +62,38 @@
 #define EIGEN_TUNE_TRIANGULAR_PANEL_WIDTH 8
 #endif
 
+/** Defines the number of columns of a dense right hand side processed at once by the sparse
+  * matrix products and triangular solvers. The sparse matrix is traversed once per panel of
+  * columns, which are stored by rows such that the updates are vectorized. The default is 8.
+  */
+#ifndef EIGEN_TUNE_SPARSE_PANEL_WIDTH
+#define EIGEN_TUNE_SPARSE_PANEL_WIDTH 8
+#endif
+
+/** Defines the cost, expressed in number of multiply-adds, of dispatching one more thread
+  * to a parallel matrix product. It is used by the cost model selecting the number of threads:
+  * the larger it is, the fewer threads are used for small and medium products.
+  */
+#ifndef EIGEN_TUNE_PARALLEL_THREAD_COST
+#define EIGEN_TUNE_PARALLEL_THREAD_COST 20000
+#endif
+
+/** Defines the minimal number of coefficients of a dynamic-size coefficient-wise assignment,
+  * reduction or min/max visit to be evaluated by chunks, possibly in parallel. This only applies
+  * when EIGEN_PARALLELIZE_COEFFWISE is defined. The default is 65536.
+  */
+#ifndef EIGEN_TUNE_PARALLEL_COEFFWISE_THRESHOLD
+#define EIGEN_TUNE_PARALLEL_COEFFWISE_THRESHOLD 65536
+#endif
+
+/** Defines the number of coefficients of the chunks a large coefficient-wise evaluation is split into.
+  * The chunks only depend on the size of the expression, such that the result of a reduction does
+  * not depend on the number of threads. It must be a multiple of the packet sizes, which is checked at
+  * compile time. The default is 16384.
+  */
+#ifndef EIGEN_TUNE_PARALLEL_COEFFWISE_CHUNK
+#define EIGEN_TUNE_PARALLEL_COEFFWISE_CHUNK 16384
+#endif
 
 /** Defines the default number of registers available for that architecture.
   * Currently it must be 8 or 16. Other values will fail.
@@ -33,6 +33,7 @@ struct Packet2cf
   __m128  v;
 };
 
+#ifndef EIGEN_VECTORIZE_AVX
 template<> struct ei_packet_traits<std::complex<float> >  : ei_default_packet_traits
 {
   typedef Packet2cf type;
@@ -53,6 +54,7 @@ template<> struct ei_packet_traits<std::complex<float> >  : ei_default_packet_tr
     HasSetLinear = 0
   };
 };
+#endif
 
 template<> struct ei_unpacket_traits<Packet2cf> { typedef std::complex<float> type; enum {size=2}; };
 
@@ -238,6 +240,7 @@ struct Packet1cd
   __m128d  v;
 };
 
+#ifndef EIGEN_VECTORIZE_AVX
 template<> struct ei_packet_traits<std::complex<double> >  : ei_default_packet_traits
 {
   typedef Packet1cd type;
@@ -258,6 +261,7 @@ template<> struct ei_packet_traits<std::complex<double> >  : ei_default_packet_t
     HasSetLinear = 0
   };
 };
+#endif
 
 template<> struct ei_unpacket_traits<Packet1cd> { typedef std::complex<double> type; enum {size=1}; };
 
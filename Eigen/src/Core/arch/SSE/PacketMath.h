@@ -66,6 +66,9 @@ template<> struct ei_is_arithmetic<__m128d> { enum { ret = true }; };
   const Packet4i ei_p4i_##NAME = ei_pset1<Packet4i>(X)
 
 
+// when AVX is enabled, float and double are vectorized with the 256 bits packets of arch/AVX,
+// while the 128 bits ones are still used as building blocks
+#ifndef EIGEN_VECTORIZE_AVX
 template<> struct ei_packet_traits<float>  : ei_default_packet_traits
 {
   typedef Packet4f type;
@@ -93,6 +96,7 @@ template<> struct ei_packet_traits<double> : ei_default_packet_traits
     HasDiv    = 1
   };
 };
+#endif
 template<> struct ei_packet_traits<int>    : ei_default_packet_traits
 {
   typedef Packet4i type;
@@ -126,8 +130,10 @@ template<> EIGEN_STRONG_INLINE Packet2d ei_pset1<Packet2d>(const double& from) {
 #endif
 template<> EIGEN_STRONG_INLINE Packet4i ei_pset1<Packet4i>(const int&    from) { return _mm_set1_epi32(from); }
 
+#ifndef EIGEN_VECTORIZE_AVX
 template<> EIGEN_STRONG_INLINE Packet4f ei_plset<float>(const float& a) { return _mm_add_ps(ei_pset1<Packet4f>(a), _mm_set_ps(3,2,1,0)); }
 template<> EIGEN_STRONG_INLINE Packet2d ei_plset<double>(const double& a) { return _mm_add_pd(ei_pset1<Packet2d>(a),_mm_set_pd(1,0)); }
+#endif
 template<> EIGEN_STRONG_INLINE Packet4i ei_plset<int>(const int& a) { return _mm_add_epi32(ei_pset1<Packet4i>(a),_mm_set_epi32(3,2,1,0)); }
 
 template<> EIGEN_STRONG_INLINE Packet4f ei_padd<Packet4f>(const Packet4f& a, const Packet4f& b) { return _mm_add_ps(a,b); }
@@ -269,6 +275,22 @@ template<> EIGEN_STRONG_INLINE Packet4i ei_ploaddup<Packet4i>(const int*     fro
   return ei_vec4i_swizzle1(tmp, 0, 0, 1, 1);
 }
 
+template<> struct ei_pgather_impl<Packet4f>
+{
+  template<typename Index> static EIGEN_STRONG_INLINE Packet4f run(const float* from, const Index* indices)
+  { return _mm_setr_ps(from[indices[0]], from[indices[1]], from[indices[2]], from[indices[3]]); }
+};
+template<> struct ei_pgather_impl<Packet2d>
+{
+  template<typename Index> static EIGEN_STRONG_INLINE Packet2d run(const double* from, const Index* indices)
+  { return _mm_setr_pd(from[indices[0]], from[indices[1]]); }
+};
+template<> struct ei_pgather_impl<Packet4i>
+{
+  template<typename Index> static EIGEN_STRONG_INLINE Packet4i run(const int* from, const Index* indices)
+  { return _mm_setr_epi32(from[indices[0]], from[indices[1]], from[indices[2]], from[indices[3]]); }
+};
+
 template<> EIGEN_STRONG_INLINE void ei_pstore<float>(float*   to, const Packet4f& from) { EIGEN_DEBUG_ALIGNED_STORE _mm_store_ps(to, from); }
 template<> EIGEN_STRONG_INLINE void ei_pstore<double>(double* to, const Packet2d& from) { EIGEN_DEBUG_ALIGNED_STORE _mm_store_pd(to, from); }
 template<> EIGEN_STRONG_INLINE void ei_pstore<int>(int*       to, const Packet4i& from) { EIGEN_DEBUG_ALIGNED_STORE _mm_store_si128(reinterpret_cast<Packet4i*>(to), from); }
@@ -0,0 +1,330 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Copyright (C) 2010 Gael Guennebaud <gael.guennebaud@inria.fr>
+//
+// Eigen is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// Alternatively, you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation; either version 2 of
+// the License, or (at your option) any later version.
+//
+// Eigen is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License or the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License and a copy of the GNU General Public License along with
+// Eigen. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef EIGEN_DISPATCHED_KERNELS_H
+#define EIGEN_DISPATCHED_KERNELS_H
+
+/* This file implements both sides of the runtime dispatch described in util/RuntimeDispatch.h:
+ *  - with EIGEN_DISPATCH_TARGET, the kernels of the current target and their registration,
+ *  - with EIGEN_RUNTIME_DISPATCH, the selection of the targets and the lookup of the kernels.
+ */
+
+/** \internal Signatures of the dispatched kernels: they only involve builtin types since
+  * Eigen's own types are distinct in each target. */
+template<typename Scalar, typename Index> struct ei_dispatched_kernel_types
+{
+  typedef void (*Gemm)(Index rows, Index cols, Index depth,
+                       const Scalar* lhs, Index lhsStride, const Scalar* rhs, Index rhsStride,
+                       Scalar* res, Index resStride, Scalar alpha,
+                       Index kc, Index mc, Index nc, Scalar* blockA, Scalar* blockB,
+                       void* info, Index tid, Index threads);
+  typedef void (*Gemv)(Index rows, Index cols, const Scalar* lhs, Index lhsStride,
+                       const Scalar* rhs, Index rhsIncr, Scalar* res, Index resIncr, Scalar alpha);
+  typedef void (*Trsm)(Index size, Index otherSize, const Scalar* tri, Index triStride,
+                       Scalar* other, Index otherStride);
+};
+
+template<int LhsStorageOrder, bool ConjugateLhs, int RhsStorageOrder, bool ConjugateRhs>
+struct ei_gemm_dispatch_variant
+{
+  enum { ret = int(LhsStorageOrder==RowMajor) | (int(ConjugateLhs)<<1)
+             | (int(RhsStorageOrder==RowMajor)<<2) | (int(ConjugateRhs)<<3) };
+};
+
+template<int StorageOrder, bool ConjugateLhs, bool ConjugateRhs>
+struct ei_gemv_dispatch_variant
+{
+  enum { ret = int(StorageOrder==RowMajor) | (int(ConjugateLhs)<<1) | (int(ConjugateRhs)<<2) };
+};
+
+template<int Side, int Mode, bool Conjugate, int TriStorageOrder>
+struct ei_trsm_dispatch_variant
+{
+  enum { ret = int(Side==OnTheRight) | (int(Conjugate)<<1) | (int(TriStorageOrder==RowMajor)<<2) | (Mode<<3) };
+};
+
+#ifdef EIGEN_DISPATCH_TARGET
+
+/***************************************************************************
+* Kernels of the current dispatch target
+***************************************************************************/
+
+/** \internal Level 3 blocking using the block sizes and the buffers of the caller.
+  * The workspace is always allocated here since its size depends on the packet size. */
+template<typename Scalar>
+class ei_external_level3_blocking : public ei_level3_blocking<Scalar,Scalar>
+{
+  public:
+    ei_external_level3_blocking(DenseIndex kc, DenseIndex mc, DenseIndex nc, Scalar* blockA, Scalar* blockB)
+    {
+      this->m_kc = kc;
+      this->m_mc = mc;
+      this->m_nc = nc;
+      this->m_blockA = blockA;
+      this->m_blockB = blockB;
+    }
+};
+
+template<typename Scalar, int Variant>
+struct ei_dispatched_gemm
+{
+  enum {
+    LhsStorageOrder = (Variant&1) ? RowMajor : ColMajor,
+    ConjugateLhs    = (Variant>>1)&1,
+    RhsStorageOrder = (Variant&4) ? RowMajor : ColMajor,
+    ConjugateRhs    = (Variant>>3)&1,
+    Enabled = NumTraits<Scalar>::IsComplex || !(ConjugateLhs || ConjugateRhs),
+    Id = DispatchedGemm,
+    Slot = ei_gemm_dispatch_variant<LhsStorageOrder,ConjugateLhs,RhsStorageOrder,ConjugateRhs>::ret
+  };
+  typedef typename ei_dispatched_kernel_types<Scalar,DenseIndex>::Gemm FuncPtr;
+
+  static void run(DenseIndex rows, DenseIndex cols, DenseIndex depth,
+                  const Scalar* lhs, DenseIndex lhsStride, const Scalar* rhs, DenseIndex rhsStride,
+                  Scalar* res, DenseIndex resStride, Scalar alpha,
+                  DenseIndex kc, DenseIndex mc, DenseIndex nc, Scalar* blockA, Scalar* blockB,
+                  void* info, DenseIndex tid, DenseIndex threads)
+  {
+    ei_external_level3_blocking<Scalar> blocking(kc, mc, nc, blockA, blockB);
+    ei_general_matrix_matrix_product<DenseIndex,Scalar,LhsStorageOrder,ConjugateLhs,Scalar,RhsStorageOrder,ConjugateRhs,ColMajor>
+      ::run(rows, cols, depth, lhs, lhsStride, rhs, rhsStride, res, resStride, alpha, blocking,
+            static_cast<GemmParallelInfo<DenseIndex>*>(info), tid, threads);
+  }
+};
+
+template<typename Scalar, int Variant>
+struct ei_dispatched_gemv
+{
+  enum {
+    StorageOrder = (Variant&1) ? RowMajor : ColMajor,
+    ConjugateLhs = (Variant>>1)&1,
+    ConjugateRhs = (Variant>>2)&1,
+    Enabled = NumTraits<Scalar>::IsComplex || !(ConjugateLhs || ConjugateRhs),
+    Id = DispatchedGemv,
+    Slot = ei_gemv_dispatch_variant<StorageOrder,ConjugateLhs,ConjugateRhs>::ret
+  };
+  typedef typename ei_dispatched_kernel_types<Scalar,DenseIndex>::Gemv FuncPtr;
+
+  static void run(DenseIndex rows, DenseIndex cols, const Scalar* lhs, DenseIndex lhsStride,
+                  const Scalar* rhs, DenseIndex rhsIncr, Scalar* res, DenseIndex resIncr, Scalar alpha)
+  {
+    ei_general_matrix_vector_product<DenseIndex,Scalar,StorageOrder,ConjugateLhs,Scalar,ConjugateRhs>
+      ::run(rows, cols, lhs, lhsStride, rhs, rhsIncr, res, resIncr, alpha);
+  }
+};
+
+template<typename Scalar, int Variant>
+struct ei_dispatched_trsm
+{
+  enum {
+    Side = (Variant&1) ? OnTheRight : OnTheLeft,
+    Conjugate = (Variant>>1)&1,
+    TriStorageOrder = (Variant&4) ? RowMajor : ColMajor,
+    Mode = Variant>>3,
+    Enabled = (Mode==Lower || Mode==Upper || Mode==UnitLower || Mode==UnitUpper)
+           && (NumTraits<Scalar>::IsComplex || !Conjugate),
+    Id = DispatchedTrsm,
+    Slot = ei_trsm_dispatch_variant<Side,Mode,Conjugate,TriStorageOrder>::ret
+  };
+  typedef typename ei_dispatched_kernel_types<Scalar,DenseIndex>::Trsm FuncPtr;
+
+  static void run(DenseIndex size, DenseIndex otherSize, const Scalar* tri, DenseIndex triStride,
+                  Scalar* other, DenseIndex otherStride)
+  {
+    ei_triangular_solve_matrix<Scalar,DenseIndex,Side,Mode,Conjugate,TriStorageOrder,ColMajor>
+      ::run(size, otherSize, tri, triStride, other, otherStride);
+  }
+};
+
+template<typename Kernel, bool Enabled = Kernel::Enabled>
+struct ei_register_dispatched_kernel
+{
+  static void run()
+  {
+    ei_dispatch_slot<typename Kernel::FuncPtr, Kernel::Id, Kernel::Slot>::func = &Kernel::run;
+  }
+};
+
+template<typename Kernel>
+struct ei_register_dispatched_kernel<Kernel,false>
+{
+  static void run() {}
+};
+
+/** \internal Registers the variants 0 to \a Variant of the kernel \a Kernel */
+template<template<typename,int> class Kernel, typename Scalar, int Variant>
+struct ei_register_dispatched_variants
+{
+  static void run()
+  {
+    ei_register_dispatched_variants<Kernel,Scalar,Variant-1>::run();
+    ei_register_dispatched_kernel<Kernel<Scalar,Variant> >::run();
+  }
+};
+
+template<template<typename,int> class Kernel, typename Scalar>
+struct ei_register_dispatched_variants<Kernel,Scalar,-1>
+{
+  static void run() {}
+};
+
+template<typename Scalar> void ei_register_dispatched_kernels()
+{
+  ei_register_dispatched_variants<ei_dispatched_gemm,Scalar,15>::run();
+  ei_register_dispatched_variants<ei_dispatched_gemv,Scalar,7>::run();
+  ei_register_dispatched_variants<ei_dispatched_trsm,Scalar,(UnitUpper<<3)|7>::run();
+}
+
+inline void ei_register_dispatched_kernels()
+{
+  ei_register_dispatched_kernels<float>();
+  ei_register_dispatched_kernels<double>();
+  ei_register_dispatched_kernels<std::complex<float> >();
+  ei_register_dispatched_kernels<std::complex<double> >();
+}
+
+#endif // EIGEN_DISPATCH_TARGET
+
+#ifdef EIGEN_RUNTIME_DISPATCH
+
+/***************************************************************************
+* Selection of the kernels at runtime
+***************************************************************************/
+
+/** \internal Registers the kernels of the linked targets supported by the current machine,
+  * from the lowest to the highest one, so that the latter wins. */
+inline bool ei_select_dispatch_targets()
+{
+  const int sets = ei_instructionSets();
+  #define EIGEN_SELECT_DISPATCH_TARGET(TARGET) \
+    if((sets & ei_dispatch_instruction_sets_##TARGET) == ei_dispatch_instruction_sets_##TARGET) \
+      ei_register_dispatched_kernels_##TARGET();
+  #ifdef EIGEN_DISPATCH_SSE4_2
+  EIGEN_SELECT_DISPATCH_TARGET(sse4_2)
+  #endif
+  #ifdef EIGEN_DISPATCH_AVX
+  EIGEN_SELECT_DISPATCH_TARGET(avx)
+  #endif
+  #ifdef EIGEN_DISPATCH_AVX2
+  EIGEN_SELECT_DISPATCH_TARGET(avx2)
+  #endif
+  #undef EIGEN_SELECT_DISPATCH_TARGET
+  EIGEN_UNUSED_VARIABLE(sets);
+  return true;
+}
+
+/** \internal \returns the selected implementation of a kernel, or a null pointer if the
+  * baseline one has to be used */
+template<typename FuncPtr, int Kernel, int Variant>
+inline FuncPtr ei_dispatched_kernel()
+{
+  static const bool initialized = ei_select_dispatch_targets();
+  EIGEN_UNUSED_VARIABLE(initialized);
+  return ei_dispatch_slot<FuncPtr,Kernel,Variant>::func;
+}
+
+// By default nothing is dispatched: only the kernels with the same scalar type on both sides
+// and the default index type have dispatched versions.
+template<typename Index, typename LhsScalar, int LhsStorageOrder, bool ConjugateLhs,
+         typename RhsScalar, int RhsStorageOrder, bool ConjugateRhs>
+struct ei_dispatch_gemm
+{
+  template<typename ResScalar, typename Blocking, typename Info>
+  static bool run(Index, Index, Index, const LhsScalar*, Index, const RhsScalar*, Index,
+                  ResScalar*, Index, ResScalar, Blocking&, Info*, Index, Index)
+  { return false; }
+};
+
+template<typename Scalar, int LhsStorageOrder, bool ConjugateLhs, int RhsStorageOrder, bool ConjugateRhs>
+struct ei_dispatch_gemm<DenseIndex,Scalar,LhsStorageOrder,ConjugateLhs,Scalar,RhsStorageOrder,ConjugateRhs>
+{
+  typedef typename ei_dispatched_kernel_types<Scalar,DenseIndex>::Gemm FuncPtr;
+
+  static bool run(DenseIndex rows, DenseIndex cols, DenseIndex depth,
+                  const Scalar* lhs, DenseIndex lhsStride, const Scalar* rhs, DenseIndex rhsStride,
+                  Scalar* res, DenseIndex resStride, Scalar alpha,
+                  ei_level3_blocking<Scalar,Scalar>& blocking, GemmParallelInfo<DenseIndex>* info,
+                  DenseIndex tid, DenseIndex threads)
+  {
+    FuncPtr func = ei_dispatched_kernel<FuncPtr,DispatchedGemm,
+                     ei_gemm_dispatch_variant<LhsStorageOrder,ConjugateLhs,RhsStorageOrder,ConjugateRhs>::ret>();
+    if(func==0)
+      return false;
+    func(rows, cols, depth, lhs, lhsStride, rhs, rhsStride, res, resStride, alpha,
+         blocking.kc(), blocking.mc(), blocking.nc(), blocking.blockA(), blocking.blockB(), info, tid, threads);
+    return true;
+  }
+};
+
+template<typename Index, typename LhsScalar, int StorageOrder, bool ConjugateLhs, typename RhsScalar, bool ConjugateRhs>
+struct ei_dispatch_gemv
+{
+  template<typename ResScalar, typename AlphaScalar>
+  static bool run(Index, Index, const LhsScalar*, Index, const RhsScalar*, Index, ResScalar*, Index, AlphaScalar)
+  { return false; }
+};
+
+template<typename Scalar, int StorageOrder, bool ConjugateLhs, bool ConjugateRhs>
+struct ei_dispatch_gemv<DenseIndex,Scalar,StorageOrder,ConjugateLhs,Scalar,ConjugateRhs>
+{
+  typedef typename ei_dispatched_kernel_types<Scalar,DenseIndex>::Gemv FuncPtr;
+
+  static bool run(DenseIndex rows, DenseIndex cols, const Scalar* lhs, DenseIndex lhsStride,
+                  const Scalar* rhs, DenseIndex rhsIncr, Scalar* res, DenseIndex resIncr, Scalar alpha)
+  {
+    FuncPtr func = ei_dispatched_kernel<FuncPtr,DispatchedGemv,
+                     ei_gemv_dispatch_variant<StorageOrder,ConjugateLhs,ConjugateRhs>::ret>();
+    if(func==0)
+      return false;
+    func(rows, cols, lhs, lhsStride, rhs, rhsIncr, res, resIncr, alpha);
+    return true;
+  }
+};
+
+template<typename Scalar, typename Index, int Side, int Mode, bool Conjugate, int TriStorageOrder>
+struct ei_dispatch_trsm
+{
+  static bool run(Index, Index, const Scalar*, Index, Scalar*, Index) { return false; }
+};
+
+template<typename Scalar, int Side, int Mode, bool Conjugate, int TriStorageOrder>
+struct ei_dispatch_trsm<Scalar,DenseIndex,Side,Mode,Conjugate,TriStorageOrder>
+{
+  typedef typename ei_dispatched_kernel_types<Scalar,DenseIndex>::Trsm FuncPtr;
+
+  static bool run(DenseIndex size, DenseIndex otherSize, const Scalar* tri, DenseIndex triStride,
+                  Scalar* other, DenseIndex otherStride)
+  {
+    FuncPtr func = ei_dispatched_kernel<FuncPtr,DispatchedTrsm,
+                     ei_trsm_dispatch_variant<Side,Mode,Conjugate,TriStorageOrder>::ret>();
+    if(func==0)
+      return false;
+    func(size, otherSize, tri, triStride, other, otherStride);
+    return true;
+  }
+};
+
+#endif // EIGEN_RUNTIME_DISPATCH
+
+#endif // EIGEN_DISPATCHED_KERNELS_H
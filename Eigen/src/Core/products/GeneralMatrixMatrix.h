@@ -42,14 +42,14 @@ struct ei_general_matrix_matrix_product<Index,LhsScalar,LhsStorageOrder,Conjugat
     ResScalar* res, Index resStride,
     ResScalar alpha,
     ei_level3_blocking<RhsScalar,LhsScalar>& blocking,
-    GemmParallelInfo<Index>* info = 0)
+    GemmParallelInfo<Index>* info = 0, Index tid = 0, Index threads = 1)
   {
     // transpose the product such that the result is column major
     ei_general_matrix_matrix_product<Index,
       RhsScalar, RhsStorageOrder==RowMajor ? ColMajor : RowMajor, ConjugateRhs,
       LhsScalar, LhsStorageOrder==RowMajor ? ColMajor : RowMajor, ConjugateLhs,
       ColMajor>
-    ::run(cols,rows,depth,rhs,rhsStride,lhs,lhsStride,res,resStride,alpha,blocking,info);
+    ::run(cols,rows,depth,rhs,rhsStride,lhs,lhsStride,res,resStride,alpha,blocking,info,tid,threads);
   }
 };
 
@@ -68,8 +68,14 @@ static void run(Index rows, Index cols, Index depth,
   ResScalar* res, Index resStride,
   ResScalar alpha,
   ei_level3_blocking<LhsScalar,RhsScalar>& blocking,
-  GemmParallelInfo<Index>* info = 0)
+  GemmParallelInfo<Index>* info = 0, Index tid = 0, Index threads = 1)
 {
+  #ifdef EIGEN_RUNTIME_DISPATCH
+  if(ei_dispatch_gemm<Index,LhsScalar,LhsStorageOrder,ConjugateLhs,RhsScalar,RhsStorageOrder,ConjugateRhs>
+      ::run(rows, cols, depth, _lhs, lhsStride, _rhs, rhsStride, res, resStride, alpha, blocking, info, tid, threads))
+    return;
+  #endif
+
   ei_const_blas_data_mapper<LhsScalar, Index, LhsStorageOrder> lhs(_lhs,lhsStride);
   ei_const_blas_data_mapper<RhsScalar, Index, RhsStorageOrder> rhs(_rhs,rhsStride);
 
@@ -83,13 +89,11 @@ static void run(Index rows, Index cols, Index depth,
   ei_gemm_pack_rhs<RhsScalar, Index, Traits::nr, RhsStorageOrder> pack_rhs;
   ei_gebp_kernel<LhsScalar, RhsScalar, Index, Traits::mr, Traits::nr, ConjugateLhs, ConjugateRhs> gebp;
 
-#ifdef EIGEN_HAS_OPENMP
+#ifndef EIGEN_DONT_PARALLELIZE
   if(info)
   {
     // this is the parallel version!
-    Index tid = omp_get_thread_num();
-    Index threads = omp_get_num_threads();
-
+    // It is run concurrently by the threads 0..threads-1, the current one being tid.
     LhsScalar* blockA = ei_aligned_stack_new(LhsScalar, kc*mc);
     std::size_t sizeW = kc*Traits::WorkSpaceFactor;
     RhsScalar* w = ei_aligned_stack_new(RhsScalar, sizeW);
@@ -117,6 +121,7 @@ static void run(Index rows, Index cols, Index depth,
       pack_rhs(blockB+info[tid].rhs_start*kc, &rhs(k,info[tid].rhs_start), rhsStride, actual_kc, info[tid].rhs_length);
 
       // Notify the other threads that the part B'_j is ready to go.
+      ei_memory_barrier();
       info[tid].sync = k;
 
       // Computes C_i += A' * B' per B'_j
@@ -148,17 +153,18 @@ static void run(Index rows, Index cols, Index depth,
       // Release all the sub blocks B'_j of B' for the current thread,
       // i.e., we simply decrement the number of users by 1
       for(Index j=0; j<threads; ++j)
-        #pragma omp atomic
-        --(info[j].users);
+        ei_atomic_decrement(&info[j].users);
     }
 
     ei_aligned_stack_delete(LhsScalar, blockA, kc*mc);
     ei_aligned_stack_delete(RhsScalar, w, sizeW);
   }
   else
-#endif // EIGEN_HAS_OPENMP
+#endif // EIGEN_DONT_PARALLELIZE
   {
     EIGEN_UNUSED_VARIABLE(info);
+    EIGEN_UNUSED_VARIABLE(tid);
+    EIGEN_UNUSED_VARIABLE(threads);
 
     // this is the sequential version!
     std::size_t sizeA = kc*mc;
@@ -229,19 +235,37 @@ struct ei_gemm_functor
     m_blocking.allocateB();
   }
 
-  void operator() (Index row, Index rows, Index col=0, Index cols=-1, GemmParallelInfo<Index>* info=0) const
+  const BlockingType& blocking() const { return m_blocking; }
+
+  void operator() (Index row, Index rows, Index col=0, Index cols=-1, GemmParallelInfo<Index>* info=0,
+                   Index tid=0, Index threads=1) const
   {
     if(cols==-1)
       cols = m_rhs.cols();
 
-    Gemm::run(rows, cols, m_lhs.cols(),
-              /*(const Scalar*)*/&(m_lhs.const_cast_derived().coeffRef(row,0)), m_lhs.outerStride(),
-              /*(const Scalar*)*/&(m_rhs.const_cast_derived().coeffRef(0,col)), m_rhs.outerStride(),
-              (Scalar*)&(m_dest.coeffRef(row,col)), m_dest.outerStride(),
-              m_actualAlpha, m_blocking, info);
+    if(info==0 && threads>1)
+    {
+      // this thread computes its own tile of the result => it cannot share the buffers of m_blocking
+      typename BlockingType::Level3Blocking blocking(m_blocking);
+      blocking.detachBuffers();
+      run(row, rows, col, cols, blocking, info, tid, threads);
+    }
+    else
+      run(row, rows, col, cols, m_blocking, info, tid, threads);
   }
 
   protected:
+    template<typename Blocking>
+    void run(Index row, Index rows, Index col, Index cols, Blocking& blocking, GemmParallelInfo<Index>* info,
+             Index tid, Index threads) const
+    {
+      Gemm::run(rows, cols, m_lhs.cols(),
+                /*(const Scalar*)*/&(m_lhs.const_cast_derived().coeffRef(row,0)), m_lhs.outerStride(),
+                /*(const Scalar*)*/&(m_rhs.const_cast_derived().coeffRef(0,col)), m_rhs.outerStride(),
+                (Scalar*)&(m_dest.coeffRef(row,col)), m_dest.outerStride(),
+                m_actualAlpha, blocking, info, tid, threads);
+    }
+
     const Lhs& m_lhs;
     const Rhs& m_rhs;
     Dest& m_dest;
@@ -269,10 +293,16 @@ class ei_level3_blocking
 
   public:
 
+    typedef ei_level3_blocking<_LhsScalar,_RhsScalar> Level3Blocking;
+
     ei_level3_blocking()
       : m_blockA(0), m_blockB(0), m_blockW(0), m_mc(0), m_nc(0), m_kc(0)
     {}
 
+    /** \internal Forgets about the buffers, without freeing them. This is used on a copy of
+      * the blocking by a thread which needs its own buffers. */
+    inline void detachBuffers() { m_blockA = 0; m_blockB = 0; m_blockW = 0; }
+
     inline DenseIndex mc() const { return m_mc; }
     inline DenseIndex nc() const { return m_nc; }
     inline DenseIndex kc() const { return m_kc; }
@@ -432,7 +462,7 @@ class GeneralProduct<Lhs, Rhs, GemmProduct>
 
       BlockingType blocking(dst.rows(), dst.cols(), lhs.cols());
 
-      ei_parallelize_gemm<(Dest::MaxRowsAtCompileTime>32 || Dest::MaxRowsAtCompileTime==Dynamic)>(GemmFunctor(lhs, rhs, dst, actualAlpha, blocking), this->rows(), this->cols(), Dest::Flags&RowMajorBit);
+      ei_parallelize_gemm<(Dest::MaxRowsAtCompileTime>32 || Dest::MaxRowsAtCompileTime==Dynamic)>(GemmFunctor(lhs, rhs, dst, actualAlpha, blocking), this->rows(), this->cols(), lhs.cols(), Dest::Flags&RowMajorBit);
     }
 };
 
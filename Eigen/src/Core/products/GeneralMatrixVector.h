@@ -64,11 +64,16 @@ EIGEN_DONT_INLINE static void run(
   const LhsScalar* lhs, Index lhsStride,
   const RhsScalar* rhs, Index rhsIncr,
   ResScalar* res, Index
-  #ifdef EIGEN_INTERNAL_DEBUGGING
+  #if defined(EIGEN_INTERNAL_DEBUGGING) || defined(EIGEN_RUNTIME_DISPATCH)
     resIncr
   #endif
   , RhsScalar alpha)
 {
+  #ifdef EIGEN_RUNTIME_DISPATCH
+  if(ei_dispatch_gemv<Index,LhsScalar,ColMajor,ConjugateLhs,RhsScalar,ConjugateRhs>
+      ::run(rows, cols, lhs, lhsStride, rhs, rhsIncr, res, resIncr, alpha))
+    return;
+  #endif
   ei_internal_assert(resIncr==1);
   #ifdef _EIGEN_ACCUMULATE_PACKETS
   #error _EIGEN_ACCUMULATE_PACKETS has already been defined
@@ -322,6 +327,11 @@ EIGEN_DONT_INLINE static void run(
   ResScalar* res, Index resIncr,
   ResScalar alpha)
 {
+  #ifdef EIGEN_RUNTIME_DISPATCH
+  if(ei_dispatch_gemv<Index,LhsScalar,RowMajor,ConjugateLhs,RhsScalar,ConjugateRhs>
+      ::run(rows, cols, lhs, lhsStride, rhs, rhsIncr, res, resIncr, alpha))
+    return;
+  #endif
   EIGEN_UNUSED_VARIABLE(rhsIncr);
   ei_internal_assert(rhsIncr==1);
   #ifdef _EIGEN_ACCUMULATE_PACKETS
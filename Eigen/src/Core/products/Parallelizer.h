@@ -38,13 +38,15 @@ inline void ei_manage_multi_threading(Action action, int* v)
   else if(action==GetAction)
   {
     ei_internal_assert(v!=0);
-    #ifdef EIGEN_HAS_OPENMP
     if(m_maxThreads>0)
       *v = m_maxThreads;
+    else if(threadPool()!=0)
+      *v = threadPool()->threads();
     else
+    #ifdef EIGEN_HAS_OPENMP
       *v = omp_get_max_threads();
     #else
-    *v = 1;
+      *v = 1;
     #endif
   }
   else
@@ -69,6 +71,111 @@ inline void setNbThreads(int v)
   ei_manage_multi_threading(SetAction, &v);
 }
 
+/** \internal \returns the number of threads a parallel kernel called from the current thread may use.
+  *
+  * This is nbThreads(), bounded by the size of the ThreadPool if any. Without thread pool, this is 1
+  * unless OpenMP is enabled and we are not already in a parallel region.
+  */
+inline int ei_parallel_threads()
+{
+#ifdef EIGEN_DONT_PARALLELIZE
+  return 1;
+#else
+  ThreadPool* pool = threadPool();
+  #ifdef EIGEN_HAS_OPENMP
+  if(pool==0 && omp_get_num_threads()>1)
+    return 1;
+  #else
+  if(pool==0)
+    return 1;
+  #endif
+  int threads = nbThreads();
+  if(pool)
+    threads = std::min(threads, pool->threads());
+  return std::max(threads, 1);
+#endif
+}
+
+/** \internal \returns the number of threads to share \a work multiply-adds, such that each of them gets
+  * at least EIGEN_TUNE_PARALLEL_THREAD_COST of them. */
+inline int ei_parallel_threads(double work)
+{
+  int threads = ei_parallel_threads();
+  if(threads>1)
+    threads = int(std::min<double>(threads, std::max<double>(1, work/EIGEN_TUNE_PARALLEL_THREAD_COST)));
+  return threads;
+}
+
+/** \internal Adaptor running the iterations of ei_parallel_for() on a ThreadPool: each task claims
+  * the next iteration until there is none left. */
+template<typename Functor>
+class ei_parallel_for_task : public ThreadPoolTask
+{
+  public:
+    ei_parallel_for_task(const Functor& func, int begin, int end)
+      : m_func(func), m_next(begin), m_end(end)
+    {}
+
+    void run(int, int) const
+    {
+      for(int i=ei_atomic_fetch_and_add(&m_next, 1); i<m_end; i=ei_atomic_fetch_and_add(&m_next, 1))
+        m_func(i);
+    }
+
+  protected:
+    const Functor& m_func;
+    mutable volatile int m_next;
+    int m_end;
+};
+
+/** \internal Calls \a func(i) for each \a i in [\a begin, \a end), on up to ei_parallel_threads() threads,
+  * using the ThreadPool if any, or OpenMP. The iterations are handed out dynamically.
+  *
+  * By default, the iterations must be independent, and they are run sequentially, in order, when no
+  * thread is available or when the thread pool is busy. If \a concurrent is true, the iterations are
+  * allowed to wait for each other: they then either run concurrently, one per thread, or not at all.
+  *
+  * \returns false if the iterations have not been run, which only happens when \a concurrent is true.
+  * The caller then has to use a sequential code path.
+  */
+template<typename Functor>
+bool ei_parallel_for(int begin, int end, const Functor& func, bool concurrent = false)
+{
+  const int count = end-begin;
+  if(count<=0)
+    return true;
+  const int threads = std::min(count, ei_parallel_threads());
+  if(concurrent && threads<count)
+    return false;
+#ifndef EIGEN_DONT_PARALLELIZE
+  if(threads>1)
+  {
+    ThreadPool* pool = threadPool();
+    if(pool)
+    {
+      ei_parallel_for_task<Functor> task(func, begin, end);
+      if(pool->run(task, threads))
+        return true;
+      // the pool is busy, e.g., we are called from one of its tasks
+      if(concurrent)
+        return false;
+    }
+    #ifdef EIGEN_HAS_OPENMP
+    else
+    {
+      #pragma omp parallel for schedule(dynamic,1) num_threads(threads)
+      for(int i=begin; i<end; ++i)
+        func(i);
+      return true;
+    }
+    #endif
+  }
+#endif
+  for(int i=begin; i<end; ++i)
+    func(i);
+  return true;
+}
+
 template<typename Index> struct GemmParallelInfo
 {
   GemmParallelInfo() : sync(-1), users(0), rhs_start(0), rhs_length(0) {}
@@ -80,70 +187,201 @@ template<typename Index> struct GemmParallelInfo
   Index rhs_length;
 };
 
+/** \internal Describes how a parallel matrix product is split among threads.
+  *
+  * The destination is cut into a grid of \c rowBlocks x \c colBlocks tiles, one per thread.
+  * When \c colBlocks is 1, the threads cooperate: each one packs a slice of the shared rhs panel B'
+  * and uses the slices packed by the others. Otherwise each thread computes its tile on its own.
+  */
+template<typename Index> struct GemmParallelPartition
+{
+  GemmParallelPartition() : rowBlocks(1), colBlocks(1) {}
+  Index threads() const { return rowBlocks*colBlocks; }
+
+  Index rowBlocks;
+  Index colBlocks;
+};
+
+/** \internal Computes the partition of a \a rows x \a depth times \a depth x \a cols product
+  * on at most \a maxThreads threads, \a kc being the blocking size along the depth.
+  *
+  * Each candidate grid is given an estimated completion time: the multiply-adds of one tile,
+  * plus the cost of packing its lhs and rhs panels, plus the synchronizations of the cooperative
+  * mode, plus EIGEN_TUNE_PARALLEL_THREAD_COST per thread for the dispatch. The fastest grid is
+  * selected, which implies that small products run on fewer threads. Tiles are at least 8 rows
+  * by 4 columns so that the register blocks of the kernel stay full.
+  */
+template<typename Index>
+GemmParallelPartition<Index> ei_compute_gemm_partition(Index rows, Index cols, Index depth, Index kc, Index maxThreads)
+{
+  // relative cost of packing one coefficient, and of one synchronization between the threads,
+  // expressed in multiply-adds
+  const double packCost = 2;
+  const double syncCost = 1000;
+  const double threadCost = EIGEN_TUNE_PARALLEL_THREAD_COST;
+
+  GemmParallelPartition<Index> best;
+  double bestCost = double(rows)*double(cols)*double(depth) + packCost*double(depth)*double(rows+cols);
+  double panels = double((depth+kc-1)/std::max<Index>(kc,1));
+
+  for(Index pr=1; pr<=maxThreads && pr*8<=rows; ++pr)
+  {
+    for(Index pc=1; pr*pc<=maxThreads && (pc==1 || pc*4<=cols); ++pc)
+    {
+      if(pr*pc==1)
+        continue;
+      double tileRows = double((rows+pr-1)/pr);
+      double tileCols = double((cols+pc-1)/pc);
+      double cost = tileRows*tileCols*double(depth) + threadCost*double(pr*pc);
+      if(pc==1)
+        cost += packCost*double(depth)*(tileRows + double((cols+pr-1)/pr)) + syncCost*panels*double(pr);
+      else
+        cost += packCost*double(depth)*(tileRows + tileCols);
+      if(cost<bestCost)
+      {
+        bestCost = cost;
+        best.rowBlocks = pr;
+        best.colBlocks = pc;
+      }
+    }
+  }
+  return best;
+}
+
+/** \internal Runs the share \a i of a parallel matrix product partitioned as \a partition.
+  * If \a transpose is true, \a rows and \a cols must already be swapped. */
+template<typename Functor, typename Index>
+void ei_run_gemm_thread(const Functor& func, Index i, const GemmParallelPartition<Index>& partition,
+                        Index rows, Index cols, bool transpose, GemmParallelInfo<Index>* info)
+{
+  Index threads = partition.threads();
+
+  if(partition.colBlocks==1)
+  {
+    // cooperative mode: the threads share the packed rhs
+    Index blockCols = (cols / threads) & ~Index(0x3);
+    Index blockRows = (rows / threads) & ~Index(0x7);
+
+    Index r0 = i*blockRows;
+    Index actualBlockRows = (i+1==threads) ? rows-r0 : blockRows;
+
+    Index c0 = i*blockCols;
+    Index actualBlockCols = (i+1==threads) ? cols-c0 : blockCols;
+
+    info[i].rhs_start = c0;
+    info[i].rhs_length = actualBlockCols;
+
+    if(transpose)
+      func(0, cols, r0, actualBlockRows, info, i, threads);
+    else
+      func(r0, actualBlockRows, 0,cols, info, i, threads);
+  }
+  else
+  {
+    // independent tiles
+    Index bi = i / partition.colBlocks;
+    Index bj = i % partition.colBlocks;
+    Index blockRows = (rows / partition.rowBlocks) & ~Index(0x7);
+    Index blockCols = (cols / partition.colBlocks) & ~Index(0x3);
+
+    Index r0 = bi*blockRows;
+    Index actualBlockRows = (bi+1==partition.rowBlocks) ? rows-r0 : blockRows;
+
+    Index c0 = bj*blockCols;
+    Index actualBlockCols = (bj+1==partition.colBlocks) ? cols-c0 : blockCols;
+
+    // a null info with several threads requests private packing buffers
+    if(transpose)
+      func(c0, actualBlockCols, r0, actualBlockRows, 0, i, threads);
+    else
+      func(r0, actualBlockRows, c0, actualBlockCols, 0, i, threads);
+  }
+}
+
+/** \internal Runs the shares of a parallel matrix product from ei_parallel_for() */
+template<typename Functor, typename Index>
+class ei_gemm_parallel_task
+{
+  public:
+    ei_gemm_parallel_task(const Functor& func, const GemmParallelPartition<Index>& partition,
+                          Index rows, Index cols, bool transpose, GemmParallelInfo<Index>* info)
+      : m_func(func), m_partition(partition), m_rows(rows), m_cols(cols), m_transpose(transpose), m_info(info)
+    {}
+
+    void operator()(int id) const
+    {
+      ei_run_gemm_thread(m_func, Index(id), m_partition, m_rows, m_cols, m_transpose, m_info);
+    }
+
+  protected:
+    const Functor& m_func;
+    GemmParallelPartition<Index> m_partition;
+    Index m_rows;
+    Index m_cols;
+    bool m_transpose;
+    GemmParallelInfo<Index>* m_info;
+};
+
 template<bool Condition, typename Functor, typename Index>
-void ei_parallelize_gemm(const Functor& func, Index rows, Index cols, bool transpose)
+void ei_parallelize_gemm(const Functor& func, Index rows, Index cols, Index depth, bool transpose)
 {
-#ifndef EIGEN_HAS_OPENMP
+#ifdef EIGEN_DONT_PARALLELIZE
   // FIXME the transpose variable is only needed to properly split
   // the matrix product when multithreading is enabled. This is a temporary
   // fix to support row-major destination matrices. This whole
   // parallelizer mechanism has to be redisigned anyway.
+  EIGEN_UNUSED_VARIABLE(depth);
   EIGEN_UNUSED_VARIABLE(transpose);
   func(0,rows, 0,cols);
 #else
 
-  // Dynamically check whether we should enable or disable OpenMP.
+  // Dynamically check whether we should enable or disable multi-threading.
   // The conditions are:
+  // - there is a thread pool or OpenMP is enabled
   // - the max number of threads we can create is greater than 1
   // - we are not already in a parallel code
   // - the sizes are large enough
 
-  // 1- are we already in a parallel session?
-  // FIXME omp_get_num_threads()>1 only works for openmp, what if the user does not use openmp?
-  if((!Condition) || (omp_get_num_threads()>1))
+  // 1- compute the maximal number of threads we are allowed to use,
+  // which is 1 if we are already in a parallel session.
+  // A busy thread pool is detected by ei_parallel_for() itself.
+  if(!Condition)
     return func(0,rows, 0,cols);
+  Index max_threads = ei_parallel_threads();
 
-  Index size = transpose ? cols : rows;
-
-  // 2- compute the maximal number of threads from the size of the product:
-  // FIXME this has to be fine tuned
-  Index max_threads = std::max<Index>(1,size / 32);
-
-  // 3 - compute the number of threads we are going to use
-  Index threads = std::min<Index>(nbThreads(), max_threads);
-
-  if(threads==1)
+  if(max_threads<=1)
     return func(0,rows, 0,cols);
 
-  func.initParallelSession();
-
+  // 2- split the product according to its shape
   if(transpose)
     std::swap(rows,cols);
 
-  Index blockCols = (cols / threads) & ~Index(0x3);
-  Index blockRows = (rows / threads) & ~Index(0x7);
-
-  GemmParallelInfo<Index>* info = new GemmParallelInfo<Index>[threads];
+  GemmParallelPartition<Index> partition = ei_compute_gemm_partition<Index>(rows, cols, depth, func.blocking().kc(), max_threads);
+  Index threads = partition.threads();
 
-  #pragma omp parallel for schedule(static,1) num_threads(threads)
-  for(Index i=0; i<threads; ++i)
+  if(threads==1)
   {
-    Index r0 = i*blockRows;
-    Index actualBlockRows = (i+1==threads) ? rows-r0 : blockRows;
+    if(transpose)
+      std::swap(rows,cols);
+    return func(0,rows, 0,cols);
+  }
 
-    Index c0 = i*blockCols;
-    Index actualBlockCols = (i+1==threads) ? cols-c0 : blockCols;
+  if(partition.colBlocks==1)
+    func.initParallelSession();
 
-    info[i].rhs_start = c0;
-    info[i].rhs_length = actualBlockCols;
+  GemmParallelInfo<Index>* info = ei_aligned_stack_new(GemmParallelInfo<Index>, threads);
 
+  // in the cooperative mode, the threads wait for the rhs slices packed by the others
+  ei_gemm_parallel_task<Functor,Index> task(func, partition, rows, cols, transpose, info);
+  if(!ei_parallel_for(0, int(threads), task, true))
+  {
+    // the pool is busy, e.g., we are called from one of its tasks
     if(transpose)
-      func(0, cols, r0, actualBlockRows, info);
-    else
-      func(r0, actualBlockRows, 0,cols, info);
+      std::swap(rows,cols);
+    func(0,rows, 0,cols);
   }
 
-  delete[] info;
+  ei_aligned_stack_delete(GemmParallelInfo<Index>, info, threads);
 #endif
 }
 
@@ -53,6 +53,12 @@ struct ei_triangular_solve_matrix<Scalar,Index,OnTheLeft,Mode,Conjugate,TriStora
     const Scalar* _tri, Index triStride,
     Scalar* _other, Index otherStride)
   {
+    #ifdef EIGEN_RUNTIME_DISPATCH
+    if(ei_dispatch_trsm<Scalar,Index,OnTheLeft,Mode,Conjugate,TriStorageOrder>
+        ::run(size, otherSize, _tri, triStride, _other, otherStride))
+      return;
+    #endif
+
     Index cols = otherSize;
     ei_const_blas_data_mapper<Scalar, Index, TriStorageOrder> tri(_tri,triStride);
     ei_blas_data_mapper<Scalar, Index, ColMajor> other(_other,otherStride);
@@ -188,6 +194,12 @@ struct ei_triangular_solve_matrix<Scalar,Index,OnTheRight,Mode,Conjugate,TriStor
     const Scalar* _tri, Index triStride,
     Scalar* _other, Index otherStride)
   {
+    #ifdef EIGEN_RUNTIME_DISPATCH
+    if(ei_dispatch_trsm<Scalar,Index,OnTheRight,Mode,Conjugate,TriStorageOrder>
+        ::run(size, otherSize, _tri, triStride, _other, otherStride))
+      return;
+    #endif
+
     Index rows = otherSize;
     ei_const_blas_data_mapper<Scalar, Index, TriStorageOrder> rhs(_tri,triStride);
     ei_blas_data_mapper<Scalar, Index, ColMajor> lhs(_other,otherStride);
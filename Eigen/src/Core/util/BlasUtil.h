@@ -48,6 +48,19 @@ struct ei_general_matrix_matrix_product;
 template<typename Index, typename LhsScalar, int LhsStorageOrder, bool ConjugateLhs, typename RhsScalar, bool ConjugateRhs>
 struct ei_general_matrix_vector_product;
 
+#ifdef EIGEN_RUNTIME_DISPATCH
+// see products/DispatchedKernels.h
+template<typename Index, typename LhsScalar, int LhsStorageOrder, bool ConjugateLhs,
+         typename RhsScalar, int RhsStorageOrder, bool ConjugateRhs>
+struct ei_dispatch_gemm;
+
+template<typename Index, typename LhsScalar, int StorageOrder, bool ConjugateLhs, typename RhsScalar, bool ConjugateRhs>
+struct ei_dispatch_gemv;
+
+template<typename Scalar, typename Index, int Side, int Mode, bool Conjugate, int TriStorageOrder>
+struct ei_dispatch_trsm;
+#endif
+
 
 template<bool Conjugate> struct ei_conj_if;
 
@@ -215,7 +215,9 @@ enum {
   SkipV = 0x2,
   AtLeastAsManyRowsAsCols = 0x4,
   AtLeastAsManyColsAsRows = 0x8,
-  Square = AtLeastAsManyRowsAsCols | AtLeastAsManyColsAsRows
+  Square = AtLeastAsManyRowsAsCols | AtLeastAsManyColsAsRows,
+  ThinU = 0x10,  // only computes the first min(rows,cols) columns of U (BDCSVD only)
+  ThinV = 0x20   // only computes the first min(rows,cols) columns of V (BDCSVD only)
 };
 
 /* the following could as well be written:
@@ -259,7 +261,8 @@ enum DecompositionOptions {
   Ax_lBx              = 0x100,
   ABx_lx              = 0x200,
   BAx_lx              = 0x400,
-  GenEigMask = Ax_lBx | ABx_lx | BAx_lx
+  GenEigMask = Ax_lBx | ABx_lx | BAx_lx,
+  DivideAndConquer    = 0x800  // selfadjoint eigen solvers
 };
 
 /** \brief Enum for reporting the status of a computation.
@@ -283,7 +286,10 @@ namespace Architecture
     Generic = 0x0,
     SSE = 0x1,
     AltiVec = 0x2,
-#if defined EIGEN_VECTORIZE_SSE
+    AVX = 0x4,
+#if defined EIGEN_VECTORIZE_AVX
+    Target = AVX
+#elif defined EIGEN_VECTORIZE_SSE
     Target = SSE
 #elif defined EIGEN_VECTORIZE_ALTIVEC
     Target = AltiVec
@@ -293,6 +299,47 @@ namespace Architecture
   };
 }
 
+/** \internal Bit flags of the x86 instruction sets used by the runtime dispatch of the kernels.
+  * \c Target is the set of instruction sets the current translation unit may contain. */
+namespace InstructionSet
+{
+  enum Type {
+    SSE2   = 0x1,
+    SSE3   = 0x2,
+    SSSE3  = 0x4,
+    SSE4_1 = 0x8,
+    SSE4_2 = 0x10,
+    AVX    = 0x20,
+    AVX2   = 0x40,
+    FMA    = 0x80,
+    Target = 0
+#if defined(__SSE2__) || defined(EIGEN_VECTORIZE_SSE2)
+      | SSE2
+#endif
+#if defined(__SSE3__) || defined(EIGEN_VECTORIZE_SSE3)
+      | SSE3
+#endif
+#if defined(__SSSE3__) || defined(EIGEN_VECTORIZE_SSSE3)
+      | SSSE3
+#endif
+#if defined(__SSE4_1__) || defined(EIGEN_VECTORIZE_SSE4_1)
+      | SSE4_1
+#endif
+#if defined(__SSE4_2__) || defined(EIGEN_VECTORIZE_SSE4_2)
+      | SSE4_2
+#endif
+#if defined(__AVX__) || defined(EIGEN_VECTORIZE_AVX)
+      | AVX
+#endif
+#if defined(__AVX2__) || defined(EIGEN_VECTORIZE_AVX2)
+      | AVX2
+#endif
+#if defined(__FMA__) || defined(EIGEN_VECTORIZE_FMA)
+      | FMA
+#endif
+  };
+}
+
 enum { CoeffBasedProductMode, LazyCoeffBasedProductMode, OuterProduct, InnerProduct, GemvProduct, GemmProduct };
 
 enum Action {GetAction, SetAction};
@@ -34,6 +34,14 @@
 #ifndef EIGEN_MEMORY_H
 #define EIGEN_MEMORY_H
 
+// The heap buffers are aligned on the size of the largest packet. The AVX packets do not
+// strictly require it, but a 32 bytes packet straddling two cache lines is slow to load.
+#ifdef EIGEN_VECTORIZE_AVX
+  #define EIGEN_HEAP_ALIGNMENT 32
+#else
+  #define EIGEN_HEAP_ALIGNMENT 16
+#endif
+
 // On 64-bit systems, glibc's malloc returns 16-byte-aligned pointers, see:
 //   http://www.gnu.org/s/libc/manual/html_node/Aligned-Memory-Blocks.html
 // This is true at least since glibc 2.8.
@@ -58,10 +66,11 @@
   #define EIGEN_FREEBSD_MALLOC_ALREADY_ALIGNED 0
 #endif
 
-#if defined(__APPLE__) \
- || defined(_WIN64) \
- || EIGEN_GLIBC_MALLOC_ALREADY_ALIGNED \
- || EIGEN_FREEBSD_MALLOC_ALREADY_ALIGNED
+#if (EIGEN_HEAP_ALIGNMENT==16) \
+ && (defined(__APPLE__) \
+  || defined(_WIN64) \
+  || EIGEN_GLIBC_MALLOC_ALREADY_ALIGNED \
+  || EIGEN_FREEBSD_MALLOC_ALREADY_ALIGNED)
   #define EIGEN_MALLOC_ALREADY_ALIGNED 1
 #else
   #define EIGEN_MALLOC_ALREADY_ALIGNED 0
@@ -86,14 +95,14 @@
 
 /* ----- Hand made implementations of aligned malloc/free and realloc ----- */
 
-/** \internal Like malloc, but the returned pointer is guaranteed to be 16-byte aligned.
-  * Fast, but wastes 16 additional bytes of memory. Does not throw any exception.
+/** \internal Like malloc, but the returned pointer is guaranteed to be aligned on EIGEN_HEAP_ALIGNMENT bytes.
+  * Fast, but wastes EIGEN_HEAP_ALIGNMENT additional bytes of memory. Does not throw any exception.
   */
 inline void* ei_handmade_aligned_malloc(size_t size)
 {
-  void *original = std::malloc(size+16);
+  void *original = std::malloc(size+EIGEN_HEAP_ALIGNMENT);
   if (original == 0) return 0;
-  void *aligned = reinterpret_cast<void*>((reinterpret_cast<size_t>(original) & ~(size_t(15))) + 16);
+  void *aligned = reinterpret_cast<void*>((reinterpret_cast<size_t>(original) & ~(size_t(EIGEN_HEAP_ALIGNMENT-1))) + EIGEN_HEAP_ALIGNMENT);
   *(reinterpret_cast<void**>(aligned) - 1) = original;
   return aligned;
 }
@@ -113,9 +122,9 @@ inline void* ei_handmade_aligned_realloc(void* ptr, size_t size, size_t = 0)
 {
   if (ptr == 0) return ei_handmade_aligned_malloc(size);
   void *original = *(reinterpret_cast<void**>(ptr) - 1);
-  original = std::realloc(original,size+16);
+  original = std::realloc(original,size+EIGEN_HEAP_ALIGNMENT);
   if (original == 0) return 0;
-  void *aligned = reinterpret_cast<void*>((reinterpret_cast<size_t>(original) & ~(size_t(15))) + 16);
+  void *aligned = reinterpret_cast<void*>((reinterpret_cast<size_t>(original) & ~(size_t(EIGEN_HEAP_ALIGNMENT-1))) + EIGEN_HEAP_ALIGNMENT);
   *(reinterpret_cast<void**>(aligned) - 1) = original;
   return aligned;
 }
@@ -163,7 +172,7 @@ inline void* ei_generic_aligned_realloc(void* ptr, size_t size, size_t old_size)
 *** Implementation of portable aligned versions of malloc/free/realloc     ***
 *****************************************************************************/
 
-/** \internal Allocates \a size bytes. The returned pointer is guaranteed to have 16 bytes alignment.
+/** \internal Allocates \a size bytes. The returned pointer is guaranteed to have 16 bytes alignment (32 bytes when AVX is enabled).
   * On allocation error, the returned pointer is null, and if exceptions are enabled then a std::bad_alloc is thrown.
   */
 inline void* ei_aligned_malloc(size_t size)
@@ -178,11 +187,11 @@ inline void* ei_aligned_malloc(size_t size)
   #elif EIGEN_MALLOC_ALREADY_ALIGNED
     result = std::malloc(size);
   #elif EIGEN_HAS_POSIX_MEMALIGN
-    if(posix_memalign(&result, 16, size)) result = 0;
+    if(posix_memalign(&result, EIGEN_HEAP_ALIGNMENT, size)) result = 0;
   #elif EIGEN_HAS_MM_MALLOC
-    result = _mm_malloc(size, 16);
+    result = _mm_malloc(size, EIGEN_HEAP_ALIGNMENT);
   #elif (defined _MSC_VER)
-    result = _aligned_malloc(size, 16);
+    result = _aligned_malloc(size, EIGEN_HEAP_ALIGNMENT);
   #else
     result = ei_handmade_aligned_malloc(size);
   #endif
@@ -233,12 +242,12 @@ inline void* ei_aligned_realloc(void *ptr, size_t new_size, size_t old_size)
   // implements _mm_malloc/_mm_free based on the corresponding _aligned_
   // functions. This may not always be the case and we just try to be safe.
   #if defined(_MSC_VER) && defined(_mm_free)
-    result = _aligned_realloc(ptr,new_size,16);
+    result = _aligned_realloc(ptr,new_size,EIGEN_HEAP_ALIGNMENT);
   #else
     result = ei_generic_aligned_realloc(ptr,new_size,old_size);
   #endif
 #elif defined(_MSC_VER)
-  result = _aligned_realloc(ptr,new_size,16);
+  result = _aligned_realloc(ptr,new_size,EIGEN_HEAP_ALIGNMENT);
 #else
   result = ei_handmade_aligned_realloc(ptr,new_size,old_size);
 #endif
@@ -796,4 +805,65 @@ inline int ei_queryTopLevelCacheSize()
   return std::max(l2,l3);
 }
 
+//---------- Instruction sets ----------
+
+#if defined(EIGEN_CPUID) && defined(__GNUC__)
+#  define EIGEN_XGETBV(eax,edx) \
+     __asm__ __volatile__ (".byte 0x0f, 0x01, 0xd0" /* xgetbv */ : "=a" (eax), "=d" (edx) : "c" (0));
+#elif defined(EIGEN_CPUID) && defined(_MSC_FULL_VER) && (_MSC_FULL_VER >= 160040219) /* MSVC++ 10.0 with SP1 */
+#  define EIGEN_XGETBV(eax,edx) { unsigned __int64 xcr0 = _xgetbv(0); eax = int(xcr0); edx = int(xcr0>>32); }
+#endif
+
+/** \internal
+ * Queries the x86 instruction sets supported by both the CPU and the operating system.
+ * \returns a combination of the InstructionSet flags */
+inline int ei_queryInstructionSets()
+{
+  int sets = 0;
+  #ifdef EIGEN_CPUID
+  int abcd[4];
+  EIGEN_CPUID(abcd,0x0,0);
+  int max_std_funcs = abcd[0];
+  if(max_std_funcs<1)
+    return 0;
+
+  EIGEN_CPUID(abcd,0x1,0);
+  if(abcd[3] & (1<<26)) sets |= InstructionSet::SSE2;
+  if(abcd[2] & (1<< 0)) sets |= InstructionSet::SSE3;
+  if(abcd[2] & (1<< 9)) sets |= InstructionSet::SSSE3;
+  if(abcd[2] & (1<<19)) sets |= InstructionSet::SSE4_1;
+  if(abcd[2] & (1<<20)) sets |= InstructionSet::SSE4_2;
+
+  // the 256 bits registers are usable only if the OS saves them on context switches (OSXSAVE + XCR0)
+  #ifdef EIGEN_XGETBV
+  bool hasFMA = abcd[2] & (1<<12);
+  if((abcd[2] & (1<<27)) && (abcd[2] & (1<<28)))
+  {
+    int xcr0, xcr0_high;
+    EIGEN_XGETBV(xcr0,xcr0_high);
+    EIGEN_UNUSED_VARIABLE(xcr0_high);
+    if((xcr0 & 0x6)==0x6)
+    {
+      sets |= InstructionSet::AVX;
+      if(hasFMA) sets |= InstructionSet::FMA;
+      if(max_std_funcs>=7)
+      {
+        EIGEN_CPUID(abcd,0x7,0);
+        if(abcd[1] & (1<<5)) sets |= InstructionSet::AVX2;
+      }
+    }
+  }
+  #endif
+  #endif
+  return sets;
+}
+
+/** \internal
+ * \returns the InstructionSet flags supported by the current machine. The CPU is queried only once. */
+inline int ei_instructionSets()
+{
+  static int sets = ei_queryInstructionSets();
+  return sets;
+}
+
 #endif // EIGEN_MEMORY_H
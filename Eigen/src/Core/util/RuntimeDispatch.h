@@ -0,0 +1,78 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Copyright (C) 2010 Gael Guennebaud <gael.guennebaud@inria.fr>
+//
+// Eigen is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// Alternatively, you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation; either version 2 of
+// the License, or (at your option) any later version.
+//
+// Eigen is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License or the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License and a copy of the GNU General Public License along with
+// Eigen. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef EIGEN_RUNTIME_DISPATCH_H
+#define EIGEN_RUNTIME_DISPATCH_H
+
+/* Runtime dispatch of the heavy kernels (opt-in)
+ *
+ * By default, the instruction sets used by Eigen are chosen at compile time. In order to ship a
+ * single binary running at full speed on several generations of x86 CPUs, the matrix-matrix
+ * products, the matrix-vector products and the triangular solvers can also be compiled for
+ * higher instruction sets in dedicated translation units, and be selected once at startup.
+ *
+ * Each such translation unit contains only:
+ * \code
+ * #define EIGEN_DISPATCH_TARGET avx2   // or sse4_2, avx
+ * #include <Eigen/Core>
+ * \endcode
+ * and is compiled with the matching flags (e.g., -mavx2 -mfma). The whole Eigen code of that
+ * translation unit lives in the namespace Eigen::avx2, nested in an unnamed namespace: its
+ * instantiations have internal linkage, so that they cannot clash with the baseline ones at link
+ * time, nor replace them when the linker merges the copies of the inline functions. The rest of the program is compiled with the baseline flags and the macro
+ * EIGEN_DISPATCH_SSE4_2, EIGEN_DISPATCH_AVX and/or EIGEN_DISPATCH_AVX2 telling which targets are
+ * linked in. On the first call to one of the kernels, the best target whose instruction sets are all
+ * supported by the CPU (and the OS) is selected, and the others are never executed.
+ *
+ * Note that the inline functions of the standard library instantiated by the dispatch translation
+ * units are shared with the rest of the program: they should be linked after the baseline objects.
+ *
+ * This file only contains what is shared by both sides: it is included in the namespace Eigen
+ * before the target namespace is opened.
+ */
+
+enum DispatchedKernel { DispatchedGemm, DispatchedGemv, DispatchedTrsm };
+
+/** \internal Holds the entry point of the selected implementation of a dispatched kernel.
+  * \a FuncPtr is one of the ei_dispatched_kernel_types and \a Variant encodes the template parameters
+  * of the kernel (see ei_gemm_dispatch_variant and friends). The pointer stays null when no linked
+  * target is supported by the CPU. */
+template<typename FuncPtr, int Kernel, int Variant> struct ei_dispatch_slot
+{
+  static FuncPtr func;
+};
+
+template<typename FuncPtr, int Kernel, int Variant> FuncPtr ei_dispatch_slot<FuncPtr,Kernel,Variant>::func = 0;
+
+/** \internal Declares the symbols exported by the translation unit of the dispatch target \a TARGET:
+  * the InstructionSet flags it has been compiled for, and the function registering its kernels. */
+#define EIGEN_DECLARE_DISPATCH_TARGET(TARGET) \
+  extern const int ei_dispatch_instruction_sets_##TARGET; \
+  void ei_register_dispatched_kernels_##TARGET();
+
+EIGEN_DECLARE_DISPATCH_TARGET(sse4_2)
+EIGEN_DECLARE_DISPATCH_TARGET(avx)
+EIGEN_DECLARE_DISPATCH_TARGET(avx2)
+
+#endif // EIGEN_RUNTIME_DISPATCH_H
@@ -90,7 +90,8 @@
         PACKET_ACCESS_REQUIRES_TO_HAVE_INNER_STRIDE_FIXED_TO_1,
         THIS_METHOD_IS_ONLY_FOR_SPECIFIC_TRANSFORMATIONS,
         YOU_CANNOT_MIX_ARRAYS_AND_MATRICES,
-        YOU_PERFORMED_AN_INVALID_TRANSFORMATION_CONVERSION
+        YOU_PERFORMED_AN_INVALID_TRANSFORMATION_CONVERSION,
+        EIGEN_TUNE_PARALLEL_COEFFWISE_CHUNK_MUST_BE_A_MULTIPLE_OF_THE_PACKET_SIZE
       };
     };
 
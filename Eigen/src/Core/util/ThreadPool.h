@@ -0,0 +1,364 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Copyright (C) 2010 Gael Guennebaud <gael.guennebaud@inria.fr>
+//
+// Eigen is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// Alternatively, you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation; either version 2 of
+// the License, or (at your option) any later version.
+//
+// Eigen is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License or the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License and a copy of the GNU General Public License along with
+// Eigen. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef EIGEN_THREADPOOL_H
+#define EIGEN_THREADPOOL_H
+
+/***************************************************************************
+* Atomic primitives used by the parallel kernels
+***************************************************************************/
+
+/** \internal Atomically adds \a inc to \a *v and \returns the previous value of \a *v */
+inline int ei_atomic_fetch_and_add(volatile int* v, int inc)
+{
+#if defined(__GNUC__)
+  return __sync_fetch_and_add(v, inc);
+#elif defined(_MSC_VER)
+  return _InterlockedExchangeAdd(reinterpret_cast<volatile long*>(v), inc);
+#else
+  int old;
+  #ifdef EIGEN_HAS_OPENMP
+  #pragma omp critical(ei_atomic)
+  #endif
+  {
+    old = *v;
+    *v = old + inc;
+  }
+  return old;
+#endif
+}
+
+/** \internal Atomically decrements \a *v */
+inline void ei_atomic_decrement(volatile int* v)
+{
+  ei_atomic_fetch_and_add(v, -1);
+}
+
+/** \internal Atomically sets \a *v to \a newval if it is equal to \a oldval.
+  * \returns true if the swap took place */
+inline bool ei_atomic_compare_and_swap(volatile int* v, int oldval, int newval)
+{
+#if defined(__GNUC__)
+  return __sync_bool_compare_and_swap(v, oldval, newval);
+#elif defined(_MSC_VER)
+  return _InterlockedCompareExchange(reinterpret_cast<volatile long*>(v), newval, oldval) == oldval;
+#else
+  bool ret = false;
+  #ifdef EIGEN_HAS_OPENMP
+  #pragma omp critical(ei_atomic)
+  #endif
+  {
+    if(*v==oldval)
+    {
+      *v = newval;
+      ret = true;
+    }
+  }
+  return ret;
+#endif
+}
+
+/** \internal Full memory barrier: makes the writes of the current thread visible to the others */
+inline void ei_memory_barrier()
+{
+#if defined(__GNUC__)
+  __sync_synchronize();
+#elif defined(_MSC_VER)
+  // _ReadWriteBarrier() would only prevent the reordering by the compiler, while the interlocked
+  // operations are full memory barriers on all the targets of MSVC
+  volatile long dummy = 0;
+  _InterlockedExchange(&dummy, 0);
+#elif defined(EIGEN_HAS_OPENMP)
+  #pragma omp flush
+#endif
+}
+
+/***************************************************************************
+* Thread pool interface
+***************************************************************************/
+
+/** \class ThreadPoolTask
+  *
+  * \brief Abstract piece of work dispatched to a ThreadPool
+  *
+  * A task submitted with ThreadPool::run(task,count) is executed \c count times, each call receiving
+  * a distinct \a id in [0,count) and the total number \a count of calls.
+  *
+  * \sa class ThreadPool
+  */
+class ThreadPoolTask
+{
+  public:
+    virtual ~ThreadPoolTask() {}
+    virtual void run(int id, int count) const = 0;
+};
+
+/** \class ThreadPool
+  *
+  * \brief Interface of the thread pools used by Eigen to parallelize its heavy kernels
+  *
+  * Any threading library can be plugged into Eigen by implementing this interface and
+  * registering an instance with setThreadPool(). When Eigen is compiled with \c EIGEN_USE_PTHREADS,
+  * a PosixThreadPool with one thread per core is used by default.
+  *
+  * \sa setThreadPool(), class PosixThreadPool
+  */
+class ThreadPool
+{
+  public:
+    virtual ~ThreadPool() {}
+
+    /** \returns the number of tasks which can run concurrently, including the calling thread */
+    virtual int threads() const = 0;
+
+    /** Calls \a task.run(id,count) for each \a id in [0,count) and returns once all of them are completed.
+      *
+      * \a count must not be larger than threads(). All the calls must be able to run concurrently
+      * since they are allowed to wait for each other.
+      *
+      * \returns false, without running anything, if the pool cannot take the job right now
+      * (e.g., it is already in use by another thread, or \a run() is called from one of its tasks).
+      * In that case the caller falls back to a sequential code path.
+      */
+    virtual bool run(const ThreadPoolTask& task, int count) = 0;
+};
+
+#ifdef EIGEN_HAS_PTHREADS
+
+/** \class PosixThreadPool
+  *
+  * \brief Persistent thread pool built on top of POSIX threads
+  *
+  * The worker threads are created once by the constructor and sleep between two jobs, so that
+  * dispatching a job costs neither a thread creation nor a heap allocation. The calling thread
+  * takes part in every job, and the ids of a job are claimed on the fly by whichever thread is
+  * available first.
+  *
+  * This class is only available when \c EIGEN_USE_PTHREADS is defined before including Eigen.
+  *
+  * \sa class ThreadPool, setThreadPool()
+  */
+class PosixThreadPool : public ThreadPool
+{
+  public:
+
+    /** Creates a pool able to run \a threads tasks concurrently, the calling thread included.
+      * The default value 0 means one thread per online processor. */
+    explicit PosixThreadPool(int threads = 0)
+      : m_workerCount(0), m_task(0), m_count(0), m_next(0), m_pending(0), m_active(0), m_generation(0),
+        m_busy(0), m_stop(false)
+    {
+      if(threads<=0)
+        threads = std::max<int>(1, int(sysconf(_SC_NPROCESSORS_ONLN)));
+      pthread_mutex_init(&m_mutex, 0);
+      pthread_cond_init(&m_wakeUp, 0);
+      pthread_cond_init(&m_done, 0);
+      m_workers = new pthread_t[threads-1];
+      for(int i=0; i<threads-1; ++i)
+      {
+        if(pthread_create(&m_workers[i], 0, &PosixThreadPool::workerMain, this)!=0)
+          break;
+        ++m_workerCount;
+      }
+    }
+
+    ~PosixThreadPool()
+    {
+      pthread_mutex_lock(&m_mutex);
+      m_stop = true;
+      pthread_cond_broadcast(&m_wakeUp);
+      pthread_mutex_unlock(&m_mutex);
+      for(int i=0; i<m_workerCount; ++i)
+        pthread_join(m_workers[i], 0);
+      delete[] m_workers;
+      pthread_cond_destroy(&m_done);
+      pthread_cond_destroy(&m_wakeUp);
+      pthread_mutex_destroy(&m_mutex);
+    }
+
+    int threads() const { return m_workerCount+1; }
+
+    bool run(const ThreadPoolTask& task, int count)
+    {
+      ei_assert(count<=threads() && "too many concurrent tasks for this thread pool");
+      if(count<=0)
+        return true;
+      if(!ei_atomic_compare_and_swap(&m_busy, 0, 1))
+        return false;
+
+      if(count==1)
+      {
+        task.run(0, 1);
+      }
+      else
+      {
+        pthread_mutex_lock(&m_mutex);
+        // the job description must not change while a late worker is still scanning the previous one
+        while(m_active>0)
+          pthread_cond_wait(&m_done, &m_mutex);
+        m_task = &task;
+        m_count = count;
+        m_next = 0;
+        m_pending = count;
+        ++m_generation;
+        pthread_cond_broadcast(&m_wakeUp);
+        pthread_mutex_unlock(&m_mutex);
+
+        execute();
+
+        pthread_mutex_lock(&m_mutex);
+        while(m_pending>0 || m_active>0)
+          pthread_cond_wait(&m_done, &m_mutex);
+        m_task = 0;
+        pthread_mutex_unlock(&m_mutex);
+      }
+
+      ei_memory_barrier();
+      m_busy = 0;
+      return true;
+    }
+
+  protected:
+
+    static void* workerMain(void* pool)
+    {
+      static_cast<PosixThreadPool*>(pool)->workerLoop();
+      return 0;
+    }
+
+    void workerLoop()
+    {
+      int seen = 0;
+      pthread_mutex_lock(&m_mutex);
+      for(;;)
+      {
+        while(!m_stop && m_generation==seen)
+          pthread_cond_wait(&m_wakeUp, &m_mutex);
+        if(m_stop)
+          break;
+        seen = m_generation;
+        ++m_active;
+        pthread_mutex_unlock(&m_mutex);
+
+        execute();
+
+        pthread_mutex_lock(&m_mutex);
+        if(--m_active==0)
+          pthread_cond_broadcast(&m_done);
+      }
+      pthread_mutex_unlock(&m_mutex);
+    }
+
+    /** \internal claims and runs the ids of the current job until there is none left */
+    void execute()
+    {
+      for(;;)
+      {
+        int id = ei_atomic_fetch_and_add(&m_next, 1);
+        if(id>=m_count)
+          break;
+        m_task->run(id, m_count);
+        ei_atomic_decrement(&m_pending);
+      }
+    }
+
+    pthread_mutex_t m_mutex;
+    pthread_cond_t m_wakeUp;
+    pthread_cond_t m_done;
+    pthread_t* m_workers;
+    int m_workerCount;
+
+    const ThreadPoolTask* volatile m_task;
+    volatile int m_count;
+    volatile int m_next;
+    volatile int m_pending;
+    int m_active;
+    int m_generation;
+    volatile int m_busy;
+    bool m_stop;
+
+  private:
+    PosixThreadPool(const PosixThreadPool&);
+    PosixThreadPool& operator=(const PosixThreadPool&);
+};
+
+#endif // EIGEN_HAS_PTHREADS
+
+/** \internal */
+inline void ei_manage_thread_pool(Action action, ThreadPool** pool)
+{
+  static ThreadPool* m_pool = 0;
+  #ifdef EIGEN_HAS_PTHREADS
+  static bool m_userDefined = false;
+  #endif
+
+  if(action==SetAction)
+  {
+    ei_internal_assert(pool!=0);
+    m_pool = *pool;
+    #ifdef EIGEN_HAS_PTHREADS
+    m_userDefined = true;
+    #endif
+  }
+  else if(action==GetAction)
+  {
+    ei_internal_assert(pool!=0);
+    #ifdef EIGEN_HAS_PTHREADS
+    if(!m_userDefined)
+    {
+      static PosixThreadPool defaultPool;
+      m_pool = &defaultPool;
+      m_userDefined = true;
+    }
+    #endif
+    *pool = m_pool;
+  }
+  else
+  {
+    ei_internal_assert(false);
+  }
+}
+
+/** \returns the thread pool used by Eigen's parallel kernels, or a null pointer if there is none
+  * \sa setThreadPool() */
+inline ThreadPool* threadPool()
+{
+  ThreadPool* ret;
+  ei_manage_thread_pool(GetAction, &ret);
+  return ret;
+}
+
+/** Sets the thread pool used by Eigen's parallel kernels. The pool is not owned by Eigen and must
+  * outlive its use. Passing a null pointer disables it, in which case Eigen falls back to OpenMP,
+  * if enabled, or to sequential code.
+  *
+  * This function is not thread safe: call it before performing any computation.
+  *
+  * \sa threadPool(), setNbThreads() */
+inline void setThreadPool(ThreadPool* pool)
+{
+  ei_manage_thread_pool(SetAction, &pool);
+}
+
+#endif // EIGEN_THREADPOOL_H
@@ -103,7 +103,8 @@ class GeneralizedSelfAdjointEigenSolver : public SelfAdjointEigenSolver<_MatrixT
       *                   Only the lower triangular part of the matrix is referenced.
       * \param[in]  matB  Positive-definite matrix in matrix pencil.
       *                   Only the lower triangular part of the matrix is referenced.
-      * \param[in]  options A or-ed set of flags {ComputeEigenvectors,EigenvaluesOnly} | {Ax_lBx,ABx_lx,BAx_lx}.
+      * \param[in]  options A or-ed set of flags {ComputeEigenvectors,EigenvaluesOnly} | {Ax_lBx,ABx_lx,BAx_lx},
+      *                     optionally with DivideAndConquer (see SelfAdjointEigenSolver::compute()).
       *                     Default is ComputeEigenvectors|Ax_lBx.
       *
       * This constructor calls compute(const MatrixType&, const MatrixType&, int)
@@ -136,7 +137,8 @@ class GeneralizedSelfAdjointEigenSolver : public SelfAdjointEigenSolver<_MatrixT
       *                   Only the lower triangular part of the matrix is referenced.
       * \param[in]  matB  Positive-definite matrix in matrix pencil.
       *                   Only the lower triangular part of the matrix is referenced.
-      * \param[in]  options A or-ed set of flags {ComputeEigenvectors,EigenvaluesOnly} | {Ax_lBx,ABx_lx,BAx_lx}.
+      * \param[in]  options A or-ed set of flags {ComputeEigenvectors,EigenvaluesOnly} | {Ax_lBx,ABx_lx,BAx_lx},
+      *                     optionally with DivideAndConquer (see SelfAdjointEigenSolver::compute()).
       *                     Default is ComputeEigenvectors|Ax_lBx.
       *
       * \returns    Reference to \c *this
@@ -183,7 +185,7 @@ GeneralizedSelfAdjointEigenSolver<MatrixType>& GeneralizedSelfAdjointEigenSolver
 compute(const MatrixType& matA, const MatrixType& matB, int options)
 {
   ei_assert(matA.cols()==matA.rows() && matB.rows()==matA.rows() && matB.cols()==matB.rows());
-  ei_assert((options&~(EigVecMask|GenEigMask))==0
+  ei_assert((options&~(EigVecMask|GenEigMask|DivideAndConquer))==0
           && (options&EigVecMask)!=EigVecMask
           && ((options&GenEigMask)==0 || (options&GenEigMask)==Ax_lBx
            || (options&GenEigMask)==ABx_lx || (options&GenEigMask)==BAx_lx)
@@ -205,7 +207,7 @@ compute(const MatrixType& matA, const MatrixType& matB, int options)
     cholB.matrixL().template solveInPlace<OnTheLeft>(matC);
     cholB.matrixU().template solveInPlace<OnTheRight>(matC);
 
-    Base::compute(matC, computeEigVecs ? ComputeEigenvectors : EigenvaluesOnly );
+    Base::compute(matC, (computeEigVecs ? ComputeEigenvectors : EigenvaluesOnly) | (options&DivideAndConquer));
 
     // transform back the eigen vectors: evecs = inv(U) * evecs
     if(computeEigVecs)
@@ -218,7 +220,7 @@ compute(const MatrixType& matA, const MatrixType& matB, int options)
     matC = matC * cholB.matrixL();
     matC = cholB.matrixU() * matC;
 
-    Base::compute(matC, computeEigVecs ? ComputeEigenvectors : EigenvaluesOnly);
+    Base::compute(matC, (computeEigVecs ? ComputeEigenvectors : EigenvaluesOnly) | (options&DivideAndConquer));
 
     // transform back the eigen vectors: evecs = inv(U) * evecs
     if(computeEigVecs)
@@ -231,7 +233,7 @@ compute(const MatrixType& matA, const MatrixType& matB, int options)
     matC = matC * cholB.matrixL();
     matC = cholB.matrixU() * matC;
 
-    Base::compute(matC, computeEigVecs ? ComputeEigenvectors : EigenvaluesOnly);
+    Base::compute(matC, (computeEigVecs ? ComputeEigenvectors : EigenvaluesOnly) | (options&DivideAndConquer));
 
     // transform back the eigen vectors: evecs = L * evecs
     if(computeEigVecs)
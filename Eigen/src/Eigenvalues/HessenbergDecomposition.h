@@ -283,14 +283,80 @@ template<typename _MatrixType> class HessenbergDecomposition
 };
 
 /** \internal
-  * Performs a tridiagonal decomposition of \a matA in place.
+  * Reduces the \a bs columns of \a matA starting at column \a k to Hessenberg form, without
+  * updating the columns on the right of the panel (LAPACK's xLAHR2).
   *
-  * \param matA the input selfadjoint matrix
+  * The reflectors computed so far are applied lazily to each column of the panel before it is
+  * reduced. On output, the Householder vectors are stored as usual in the panel, and their
+  * product \f$ Q = I - V T V^* \f$ is explicitly available: the leading 1 of the vectors and
+  * the zeros above are stored in \a V, the upper triangular factor is returned in \a T, and the
+  * rows \a k+1 to \a n-1 of \a Y are equal to \f$ A V T \f$ where \f$ A \f$ is the input matrix.
+  */
+template<typename MatrixType, typename CoeffVectorType, typename WorkspaceType>
+void ei_hessenberg_panel(MatrixType& matA, CoeffVectorType& hCoeffs,
+                         typename MatrixType::Index k, typename MatrixType::Index bs,
+                         WorkspaceType& V, WorkspaceType& Y, WorkspaceType& T)
+{
+  typedef typename MatrixType::Index Index;
+  typedef typename MatrixType::Scalar Scalar;
+  typedef typename MatrixType::RealScalar RealScalar;
+  Index n = matA.rows();
+  Index m = n-k-1;
+
+  for (Index i = 0; i<bs; ++i)
+  {
+    Index c = k+i;
+    Index remainingSize = n-c-1;
+    typename MatrixType::ColXpr col(matA.col(c));
+
+    if(i>0)
+    {
+      // A = A Q
+      col.tail(m).noalias() -= Y.block(k+1,0,m,i) * V.block(i-1,0,1,i).adjoint();
+      // A = Q^* A, the first i coefficients of the column of T being used as a temporary
+      typename WorkspaceType::ColXpr w = T.col(i);
+      w.head(i).noalias() = V.block(0,0,m,i).adjoint() * col.tail(m);
+      w.head(i) = T.block(0,0,i,i).template triangularView<Upper>().adjoint() * w.head(i);
+      col.tail(m).noalias() -= V.block(0,0,m,i) * w.head(i);
+    }
+
+    RealScalar beta;
+    Scalar h;
+    col.tail(remainingSize).makeHouseholderInPlace(h, beta);
+    hCoeffs.coeffRef(c) = h;
+    col.coeffRef(c+1) = beta;
+
+    V.col(i).head(i).setZero();
+    V.coeffRef(i,i) = Scalar(1);
+    V.col(i).segment(i+1,remainingSize-1) = col.tail(remainingSize-1);
+
+    // Y_i = conj(h) (A v_i - Y V^* v_i) and T_i = -conj(h) T V^* v_i
+    typename WorkspaceType::ColXpr Yi = Y.col(i);
+    Yi.segment(k+1,m).noalias() = matA.block(k+1,c+1,m,remainingSize) * V.col(i).segment(i,remainingSize);
+    if(i>0)
+    {
+      T.col(i).head(i).noalias() = V.block(i,0,remainingSize,i).adjoint() * V.col(i).segment(i,remainingSize);
+      Yi.segment(k+1,m).noalias() -= Y.block(k+1,0,m,i) * T.col(i).head(i);
+      T.col(i).head(i) = T.block(0,0,i,i).template triangularView<Upper>() * T.col(i).head(i);
+      T.col(i).head(i) *= -ei_conj(h);
+    }
+    Yi.segment(k+1,m) *= ei_conj(h);
+    T.coeffRef(i,i) = ei_conj(h);
+  }
+}
+
+/** \internal
+  * Performs a Hessenberg decomposition of \a matA in place.
+  *
+  * \param matA the input matrix
   * \param hCoeffs returned Householder coefficients
   *
-  * The result is written in the lower triangular part of \a matA.
+  * Large matrices are reduced by panels of 32 columns (see ei_hessenberg_panel()), such that
+  * most of the flops of the two-sided update of the remaining columns are performed by the
+  * matrix-matrix product kernel. The last 128 columns, and small matrices, are reduced one
+  * column at a time.
   *
-  * Implemented from Golub's "%Matrix Computations", algorithm 8.3.1.
+  * Implemented from Golub's "%Matrix Computations", algorithm 7.4.2, and from LAPACK's xGEHRD.
   *
   * \sa packedMatrix()
   */
@@ -299,8 +365,38 @@ void HessenbergDecomposition<MatrixType>::_compute(MatrixType& matA, CoeffVector
 {
   assert(matA.rows()==matA.cols());
   Index n = matA.rows();
+  const Index blockSize = 32;
+  const Index blockingThreshold = 128;
   temp.resize(n);
-  for (Index i = 0; i<n-1; ++i)
+
+  Index k = 0;
+  if(n > blockingThreshold)
+  {
+    typedef Matrix<Scalar,Dynamic,Dynamic> WorkspaceType;
+    WorkspaceType V(n, blockSize), Y(n, blockSize), T(blockSize, blockSize), tmp;
+    for (; n-k > blockingThreshold; k += blockSize)
+    {
+      Index bs = blockSize;
+      Index m = n-k-1;
+      ei_hessenberg_panel(matA, hCoeffs, k, bs, V, Y, T);
+      Block<WorkspaceType,Dynamic,Dynamic> Vk(V, 0, 0, m, bs);
+
+      // the top rows of Y = A V T, and the remaining right update of the panel
+      Y.topRows(k+1).noalias() = matA.block(0,k+1,k+1,m) * Vk;
+      Y.topRows(k+1) = Y.topRows(k+1) * T.template triangularView<Upper>();
+      matA.block(0,k+1,k+1,bs-1).noalias() -= Y.topRows(k+1) * Vk.topRows(bs-1).adjoint();
+
+      // A22 = Q^* (A22 - Y V^*) where A22 are the columns on the right of the panel
+      Index tcols = n-k-bs;
+      Block<MatrixType,Dynamic,Dynamic> A2(matA, 0, k+bs, n, tcols);
+      A2.noalias() -= Y.topRows(n) * Vk.bottomRows(tcols).adjoint();
+      tmp.noalias() = Vk.adjoint() * A2.bottomRows(m);
+      tmp = T.template triangularView<Upper>().adjoint() * tmp;
+      A2.bottomRows(m).noalias() -= Vk * tmp;
+    }
+  }
+
+  for (Index i = k; i<n-1; ++i)
   {
     // let's consider the vector v = i-th column starting at position i+1
     Index remainingSize = n-i-1;
@@ -167,10 +167,15 @@ template<typename _MatrixType> class RealSchur
       * The Schur decomposition is computed by first reducing the matrix to
       * Hessenberg form using the class HessenbergDecomposition. The Hessenberg
       * matrix is then reduced to triangular form by performing Francis QR
-      * iterations with implicit double shift. The cost of computing the Schur
-      * decomposition depends on the number of iterations; as a rough guide, it
-      * may be taken to be \f$25n^3\f$ flops if \a computeU is true and
-      * \f$10n^3\f$ flops if \a computeU is false.
+      * iterations with implicit double shift. While the active part of the
+      * matrix is large, aggressive early deflation is performed before each
+      * batch of QR iterations: the Schur form of a trailing window is computed,
+      * the eigenvalues which are decoupled from the rest of the matrix are
+      * deflated at once, and the remaining eigenvalues of the window are used
+      * as shifts. The cost of computing the Schur decomposition depends on the
+      * number of iterations; as a rough guide, it may be taken to be
+      * \f$25n^3\f$ flops if \a computeU is true and \f$10n^3\f$ flops if
+      * \a computeU is false.
       *
       * Example: \include RealSchur_compute.cpp
       * Output: \verbinclude RealSchur_compute.out
@@ -194,6 +199,14 @@ template<typename _MatrixType> class RealSchur
     static const int m_maxIterations = 40;
 
   private:
+
+    enum {
+      /** \internal Minimal size of the active part of the matrix for aggressive early deflation. */
+      AedThreshold = 120,
+      /** \internal If aggressive early deflation deflates more than this percentage of the
+        * window, it is attempted again before performing any QR iteration. */
+      AedNibble = 14
+    };
     
     MatrixType m_matT;
     MatrixType m_matU;
@@ -204,6 +217,7 @@ template<typename _MatrixType> class RealSchur
     bool m_matUisUptodate;
 
     typedef Matrix<Scalar,3,1> Vector3s;
+    typedef Matrix<Scalar,3,Dynamic> ShiftsType;
 
     Scalar computeNormOfT();
     Index findSmallSubdiagEntry(Index iu, Scalar norm);
@@ -211,6 +225,12 @@ template<typename _MatrixType> class RealSchur
     void computeShift(Index iu, Index iter, Scalar& exshift, Vector3s& shiftInfo);
     void initFrancisQRStep(Index il, Index iu, const Vector3s& shiftInfo, Index& im, Vector3s& firstHouseholderVector);
     void performFrancisQRStep(Index il, Index im, Index iu, bool computeU, const Vector3s& firstHouseholderVector, Scalar* workspace);
+    static Index aedWindowSize(Index activeSize)
+    {
+      // as recommended by LAPACK's xIPARMQ for the window of xLAQR0
+      return activeSize < 590 ? std::max<Index>(10, activeSize / 8) : 96;
+    }
+    Index aggressiveEarlyDeflation(Index iu, Index windowSize, bool computeU, Scalar exshift, ShiftsType& shifts, Index& nbShifts);
 };
 
 
@@ -237,6 +257,7 @@ RealSchur<MatrixType>& RealSchur<MatrixType>::compute(const MatrixType& matrix,
   Index iter = 0; // iteration count
   Scalar exshift = 0.0; // sum of exceptional shifts
   Scalar norm = computeNormOfT();
+  ShiftsType shifts;
 
   while (iu >= 0)
   {
@@ -257,6 +278,33 @@ RealSchur<MatrixType>& RealSchur<MatrixType>::compute(const MatrixType& matrix,
       iu -= 2;
       iter = 0;
     }
+    else if (iu-il+1 >= AedThreshold && iter != 10 && iter != 30)
+    {
+      // Aggressive early deflation, followed by a batch of QR iterations using the
+      // undeflated eigenvalues of the window as shifts
+      Index windowSize = aedWindowSize(iu-il+1);
+      Index nbShifts;
+      Index deflated = aggressiveEarlyDeflation(iu, windowSize, computeU, exshift, shifts, nbShifts);
+      if (deflated > 0)
+      {
+        iu -= deflated;
+        iter = 0;
+        if (100*deflated > AedNibble*windowSize)
+          continue;
+      }
+      iter = iter + 1;
+      if (iter > m_maxIterations) break;
+      for (Index j = 0; j < nbShifts; ++j)
+      {
+        il = findSmallSubdiagEntry(iu, norm);
+        if (il >= iu-1)
+          break;
+        Vector3s firstHouseholderVector;
+        Index im;
+        initFrancisQRStep(il, iu, shifts.col(j), im, firstHouseholderVector);
+        performFrancisQRStep(il, im, iu, computeU, firstHouseholderVector, workspace);
+      }
+    }
     else // No convergence yet
     {
       Vector3s firstHouseholderVector, shiftInfo;
@@ -439,11 +487,34 @@ inline void RealSchur<MatrixType>::performFrancisQRStep(Index il, Index im, Inde
       else if (!firstIteration)
         m_matT.coeffRef(k,k-1) = beta;
 
-      // These Householder transformations form the O(n^3) part of the algorithm
-      m_matT.block(k, k, 3, size-k).applyHouseholderOnTheLeft(ess, tau, workspace);
-      m_matT.block(0, k, std::min(iu,k+3) + 1, 3).applyHouseholderOnTheRight(ess, tau, workspace);
+      // These Householder transformations form the O(n^3) part of the algorithm.
+      // They are applied by hand since the generic code is not efficient for such small reflectors.
+      const Scalar v1 = ess.coeff(0), v2 = ess.coeff(1);
+      for (Index j = k; j < size; ++j)
+      {
+        const Scalar t = tau * (m_matT.coeff(k,j) + v1 * m_matT.coeff(k+1,j) + v2 * m_matT.coeff(k+2,j));
+        m_matT.coeffRef(k,j)   -= t;
+        m_matT.coeffRef(k+1,j) -= t * v1;
+        m_matT.coeffRef(k+2,j) -= t * v2;
+      }
+      const Index rowEnd = std::min(iu,k+3) + 1;
+      for (Index i = 0; i < rowEnd; ++i)
+      {
+        const Scalar t = tau * (m_matT.coeff(i,k) + v1 * m_matT.coeff(i,k+1) + v2 * m_matT.coeff(i,k+2));
+        m_matT.coeffRef(i,k)   -= t;
+        m_matT.coeffRef(i,k+1) -= t * v1;
+        m_matT.coeffRef(i,k+2) -= t * v2;
+      }
       if (computeU)
-	m_matU.block(0, k, size, 3).applyHouseholderOnTheRight(ess, tau, workspace);
+      {
+        for (Index i = 0; i < size; ++i)
+        {
+          const Scalar t = tau * (m_matU.coeff(i,k) + v1 * m_matU.coeff(i,k+1) + v2 * m_matU.coeff(i,k+2));
+          m_matU.coeffRef(i,k)   -= t;
+          m_matU.coeffRef(i,k+1) -= t * v1;
+          m_matU.coeffRef(i,k+2) -= t * v2;
+        }
+      }
     }
   }
 
@@ -470,4 +541,116 @@ inline void RealSchur<MatrixType>::performFrancisQRStep(Index il, Index im, Inde
   }
 }
 
+/** \internal Performs aggressive early deflation on the window of size \a windowSize at the bottom
+  * of the active part of T ending at row \a iu, and returns the number of deflated rows.
+  *
+  * The window is reduced to real Schur form, and the trailing eigenvalues whose coupling with the
+  * rest of the matrix (the spike) is negligible are deflated. The remaining part of the window is
+  * then brought back to Hessenberg form. The undeflated eigenvalues of the window are returned as
+  * \a nbShifts pairs of shifts (in the format of computeShift()) in the columns of \a shifts. */
+template<typename MatrixType>
+typename MatrixType::Index RealSchur<MatrixType>::aggressiveEarlyDeflation(Index iu, Index windowSize, bool computeU, Scalar exshift, ShiftsType& shifts, Index& nbShifts)
+{
+  typedef Matrix<Scalar,Dynamic,Dynamic> WindowMatrixType;
+  typedef Matrix<Scalar,Dynamic,1> WindowVectorType;
+  const Index size = m_matT.cols();
+  const Index nw = windowSize;
+  const Index kwtop = iu - nw + 1;
+  const Scalar spikeBase = m_matT.coeff(kwtop, kwtop-1);
+  nbShifts = 0;
+
+  RealSchur<WindowMatrixType> windowSchur(m_matT.block(kwtop, kwtop, nw, nw));
+  if (windowSchur.info() != Success)
+    return 0;
+  WindowMatrixType S = windowSchur.matrixT();
+  WindowMatrixType Z = windowSchur.matrixU();
+  WindowVectorType spike = spikeBase * Z.row(0).transpose();
+
+  // Look for negligible components of the spike, starting from the bottom of the window
+  const Scalar eps = NumTraits<Scalar>::epsilon();
+  const Scalar smallNum = std::numeric_limits<Scalar>::min() * (Scalar(size) / eps);
+  Index ns = nw;
+  while (ns > 0)
+  {
+    bool twoByTwo = ns > 1 && S.coeff(ns-1, ns-2) != Scalar(0);
+    Scalar foo = ei_abs(S.coeff(ns-1, ns-1));
+    Scalar spikeValue = ei_abs(spike.coeff(ns-1));
+    if (twoByTwo)
+    {
+      foo += ei_sqrt(ei_abs(S.coeff(ns-1, ns-2))) * ei_sqrt(ei_abs(S.coeff(ns-2, ns-1)));
+      spikeValue = std::max(spikeValue, ei_abs(spike.coeff(ns-2)));
+    }
+    if (foo == Scalar(0))
+      foo = ei_abs(spikeBase);
+    if (spikeValue > std::max(smallNum, eps * foo))
+      break;
+    ns -= twoByTwo ? 2 : 1;
+  }
+
+  // The undeflated eigenvalues are used as shifts, starting from the bottom
+  shifts.resize(3, ns);
+  Index i = ns-1;
+  while (i >= 0)
+  {
+    if (i > 0 && S.coeff(i, i-1) != Scalar(0))
+    {
+      // complex conjugate pair
+      shifts.col(nbShifts) << S.coeff(i,i), S.coeff(i-1,i-1), S.coeff(i,i-1) * S.coeff(i-1,i);
+      i -= 2;
+    }
+    else if (i > 0 && (i == 1 || S.coeff(i-1, i-2) == Scalar(0)))
+    {
+      // two real eigenvalues
+      shifts.col(nbShifts) << S.coeff(i,i), S.coeff(i-1,i-1), Scalar(0);
+      i -= 2;
+    }
+    else
+    {
+      shifts.col(nbShifts) << S.coeff(i,i), S.coeff(i,i), Scalar(0);
+      i -= 1;
+    }
+    ++nbShifts;
+  }
+
+  const Index nd = nw - ns;
+  if (nd == 0)
+    return 0;
+
+  // Bring the undeflated part of the window back to Hessenberg form
+  spike.tail(nd).setZero();
+  if (ns > 1)
+  {
+    WindowVectorType ess(ns-1), workspace(nw);
+    Scalar tau, beta;
+    spike.head(ns).makeHouseholder(ess, tau, beta);
+    S.topRows(ns).applyHouseholderOnTheLeft(ess, tau, workspace.data());
+    S.topLeftCorner(ns, ns).applyHouseholderOnTheRight(ess, tau, workspace.data());
+    Z.leftCols(ns).applyHouseholderOnTheRight(ess, tau, workspace.data());
+    spike.head(ns).setZero();
+    spike.coeffRef(0) = beta;
+
+    HessenbergDecomposition<WindowMatrixType> hess(S.topLeftCorner(ns, ns));
+    WindowMatrixType Q = hess.matrixQ();
+    S.topLeftCorner(ns, ns) = hess.matrixH();
+    S.topRightCorner(ns, nd) = Q.transpose() * S.topRightCorner(ns, nd);
+    Z.leftCols(ns) = Z.leftCols(ns) * Q;
+  }
+
+  // Apply the orthogonal transformation of the window to the rest of the matrix
+  m_matT.block(kwtop, kwtop, nw, nw) = S;
+  m_matT.col(kwtop-1).segment(kwtop, nw) = spike;
+  if (kwtop > 0)
+    m_matT.block(0, kwtop, kwtop, nw) = m_matT.block(0, kwtop, kwtop, nw) * Z;
+  if (iu+1 < size)
+    m_matT.block(kwtop, iu+1, nw, size-iu-1) = Z.transpose() * m_matT.block(kwtop, iu+1, nw, size-iu-1);
+  if (computeU)
+    m_matU.middleCols(kwtop, nw) = m_matU.middleCols(kwtop, nw) * Z;
+
+  for (Index k = kwtop+ns; k <= iu; ++k)
+    m_matT.coeffRef(k,k) += exshift;
+  if (ns > 0)
+    m_matT.coeffRef(kwtop+ns, kwtop+ns-1) = Scalar(0);
+  return nd;
+}
+
 #endif // EIGEN_REAL_SCHUR_H
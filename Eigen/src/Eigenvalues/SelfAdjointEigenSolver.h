@@ -171,7 +171,8 @@ template<typename _MatrixType> class SelfAdjointEigenSolver
       *
       * \param[in]  matrix  Selfadjoint matrix whose eigendecomposition is to
       *    be computed. Only the lower triangular part of the matrix is referenced.
-      * \param[in]  options Can be ComputeEigenvectors (default) or EigenvaluesOnly.
+      * \param[in]  options Can be ComputeEigenvectors (default) or EigenvaluesOnly,
+      *    optionally or-ed with DivideAndConquer.
       * \returns    Reference to \c *this
       *
       * This function computes the eigenvalues of \p matrix.  The eigenvalues()
@@ -188,6 +189,13 @@ template<typename _MatrixType> class SelfAdjointEigenSolver
       * The cost of the computation is about \f$ 9n^3 \f$ if the eigenvectors
       * are required and \f$ 4n^3/3 \f$ if they are not required.
       *
+      * If \p options contains DivideAndConquer (e.g., ComputeEigenvectors|DivideAndConquer), the
+      * tridiagonal matrix is diagonalized with Cuppen's divide-and-conquer algorithm instead: it is
+      * recursively split into halves whose eigendecompositions are merged by solving secular equations,
+      * and most of the work is done by matrix-matrix products. This is much faster for large matrices,
+      * and the independent sub-problems are solved in parallel when Eigen has several threads
+      * (see setThreadPool()). This option has no effect if the eigenvectors are not requested.
+      *
       * This method reuses the memory in the SelfAdjointEigenSolver object that
       * was allocated when the object was constructed, if the size of the
       * matrix does not change.
@@ -338,12 +346,26 @@ template<typename _MatrixType> class SelfAdjointEigenSolver
 template<typename RealScalar, typename Scalar, typename Index>
 static void ei_tridiagonal_qr_step(RealScalar* diag, RealScalar* subdiag, Index start, Index end, Scalar* matrixQ, Index n);
 
+/** \internal
+  *
+  * Diagonalizes the n x n tridiagonal symmetric matrix represented by \a diag and \a subdiag
+  * with implicit symmetric QR steps. The (unsorted) eigenvalues are returned in \a diag, and the
+  * rotations are applied on the right of the n x n column-major matrix \a matrixQ, if not null.
+  */
+template<typename RealScalar, typename Scalar, typename Index>
+static ComputationInfo ei_tridiagonal_qr(RealScalar* diag, RealScalar* subdiag, Index n, Scalar* matrixQ, int maxIterations);
+
+// forward declaration, implementation in TridiagonalDivideAndConquer.h
+template<typename RealScalar, typename Index>
+ComputationInfo ei_tridiagonal_divide_and_conquer(RealScalar* diag, RealScalar* subdiag, Index n,
+                                                  Matrix<RealScalar,Dynamic,Dynamic>& eivec, int maxIterations);
+
 template<typename MatrixType>
 SelfAdjointEigenSolver<MatrixType>& SelfAdjointEigenSolver<MatrixType>
 ::compute(const MatrixType& matrix, int options)
 {
   ei_assert(matrix.cols() == matrix.rows());
-  ei_assert((options&~(EigVecMask|GenEigMask))==0
+  ei_assert((options&~(EigVecMask|GenEigMask|DivideAndConquer))==0
           && (options&EigVecMask)!=EigVecMask
           && "invalid option parameter");
   bool computeEigenvectors = (options&ComputeEigenvectors)==ComputeEigenvectors;
@@ -369,40 +391,16 @@ SelfAdjointEigenSolver<MatrixType>& SelfAdjointEigenSolver<MatrixType>
   m_subdiag.resize(n-1);
   ei_tridiagonalization_inplace(mat, diag, m_subdiag, computeEigenvectors);
 
-  Index end = n-1;
-  Index start = 0;
-  Index iter = 0; // number of iterations we are working on one element
-
-  while (end>0)
+  if(computeEigenvectors && (options&DivideAndConquer)==DivideAndConquer)
   {
-    for (Index i = start; i<end; ++i)
-      if (ei_isMuchSmallerThan(ei_abs(m_subdiag[i]),(ei_abs(diag[i])+ei_abs(diag[i+1]))))
-        m_subdiag[i] = 0;
-
-    // find the largest unreduced block
-    while (end>0 && m_subdiag[end-1]==0)
-    {
-      iter = 0;
-      end--;
-    }
-    if (end<=0)
-      break;
-
-    // if we spent too many iterations on the current element, we give up
-    iter++;
-    if(iter > m_maxIterations) break;
-
-    start = end - 1;
-    while (start>0 && m_subdiag[start-1]!=0)
-      start--;
-
-    ei_tridiagonal_qr_step(diag.data(), m_subdiag.data(), start, end, computeEigenvectors ? m_eivec.data() : (Scalar*)0, n);
+    // the eigenvectors of the tridiagonal matrix are computed apart, and then applied to Q
+    Matrix<RealScalar,Dynamic,Dynamic> tridiagEivec(n,n);
+    m_info = ei_tridiagonal_divide_and_conquer(diag.data(), m_subdiag.data(), n, tridiagEivec, m_maxIterations);
+    if(m_info == Success)
+      m_eivec = m_eivec * tridiagEivec.template cast<Scalar>();
   }
-
-  if (iter <= m_maxIterations)
-    m_info = Success;
   else
-    m_info = NoConvergence;
+    m_info = ei_tridiagonal_qr(diag.data(), m_subdiag.data(), n, computeEigenvectors ? m_eivec.data() : (Scalar*)0, m_maxIterations);
 
   // Sort eigenvalues and corresponding vectors.
   // TODO make the sort optional ?
@@ -427,6 +425,42 @@ SelfAdjointEigenSolver<MatrixType>& SelfAdjointEigenSolver<MatrixType>
   return *this;
 }
 
+template<typename RealScalar, typename Scalar, typename Index>
+static ComputationInfo ei_tridiagonal_qr(RealScalar* diag, RealScalar* subdiag, Index n, Scalar* matrixQ, int maxIterations)
+{
+  Index end = n-1;
+  Index start = 0;
+  Index iter = 0; // number of iterations we are working on one element
+
+  while (end>0)
+  {
+    for (Index i = start; i<end; ++i)
+      if (ei_isMuchSmallerThan(ei_abs(subdiag[i]),(ei_abs(diag[i])+ei_abs(diag[i+1]))))
+        subdiag[i] = 0;
+
+    // find the largest unreduced block
+    while (end>0 && subdiag[end-1]==0)
+    {
+      iter = 0;
+      end--;
+    }
+    if (end<=0)
+      break;
+
+    // if we spent too many iterations on the current element, we give up
+    iter++;
+    if(iter > maxIterations) break;
+
+    start = end - 1;
+    while (start>0 && subdiag[start-1]!=0)
+      start--;
+
+    ei_tridiagonal_qr_step(diag, subdiag, start, end, matrixQ, n);
+  }
+
+  return iter <= maxIterations ? Success : NoConvergence;
+}
+
 template<typename RealScalar, typename Scalar, typename Index>
 static void ei_tridiagonal_qr_step(RealScalar* diag, RealScalar* subdiag, Index start, Index end, Scalar* matrixQ, Index n)
 {
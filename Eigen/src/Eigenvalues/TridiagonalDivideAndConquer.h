@@ -0,0 +1,438 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Copyright (C) 2010 Gael Guennebaud <gael.guennebaud@inria.fr>
+//
+// Eigen is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// Alternatively, you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation; either version 2 of
+// the License, or (at your option) any later version.
+//
+// Eigen is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License or the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License and a copy of the GNU General Public License along with
+// Eigen. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef EIGEN_TRIDIAGONAL_DIVIDE_AND_CONQUER_H
+#define EIGEN_TRIDIAGONAL_DIVIDE_AND_CONQUER_H
+
+/* Cuppen's divide-and-conquer algorithm for the symmetric tridiagonal eigenproblem
+ *
+ * The tridiagonal matrix T is torn in two halves by a rank-one modification:
+ *   T = diag(T1, T2) + rho u u^T,  with u = e_{k-1} + e_k and rho = T(k,k-1),
+ * the eigendecompositions Q1 D1 Q1^T and Q2 D2 Q2^T of the halves are computed recursively, and
+ * the eigenvalues of T are those of the rank-one update D + rho z z^T, with D = diag(D1,D2) and
+ * z = diag(Q1,Q2)^T u. They are the roots of the secular equation
+ *   1/rho + sum_i z_i^2 / (d_i - lambda) = 0,
+ * and the eigenvectors of T are obtained by a matrix-matrix product with those of D + rho z z^T.
+ * Small sub-problems are solved by the QR algorithm.
+ *
+ * The implementation follows LAPACK's xSTEDC/xLAED*: the components of z which are too small and
+ * the nearly equal eigenvalues are deflated, the roots are computed relative to their closest pole,
+ * and the eigenvectors are computed from the Gu-Eisenstat (Lowner) vector so that they remain
+ * orthogonal.
+ */
+
+/** \internal
+  * Computes the \a j-th smallest eigenvalue of \f$ D + \rho z z^T \f$, where \f$ D = diag(d) \f$ is
+  * strictly increasing, \f$ \rho > 0 \f$, and \a z is a unit vector without zero component.
+  *
+  * The root of the secular equation is computed relative to its closest pole, with a rational
+  * approximation of the secular function by two poles safeguarded by bisection. On output,
+  * \a delta[i] contains \f$ d_i - \lambda_j \f$ computed without cancellation.
+  */
+template<typename RealScalar, typename Index>
+RealScalar ei_secular_equation_root(const RealScalar* d, const RealScalar* z, Index k, RealScalar rho,
+                                    Index j, RealScalar* delta)
+{
+  const RealScalar invRho = RealScalar(1)/rho;
+
+  // choose the origin among the two poles around the root, and bracket the root in shifted coordinates
+  Index origin;
+  RealScalar lo, hi;
+  if(j<k-1)
+  {
+    RealScalar gap = d[j+1]-d[j];
+    RealScalar mid = gap/RealScalar(2);
+    RealScalar w = invRho;
+    for(Index i=0; i<k; ++i)
+      w += z[i]*z[i] / ((d[i]-d[j]) - mid);
+    if(w>=0)
+    {
+      origin = j;
+      lo = 0;
+      hi = mid;
+    }
+    else
+    {
+      origin = j+1;
+      lo = -mid;
+      hi = 0;
+    }
+  }
+  else
+  {
+    origin = j;
+    lo = 0;
+    hi = rho;
+  }
+  for(Index i=0; i<k; ++i)
+    delta[i] = d[i] - d[origin];
+
+  RealScalar tau = ei_secular_equation_iterate(delta, z, k, invRho, j, lo, hi);
+  for(Index i=0; i<k; ++i)
+    delta[i] -= tau;
+  return d[origin] + tau;
+}
+
+/** \internal
+  * Recursive divide-and-conquer solver working on the diagonal blocks of a single eigenvector matrix.
+  * The sub-problems of a same level write disjoint blocks and can be solved concurrently.
+  */
+template<typename RealScalar, typename Index>
+struct ei_tridiagonal_dc
+{
+  typedef Matrix<RealScalar,Dynamic,Dynamic> MatrixType;
+  typedef Matrix<RealScalar,Dynamic,1> VectorType;
+  typedef Matrix<Index,Dynamic,1> IndexVectorType;
+
+  /** Size below which the sub-problems are solved by the QR algorithm */
+  enum { LeafSize = 32 };
+
+  ei_tridiagonal_dc(RealScalar* diag, RealScalar* subdiag, MatrixType& eivec, int maxIterations)
+    : m_diag(diag), m_subdiag(subdiag), m_eivec(eivec), m_maxIterations(maxIterations)
+  {}
+
+  /** Replaces T by diag(T1, T2) at position \a k of the sub-problem, \returns the split point */
+  Index tear(Index start, Index size)
+  {
+    Index k = size/2;
+    RealScalar rho = m_subdiag[start+k-1];
+    m_diag[start+k-1] -= rho;
+    m_diag[start+k] -= rho;
+    return k;
+  }
+
+  bool solve(Index start, Index size)
+  {
+    if(size<=Index(LeafSize))
+    {
+      MatrixType q = MatrixType::Identity(size,size);
+      ComputationInfo info = ei_tridiagonal_qr(m_diag+start, m_subdiag+start, size, q.data(), m_maxIterations);
+      m_eivec.block(start,start,size,size) = q;
+      return info==Success;
+    }
+    Index k = tear(start,size);
+    bool ok = solve(start,k);
+    ok = solve(start+k,size-k) && ok;
+    if(ok)
+      merge(start,k,size);
+    return ok;
+  }
+
+  /** Tears the sub-problem down to \a parts independent ones, whose positions are appended to \a starts and \a sizes */
+  void tearParts(Index start, Index size, int parts, Index* starts, Index* sizes, int& count)
+  {
+    if(parts==1)
+    {
+      starts[count] = start;
+      sizes[count] = size;
+      ++count;
+      return;
+    }
+    Index k = tear(start,size);
+    tearParts(start, k, parts/2, starts, sizes, count);
+    tearParts(start+k, size-k, parts/2, starts, sizes, count);
+  }
+
+  /** Merges back the sub-problems created by tearParts() once they are solved */
+  void mergeParts(Index start, Index size, int parts)
+  {
+    if(parts==1)
+      return;
+    Index k = size/2;
+    mergeParts(start, k, parts/2);
+    mergeParts(start+k, size-k, parts/2);
+    merge(start, k, size);
+  }
+
+  void merge(Index start, Index k, Index size);
+
+  RealScalar* m_diag;
+  RealScalar* m_subdiag;
+  MatrixType& m_eivec;
+  int m_maxIterations;
+};
+
+template<typename RealScalar, typename Index>
+void ei_tridiagonal_dc<RealScalar,Index>::merge(Index start, Index k, Index size)
+{
+  const RealScalar eps = NumTraits<RealScalar>::epsilon();
+  Block<MatrixType> Q(m_eivec, start, start, size, size);
+  RealScalar* d = m_diag + start;
+
+  // rank-one update D + rho z z^T, with z = diag(Q1,Q2)^T u normalized
+  RealScalar rho = RealScalar(2) * m_subdiag[start+k-1];
+  VectorType z(size);
+  z.head(k) = Q.row(k-1).head(k).transpose();
+  z.tail(size-k) = Q.row(k).tail(size-k).transpose();
+  z *= RealScalar(1)/ei_sqrt(RealScalar(2));
+
+  // a negative rho is handled by negating D
+  bool flip = rho<0;
+  if(flip)
+  {
+    rho = -rho;
+    for(Index i=0; i<size; ++i)
+      d[i] = -d[i];
+  }
+
+  // sort the eigenvalues of the two halves
+  IndexVectorType perm(size);
+  for(Index i=0; i<size; ++i)
+    perm[i] = i;
+  std::sort(perm.data(), perm.data()+size, ei_index_less<RealScalar,Index>(d));
+  MatrixType sortedQ(size,size);
+  VectorType dd(size), zz(size);
+  for(Index i=0; i<size; ++i)
+  {
+    sortedQ.col(i) = Q.col(perm[i]);
+    dd[i] = d[perm[i]];
+    zz[i] = z[perm[i]];
+  }
+
+  // Deflation: the negligible components of z, and the close eigenvalues after a rotation zeroing
+  // one of the two corresponding components of z.
+  // The columns of Q coming from the first half have zeros in the last size-k rows, and conversely
+  // (type 1 and 3 respectively), unless they have been mixed by a rotation (type 2).
+  RealScalar tol = RealScalar(8)*eps*std::max(dd.cwiseAbs().maxCoeff(), rho);
+  IndexVectorType deflated = IndexVectorType::Zero(size);
+  IndexVectorType type(size);
+  for(Index i=0; i<size; ++i)
+    type[i] = perm[i]<k ? 1 : 3;
+  Index prev = -1;
+  for(Index i=0; i<size; ++i)
+  {
+    if(rho*ei_abs(zz[i]) <= tol)
+    {
+      deflated[i] = 1;
+      continue;
+    }
+    if(prev>=0)
+    {
+      RealScalar t = ei_sqrt(zz[prev]*zz[prev] + zz[i]*zz[i]);
+      RealScalar c = zz[i]/t;
+      RealScalar s = -zz[prev]/t;
+      if(ei_abs((dd[i]-dd[prev])*c*s) <= tol)
+      {
+        zz[i] = t;
+        zz[prev] = 0;
+        RealScalar dprev = c*c*dd[prev] + s*s*dd[i];
+        dd[i] = s*s*dd[prev] + c*c*dd[i];
+        dd[prev] = dprev;
+        VectorType qprev = c*sortedQ.col(prev) + s*sortedQ.col(i);
+        sortedQ.col(i) = c*sortedQ.col(i) - s*sortedQ.col(prev);
+        sortedQ.col(prev) = qprev;
+        if(type[i]!=type[prev])
+          type[i] = type[prev] = 2;
+        deflated[prev] = 1;
+      }
+    }
+    prev = i;
+  }
+
+  Index K = size - deflated.sum();
+  MatrixType vecs(size,size);
+  VectorType values(size);
+
+  if(K>0)
+  {
+    // gather the non deflated columns by type
+    VectorType dk(K), zk(K);
+    IndexVectorType pos(K);
+    Index typeCount[3] = {0, 0, 0};
+    for(Index i=0, j=0; i<size; ++i)
+      if(!deflated[i])
+      {
+        dk[j] = dd[i];
+        zk[j] = zz[i];
+        ++typeCount[type[i]-1];
+        ++j;
+      }
+    Index typeStart[3] = {0, typeCount[0], typeCount[0]+typeCount[1]};
+    MatrixType Qk(size,K);
+    for(Index i=0, j=0; i<size; ++i)
+      if(!deflated[i])
+      {
+        pos[j] = typeStart[type[i]-1]++;
+        Qk.col(pos[j]) = sortedQ.col(i);
+        ++j;
+      }
+    RealScalar znorm = zk.norm();
+    zk /= znorm;
+    RealScalar rhok = rho*znorm*znorm;
+
+    // solve the secular equation, delta(i,j) = dk[i] - lambda_j
+    MatrixType delta(K,K);
+    for(Index j=0; j<K; ++j)
+      values[j] = ei_secular_equation_root(dk.data(), zk.data(), K, rhok, j, &delta.coeffRef(0,j));
+
+    // recompute z from the computed eigenvalues (Lowner's formula) such that they are the exact
+    // eigenvalues of a nearby problem, then the eigenvectors (up to a scaling factor)
+    VectorType w = delta.diagonal();
+    for(Index j=0; j<K; ++j)
+      for(Index i=0; i<K; ++i)
+        if(i!=j)
+          w[i] *= delta(i,j) / (dk[i]-dk[j]);
+    for(Index i=0; i<K; ++i)
+      zk[i] = zk[i]<0 ? -ei_sqrt(ei_abs(w[i])) : ei_sqrt(ei_abs(w[i]));
+    MatrixType V(K,K);
+    for(Index j=0; j<K; ++j)
+    {
+      VectorType v = zk.cwiseQuotient(delta.col(j));
+      v.normalize();
+      for(Index i=0; i<K; ++i)
+        V(pos[i],j) = v[i];
+    }
+
+    // the eigenvectors are Qk V, where the zero blocks of Qk are skipped
+    Index topCols = typeCount[0]+typeCount[1];
+    Index bottomCols = typeCount[1]+typeCount[2];
+    if(topCols>0)
+      vecs.topLeftCorner(k,K).noalias() = Qk.topLeftCorner(k,topCols) * V.topRows(topCols);
+    else
+      vecs.topLeftCorner(k,K).setZero();
+    if(bottomCols>0)
+      vecs.bottomLeftCorner(size-k,K).noalias() = Qk.bottomRightCorner(size-k,bottomCols) * V.bottomRows(bottomCols);
+    else
+      vecs.bottomLeftCorner(size-k,K).setZero();
+  }
+
+  for(Index i=0, j=K; i<size; ++i)
+    if(deflated[i])
+    {
+      values[j] = dd[i];
+      vecs.col(j) = sortedQ.col(i);
+      ++j;
+    }
+
+  if(flip)
+    values = -values;
+
+  // store the sorted eigenvalues and eigenvectors
+  for(Index i=0; i<size; ++i)
+    perm[i] = i;
+  std::sort(perm.data(), perm.data()+size, ei_index_less<RealScalar,Index>(values.data()));
+  for(Index i=0; i<size; ++i)
+  {
+    d[i] = values[perm[i]];
+    Q.col(i) = vecs.col(perm[i]);
+  }
+}
+
+/** \internal Solves in parallel the sub-problems of the first levels of the recursion */
+template<typename RealScalar, typename Index>
+class ei_tridiagonal_dc_task
+{
+  public:
+    ei_tridiagonal_dc_task(ei_tridiagonal_dc<RealScalar,Index>& dc, const Index* starts, const Index* sizes, bool* ok)
+      : m_dc(dc), m_starts(starts), m_sizes(sizes), m_ok(ok)
+    {}
+
+    void operator()(int id) const
+    {
+      m_ok[id] = m_dc.solve(m_starts[id], m_sizes[id]);
+    }
+
+  protected:
+    ei_tridiagonal_dc<RealScalar,Index>& m_dc;
+    const Index* m_starts;
+    const Index* m_sizes;
+    bool* m_ok;
+};
+
+/** \internal
+  *
+  * \eigenvalues_module \ingroup Eigenvalues_Module
+  *
+  * Computes the eigenvalues and eigenvectors of the n x n tridiagonal symmetric matrix represented
+  * by \a diag and \a subdiag with the divide-and-conquer algorithm.
+  *
+  * On output, \a diag contains the eigenvalues in increasing order, the columns of \a eivec the
+  * corresponding eigenvectors, and \a subdiag is destroyed.
+  *
+  * When Eigen is allowed to use several threads, the sub-problems of the first levels of the recursion
+  * are solved concurrently, using the ThreadPool if any, or OpenMP. The merges of the last levels are
+  * then parallelized by the matrix-matrix products.
+  */
+template<typename RealScalar, typename Index>
+ComputationInfo ei_tridiagonal_divide_and_conquer(RealScalar* diag, RealScalar* subdiag, Index n,
+                                                  Matrix<RealScalar,Dynamic,Dynamic>& eivec, int maxIterations)
+{
+  eivec.setZero(n,n);
+
+  // scale the matrix to avoid overflows in the secular equations
+  RealScalar scale = 0;
+  for(Index i=0; i<n; ++i)
+    scale = std::max(scale, ei_abs(diag[i]));
+  for(Index i=0; i<n-1; ++i)
+    scale = std::max(scale, ei_abs(subdiag[i]));
+  if(scale==RealScalar(0))
+  {
+    eivec.setIdentity();
+    return Success;
+  }
+  for(Index i=0; i<n; ++i)
+    diag[i] /= scale;
+  for(Index i=0; i<n-1; ++i)
+    subdiag[i] /= scale;
+
+  typedef ei_tridiagonal_dc<RealScalar,Index> DC;
+  DC dc(diag, subdiag, eivec, maxIterations);
+  bool ok = true;
+
+  int parts = 1;
+  const int threads = ei_parallel_threads();
+  while(parts*2<=threads && n/(parts*2)>Index(DC::LeafSize))
+    parts *= 2;
+
+  if(parts==1)
+    ok = dc.solve(0,n);
+  else
+  {
+    // tear the matrix into 'parts' independent sub-problems as the recursion would do,
+    // solve them concurrently, and merge them back
+    Index* starts = ei_aligned_stack_new(Index, parts);
+    Index* sizes = ei_aligned_stack_new(Index, parts);
+    bool* partOk = ei_aligned_stack_new(bool, parts);
+    int count = 0;
+    dc.tearParts(0, n, parts, starts, sizes, count);
+
+    ei_parallel_for(0, parts, ei_tridiagonal_dc_task<RealScalar,Index>(dc, starts, sizes, partOk));
+    for(int p=0; p<parts; ++p)
+      ok = ok && partOk[p];
+
+    ei_aligned_stack_delete(bool, partOk, parts);
+    ei_aligned_stack_delete(Index, sizes, parts);
+    ei_aligned_stack_delete(Index, starts, parts);
+
+    if(ok)
+      dc.mergeParts(0, n, parts);
+  }
+
+  for(Index i=0; i<n; ++i)
+    diag[i] *= scale;
+
+  return ok ? Success : NoConvergence;
+}
+
+#endif // EIGEN_TRIDIAGONAL_DIVIDE_AND_CONQUER_H
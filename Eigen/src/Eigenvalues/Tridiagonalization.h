@@ -327,6 +327,103 @@ Tridiagonalization<MatrixType>::matrixT() const
   return matT;
 }
 
+/** \internal
+  * Unblocked tridiagonalization of the selfadjoint matrix \a matA in-place.
+  * Same interface and output as ei_tridiagonalization_inplace(MatrixType&, CoeffVectorType&),
+  * which calls it for small matrices and for the last columns of large ones.
+  *
+  * Implemented from Golub's "Matrix Computations", algorithm 8.3.1.
+  */
+template<typename MatrixType, typename CoeffVectorType>
+void ei_tridiagonalization_inplace_unblocked(MatrixType& matA, CoeffVectorType& hCoeffs)
+{
+  ei_assert(matA.rows()==matA.cols());
+  ei_assert(matA.rows()==hCoeffs.size()+1);
+  typedef typename MatrixType::Index Index;
+  typedef typename MatrixType::Scalar Scalar;
+  typedef typename MatrixType::RealScalar RealScalar;
+  Index n = matA.rows();
+  for (Index i = 0; i<n-1; ++i)
+  {
+    Index remainingSize = n-i-1;
+    RealScalar beta;
+    Scalar h;
+    matA.col(i).tail(remainingSize).makeHouseholderInPlace(h, beta);
+
+    // Apply similarity transformation to remaining columns,
+    // i.e., A = H A H' where H = I - h v v' and v = matA.col(i).tail(n-i-1)
+    matA.col(i).coeffRef(i+1) = 1;
+
+    hCoeffs.tail(n-i-1).noalias() = (matA.bottomRightCorner(remainingSize,remainingSize).template selfadjointView<Lower>()
+                                  * (ei_conj(h) * matA.col(i).tail(remainingSize)));
+
+    hCoeffs.tail(n-i-1) += (ei_conj(h)*Scalar(-0.5)*(hCoeffs.tail(remainingSize).dot(matA.col(i).tail(remainingSize)))) * matA.col(i).tail(n-i-1);
+
+    matA.bottomRightCorner(remainingSize, remainingSize).template selfadjointView<Lower>()
+      .rankUpdate(matA.col(i).tail(remainingSize), hCoeffs.tail(remainingSize), -1);
+
+    matA.col(i).coeffRef(i+1) = beta;
+    hCoeffs.coeffRef(i) = h;
+  }
+}
+
+/** \internal
+  * Reduces the \a bs columns of \a matA starting at column \a k, without updating the
+  * trailing part of the matrix (LAPACK's xLATRD).
+  *
+  * The remaining matrix is kept unchanged, and the reflectors computed so far are applied lazily
+  * to each column of the panel before it is reduced. On output, the Householder vectors \f$ V \f$
+  * are stored in the columns of the panel (with their leading 1 explicitly stored on the
+  * subdiagonal, the true subdiagonal coefficients being returned in \a betas), and the rows
+  * \a k+1 to \a n-1 of the matrix \a W are such that the trailing matrix has to be updated as
+  * \f$ A_{22} - V W^* - W V^* \f$.
+  */
+template<typename MatrixType, typename CoeffVectorType, typename WorkspaceType, typename BetaVectorType>
+void ei_tridiagonalization_panel(MatrixType& matA, CoeffVectorType& hCoeffs,
+                                 typename MatrixType::Index k, typename MatrixType::Index bs,
+                                 WorkspaceType& W, BetaVectorType& betas)
+{
+  typedef typename MatrixType::Index Index;
+  typedef typename MatrixType::Scalar Scalar;
+  typedef typename MatrixType::RealScalar RealScalar;
+  Index n = matA.rows();
+
+  for (Index i = 0; i<bs; ++i)
+  {
+    Index c = k+i;
+    Index remainingSize = n-c-1;
+
+    // apply the previous reflectors of the panel to the current column
+    if(i>0)
+    {
+      matA.col(c).tail(remainingSize+1).noalias() -= matA.block(c,k,remainingSize+1,i) * W.block(c,0,1,i).adjoint();
+      matA.col(c).tail(remainingSize+1).noalias() -= W.block(c,0,remainingSize+1,i) * matA.block(c,k,1,i).adjoint();
+    }
+
+    RealScalar beta;
+    Scalar h;
+    matA.col(c).tail(remainingSize).makeHouseholderInPlace(h, beta);
+    matA.col(c).coeffRef(c+1) = 1;
+    betas.coeffRef(i) = beta;
+    hCoeffs.coeffRef(c) = h;
+
+    // w = conj(h) (A - V W^* - W V^*) v, where A is the not yet updated trailing matrix.
+    // The first i coefficients of the column of W are used as a temporary.
+    typename WorkspaceType::ColXpr Wi = W.col(i);
+    Wi.tail(remainingSize).noalias() = matA.bottomRightCorner(remainingSize,remainingSize).template selfadjointView<Lower>()
+                               * matA.col(c).tail(remainingSize);
+    if(i>0)
+    {
+      Wi.head(i).noalias() = W.block(c+1,0,remainingSize,i).adjoint() * matA.col(c).tail(remainingSize);
+      Wi.tail(remainingSize).noalias() -= matA.block(c+1,k,remainingSize,i) * Wi.head(i);
+      Wi.head(i).noalias() = matA.block(c+1,k,remainingSize,i).adjoint() * matA.col(c).tail(remainingSize);
+      Wi.tail(remainingSize).noalias() -= W.block(c+1,0,remainingSize,i) * Wi.head(i);
+    }
+    Wi.tail(remainingSize) *= ei_conj(h);
+    Wi.tail(remainingSize) += (ei_conj(h)*Scalar(-0.5)*(Wi.tail(remainingSize).dot(matA.col(c).tail(remainingSize)))) * matA.col(c).tail(remainingSize);
+  }
+}
+
 /** \internal
   * Performs a tridiagonal decomposition of the selfadjoint matrix \a matA in-place.
   *
@@ -346,7 +443,12 @@ Tridiagonalization<MatrixType>::matrixT() const
   * \f$ v_i \f$ is the Householder vector defined by
   *       \f$ v_i = [ 0, \ldots, 0, 1, matA(i+2,i), \ldots, matA(N-1,i) ]^T \f$.
   *
-  * Implemented from Golub's "Matrix Computations", algorithm 8.3.1.
+  * Large matrices are reduced by panels of 32 columns (see ei_tridiagonalization_panel()):
+  * half of the flops are then performed by the rank-2k update of the trailing matrix, which
+  * goes through the matrix-matrix product kernel. The last 128 columns, and small
+  * matrices, are reduced by the unblocked algorithm.
+  *
+  * Implemented from Golub's "Matrix Computations", algorithm 8.3.1, and from LAPACK's xSYTRD.
   *
   * \sa Tridiagonalization::packedMatrix()
   */
@@ -359,28 +461,52 @@ void ei_tridiagonalization_inplace(MatrixType& matA, CoeffVectorType& hCoeffs)
   typedef typename MatrixType::Scalar Scalar;
   typedef typename MatrixType::RealScalar RealScalar;
   Index n = matA.rows();
-  for (Index i = 0; i<n-1; ++i)
-  {
-    Index remainingSize = n-i-1;
-    RealScalar beta;
-    Scalar h;
-    matA.col(i).tail(remainingSize).makeHouseholderInPlace(h, beta);
-
-    // Apply similarity transformation to remaining columns,
-    // i.e., A = H A H' where H = I - h v v' and v = matA.col(i).tail(n-i-1)
-    matA.col(i).coeffRef(i+1) = 1;
+  const Index blockSize = 32;
+  const Index blockingThreshold = 128;
 
-    hCoeffs.tail(n-i-1).noalias() = (matA.bottomRightCorner(remainingSize,remainingSize).template selfadjointView<Lower>()
-                                  * (ei_conj(h) * matA.col(i).tail(remainingSize)));
+  if(n <= blockingThreshold)
+  {
+    ei_tridiagonalization_inplace_unblocked(matA, hCoeffs);
+    return;
+  }
 
-    hCoeffs.tail(n-i-1) += (ei_conj(h)*Scalar(-0.5)*(hCoeffs.tail(remainingSize).dot(matA.col(i).tail(remainingSize)))) * matA.col(i).tail(n-i-1);
+  Matrix<Scalar,Dynamic,Dynamic> W(n, blockSize);
+  Matrix<Scalar,Dynamic,Dynamic> diagBlock(blockSize, blockSize);
+  Matrix<RealScalar,Dynamic,1> betas(blockSize);
 
-    matA.bottomRightCorner(remainingSize, remainingSize).template selfadjointView<Lower>()
-      .rankUpdate(matA.col(i).tail(remainingSize), hCoeffs.tail(remainingSize), -1);
+  Index k = 0;
+  for (; n-k > blockingThreshold; k += blockSize)
+  {
+    Index bs = blockSize;
+    ei_tridiagonalization_panel(matA, hCoeffs, k, bs, W, betas);
+
+    // update the lower triangular part of the trailing matrix: A22 -= V W^* + W V^*,
+    // by blocks of columns such that only the diagonal blocks are computed twice as needed
+    Index tsize = n-k-bs;
+    Block<MatrixType,Dynamic,Dynamic> A22(matA, k+bs, k+bs, tsize, tsize);
+    Block<MatrixType,Dynamic,Dynamic> V(matA, k+bs, k, tsize, bs);
+    Block<Matrix<Scalar,Dynamic,Dynamic>,Dynamic,Dynamic> W2(W, k+bs, 0, tsize, bs);
+    for (Index j = 0; j<tsize; j += blockSize)
+    {
+      Index cs = std::min(blockSize, tsize-j);
+      Index below = tsize-j-cs;
+      diagBlock.topLeftCorner(cs,cs).noalias() = V.middleRows(j,cs) * W2.middleRows(j,cs).adjoint();
+      diagBlock.topLeftCorner(cs,cs).noalias() += W2.middleRows(j,cs) * V.middleRows(j,cs).adjoint();
+      A22.block(j,j,cs,cs).template triangularView<Lower>() -= diagBlock.topLeftCorner(cs,cs);
+      if(below>0)
+      {
+        A22.block(j+cs,j,below,cs).noalias() -= V.bottomRows(below) * W2.middleRows(j,cs).adjoint();
+        A22.block(j+cs,j,below,cs).noalias() -= W2.bottomRows(below) * V.middleRows(j,cs).adjoint();
+      }
+    }
 
-    matA.col(i).coeffRef(i+1) = beta;
-    hCoeffs.coeffRef(i) = h;
+    for (Index i = 0; i<bs; ++i)
+      matA.coeffRef(k+i+1,k+i) = betas.coeff(i);
   }
+
+  Block<MatrixType,Dynamic,Dynamic> corner(matA, k, k, n-k, n-k);
+  VectorBlock<CoeffVectorType> cornerCoeffs(hCoeffs, k, n-k-1);
+  ei_tridiagonalization_inplace_unblocked(corner, cornerCoeffs);
 }
 
 // forward declaration, implementation at the end of this file
@@ -40,21 +40,26 @@ void ei_make_block_householder_triangular_factor(TriangularFactorType& triFactor
   for(Index i = 0; i < nbVecs; i++)
   {
     Index rs = vectors.rows() - i;
+    // the coefficients might be stored on the diagonal of the vectors (e.g., UpperBidiagonalization)
+    Scalar hi = hCoeffs(i);
     Scalar Vii = vectors(i,i);
     vectors.const_cast_derived().coeffRef(i,i) = Scalar(1);
-    triFactor.col(i).head(i).noalias() = -hCoeffs(i) * vectors.block(i, 0, rs, i).adjoint()
+    triFactor.col(i).head(i).noalias() = -hi * vectors.block(i, 0, rs, i).adjoint()
                                        * vectors.col(i).tail(rs);
     vectors.const_cast_derived().coeffRef(i, i) = Vii;
     // FIXME add .noalias() once the triangular product can work inplace
     triFactor.col(i).head(i) = triFactor.block(0,0,i,i).template triangularView<Upper>()
                              * triFactor.col(i).head(i);
-    triFactor(i,i) = hCoeffs(i);
+    triFactor(i,i) = hi;
   }
 }
 
-/** \internal */
+/** \internal
+  * Applies to \a mat the adjoint of the product \f$ H_0 H_1 \ldots H_{k-1} \f$ of the Householder reflectors
+  * defined by \a vectors and \a hCoeffs, or the product itself if \a forward is true. */
 template<typename MatrixType,typename VectorsType,typename CoeffsType>
-void ei_apply_block_householder_on_the_left(MatrixType& mat, const VectorsType& vectors, const CoeffsType& hCoeffs)
+void ei_apply_block_householder_on_the_left(MatrixType& mat, const VectorsType& vectors, const CoeffsType& hCoeffs,
+                                            bool forward = false)
 {
   typedef typename MatrixType::Index Index;
   enum { TFactorSize = MatrixType::ColsAtCompileTime };
@@ -64,11 +69,14 @@ void ei_apply_block_householder_on_the_left(MatrixType& mat, const VectorsType&
 
   const TriangularView<VectorsType, UnitLower>& V(vectors);
 
-  // A -= V T V^* A
+  // A -= V T^* V^* A, or A -= V T V^* A if forward is true
   Matrix<typename MatrixType::Scalar,VectorsType::ColsAtCompileTime,MatrixType::ColsAtCompileTime,0,
          VectorsType::MaxColsAtCompileTime,MatrixType::MaxColsAtCompileTime> tmp = V.adjoint() * mat;
   // FIXME add .noalias() once the triangular product can work inplace
-  tmp = T.template triangularView<Upper>().adjoint() * tmp;
+  if(forward)
+    tmp = T.template triangularView<Upper>() * tmp;
+  else
+    tmp = T.template triangularView<Upper>().adjoint() * tmp;
   mat.noalias() -= V * tmp;
 }
 
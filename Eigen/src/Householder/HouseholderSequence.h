@@ -77,6 +77,13 @@ struct ei_hseq_side_dependent_impl
     Index start = k+1+h.m_shift;
     return Block<VectorsType,Dynamic,1>(h.m_vectors, start, k, h.rows()-start, 1);
   }
+
+  typedef Block<VectorsType, Dynamic, Dynamic> EssentialVectorsType;
+  static inline const EssentialVectorsType essentialVectors(const HouseholderSequenceType& h, Index k, Index count)
+  {
+    Index start = k+h.m_shift;
+    return Block<VectorsType,Dynamic,Dynamic>(h.m_vectors, start, k, h.rows()-start, count);
+  }
 };
 
 template<typename VectorsType, typename CoeffsType>
@@ -90,6 +97,13 @@ struct ei_hseq_side_dependent_impl<VectorsType, CoeffsType, OnTheRight>
     Index start = k+1+h.m_shift;
     return Block<VectorsType,1,Dynamic>(h.m_vectors, k, start, 1, h.rows()-start).transpose();
   }
+
+  typedef Transpose<Block<VectorsType, Dynamic, Dynamic> > EssentialVectorsType;
+  static inline const EssentialVectorsType essentialVectors(const HouseholderSequenceType& h, Index k, Index count)
+  {
+    Index start = k+h.m_shift;
+    return Block<VectorsType,Dynamic,Dynamic>(h.m_vectors, k, start, count, h.rows()-start).transpose();
+  }
 };
 
 template<typename OtherScalarType, typename MatrixType> struct ei_matrix_type_times_scalar_type
@@ -109,11 +123,15 @@ template<typename VectorsType, typename CoeffsType, int Side> class HouseholderS
       MaxRowsAtCompileTime = ei_traits<HouseholderSequence>::MaxRowsAtCompileTime,
       MaxColsAtCompileTime = ei_traits<HouseholderSequence>::MaxColsAtCompileTime
     };
+    // number of reflectors applied at once by the blocked algorithms
+    enum { BlockSize = 48 };
     typedef typename ei_traits<HouseholderSequence>::Scalar Scalar;
     typedef typename VectorsType::Index Index;
 
     typedef typename ei_hseq_side_dependent_impl<VectorsType,CoeffsType,Side>::EssentialVectorType
             EssentialVectorType;
+    typedef typename ei_hseq_side_dependent_impl<VectorsType,CoeffsType,Side>::EssentialVectorsType
+            EssentialVectorsType;
 
   public:
 
@@ -145,6 +163,14 @@ template<typename VectorsType, typename CoeffsType, int Side> class HouseholderS
       return ei_hseq_side_dependent_impl<VectorsType,CoeffsType,Side>::essentialVector(*this, k);
     }
 
+    /** \internal \returns the \a count consecutive Householder vectors starting at \a k as the columns of a
+      * unit lower trapezoidal matrix (the diagonal being the position of their implicit leading 1) */
+    const EssentialVectorsType essentialVectors(Index k, Index count) const
+    {
+      ei_assert(k >= 0 && count >= 0 && k+count <= m_actualVectors);
+      return ei_hseq_side_dependent_impl<VectorsType,CoeffsType,Side>::essentialVectors(*this, k, count);
+    }
+
     HouseholderSequence transpose() const
     { return HouseholderSequence(m_vectors, m_coeffs, !m_trans, m_actualVectors, m_shift); }
 
@@ -163,43 +189,51 @@ template<typename VectorsType, typename CoeffsType, int Side> class HouseholderS
       // FIXME find a way to pass this temporary if the user want to
       Matrix<Scalar, DestType::RowsAtCompileTime, 1,
              AutoAlign|ColMajor, DestType::MaxRowsAtCompileTime, 1> temp(rows());
-      if(    ei_is_same_type<typename ei_cleantype<VectorsType>::type,DestType>::ret
-          && ei_extract_data(dst) == ei_extract_data(m_vectors))
+      bool inPlace = ei_is_same_type<typename ei_cleantype<VectorsType>::type,DestType>::ret
+                  && ei_extract_data(dst) == ei_extract_data(m_vectors);
+      if(inPlace)
       {
-        // in-place
         dst.diagonal().setOnes();
         dst.template triangularView<StrictlyUpper>().setZero();
-        for(Index k = vecs-1; k >= 0; --k)
-        {
-          Index cornerSize = rows() - k - m_shift;
-          if(m_trans)
-            dst.bottomRightCorner(cornerSize, cornerSize)
-            .applyHouseholderOnTheRight(essentialVector(k), m_coeffs.coeff(k), &temp.coeffRef(0));
-          else
-            dst.bottomRightCorner(cornerSize, cornerSize)
-              .applyHouseholderOnTheLeft(essentialVector(k), m_coeffs.coeff(k), &temp.coeffRef(0));
-
-          // clear the off diagonal vector
-          dst.col(k).tail(rows()-k-1).setZero();
-        }
-        // clear the remaining columns if needed
-        for(Index k = 0; k<cols()-vecs ; ++k)
-          dst.col(k).tail(rows()-k-1).setZero();
       }
       else
-      {
         dst.setIdentity(rows(), rows());
-        for(Index k = vecs-1; k >= 0; --k)
+
+      // The reflectors are applied from the last one, and, for large sequences, by blocks of
+      // BlockSize: each block is first applied at once to the already formed columns, and then
+      // one by one to the columns holding its own vectors.
+      bool blocked = !m_trans && vecs > Index(BlockSize);
+      for(Index end = vecs; end > 0; )
+      {
+        Index start = blocked ? std::max<Index>(0, end-Index(BlockSize)) : 0;
+        Index formed = blocked ? end+m_shift : cols();
+        if(blocked && formed < cols())
+        {
+          Block<DestType,Dynamic,Dynamic> formedCols(dst, start+m_shift, formed, rows()-start-m_shift, cols()-formed);
+          ei_apply_block_householder_on_the_left(formedCols, essentialVectors(start, end-start),
+                                                 m_coeffs.segment(start, end-start), true);
+        }
+        for(Index k = end-1; k >= start; --k)
         {
           Index cornerSize = rows() - k - m_shift;
           if(m_trans)
             dst.bottomRightCorner(cornerSize, cornerSize)
             .applyHouseholderOnTheRight(essentialVector(k), m_coeffs.coeff(k), &temp.coeffRef(0));
           else
-            dst.bottomRightCorner(cornerSize, cornerSize)
+            dst.block(k+m_shift, k+m_shift, cornerSize, formed-k-m_shift)
               .applyHouseholderOnTheLeft(essentialVector(k), m_coeffs.coeff(k), &temp.coeffRef(0));
+
+          // clear the off diagonal vector
+          if(inPlace)
+            dst.col(k).tail(rows()-k-1).setZero();
         }
+        end = start;
       }
+
+      // clear the remaining columns if needed
+      if(inPlace)
+        for(Index k = 0; k<cols()-vecs ; ++k)
+          dst.col(k).tail(rows()-k-1).setZero();
     }
 
     /** \internal */
@@ -217,6 +251,20 @@ template<typename VectorsType, typename CoeffsType, int Side> class HouseholderS
     /** \internal */
     template<typename Dest> inline void applyThisOnTheLeft(Dest& dst) const
     {
+      // long sequences applied to enough columns to amortize the triangular factors are applied by blocks
+      if(!m_trans && m_actualVectors > Index(BlockSize) && dst.cols() >= Index(BlockSize)/4)
+      {
+        for(Index end = m_actualVectors; end > 0; )
+        {
+          Index start = std::max<Index>(0, end-Index(BlockSize));
+          Block<Dest,Dynamic,Dynamic> bottom(dst, start+m_shift, 0, rows()-start-m_shift, dst.cols());
+          ei_apply_block_householder_on_the_left(bottom, essentialVectors(start, end-start),
+                                                 m_coeffs.segment(start, end-start), true);
+          end = start;
+        }
+        return;
+      }
+
       Matrix<Scalar,1,Dest::ColsAtCompileTime> temp(dst.cols());
       for(Index k = 0; k < m_actualVectors; ++k)
       {
@@ -368,6 +368,167 @@ typename MatrixType::RealScalar ColPivHouseholderQR<MatrixType>::logAbsDetermina
   return m_qr.diagonal().cwiseAbs().array().log().sum();
 }
 
+/** \internal
+  * Performs the column pivoting Householder QR decomposition of \a mat in place, processing panels of
+  * \a maxBlockSize columns at once (QP3-style). Within a panel, the reflectors are applied to the
+  * trailing matrix lazily through the matrix \c F such that the updated trailing matrix is \c A-VF^*,
+  * where V stores the Householder vectors of the panel. Only the current column and the current row
+  * are updated explicitly, the rest of the trailing matrix being updated by a single matrix product
+  * at the end of each panel. The squared column norms \a colSqNorms, initially those of \a mat, are
+  * downdated, and recomputed when the downdating becomes inaccurate, which also terminates the panel.
+  *
+  * \returns the number of actual column transpositions
+  */
+template<typename MatrixQR, typename HCoeffs, typename Transpositions, typename RealVector>
+typename MatrixQR::Index ei_colpiv_householder_qr_inplace_blocked(MatrixQR& mat, HCoeffs& hCoeffs, Transpositions& transpositions,
+                                                                  RealVector& colSqNorms,
+                                                                  typename MatrixQR::RealScalar threshold_helper,
+                                                                  typename MatrixQR::Index& nonzero_pivots,
+                                                                  typename MatrixQR::RealScalar& maxpivot,
+                                                                  typename MatrixQR::Index maxBlockSize = 32)
+{
+  typedef typename MatrixQR::Index Index;
+  typedef typename MatrixQR::Scalar Scalar;
+  typedef typename MatrixQR::RealScalar RealScalar;
+
+  const Index rows = mat.rows();
+  const Index cols = mat.cols();
+  const Index size = std::min(rows,cols);
+  const RealScalar tol3z = ei_sqrt(NumTraits<RealScalar>::epsilon());
+
+  // vn1 stores the (downdated) squared norms of the trailing columns, and vn2 the squared norms
+  // at the last recomputation
+  RealVector& vn1 = colSqNorms;
+  Matrix<RealScalar,Dynamic,1> vn2 = vn1.transpose();
+
+  Matrix<Scalar,Dynamic,Dynamic> F(cols, maxBlockSize);
+  Matrix<Scalar,Dynamic,1> aux(maxBlockSize);
+  Matrix<Index,Dynamic,1> toRecompute(cols);
+
+  Index number_of_transpositions = 0;
+  bool exactNorms = true;
+  nonzero_pivots = size;
+
+  for(Index k0 = 0; k0 < size;)
+  {
+    const Index bs = std::min(maxBlockSize, size-k0);
+    Index nbToRecompute = 0;
+    bool recomputeAll = false, terminate = false;
+
+    Index k = 0;
+    while(k < bs)
+    {
+      const Index kk = k0 + k;
+      const Index rc = cols - kk - 1; // remaining columns
+
+      Index pvt;
+      RealScalar biggest_col_sq_norm = vn1.tail(cols-kk).maxCoeff(&pvt);
+      pvt += kk;
+
+      // if the biggest column is negligible, either terminate or, if the norms are
+      // only estimates, update the trailing matrix and recompute them first
+      if(biggest_col_sq_norm < threshold_helper * (rows-kk))
+      {
+        if(k==0 && exactNorms)
+          terminate = true;
+        else
+          recomputeAll = true;
+        break;
+      }
+
+      transpositions.coeffRef(kk) = pvt;
+      if(pvt != kk)
+      {
+        mat.col(kk).swap(mat.col(pvt));
+        F.row(kk-k0).head(k).swap(F.row(pvt-k0).head(k));
+        std::swap(vn1.coeffRef(kk), vn1.coeffRef(pvt));
+        std::swap(vn2.coeffRef(kk), vn2.coeffRef(pvt));
+        ++number_of_transpositions;
+      }
+
+      // apply the previous reflectors of the panel to the current column
+      if(k>0)
+        mat.col(kk).tail(rows-kk).noalias() -= mat.block(kk,k0,rows-kk,k) * F.row(kk-k0).head(k).adjoint();
+
+      RealScalar beta;
+      mat.col(kk).tail(rows-kk).makeHouseholderInPlace(hCoeffs.coeffRef(kk), beta);
+      if(ei_abs(beta) > maxpivot) maxpivot = ei_abs(beta);
+      Scalar tau = hCoeffs.coeff(kk);
+
+      mat.coeffRef(kk,kk) = Scalar(1);
+      if(rc>0)
+      {
+        // F(kk+1:cols,k) = conj(tau) * (A - V F^*)(kk:rows,kk+1:cols)^* v
+        F.col(k).segment(kk+1-k0,rc).noalias() = (ei_conj(tau) * mat.block(kk,kk+1,rows-kk,rc).adjoint()) * mat.col(kk).tail(rows-kk);
+        if(k>0)
+        {
+          aux.head(k).noalias() = mat.block(kk,k0,rows-kk,k).adjoint() * mat.col(kk).tail(rows-kk);
+          F.col(k).segment(kk+1-k0,rc).noalias() -= (ei_conj(tau) * F.block(kk+1-k0,0,rc,k)) * aux.head(k);
+        }
+
+        // update the current row of the trailing matrix
+        mat.row(kk).tail(rc).noalias() -= mat.row(kk).segment(k0,k+1) * F.block(kk+1-k0,0,rc,k+1).adjoint();
+      }
+      mat.coeffRef(kk,kk) = beta;
+
+      // downdate the norms of the trailing columns
+      for(Index j = kk+1; j < cols; ++j)
+      {
+        if(vn1.coeff(j) != RealScalar(0))
+        {
+          RealScalar temp = std::max(RealScalar(1) - ei_abs2(mat.coeff(kk,j)) / vn1.coeff(j), RealScalar(0));
+          RealScalar temp2 = temp * (vn1.coeff(j) / vn2.coeff(j));
+          if(temp2 <= tol3z)
+            toRecompute.coeffRef(nbToRecompute++) = j;
+          else
+            vn1.coeffRef(j) *= temp;
+        }
+      }
+
+      ++k;
+      if(nbToRecompute>0)
+        break;
+    }
+
+    if(terminate)
+    {
+      nonzero_pivots = k0;
+      hCoeffs.tail(size-k0).setZero();
+      mat.bottomRightCorner(rows-k0,cols-k0)
+         .template triangularView<StrictlyLower>()
+         .setZero();
+      break;
+    }
+
+    // update the trailing matrix: A22 -= V2 F2^*
+    const Index kb = k;
+    const Index kn = k0 + kb;
+    if(kb>0 && kn<rows && kn<cols)
+      mat.bottomRightCorner(rows-kn,cols-kn).noalias() -= mat.block(kn,k0,rows-kn,kb) * F.block(kb,0,cols-kn,kb).adjoint();
+
+    // recompute the inaccurate norms
+    if(recomputeAll)
+    {
+      for(Index j = kn; j < cols; ++j)
+        vn1.coeffRef(j) = mat.col(j).tail(rows-kn).squaredNorm();
+      vn2.tail(cols-kn) = vn1.tail(cols-kn).transpose();
+    }
+    else
+    {
+      for(Index i = 0; i < nbToRecompute; ++i)
+      {
+        Index j = toRecompute.coeff(i);
+        vn1.coeffRef(j) = vn2.coeffRef(j) = mat.col(j).tail(rows-kn).squaredNorm();
+      }
+    }
+    exactNorms = recomputeAll;
+
+    k0 = kn;
+  }
+
+  return number_of_transpositions;
+}
+
 template<typename MatrixType>
 ColPivHouseholderQR<MatrixType>& ColPivHouseholderQR<MatrixType>::compute(const MatrixType& matrix)
 {
@@ -392,61 +553,70 @@ ColPivHouseholderQR<MatrixType>& ColPivHouseholderQR<MatrixType>::compute(const
   m_nonzero_pivots = size; // the generic case is that in which all pivots are nonzero (invertible case)
   m_maxpivot = RealScalar(0);
 
-  for(Index k = 0; k < size; ++k)
+  if(size >= 64)
+  {
+    number_of_transpositions = ei_colpiv_householder_qr_inplace_blocked(m_qr, m_hCoeffs, m_colsTranspositions, m_colSqNorms,
+                                                                        threshold_helper, m_nonzero_pivots, m_maxpivot);
+  }
+  else
   {
-    // first, we look up in our table m_colSqNorms which column has the biggest squared norm
-    Index biggest_col_index;
-    RealScalar biggest_col_sq_norm = m_colSqNorms.tail(cols-k).maxCoeff(&biggest_col_index);
-    biggest_col_index += k;
-
-    // since our table m_colSqNorms accumulates imprecision at every step, we must now recompute
-    // the actual squared norm of the selected column.
-    // Note that not doing so does result in solve() sometimes returning inf/nan values
-    // when running the unit test with 1000 repetitions.
-    biggest_col_sq_norm = m_qr.col(biggest_col_index).tail(rows-k).squaredNorm();
-
-    // we store that back into our table: it can't hurt to correct our table.
-    m_colSqNorms.coeffRef(biggest_col_index) = biggest_col_sq_norm;
-
-    // if the current biggest column is smaller than epsilon times the initial biggest column,
-    // terminate to avoid generating nan/inf values.
-    // Note that here, if we test instead for "biggest == 0", we get a failure every 1000 (or so)
-    // repetitions of the unit test, with the result of solve() filled with large values of the order
-    // of 1/(size*epsilon).
-    if(biggest_col_sq_norm < threshold_helper * (rows-k))
-    {
-      m_nonzero_pivots = k;
-      m_hCoeffs.tail(size-k).setZero();
-      m_qr.bottomRightCorner(rows-k,cols-k)
-          .template triangularView<StrictlyLower>()
-          .setZero();
-      break;
-    }
 
-    // apply the transposition to the columns
-    m_colsTranspositions.coeffRef(k) = biggest_col_index;
-    if(k != biggest_col_index) {
-      m_qr.col(k).swap(m_qr.col(biggest_col_index));
-      std::swap(m_colSqNorms.coeffRef(k), m_colSqNorms.coeffRef(biggest_col_index));
-      ++number_of_transpositions;
+    for(Index k = 0; k < size; ++k)
+    {
+      // first, we look up in our table m_colSqNorms which column has the biggest squared norm
+      Index biggest_col_index;
+      RealScalar biggest_col_sq_norm = m_colSqNorms.tail(cols-k).maxCoeff(&biggest_col_index);
+      biggest_col_index += k;
+
+      // since our table m_colSqNorms accumulates imprecision at every step, we must now recompute
+      // the actual squared norm of the selected column.
+      // Note that not doing so does result in solve() sometimes returning inf/nan values
+      // when running the unit test with 1000 repetitions.
+      biggest_col_sq_norm = m_qr.col(biggest_col_index).tail(rows-k).squaredNorm();
+
+      // we store that back into our table: it can't hurt to correct our table.
+      m_colSqNorms.coeffRef(biggest_col_index) = biggest_col_sq_norm;
+
+      // if the current biggest column is smaller than epsilon times the initial biggest column,
+      // terminate to avoid generating nan/inf values.
+      // Note that here, if we test instead for "biggest == 0", we get a failure every 1000 (or so)
+      // repetitions of the unit test, with the result of solve() filled with large values of the order
+      // of 1/(size*epsilon).
+      if(biggest_col_sq_norm < threshold_helper * (rows-k))
+      {
+        m_nonzero_pivots = k;
+        m_hCoeffs.tail(size-k).setZero();
+        m_qr.bottomRightCorner(rows-k,cols-k)
+            .template triangularView<StrictlyLower>()
+            .setZero();
+        break;
+      }
+
+      // apply the transposition to the columns
+      m_colsTranspositions.coeffRef(k) = biggest_col_index;
+      if(k != biggest_col_index) {
+        m_qr.col(k).swap(m_qr.col(biggest_col_index));
+        std::swap(m_colSqNorms.coeffRef(k), m_colSqNorms.coeffRef(biggest_col_index));
+        ++number_of_transpositions;
+      }
+
+      // generate the householder vector, store it below the diagonal
+      RealScalar beta;
+      m_qr.col(k).tail(rows-k).makeHouseholderInPlace(m_hCoeffs.coeffRef(k), beta);
+
+      // apply the householder transformation to the diagonal coefficient
+      m_qr.coeffRef(k,k) = beta;
+
+      // remember the maximum absolute value of diagonal coefficients
+      if(ei_abs(beta) > m_maxpivot) m_maxpivot = ei_abs(beta);
+
+      // apply the householder transformation
+      m_qr.bottomRightCorner(rows-k, cols-k-1)
+          .applyHouseholderOnTheLeft(m_qr.col(k).tail(rows-k-1), m_hCoeffs.coeffRef(k), &m_temp.coeffRef(k+1));
+
+      // update our table of squared norms of the columns
+      m_colSqNorms.tail(cols-k-1) -= m_qr.row(k).tail(cols-k-1).cwiseAbs2();
     }
-
-    // generate the householder vector, store it below the diagonal
-    RealScalar beta;
-    m_qr.col(k).tail(rows-k).makeHouseholderInPlace(m_hCoeffs.coeffRef(k), beta);
-
-    // apply the householder transformation to the diagonal coefficient
-    m_qr.coeffRef(k,k) = beta;
-
-    // remember the maximum absolute value of diagonal coefficients
-    if(ei_abs(beta) > m_maxpivot) m_maxpivot = ei_abs(beta);
-
-    // apply the householder transformation
-    m_qr.bottomRightCorner(rows-k, cols-k-1)
-        .applyHouseholderOnTheLeft(m_qr.col(k).tail(rows-k-1), m_hCoeffs.coeffRef(k), &m_temp.coeffRef(k+1));
-
-    // update our table of squared norms of the columns
-    m_colSqNorms.tail(cols-k-1) -= m_qr.row(k).tail(cols-k-1).cwiseAbs2();
   }
 
   m_colsPermutation.setIdentity(cols);
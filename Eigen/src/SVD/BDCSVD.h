@@ -0,0 +1,720 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Copyright (C) 2010 Gael Guennebaud <gael.guennebaud@inria.fr>
+//
+// Eigen is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// Alternatively, you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation; either version 2 of
+// the License, or (at your option) any later version.
+//
+// Eigen is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License or the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License and a copy of the GNU General Public License along with
+// Eigen. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef EIGEN_BDCSVD_H
+#define EIGEN_BDCSVD_H
+
+/* Divide-and-conquer algorithm for the SVD of an upper bidiagonal matrix
+ *
+ * A sub-problem is an upper bidiagonal matrix B with r rows and r or r+1 columns. Removing its row k
+ * leaves two independent sub-problems: B1, made of the first k rows (and k+1 columns), and B2, made
+ * of the remaining ones. Given their SVDs, B1 = U1 [D1 0] [V1 q1]^*  and B2 = U2 D2 V2^*, we have
+ *   B = diag(U1,1,U2) P M Q^* diag([V1 q1],V2)^*,
+ * where P and Q are permutations, and M = [z; 0 D] is made of the dense row z = (alpha q1(k),
+ * alpha V1(k,:), beta V2(0,:)) on top of the diagonal D = diag(0,D1,D2) (alpha and beta being the
+ * coefficients of the removed row). The singular values of M are the roots of the secular equation
+ *   1 + sum_i z_i^2 / (d_i^2 - sigma^2) = 0,
+ * and its singular vectors have closed forms, so that the singular vectors of B are obtained by
+ * matrix-matrix products. Small sub-problems are solved by JacobiSVD.
+ *
+ * The implementation follows LAPACK's xBDSDC/xLASD*, and shares its deflation strategy and the
+ * computation of the roots relative to their closest pole with the tridiagonal divide-and-conquer
+ * eigensolver.
+ */
+
+/** \internal
+  * Computes the \a j-th smallest singular value of \f$ M = [z; 0 D] \f$, where \f$ D = diag(d) \f$,
+  * \a d is strictly increasing with \a d[0] equal to zero, and \a z has no zero component.
+  *
+  * On output, \a diff[i] and \a sum[i] contain \f$ d_i - \sigma_j \f$ and \f$ d_i + \sigma_j \f$
+  * computed without cancellation, and \a converged tells whether the secular equation has converged.
+  */
+template<typename RealScalar, typename Index>
+RealScalar ei_bidiagonal_secular_root(const RealScalar* d, const RealScalar* z, Index k, Index j,
+                                      RealScalar* diff, RealScalar* sum, bool& converged)
+{
+  // the root is computed as sigma^2 = d_o^2 + tau, where the origin d_o is the closest of d_j and d_{j+1},
+  // relative to the poles d_i^2 - d_o^2 = (d_i-d_o)(d_i+d_o)
+  Index origin;
+  RealScalar lo, hi;
+  if(j<k-1)
+  {
+    RealScalar mid = (d[j+1]-d[j])*(d[j+1]+d[j]) / RealScalar(2);
+    RealScalar w = 1;
+    for(Index i=0; i<k; ++i)
+      w += z[i]*z[i] / ((d[i]-d[j])*(d[i]+d[j]) - mid);
+    if(w>=0)
+    {
+      origin = j;
+      lo = 0;
+      hi = mid;
+    }
+    else
+    {
+      origin = j+1;
+      lo = -mid;
+      hi = 0;
+    }
+  }
+  else
+  {
+    origin = j;
+    lo = 0;
+    hi = 0;
+    for(Index i=0; i<k; ++i)
+      hi += z[i]*z[i];
+  }
+  RealScalar dOrigin = d[origin];
+  for(Index i=0; i<k; ++i)
+    diff[i] = (d[i]-dOrigin)*(d[i]+dOrigin);
+
+  RealScalar tau = ei_secular_equation_iterate(diff, z, k, RealScalar(1), j, lo, hi, &converged);
+
+  // sigma - d_o = tau / (d_o + sigma)
+  RealScalar sigma = ei_sqrt(dOrigin*dOrigin + tau);
+  RealScalar eta = sigma==RealScalar(0) ? RealScalar(0) : tau / (dOrigin + sigma);
+  for(Index i=0; i<k; ++i)
+  {
+    diff[i] = (d[i]-dOrigin) - eta;
+    sum[i] = d[i] + sigma;
+  }
+  return sigma;
+}
+
+/** \internal
+  * Recursive divide-and-conquer solver working on the diagonal blocks of the matrices of left and right
+  * singular vectors. The sub-problems of a same level write disjoint blocks and can be solved concurrently.
+  *
+  * The sub-problem of size \a rows x \a cols at position \a start is split at its row rows/2. On output,
+  * its singular values, in decreasing order, are stored in the entries \a start to \a start+rows-1 of
+  * \a m_diag, the corresponding singular vectors in the first \a rows columns of the diagonal blocks of
+  * \a m_matU and \a m_matV, and, if \a cols is rows+1, the last column of the block of \a m_matV holds
+  * a vector of the null space. solve() returns false if one of the secular equations has not converged.
+  */
+template<typename RealScalar, typename Index>
+struct ei_bidiagonal_dc
+{
+  typedef Matrix<RealScalar,Dynamic,Dynamic> MatrixType;
+  typedef Matrix<RealScalar,Dynamic,1> VectorType;
+  typedef Matrix<Index,Dynamic,1> IndexVectorType;
+
+  /** Number of rows below which the sub-problems are solved by JacobiSVD */
+  enum { LeafSize = 32 };
+
+  ei_bidiagonal_dc(RealScalar* diag, RealScalar* superdiag, MatrixType& matU, MatrixType& matV)
+    : m_diag(diag), m_superdiag(superdiag), m_matU(matU), m_matV(matV)
+  {}
+
+  bool solve(Index start, Index rows, Index cols)
+  {
+    if(rows<=Index(LeafSize))
+    {
+      MatrixType b = MatrixType::Zero(rows,cols);
+      for(Index i=0; i<rows; ++i)
+      {
+        b(i,i) = m_diag[start+i];
+        if(i+1<cols)
+          b(i,i+1) = m_superdiag[start+i];
+      }
+      JacobiSVD<MatrixType> svd(b);
+      m_matU.block(start,start,rows,rows) = svd.matrixU();
+      m_matV.block(start,start,cols,cols) = svd.matrixV();
+      for(Index i=0; i<rows; ++i)
+        m_diag[start+i] = svd.singularValues().coeff(i);
+      return true;
+    }
+    Index k = rows/2;
+    bool ok = solve(start, k, k+1);
+    ok = solve(start+k+1, rows-k-1, cols-k-1) && ok;
+    if(ok)
+      ok = merge(start, k, rows, cols);
+    return ok;
+  }
+
+  /** Appends to \a starts, \a rows and \a cols the positions of the \a parts sub-problems of the recursion */
+  void splitParts(Index start, Index r, Index c, int parts, Index* starts, Index* rows, Index* cols, int& count)
+  {
+    if(parts==1)
+    {
+      starts[count] = start;
+      rows[count] = r;
+      cols[count] = c;
+      ++count;
+      return;
+    }
+    Index k = r/2;
+    splitParts(start, k, k+1, parts/2, starts, rows, cols, count);
+    splitParts(start+k+1, r-k-1, c-k-1, parts/2, starts, rows, cols, count);
+  }
+
+  /** Merges back the sub-problems created by splitParts() once they are solved */
+  bool mergeParts(Index start, Index rows, Index cols, int parts)
+  {
+    if(parts==1)
+      return true;
+    Index k = rows/2;
+    return mergeParts(start, k, k+1, parts/2)
+        && mergeParts(start+k+1, rows-k-1, cols-k-1, parts/2)
+        && merge(start, k, rows, cols);
+  }
+
+  bool merge(Index start, Index k, Index rows, Index cols);
+
+  RealScalar* m_diag;
+  RealScalar* m_superdiag;
+  MatrixType& m_matU;
+  MatrixType& m_matV;
+};
+
+template<typename RealScalar, typename Index>
+bool ei_bidiagonal_dc<RealScalar,Index>::merge(Index start, Index k, Index rows, Index cols)
+{
+  const RealScalar eps = NumTraits<RealScalar>::epsilon();
+  Block<MatrixType> U(m_matU, start, start, rows, rows);
+  Block<MatrixType> V(m_matV, start, start, cols, cols);
+  RealScalar alpha = m_diag[start+k];
+  RealScalar beta = m_superdiag[start+k];
+  bool rectangular = cols>rows;
+
+  // Gather the columns of diag(U1,1,U2) and diag([V1 q1],V2) in the order of M: the middle row and q1
+  // first, followed by the singular vectors of the two halves. The columns coming from the first half
+  // have zeros in the rows below k, and conversely (type 1 and 3 respectively), unless they have been
+  // mixed by a rotation (type 2).
+  MatrixType sortedU(rows,rows), sortedV(cols,rows);
+  VectorType d(rows), z(rows), nullVector;
+  IndexVectorType typeU(rows), typeV(rows);
+  sortedU.col(0).setZero();
+  sortedU(k,0) = 1;
+  sortedV.col(0) = V.col(k);
+  d[0] = 0;
+  z[0] = alpha*V(k,k);
+  typeU[0] = typeV[0] = 1;
+  for(Index i=1; i<rows; ++i)
+  {
+    Index c = i<=k ? i-1 : i;
+    sortedU.col(i) = U.col(c);
+    sortedV.col(i) = V.col(c);
+    d[i] = m_diag[start+c];
+    z[i] = i<=k ? alpha*V(k,c) : beta*V(k+1,c);
+    typeU[i] = typeV[i] = i<=k ? 1 : 3;
+  }
+
+  // the null vector of B2 is rotated into the first column, leaving a zero column in M
+  if(rectangular)
+  {
+    nullVector = V.col(rows);
+    RealScalar zq = beta*V(k+1,rows);
+    RealScalar t = ei_sqrt(z[0]*z[0] + zq*zq);
+    if(zq!=RealScalar(0))
+    {
+      RealScalar c = z[0]/t, s = zq/t;
+      VectorType v0 = sortedV.col(0);
+      sortedV.col(0) = c*v0 + s*nullVector;
+      nullVector = c*nullVector - s*v0;
+      z[0] = t;
+      typeV[0] = 2;
+    }
+  }
+
+  // sort the singular values of the two halves
+  IndexVectorType perm(rows);
+  for(Index i=0; i<rows; ++i)
+    perm[i] = i;
+  std::sort(perm.data()+1, perm.data()+rows, ei_index_less<RealScalar,Index>(d.data()));
+  {
+    MatrixType tmpU(rows,rows), tmpV(cols,rows);
+    VectorType tmpD(rows), tmpZ(rows);
+    IndexVectorType tmpTypeU(rows), tmpTypeV(rows);
+    for(Index i=0; i<rows; ++i)
+    {
+      tmpU.col(i) = sortedU.col(perm[i]);
+      tmpV.col(i) = sortedV.col(perm[i]);
+      tmpD[i] = d[perm[i]];
+      tmpZ[i] = z[perm[i]];
+      tmpTypeU[i] = typeU[perm[i]];
+      tmpTypeV[i] = typeV[perm[i]];
+    }
+    sortedU.swap(tmpU);
+    sortedV.swap(tmpV);
+    d.swap(tmpD);
+    z.swap(tmpZ);
+    typeU.swap(tmpTypeU);
+    typeV.swap(tmpTypeV);
+  }
+
+  // Deflation: the negligible components of z, the singular values close to zero after a rotation
+  // of the right vectors zeroing the corresponding component of z, and the close singular values
+  // after a rotation of both the left and right vectors zeroing one of the two components of z.
+  RealScalar tol = RealScalar(8)*eps*std::max(d[rows-1], std::max(ei_abs(alpha), ei_abs(beta)));
+  IndexVectorType deflated = IndexVectorType::Zero(rows);
+  Index prev = -1;
+  for(Index i=1; i<rows; ++i)
+  {
+    if(ei_abs(z[i]) <= tol)
+    {
+      deflated[i] = 1;
+      continue;
+    }
+    if(d[i] <= tol)
+    {
+      RealScalar t = ei_sqrt(z[0]*z[0] + z[i]*z[i]);
+      RealScalar c = z[0]/t, s = z[i]/t;
+      VectorType v0 = sortedV.col(0);
+      sortedV.col(0) = c*v0 + s*sortedV.col(i);
+      sortedV.col(i) = c*sortedV.col(i) - s*v0;
+      z[0] = t;
+      z[i] = 0;
+      if(typeV[i]!=typeV[0])
+        typeV[i] = typeV[0] = 2;
+      deflated[i] = 1;
+      continue;
+    }
+    if(prev>=0 && d[i]-d[prev] <= tol)
+    {
+      RealScalar t = ei_sqrt(z[prev]*z[prev] + z[i]*z[i]);
+      RealScalar c = z[i]/t, s = z[prev]/t;
+      VectorType uprev = c*sortedU.col(prev) - s*sortedU.col(i);
+      sortedU.col(i) = s*sortedU.col(prev) + c*sortedU.col(i);
+      sortedU.col(prev) = uprev;
+      VectorType vprev = c*sortedV.col(prev) - s*sortedV.col(i);
+      sortedV.col(i) = s*sortedV.col(prev) + c*sortedV.col(i);
+      sortedV.col(prev) = vprev;
+      z[i] = t;
+      z[prev] = 0;
+      if(typeU[i]!=typeU[prev])
+        typeU[i] = typeU[prev] = 2;
+      if(typeV[i]!=typeV[prev])
+        typeV[i] = typeV[prev] = 2;
+      deflated[prev] = 1;
+    }
+    prev = i;
+  }
+  // the pole at zero is kept, unless M is zero
+  if(ei_abs(z[0]) <= tol)
+  {
+    if(tol==RealScalar(0))
+      deflated[0] = 1;
+    else
+      z[0] = tol;
+  }
+
+  Index K = rows - deflated.sum();
+  MatrixType vecsU(rows,rows), vecsV(cols,rows);
+  VectorType values(rows);
+  bool converged = true;
+
+  if(K>0)
+  {
+    // gather the non deflated columns by type
+    VectorType dk(K), zk(K);
+    IndexVectorType posU(K), posV(K);
+    Index countU[3] = {0, 0, 0}, countV[3] = {0, 0, 0};
+    for(Index i=0, j=0; i<rows; ++i)
+      if(!deflated[i])
+      {
+        dk[j] = d[i];
+        zk[j] = z[i];
+        ++countU[typeU[i]-1];
+        ++countV[typeV[i]-1];
+        ++j;
+      }
+    Index startU[3] = {0, countU[0], countU[0]+countU[1]};
+    Index startV[3] = {0, countV[0], countV[0]+countV[1]};
+    MatrixType Uk(rows,K), Vk(cols,K);
+    for(Index i=0, j=0; i<rows; ++i)
+      if(!deflated[i])
+      {
+        posU[j] = startU[typeU[i]-1]++;
+        posV[j] = startV[typeV[i]-1]++;
+        Uk.col(posU[j]) = sortedU.col(i);
+        Vk.col(posV[j]) = sortedV.col(i);
+        ++j;
+      }
+
+    // solve the secular equation: diff(i,j) = dk[i] - sigma_j and sum(i,j) = dk[i] + sigma_j
+    MatrixType diff(K,K), sum(K,K);
+    for(Index j=0; j<K; ++j)
+    {
+      bool rootConverged;
+      values[j] = ei_bidiagonal_secular_root(dk.data(), zk.data(), K, j, &diff.coeffRef(0,j), &sum.coeffRef(0,j), rootConverged);
+      converged = converged && rootConverged;
+    }
+    if(!converged)
+      return false;
+
+    // recompute z from the computed singular values (Lowner's formula) such that they are the exact
+    // singular values of a nearby problem, then the singular vectors of M (up to scaling factors)
+    VectorType w(K);
+    for(Index i=0; i<K; ++i)
+      w[i] = diff(i,i)*sum(i,i);
+    for(Index j=0; j<K; ++j)
+      for(Index i=0; i<K; ++i)
+        if(i!=j)
+          w[i] *= diff(i,j)*sum(i,j) / ((dk[i]-dk[j])*(dk[i]+dk[j]));
+    for(Index i=0; i<K; ++i)
+      zk[i] = zk[i]<0 ? -ei_sqrt(ei_abs(w[i])) : ei_sqrt(ei_abs(w[i]));
+    MatrixType Um(K,K), Vm(K,K);
+    VectorType u(K), v(K);
+    for(Index j=0; j<K; ++j)
+    {
+      for(Index i=0; i<K; ++i)
+        v[i] = zk[i] / (diff(i,j)*sum(i,j));
+      u = dk.cwiseProduct(v);
+      u[0] = -1;
+      u.normalize();
+      v.normalize();
+      for(Index i=0; i<K; ++i)
+      {
+        Um(posU[i],j) = u[i];
+        Vm(posV[i],j) = v[i];
+      }
+    }
+
+    // the singular vectors are Uk Um and Vk Vm, where the zero blocks of Uk and Vk are skipped
+    Index topU = countU[0]+countU[1], bottomU = countU[1]+countU[2];
+    Index topV = countV[0]+countV[1], bottomV = countV[1]+countV[2];
+    if(topU>0)
+      vecsU.topLeftCorner(k+1,K).noalias() = Uk.topLeftCorner(k+1,topU) * Um.topRows(topU);
+    else
+      vecsU.topLeftCorner(k+1,K).setZero();
+    if(bottomU>0)
+      vecsU.bottomLeftCorner(rows-k-1,K).noalias() = Uk.bottomRightCorner(rows-k-1,bottomU) * Um.bottomRows(bottomU);
+    else
+      vecsU.bottomLeftCorner(rows-k-1,K).setZero();
+    if(topV>0)
+      vecsV.topLeftCorner(k+1,K).noalias() = Vk.topLeftCorner(k+1,topV) * Vm.topRows(topV);
+    else
+      vecsV.topLeftCorner(k+1,K).setZero();
+    if(bottomV>0)
+      vecsV.bottomLeftCorner(cols-k-1,K).noalias() = Vk.bottomRightCorner(cols-k-1,bottomV) * Vm.bottomRows(bottomV);
+    else
+      vecsV.bottomLeftCorner(cols-k-1,K).setZero();
+  }
+
+  for(Index i=0, j=K; i<rows; ++i)
+    if(deflated[i])
+    {
+      values[j] = d[i];
+      vecsU.col(j) = sortedU.col(i);
+      vecsV.col(j) = sortedV.col(i);
+      ++j;
+    }
+
+  // store the singular values in decreasing order
+  for(Index i=0; i<rows; ++i)
+    perm[i] = i;
+  std::sort(perm.data(), perm.data()+rows, ei_index_less<RealScalar,Index>(values.data()));
+  for(Index i=0; i<rows; ++i)
+  {
+    Index p = perm[rows-1-i];
+    m_diag[start+i] = values[p];
+    U.col(i) = vecsU.col(p);
+    V.col(i) = vecsV.col(p);
+  }
+  if(rectangular)
+    V.col(rows) = nullVector;
+  return true;
+}
+
+/** \internal Solves in parallel the sub-problems of the first levels of the recursion */
+template<typename RealScalar, typename Index>
+class ei_bidiagonal_dc_task
+{
+  public:
+    ei_bidiagonal_dc_task(ei_bidiagonal_dc<RealScalar,Index>& dc, const Index* starts, const Index* rows, const Index* cols,
+                          bool* ok)
+      : m_dc(dc), m_starts(starts), m_rows(rows), m_cols(cols), m_ok(ok)
+    {}
+
+    void operator()(int id) const
+    {
+      m_ok[id] = m_dc.solve(m_starts[id], m_rows[id], m_cols[id]);
+    }
+
+  protected:
+    ei_bidiagonal_dc<RealScalar,Index>& m_dc;
+    const Index* m_starts;
+    const Index* m_rows;
+    const Index* m_cols;
+    bool* m_ok;
+};
+
+/** \internal
+  *
+  * \svd_module
+  *
+  * Computes the SVD \f$ B = U \Sigma V^T \f$ of the n x n upper bidiagonal matrix represented by \a diag
+  * and \a superdiag with the divide-and-conquer algorithm.
+  *
+  * On output, \a diag contains the singular values in decreasing order, the columns of \a matU and
+  * \a matV the corresponding left and right singular vectors, and \a superdiag is left unchanged.
+  * Returns \c NoConvergence if one of the secular equations has not converged, \c Success otherwise.
+  *
+  * When Eigen is allowed to use several threads, the sub-problems of the first levels of the recursion
+  * are solved concurrently, using the ThreadPool if any, or OpenMP. The merges of the last levels are
+  * then parallelized by the matrix-matrix products.
+  */
+template<typename RealScalar, typename Index>
+ComputationInfo ei_bidiagonal_divide_and_conquer(RealScalar* diag, RealScalar* superdiag, Index n,
+                                      Matrix<RealScalar,Dynamic,Dynamic>& matU,
+                                      Matrix<RealScalar,Dynamic,Dynamic>& matV)
+{
+  matU.setZero(n,n);
+  matV.setZero(n,n);
+
+  // scale the matrix to avoid overflows in the secular equations
+  RealScalar scale = 0;
+  for(Index i=0; i<n; ++i)
+    scale = std::max(scale, ei_abs(diag[i]));
+  for(Index i=0; i<n-1; ++i)
+    scale = std::max(scale, ei_abs(superdiag[i]));
+  if(scale==RealScalar(0))
+  {
+    matU.setIdentity();
+    matV.setIdentity();
+    return Success;
+  }
+  Matrix<RealScalar,Dynamic,1> superdiagCopy = Map<Matrix<RealScalar,Dynamic,1> >(superdiag, n-1) / scale;
+  for(Index i=0; i<n; ++i)
+    diag[i] /= scale;
+
+  typedef ei_bidiagonal_dc<RealScalar,Index> DC;
+  DC dc(diag, superdiagCopy.data(), matU, matV);
+  bool ok = true;
+
+  int parts = 1;
+  const int threads = ei_parallel_threads();
+  while(parts*2<=threads && n/(parts*2)>Index(DC::LeafSize))
+    parts *= 2;
+
+  if(parts==1)
+    ok = dc.solve(0, n, n);
+  else
+  {
+    // split the matrix into 'parts' independent sub-problems as the recursion would do,
+    // solve them concurrently, and merge them back
+    Index* starts = ei_aligned_stack_new(Index, parts);
+    Index* rows = ei_aligned_stack_new(Index, parts);
+    Index* cols = ei_aligned_stack_new(Index, parts);
+    bool* partOk = ei_aligned_stack_new(bool, parts);
+    int count = 0;
+    dc.splitParts(0, n, n, parts, starts, rows, cols, count);
+
+    ei_parallel_for(0, parts, ei_bidiagonal_dc_task<RealScalar,Index>(dc, starts, rows, cols, partOk));
+    for(int p=0; p<parts; ++p)
+      ok = ok && partOk[p];
+
+    ei_aligned_stack_delete(bool, partOk, parts);
+    ei_aligned_stack_delete(Index, cols, parts);
+    ei_aligned_stack_delete(Index, rows, parts);
+    ei_aligned_stack_delete(Index, starts, parts);
+
+    if(ok)
+      ok = dc.mergeParts(0, n, n, parts);
+  }
+
+  for(Index i=0; i<n; ++i)
+    diag[i] *= scale;
+
+  return ok ? Success : NoConvergence;
+}
+
+/** \ingroup SVD_Module
+  *
+  *
+  * \class BDCSVD
+  *
+  * \brief Bidiagonal divide and conquer SVD decomposition of a large matrix
+  *
+  * \param MatrixType the type of the matrix of which we are computing the SVD decomposition
+  * \param Options a bit field of flags offering the following options: \c SkipU and \c SkipV allow to skip the computation of
+  *                the unitaries \a U and \a V respectively; \c ThinU and \c ThinV allow to only compute their first
+  *                min(rows,cols) columns, which is all that is needed to reconstruct the matrix or to solve least squares
+  *                problems.
+  *
+  * The matrix is first reduced to an upper bidiagonal matrix by blocked Householder transformations (see
+  * UpperBidiagonalization), whose SVD is computed by a divide and conquer algorithm, and the singular vectors
+  * are finally obtained by applying the Householder transformations by blocks. Most of the flops thus go through
+  * the matrix-matrix product kernel, which makes this decomposition much faster than JacobiSVD for large matrices.
+  * Matrices with fewer than 16 rows or columns are handed to JacobiSVD, which is faster and more accurate at these
+  * sizes.
+  *
+  * The singular values are sorted in decreasing order.
+  *
+  * \sa class JacobiSVD
+  */
+template<typename _MatrixType, unsigned int Options> class BDCSVD
+{
+  public:
+
+    typedef _MatrixType MatrixType;
+    typedef typename MatrixType::Scalar Scalar;
+    typedef typename NumTraits<typename MatrixType::Scalar>::Real RealScalar;
+    typedef typename MatrixType::Index Index;
+    enum {
+      ComputeU = (Options & SkipU) == 0,
+      ComputeV = (Options & SkipV) == 0,
+      /** size below which JacobiSVD is used */
+      JacobiThreshold = 16
+    };
+    typedef Matrix<Scalar, Dynamic, Dynamic> MatrixUType;
+    typedef Matrix<Scalar, Dynamic, Dynamic> MatrixVType;
+    typedef Matrix<RealScalar, Dynamic, 1> SingularValuesType;
+
+    /** \brief Default Constructor.
+      *
+      * The default constructor is useful in cases in which the user intends to
+      * perform decompositions via BDCSVD::compute(const MatrixType&).
+      */
+    BDCSVD() : m_isInitialized(false) {}
+
+    BDCSVD(const MatrixType& matrix) : m_isInitialized(false)
+    {
+      compute(matrix);
+    }
+
+    BDCSVD& compute(const MatrixType& matrix);
+
+    const MatrixUType& matrixU() const
+    {
+      ei_assert(m_isInitialized && "BDCSVD is not initialized.");
+      return m_matrixU;
+    }
+
+    const SingularValuesType& singularValues() const
+    {
+      ei_assert(m_isInitialized && "BDCSVD is not initialized.");
+      return m_singularValues;
+    }
+
+    const MatrixVType& matrixV() const
+    {
+      ei_assert(m_isInitialized && "BDCSVD is not initialized.");
+      return m_matrixV;
+    }
+
+    /** \brief Reports whether previous computation was successful.
+      *
+      * \returns \c Success if computation was succesful, \c NoConvergence otherwise.
+      */
+    ComputationInfo info() const
+    {
+      ei_assert(m_isInitialized && "BDCSVD is not initialized.");
+      return m_info;
+    }
+
+  protected:
+    template<typename Derived>
+    void computeTall(const MatrixBase<Derived>& matrix, MatrixUType& matU, MatrixVType& matV,
+                     bool computeU, bool computeV, bool thinU);
+
+    MatrixUType m_matrixU;
+    MatrixVType m_matrixV;
+    SingularValuesType m_singularValues;
+    ComputationInfo m_info;
+    bool m_isInitialized;
+};
+
+template<typename MatrixType, unsigned int Options>
+BDCSVD<MatrixType, Options>& BDCSVD<MatrixType, Options>::compute(const MatrixType& matrix)
+{
+  Index rows = matrix.rows();
+  Index cols = matrix.cols();
+  Index diagSize = std::min(rows, cols);
+
+  if(diagSize < Index(JacobiThreshold))
+  {
+    JacobiSVD<MatrixType, Options & ~(ThinU|ThinV)> svd(matrix);
+    m_singularValues = svd.singularValues();
+    if(ComputeU)
+    {
+      if(Options & ThinU)
+        m_matrixU = svd.matrixU().leftCols(diagSize);
+      else
+        m_matrixU = svd.matrixU();
+    }
+    if(ComputeV)
+    {
+      if(Options & ThinV)
+        m_matrixV = svd.matrixV().leftCols(diagSize);
+      else
+        m_matrixV = svd.matrixV();
+    }
+    m_info = Success;
+  }
+  else if(rows >= cols)
+    computeTall(matrix, m_matrixU, m_matrixV, ComputeU, ComputeV, Options & ThinU);
+  else
+  {
+    // A^* = V' S U'^*  gives  A = U' S V'^*
+    computeTall(matrix.adjoint(), m_matrixV, m_matrixU, ComputeV, ComputeU, Options & ThinV);
+  }
+
+  m_isInitialized = true;
+  return *this;
+}
+
+template<typename MatrixType, unsigned int Options>
+template<typename Derived>
+void BDCSVD<MatrixType, Options>::computeTall(const MatrixBase<Derived>& matrix, MatrixUType& matU, MatrixVType& matV,
+                                              bool computeU, bool computeV, bool thinU)
+{
+  typedef Matrix<Scalar, Dynamic, Dynamic> WorkMatrixType;
+  typedef Matrix<RealScalar, Dynamic, Dynamic> RealMatrixType;
+  Index rows = matrix.rows();
+  Index cols = matrix.cols();
+
+  UpperBidiagonalization<WorkMatrixType> bidiagonalization(matrix);
+  m_singularValues = bidiagonalization.bidiagonal().template diagonal<0>().transpose();
+  SingularValuesType superdiag = bidiagonalization.bidiagonal().template diagonal<1>().transpose();
+
+  RealMatrixType bidiagU, bidiagV;
+  m_info = ei_bidiagonal_divide_and_conquer(m_singularValues.data(), superdiag.data(), cols, bidiagU, bidiagV);
+
+  if(computeU)
+  {
+    if(thinU)
+    {
+      matU.setZero(rows, cols);
+      matU.topRows(cols) = bidiagU.template cast<Scalar>();
+      matU.applyOnTheLeft(bidiagonalization.householderU());
+    }
+    else
+    {
+      matU = bidiagonalization.householderU();
+      matU.leftCols(cols) = matU.leftCols(cols) * bidiagU.template cast<Scalar>();
+    }
+  }
+  if(computeV)
+  {
+    // UpperBidiagonalization applies the right reflectors as A (I - h conj(v) v^T), so that V is the
+    // conjugate of the product of the reflectors I - conj(h) v v^*
+    matV = bidiagV.template cast<Scalar>();
+    matV.applyOnTheLeft(bidiagonalization.householderV().conjugate());
+    if(NumTraits<Scalar>::IsComplex)
+      matV = matV.conjugate();
+  }
+}
+
+#endif // EIGEN_BDCSVD_H
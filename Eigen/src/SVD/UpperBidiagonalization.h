@@ -93,45 +93,188 @@ template<typename _MatrixType> class UpperBidiagonalization
     bool m_isInitialized;
 };
 
-template<typename _MatrixType>
-UpperBidiagonalization<_MatrixType>& UpperBidiagonalization<_MatrixType>::compute(const _MatrixType& matrix)
+/** \internal
+  * Unblocked upper bidiagonalization of the columns \a k0 to cols-1 of \a mat in-place, the previous
+  * columns and rows being already reduced and the corresponding transformations applied to the
+  * trailing matrix. Same storage as ei_upper_bidiagonalization_inplace_blocked(), which calls it for
+  * small matrices and for the last columns of large ones.
+  */
+template<typename MatrixType, typename BidiagType>
+void ei_upper_bidiagonalization_inplace_unblocked(MatrixType& mat, BidiagType& bidiagonal,
+                                                  typename MatrixType::Index k0 = 0)
 {
-  Index rows = matrix.rows();
-  Index cols = matrix.cols();
-  
-  ei_assert(rows >= cols && "UpperBidiagonalization is only for matrices satisfying rows>=cols.");
-  
-  m_householder = matrix;
+  typedef typename MatrixType::Index Index;
+  typedef typename MatrixType::Scalar Scalar;
+  Index rows = mat.rows();
+  Index cols = mat.cols();
 
-  ColVectorType temp(rows);
+  Matrix<Scalar, MatrixType::RowsAtCompileTime, 1, 0, MatrixType::MaxRowsAtCompileTime, 1> temp(rows);
 
-  for (Index k = 0; /* breaks at k==cols-1 below */ ; ++k)
+  for (Index k = k0; /* breaks at k==cols-1 below */ ; ++k)
   {
     Index remainingRows = rows - k;
     Index remainingCols = cols - k - 1;
 
-    // construct left householder transform in-place in m_householder
-    m_householder.col(k).tail(remainingRows)
-                 .makeHouseholderInPlace(m_householder.coeffRef(k,k),
-                                         m_bidiagonal.template diagonal<0>().coeffRef(k));
-    // apply householder transform to remaining part of m_householder on the left
-    m_householder.bottomRightCorner(remainingRows, remainingCols)
-                 .applyHouseholderOnTheLeft(m_householder.col(k).tail(remainingRows-1),
-                                            m_householder.coeff(k,k),
-                                            temp.data());
+    // construct left householder transform in-place in mat
+    mat.col(k).tail(remainingRows)
+       .makeHouseholderInPlace(mat.coeffRef(k,k),
+                               bidiagonal.template diagonal<0>().coeffRef(k));
+    // apply householder transform to remaining part of mat on the left
+    mat.bottomRightCorner(remainingRows, remainingCols)
+       .applyHouseholderOnTheLeft(mat.col(k).tail(remainingRows-1),
+                                  mat.coeff(k,k),
+                                  temp.data());
 
     if(k == cols-1) break;
-    
-    // construct right householder transform in-place in m_householder
-    m_householder.row(k).tail(remainingCols)
-                 .makeHouseholderInPlace(m_householder.coeffRef(k,k+1),
-                                         m_bidiagonal.template diagonal<1>().coeffRef(k));
-    // apply householder transform to remaining part of m_householder on the left
-    m_householder.bottomRightCorner(remainingRows-1, remainingCols)
-                 .applyHouseholderOnTheRight(m_householder.row(k).tail(remainingCols-1).transpose(),
-                                             m_householder.coeff(k,k+1),
-                                             temp.data());
+
+    // construct right householder transform in-place in mat
+    mat.row(k).tail(remainingCols)
+       .makeHouseholderInPlace(mat.coeffRef(k,k+1),
+                               bidiagonal.template diagonal<1>().coeffRef(k));
+    // apply householder transform to remaining part of mat on the left
+    mat.bottomRightCorner(remainingRows-1, remainingCols)
+       .applyHouseholderOnTheRight(mat.row(k).tail(remainingCols-1).transpose(),
+                                   mat.coeff(k,k+1),
+                                   temp.data());
+  }
+}
+
+/** \internal
+  * Reduces the \a bs rows and columns of \a A starting at \a k0, without updating the trailing part
+  * of the matrix (LAPACK's xLABRD).
+  *
+  * The reflectors computed so far are applied lazily to each row and column of the panel before it
+  * is reduced. On output, the left and right Householder vectors \f$ U \f$ and \f$ V \f$ are stored in
+  * the columns and rows of the panel, with their leading 1 explicitly stored on the diagonal and
+  * superdiagonal (the Householder coefficients being returned in \a tauU and \a tauV), and the rows
+  * k0+bs to rows-1 of \a X and cols-1 of \a Y are such that the trailing matrix has to be updated as
+  * \f$ A_{22} - U Y^* - X V^T \f$.
+  */
+template<typename MatrixType, typename BidiagType, typename WorkspaceType, typename CoeffVectorType>
+void ei_upper_bidiagonalization_panel(MatrixType& A, BidiagType& bidiagonal,
+                                      typename MatrixType::Index k0, typename MatrixType::Index bs,
+                                      WorkspaceType& X, WorkspaceType& Y,
+                                      CoeffVectorType& tauU, CoeffVectorType& tauV)
+{
+  typedef typename MatrixType::Index Index;
+  Index rows = A.rows();
+  Index cols = A.cols();
+  CoeffVectorType tmp(bs);
+
+  for (Index i = 0; i<bs; ++i)
+  {
+    Index k = k0+i;
+    Index remainingRows = rows - k;
+    Index remainingCols = cols - k - 1;
+
+    // apply the previous reflectors of the panel to the current column: A(k:,k) -= U Y(k,:)^* + X V(k,:)^T
+    if(i>0)
+    {
+      A.col(k).tail(remainingRows).noalias() -= A.block(k,k0,remainingRows,i) * Y.row(k).head(i).adjoint();
+      A.col(k).tail(remainingRows).noalias() -= X.block(k,0,remainingRows,i) * A.col(k).segment(k0,i);
+    }
+
+    A.col(k).tail(remainingRows).makeHouseholderInPlace(tauU.coeffRef(i), bidiagonal.template diagonal<0>().coeffRef(k));
+    A.coeffRef(k,k) = 1;
+
+    // y = conj(tauU) (A^* u - Y U^* u - conj(V) X^* u), where A is the not yet updated trailing matrix
+    typename WorkspaceType::ColXpr Yi = Y.col(i);
+    Yi.tail(remainingCols).noalias() = A.block(k,k+1,remainingRows,remainingCols).adjoint() * A.col(k).tail(remainingRows);
+    if(i>0)
+    {
+      tmp.head(i).noalias() = A.block(k,k0,remainingRows,i).adjoint() * A.col(k).tail(remainingRows);
+      Yi.tail(remainingCols).noalias() -= Y.block(k+1,0,remainingCols,i) * tmp.head(i);
+      tmp.head(i).noalias() = X.block(k,0,remainingRows,i).adjoint() * A.col(k).tail(remainingRows);
+      Yi.tail(remainingCols).noalias() -= A.block(k0,k+1,i,remainingCols).adjoint() * tmp.head(i);
+    }
+    Yi.tail(remainingCols) *= ei_conj(tauU.coeff(i));
+
+    // apply the reflectors to the current row: A(k,k+1:) -= U(k,:) Y^* + X(k,:) V^T
+    A.row(k).tail(remainingCols).noalias() -= A.row(k).segment(k0,i+1) * Y.block(k+1,0,remainingCols,i+1).adjoint();
+    if(i>0)
+      A.row(k).tail(remainingCols).noalias() -= X.row(k).head(i) * A.block(k0,k+1,i,remainingCols);
+
+    A.row(k).tail(remainingCols).makeHouseholderInPlace(tauV.coeffRef(i), bidiagonal.template diagonal<1>().coeffRef(k));
+    A.coeffRef(k,k+1) = 1;
+
+    // x = tauV (A - U Y^* - X V^T) conj(v)
+    typename WorkspaceType::ColXpr Xi = X.col(i);
+    Index belowRows = remainingRows-1;
+    Xi.tail(belowRows).noalias() = A.block(k+1,k+1,belowRows,remainingCols) * A.row(k).tail(remainingCols).adjoint();
+    tmp.head(i+1).noalias() = Y.block(k+1,0,remainingCols,i+1).adjoint() * A.row(k).tail(remainingCols).adjoint();
+    Xi.tail(belowRows).noalias() -= A.block(k+1,k0,belowRows,i+1) * tmp.head(i+1);
+    if(i>0)
+    {
+      tmp.head(i).noalias() = A.block(k0,k+1,i,remainingCols) * A.row(k).tail(remainingCols).adjoint();
+      Xi.tail(belowRows).noalias() -= X.block(k+1,0,belowRows,i) * tmp.head(i);
+    }
+    Xi.tail(belowRows) *= tauV.coeff(i);
+  }
+}
+
+/** \internal
+  * Performs the upper bidiagonalization of \a A in-place, \a A having at least as many rows as columns.
+  *
+  * On output, the diagonal and superdiagonal of the bidiagonal matrix are stored in \a bidiagonal,
+  * the essential parts of the left Householder vectors are stored below the diagonal of \a A, and
+  * those of the right Householder vectors on the right of its superdiagonal. The diagonal and the
+  * superdiagonal of \a A hold the respective Householder coefficients.
+  *
+  * Large matrices are reduced by panels of 32 rows and columns (see ei_upper_bidiagonalization_panel()):
+  * half of the flops are then performed by the update of the trailing matrix, which goes through the
+  * matrix-matrix product kernel. The last 128 columns, and small matrices, are reduced by the
+  * unblocked algorithm.
+  *
+  * Implemented from LAPACK's xGEBRD.
+  */
+template<typename MatrixType, typename BidiagType>
+void ei_upper_bidiagonalization_inplace_blocked(MatrixType& A, BidiagType& bidiagonal)
+{
+  typedef typename MatrixType::Index Index;
+  typedef typename MatrixType::Scalar Scalar;
+  Index rows = A.rows();
+  Index cols = A.cols();
+  const Index blockSize = 32;
+  const Index blockingThreshold = 128;
+
+  Index k = 0;
+  if(cols > blockingThreshold)
+  {
+    Matrix<Scalar,Dynamic,Dynamic> X(rows, blockSize), Y(cols, blockSize);
+    Matrix<Scalar,Dynamic,1> tauU(blockSize), tauV(blockSize);
+    for (; cols-k > blockingThreshold; k += blockSize)
+    {
+      Index bs = blockSize;
+      ei_upper_bidiagonalization_panel(A, bidiagonal, k, bs, X, Y, tauU, tauV);
+
+      // update the trailing matrix: A22 -= U Y^* + X V^T
+      Index trows = rows-k-bs;
+      Index tcols = cols-k-bs;
+      A.bottomRightCorner(trows, tcols).noalias() -= A.block(k+bs,k,trows,bs) * Y.block(k+bs,0,tcols,bs).adjoint();
+      A.bottomRightCorner(trows, tcols).noalias() -= X.block(k+bs,0,trows,bs) * A.block(k,k+bs,bs,tcols);
+
+      for (Index i = 0; i<bs; ++i)
+      {
+        A.coeffRef(k+i,k+i) = tauU.coeff(i);
+        A.coeffRef(k+i,k+i+1) = tauV.coeff(i);
+      }
+    }
   }
+
+  ei_upper_bidiagonalization_inplace_unblocked(A, bidiagonal, k);
+}
+
+template<typename _MatrixType>
+UpperBidiagonalization<_MatrixType>& UpperBidiagonalization<_MatrixType>::compute(const _MatrixType& matrix)
+{
+  Index rows = matrix.rows();
+  Index cols = matrix.cols();
+  
+  ei_assert(rows >= cols && "UpperBidiagonalization is only for matrices satisfying rows>=cols.");
+  
+  m_householder = matrix;
+  ei_upper_bidiagonalization_inplace_blocked(m_householder, m_bidiagonal);
+
   m_isInitialized = true;
   return *this;
 }
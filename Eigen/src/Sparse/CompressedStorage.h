@@ -61,8 +61,11 @@ class CompressedStorage
     CompressedStorage& operator=(const CompressedStorage& other)
     {
       resize(other.size());
-      memcpy(m_values, other.m_values, m_size * sizeof(Scalar));
-      memcpy(m_indices, other.m_indices, m_size * sizeof(Index));
+      if(m_size>0)
+      {
+        memcpy(m_values, other.m_values, m_size * sizeof(Scalar));
+        memcpy(m_indices, other.m_indices, m_size * sizeof(Index));
+      }
       return *this;
     }
 
@@ -218,8 +221,11 @@ class CompressedStorage
       Index* newIndices = new Index[size];
       size_t copySize = std::min(size, m_size);
       // copy
-      memcpy(newValues,  m_values,  copySize * sizeof(Scalar));
-      memcpy(newIndices, m_indices, copySize * sizeof(Index));
+      if(copySize>0)
+      {
+        memcpy(newValues,  m_values,  copySize * sizeof(Scalar));
+        memcpy(newIndices, m_indices, copySize * sizeof(Index));
+      }
       // delete old stuff
       delete[] m_values;
       delete[] m_indices;
@@ -62,6 +62,7 @@ class MappedSparseMatrix
     inline Index innerSize() const { return m_innerSize; }
     inline Index outerSize() const { return m_outerSize; }
     inline Index innerNonZeros(Index j) const { return m_outerIndex[j+1]-m_outerIndex[j]; }
+    inline bool isCompressed() const { return true; }
 
     //----------------------------------------
     // direct access interface
@@ -203,9 +203,9 @@ class SparseInnerVectorSet<DynamicSparseMatrix<_Scalar, _Options>, Size>
 
 template<typename _Scalar, int _Options, typename _Index, int Size>
 class SparseInnerVectorSet<SparseMatrix<_Scalar, _Options, _Index>, Size>
-  : public SparseMatrixBase<SparseInnerVectorSet<SparseMatrix<_Scalar, _Options>, Size> >
+  : public SparseMatrixBase<SparseInnerVectorSet<SparseMatrix<_Scalar, _Options, _Index>, Size> >
 {
-    typedef SparseMatrix<_Scalar, _Options> MatrixType;
+    typedef SparseMatrix<_Scalar, _Options, _Index> MatrixType;
   public:
 
     enum { IsRowMajor = ei_traits<SparseInnerVectorSet>::IsRowMajor };
@@ -241,6 +241,7 @@ class SparseInnerVectorSet<SparseMatrix<_Scalar, _Options, _Index>, Size>
     {
       typedef typename ei_cleantype<typename MatrixType::Nested>::type _NestedMatrixType;
       _NestedMatrixType& matrix = const_cast<_NestedMatrixType&>(m_matrix);;
+      matrix.makeCompressed();
       // This assignement is slow if this vector set not empty
       // and/or it is not at the end of the nonzeros of the underlying matrix.
 
@@ -332,6 +333,13 @@ class SparseInnerVectorSet<SparseMatrix<_Scalar, _Options, _Index>, Size>
 
     Index nonZeros() const
     {
+      if(!m_matrix.isCompressed())
+      {
+        Index nnz = 0;
+        for(Index k=0; k<m_outerSize.value(); ++k)
+          nnz += m_matrix.innerNonZeros(m_outerStart+k);
+        return nnz;
+      }
       return  std::size_t(m_matrix._outerIndexPtr()[m_outerStart+m_outerSize.value()])
             - std::size_t(m_matrix._outerIndexPtr()[m_outerStart]);
     }
@@ -340,7 +348,7 @@ class SparseInnerVectorSet<SparseMatrix<_Scalar, _Options, _Index>, Size>
     {
       EIGEN_STATIC_ASSERT_VECTOR_ONLY(SparseInnerVectorSet);
       ei_assert(nonZeros()>0);
-      return m_matrix._valuePtr()[m_matrix._outerIndexPtr()[m_outerStart+1]-1];
+      return m_matrix._valuePtr()[m_matrix._outerIndexPtr()[m_outerStart]+m_matrix.innerNonZeros(m_outerStart)-1];
     }
 
 //     template<typename Sparse>
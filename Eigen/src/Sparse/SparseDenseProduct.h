@@ -145,6 +145,179 @@ struct ei_traits<SparseTimeDenseProduct<Lhs,Rhs> >
   typedef MatrixXpr XprKind;
 };
 
+/** \internal dest += alpha * lhs * rhs restricted to the outer vectors \a start to \a end-1 of \a lhs */
+template<typename Lhs, typename Rhs, typename Dest>
+void ei_sparse_time_dense_product_outer_range(const Lhs& lhs, const Rhs& rhs, Dest& dest, typename Dest::Scalar alpha,
+                                              typename Lhs::Index start, typename Lhs::Index end)
+{
+  typedef typename Lhs::Index Index;
+  typedef typename Lhs::InnerIterator LhsInnerIterator;
+  enum { LhsIsRowMajor = (Lhs::Flags&RowMajorBit)==RowMajorBit };
+  for(Index j=start; j<end; ++j)
+  {
+    typename Rhs::Scalar rhs_j = alpha * rhs.coeff(j,0);
+    typename Dest::RowXpr dest_j(dest.row(LhsIsRowMajor ? j : 0));
+    for(LhsInnerIterator it(lhs,j); it ;++it)
+    {
+      if(LhsIsRowMajor)                   dest_j += (alpha*it.value()) * rhs.row(it.index());
+      else if(Rhs::ColsAtCompileTime==1)  dest.coeffRef(it.index(),0) += it.value() * rhs_j;
+      else                                dest.row(it.index()) += (alpha*it.value()) * rhs.row(j);
+    }
+  }
+}
+
+/** \internal Computes a share of a parallel sparse times dense product.
+  *
+  * In the first phase, each thread processes the outer vectors of \a lhs between \a starts[id] and
+  * \a starts[id+1]. With a row major \a lhs, the threads write distinct rows of \a dest. Otherwise,
+  * the first thread accumulates into \a dest and the other ones into private slices of \a buffer,
+  * which are summed into \a dest by the second phase, the threads then processing distinct rows.
+  */
+template<typename Lhs, typename Rhs, typename Dest>
+class ei_sparse_time_dense_task
+{
+    typedef typename Lhs::Index Index;
+    typedef typename Dest::Scalar Scalar;
+  public:
+    typedef Map<Matrix<Scalar,Dynamic,Dynamic,(Dest::Flags&RowMajorBit) ? RowMajor : ColMajor> > BufferType;
+
+    ei_sparse_time_dense_task(const Lhs& lhs, const Rhs& rhs, Dest& dest, Scalar alpha,
+                              const Index* starts, BufferType* buffer, int phase, int threads)
+      : m_lhs(lhs), m_rhs(rhs), m_dest(dest), m_alpha(alpha), m_starts(starts), m_buffer(buffer), m_phase(phase),
+        m_threads(threads)
+    {}
+
+    void operator()(int id) const
+    {
+      const Index rows = m_dest.rows(), cols = m_dest.cols();
+      if(m_phase==0)
+      {
+        if(id==0 || m_buffer==0)
+          ei_sparse_time_dense_product_outer_range(m_lhs, m_rhs, m_dest, m_alpha, m_starts[id], m_starts[id+1]);
+        else
+        {
+          Block<BufferType> partial(*m_buffer, 0, (id-1)*cols, rows, cols);
+          partial.setZero();
+          ei_sparse_time_dense_product_outer_range(m_lhs, m_rhs, partial, m_alpha, m_starts[id], m_starts[id+1]);
+        }
+      }
+      else
+      {
+        Index r0 = (rows*id)/m_threads;
+        Index r1 = (rows*(id+1))/m_threads;
+        for(Index k=1; k<m_threads; ++k)
+          m_dest.middleRows(r0, r1-r0) += m_buffer->block(r0, (k-1)*cols, r1-r0, cols);
+      }
+    }
+
+  protected:
+    const Lhs& m_lhs;
+    const Rhs& m_rhs;
+    Dest& m_dest;
+    Scalar m_alpha;
+    const Index* m_starts;
+    BufferType* m_buffer;
+    int m_phase;
+    int m_threads;
+};
+
+/** \internal
+  * Performs dest += alpha * lhs * rhs, processing the columns of \a rhs at once.
+  *
+  * When Eigen is allowed to use several threads and \a lhs exposes its compressed storage, the outer
+  * vectors of \a lhs are split among the threads such that each of them gets the same number of
+  * nonzeros, using the ThreadPool if any, or OpenMP. Each thread processes at least
+  * EIGEN_TUNE_PARALLEL_THREAD_COST multiply-adds.
+  */
+template<typename Lhs, typename Rhs, typename Dest>
+void ei_sparse_time_dense_product_columns(const Lhs& lhs, const Rhs& rhs, Dest& dest, typename Dest::Scalar alpha)
+{
+  typedef typename Lhs::Index Index;
+  typedef typename Dest::Scalar Scalar;
+  enum { LhsIsRowMajor = (Lhs::Flags&RowMajorBit)==RowMajorBit };
+
+  const Index outerSize = lhs.outerSize();
+  const Index* outerIndex = ei_sparse_outer_index<Lhs>::get(lhs);
+  const int threads = outerIndex ? ei_parallel_threads(double(outerIndex[outerSize]-outerIndex[0]) * double(rhs.cols())) : 1;
+
+  if(threads<=1)
+  {
+    ei_sparse_time_dense_product_outer_range(lhs, rhs, dest, alpha, 0, outerSize);
+    return;
+  }
+
+  // split the outer vectors such that each share has the same number of nonzeros
+  Index* starts = ei_aligned_stack_new(Index, threads+1);
+  const Index nnz = outerIndex[outerSize]-outerIndex[0];
+  starts[0] = 0;
+  for(int t=1; t<threads; ++t)
+  {
+    Index target = outerIndex[0] + Index((double(nnz)*t)/threads);
+    starts[t] = std::max<Index>(starts[t-1], Index(std::lower_bound(outerIndex, outerIndex+outerSize, target) - outerIndex));
+  }
+  starts[threads] = outerSize;
+
+  // the private slices of the threads, if any, are allocated on the stack when they are small enough
+  typedef typename ei_sparse_time_dense_task<Lhs,Rhs,Dest>::BufferType BufferType;
+  const Index bufferSize = LhsIsRowMajor ? 0 : dest.rows()*dest.cols()*(threads-1);
+  Scalar* bufferData = ei_aligned_stack_new(Scalar, bufferSize);
+  BufferType buffer(bufferData, dest.rows(), LhsIsRowMajor ? 0 : dest.cols()*(threads-1));
+
+  for(int phase=0; phase<(LhsIsRowMajor?1:2); ++phase)
+    ei_parallel_for(0, threads, ei_sparse_time_dense_task<Lhs,Rhs,Dest>
+                                  (lhs, rhs, dest, alpha, starts, LhsIsRowMajor ? 0 : &buffer, phase, threads));
+
+  ei_aligned_stack_delete(Scalar, bufferData, bufferSize);
+  ei_aligned_stack_delete(Index, starts, threads+1);
+}
+
+/** \internal
+  * Performs dest += alpha * lhs * rhs.
+  *
+  * With several right hand sides, the sparse matrix is traversed once per panel of
+  * EIGEN_TUNE_SPARSE_PANEL_WIDTH columns, which are stored by rows such that the rows of the result are
+  * updated with packets. The remaining columns are processed by ei_sparse_time_dense_product_columns().
+  */
+template<typename _Lhs, typename Rhs, typename Dest>
+void ei_sparse_time_dense_product(const _Lhs& lhs, const Rhs& rhs, Dest& dest, typename Dest::Scalar alpha)
+{
+  typedef typename ei_cleantype<_Lhs>::type Lhs;
+  typedef typename Lhs::Index Index;
+  typedef typename Dest::Scalar Scalar;
+  enum {
+    RhsAndDestAreRowMajor = (Rhs::Flags&RowMajorBit) && (Dest::Flags&RowMajorBit),
+    PanelWidth = EIGEN_TUNE_SPARSE_PANEL_WIDTH
+  };
+
+  const Index panelCols = (Rhs::ColsAtCompileTime==1 || RhsAndDestAreRowMajor) ? 0 : (rhs.cols()/PanelWidth)*PanelWidth;
+  if(panelCols==0)
+  {
+    ei_sparse_time_dense_product_columns(lhs, rhs, dest, alpha);
+    return;
+  }
+
+  typedef Map<Matrix<Scalar,Dynamic,PanelWidth,RowMajor>, Aligned> Panel;
+  Scalar* rhsData = ei_aligned_stack_new(Scalar, rhs.rows()*PanelWidth);
+  Scalar* destData = ei_aligned_stack_new(Scalar, dest.rows()*PanelWidth);
+  Panel rhsPanel(rhsData, rhs.rows(), int(PanelWidth));
+  Panel destPanel(destData, dest.rows(), int(PanelWidth));
+  for(Index c=0; c<panelCols; c+=PanelWidth)
+  {
+    rhsPanel = rhs.middleCols(c,PanelWidth);
+    destPanel.setZero();
+    ei_sparse_time_dense_product_columns(lhs, rhsPanel, destPanel, alpha);
+    dest.middleCols(c,PanelWidth) += destPanel;
+  }
+  ei_aligned_stack_delete(Scalar, destData, dest.rows()*PanelWidth);
+  ei_aligned_stack_delete(Scalar, rhsData, rhs.rows()*PanelWidth);
+
+  if(panelCols<rhs.cols())
+  {
+    Block<Dest> remaining(dest, 0, panelCols, dest.rows(), dest.cols()-panelCols);
+    ei_sparse_time_dense_product_columns(lhs, rhs.rightCols(rhs.cols()-panelCols), remaining, alpha);
+  }
+}
+
 template<typename Lhs, typename Rhs>
 class SparseTimeDenseProduct
   : public ProductBase<SparseTimeDenseProduct<Lhs,Rhs>, Lhs, Rhs>
@@ -157,21 +330,7 @@ class SparseTimeDenseProduct
 
     template<typename Dest> void scaleAndAddTo(Dest& dest, Scalar alpha) const
     {
-      typedef typename ei_cleantype<Lhs>::type _Lhs;
-      typedef typename ei_cleantype<Rhs>::type _Rhs;
-      typedef typename _Lhs::InnerIterator LhsInnerIterator;
-      enum { LhsIsRowMajor = (_Lhs::Flags&RowMajorBit)==RowMajorBit };
-      for(Index j=0; j<m_lhs.outerSize(); ++j)
-      {
-        typename Rhs::Scalar rhs_j = alpha * m_rhs.coeff(j,0);
-        Block<Dest,1,Dest::ColsAtCompileTime> dest_j(dest.row(LhsIsRowMajor ? j : 0));
-        for(LhsInnerIterator it(m_lhs,j); it ;++it)
-        {
-          if(LhsIsRowMajor)                   dest_j += (alpha*it.value()) * m_rhs.row(it.index());
-          else if(Rhs::ColsAtCompileTime==1)  dest.coeffRef(it.index()) += it.value() * rhs_j;
-          else                                dest.row(it.index()) += (alpha*it.value()) * m_rhs.row(j);
-        }
-      }
+      ei_sparse_time_dense_product(m_lhs, m_rhs, dest, alpha);
     }
 
   private:
@@ -34,6 +34,13 @@
   * This class implements a sparse matrix using the very common compressed row/column storage
   * scheme.
   *
+  * In addition to this \em compressed mode, a matrix can be switched to an \em uncompressed mode
+  * by reserving some room per inner vector with reserve(const DenseBase<SizesType>&). Each inner
+  * vector then owns some free room after its nonzeros, and their number is stored in a separate
+  * array. In this mode, insert() only moves the coefficients of the inner vector being filled,
+  * whatever the insertion order. makeCompressed() gets back to the compressed mode, which is
+  * required by the low level algorithms and the external backends.
+  *
   * \param _Scalar the scalar type, i.e. the type of the coefficients
   * \param _Options Union of bit flags controlling the storage scheme. Currently the only possibility
   *                 is RowMajor. The default is 0 which means column-major.
@@ -83,6 +90,7 @@ class SparseMatrix
     Index m_outerSize;
     Index m_innerSize;
     Index* m_outerIndex;
+    Index* m_innerNonZeros;     // optional, if null then the data is compressed
     CompressedStorage<Scalar,Index> m_data;
 
   public:
@@ -92,7 +100,12 @@ class SparseMatrix
 
     inline Index innerSize() const { return m_innerSize; }
     inline Index outerSize() const { return m_outerSize; }
-    inline Index innerNonZeros(Index j) const { return m_outerIndex[j+1]-m_outerIndex[j]; }
+    inline Index innerNonZeros(Index j) const
+    { return m_innerNonZeros ? m_innerNonZeros[j] : m_outerIndex[j+1]-m_outerIndex[j]; }
+
+    /** \returns whether \c *this is in compressed form, i.e., without any free room between
+      * its inner vectors. \sa makeCompressed(), reserve(const DenseBase<SizesType>&) */
+    inline bool isCompressed() const { return m_innerNonZeros==0; }
 
     inline const Scalar* _valuePtr() const { return &m_data.value(0); }
     inline Scalar* _valuePtr() { return &m_data.value(0); }
@@ -103,6 +116,11 @@ class SparseMatrix
     inline const Index* _outerIndexPtr() const { return m_outerIndex; }
     inline Index* _outerIndexPtr() { return m_outerIndex; }
 
+    /** \internal \returns the number of nonzeros of each inner vector in uncompressed mode, or
+      * a null pointer in compressed mode */
+    inline const Index* _innerNonZeroPtr() const { return m_innerNonZeros; }
+    inline Index* _innerNonZeroPtr() { return m_innerNonZeros; }
+
     inline Storage& data() { return m_data; }
     inline const Storage& data() const { return m_data; }
 
@@ -110,7 +128,8 @@ class SparseMatrix
     {
       const Index outer = IsRowMajor ? row : col;
       const Index inner = IsRowMajor ? col : row;
-      return m_data.atInRange(m_outerIndex[outer], m_outerIndex[outer+1], inner);
+      Index end = m_innerNonZeros ? m_outerIndex[outer] + m_innerNonZeros[outer] : m_outerIndex[outer+1];
+      return m_data.atInRange(m_outerIndex[outer], end, inner);
     }
 
     inline Scalar& coeffRef(Index row, Index col)
@@ -119,7 +138,7 @@ class SparseMatrix
       const Index inner = IsRowMajor ? col : row;
 
       Index start = m_outerIndex[outer];
-      Index end = m_outerIndex[outer+1];
+      Index end = m_innerNonZeros ? m_outerIndex[outer] + m_innerNonZeros[outer] : m_outerIndex[outer+1];
       ei_assert(end>=start && "you probably called coeffRef on a non finalized matrix");
       ei_assert(end>start && "coeffRef cannot be called on a zero coefficient");
       const Index id = m_data.searchLowerIndex(start,end-1,inner);
@@ -131,22 +150,124 @@ class SparseMatrix
 
     class InnerIterator;
 
-    /** Removes all non zeros */
+    /** Removes all non zeros, and gets back to the compressed mode */
     inline void setZero()
     {
       m_data.clear();
       memset(m_outerIndex, 0, (m_outerSize+1)*sizeof(Index));
+      delete[] m_innerNonZeros;
+      m_innerNonZeros = 0;
     }
 
     /** \returns the number of non zero coefficients */
-    inline Index nonZeros() const  { return static_cast<Index>(m_data.size()); }
+    inline Index nonZeros() const
+    {
+      if(m_innerNonZeros)
+      {
+        Index nnz = 0;
+        for(Index j=0; j<m_outerSize; ++j)
+          nnz += m_innerNonZeros[j];
+        return nnz;
+      }
+      return static_cast<Index>(m_data.size());
+    }
 
     /** Preallocates \a reserveSize non zeros */
     inline void reserve(Index reserveSize)
     {
+      ei_assert(isCompressed() && "This function does not make sense in uncompressed mode.");
       m_data.reserve(reserveSize);
     }
 
+    /** Preallocates room for at least \a reserveSizes[j] additional nonzeros in the j-th inner
+      * vector, and switches \c *this to the uncompressed mode. The current nonzeros are preserved.
+      *
+      * This is the way to go to fill a matrix in any order with insert(): if the estimates are
+      * large enough, each insertion only moves the coefficients of its own inner vector.
+      *
+      * \sa insert(), makeCompressed() */
+    template<typename SizesType>
+    void reserve(const DenseBase<SizesType>& reserveSizes)
+    {
+      ei_assert(Index(reserveSizes.size())==m_outerSize);
+      Index* newOuterIndex = new Index[m_outerSize+1];
+      Index count = 0;
+      for(Index j=0; j<m_outerSize; ++j)
+      {
+        newOuterIndex[j] = count;
+        Index alreadyReserved = (m_outerIndex[j+1]-m_outerIndex[j]) - innerNonZeros(j);
+        count += std::max<Index>(reserveSizes.coeff(j), alreadyReserved) + innerNonZeros(j);
+      }
+      newOuterIndex[m_outerSize] = count;
+
+      if(count>Index(m_data.allocatedSize()))
+      {
+        // move the inner vectors to a new buffer
+        Storage newData(count);
+        for(Index j=0; j<m_outerSize; ++j)
+        {
+          Index size = innerNonZeros(j);
+          if(size>0)
+          {
+            memcpy(&newData.value(newOuterIndex[j]), &m_data.value(m_outerIndex[j]), size*sizeof(Scalar));
+            memcpy(&newData.index(newOuterIndex[j]), &m_data.index(m_outerIndex[j]), size*sizeof(Index));
+          }
+        }
+        m_data.swap(newData);
+      }
+      else
+      {
+        // the inner vectors only move forward, so let's start from the last one
+        m_data.resize(count);
+        for(Index j=m_outerSize-1; j>=0; --j)
+        {
+          Index offset = newOuterIndex[j] - m_outerIndex[j];
+          if(offset>0)
+            for(Index i=innerNonZeros(j)-1; i>=0; --i)
+            {
+              m_data.index(newOuterIndex[j]+i) = m_data.index(m_outerIndex[j]+i);
+              m_data.value(newOuterIndex[j]+i) = m_data.value(m_outerIndex[j]+i);
+            }
+        }
+      }
+
+      if(!m_innerNonZeros)
+      {
+        m_innerNonZeros = new Index[m_outerSize];
+        for(Index j=0; j<m_outerSize; ++j)
+          m_innerNonZeros[j] = m_outerIndex[j+1]-m_outerIndex[j];
+      }
+      std::swap(m_outerIndex, newOuterIndex);
+      delete[] newOuterIndex;
+    }
+
+    /** Turns \c *this into the compressed mode, removing the free room between the inner vectors.
+      * \sa reserve(const DenseBase<SizesType>&), isCompressed() */
+    void makeCompressed()
+    {
+      if(isCompressed())
+        return;
+      Index count = 0;
+      for(Index j=0; j<m_outerSize; ++j)
+      {
+        Index start = m_outerIndex[j];
+        Index size = m_innerNonZeros[j];
+        m_outerIndex[j] = count;
+        if(start>count)
+          for(Index i=0; i<size; ++i)
+          {
+            m_data.index(count+i) = m_data.index(start+i);
+            m_data.value(count+i) = m_data.value(start+i);
+          }
+        count += size;
+      }
+      m_outerIndex[m_outerSize] = count;
+      delete[] m_innerNonZeros;
+      m_innerNonZeros = 0;
+      m_data.resize(count);
+      m_data.squeeze();
+    }
+
     //--- low level purely coherent filling ---
 
     /** \returns a reference to the non zero coefficient at position \a row, \a col assuming that:
@@ -166,6 +287,7 @@ class SparseMatrix
     /** \sa insertBack, startVec */
     inline Scalar& insertBackByOuterInner(Index outer, Index inner)
     {
+      ei_assert(isCompressed() && "insertBack requires a compressed matrix, use insert() instead");
       ei_assert(size_t(m_outerIndex[outer+1]) == m_data.size() && "Invalid ordered insertion (invalid outer index)");
       ei_assert( (m_outerIndex[outer+1]-m_outerIndex[outer]==0 || m_data.index(m_data.size()-1)<inner) && "Invalid ordered insertion (invalid inner index)");
       Index id = m_outerIndex[outer+1];
@@ -177,6 +299,7 @@ class SparseMatrix
     /** \warning use it only if you know what you are doing */
     inline Scalar& insertBackByOuterInnerUnordered(Index outer, Index inner)
     {
+      ei_assert(isCompressed() && "insertBack requires a compressed matrix, use insert() instead");
       Index id = m_outerIndex[outer+1];
       ++m_outerIndex[outer+1];
       m_data.append(0, inner);
@@ -186,6 +309,7 @@ class SparseMatrix
     /** \sa insertBack, insertBackByOuterInner */
     inline void startVec(Index outer)
     {
+      ei_assert(isCompressed() && "startVec cannot be used in uncompressed mode, call makeCompressed() first");
       ei_assert(m_outerIndex[outer]==int(m_data.size()) && "You must call startVec for each inner vector sequentially");
       ei_assert(m_outerIndex[outer+1]==0 && "You must call startVec for each inner vector sequentially");
       m_outerIndex[outer+1] = m_outerIndex[outer];
@@ -196,16 +320,21 @@ class SparseMatrix
     /** \returns a reference to a novel non zero coefficient with coordinates \a row x \a col.
       * The non zero coefficient must \b not already exist.
       *
-      * \warning This function can be extremely slow if the non zero coefficients
-      * are not inserted in a coherent order.
+      * \warning In compressed mode, this function can be extremely slow if the non zero
+      * coefficients are not inserted in a coherent order. In uncompressed mode, the cost of an
+      * insertion is proportional to the number of nonzeros of the target inner vector, as long as
+      * this vector has some free room left, see reserve(const DenseBase<SizesType>&).
       *
-      * After an insertion session, you should call the finalize() function.
+      * After an insertion session in compressed mode, you should call the finalize() function.
       */
     EIGEN_DONT_INLINE Scalar& insert(Index row, Index col)
     {
       const Index outer = IsRowMajor ? row : col;
       const Index inner = IsRowMajor ? col : row;
 
+      if(m_innerNonZeros)
+        return insertUncompressed(outer, inner);
+
       Index previousOuter = outer;
       if (m_outerIndex[outer+1]==0)
       {
@@ -305,13 +434,51 @@ class SparseMatrix
       return (m_data.value(id) = 0);
     }
 
+  protected:
+
+    /** \internal insertion in uncompressed mode, doubling the room of the inner vector when it is full */
+    Scalar& insertUncompressed(Index outer, Index inner)
+    {
+      Index room = m_outerIndex[outer+1] - m_outerIndex[outer];
+      Index innerNNZ = m_innerNonZeros[outer];
+      if(innerNNZ>=room)
+      {
+        // this inner vector is full, we need to reallocate the whole buffer
+        Matrix<Index,Dynamic,1> sizes = Matrix<Index,Dynamic,1>::Zero(m_outerSize);
+        sizes[outer] = std::max<Index>(2, innerNNZ);
+        reserve(sizes);
+      }
+
+      Index start = m_outerIndex[outer];
+      Index p = start + m_innerNonZeros[outer];
+      while( (p > start) && (m_data.index(p-1) > inner) )
+      {
+        m_data.index(p) = m_data.index(p-1);
+        m_data.value(p) = m_data.value(p-1);
+        --p;
+      }
+      ei_assert((p<=start || m_data.index(p-1)!=inner) && "you cannot insert an element that already exists, you must call coeffRef to this end");
+
+      m_innerNonZeros[outer]++;
+      m_data.index(p) = inner;
+      return (m_data.value(p) = 0);
+    }
+
+  public:
+
 
 
 
-    /** Must be called after inserting a set of non zero entries.
+    template<typename InputIterators>
+    void setFromTriplets(const InputIterators& begin, const InputIterators& end);
+
+    /** Must be called after inserting a set of non zero entries in compressed mode.
+      * It has no effect in uncompressed mode.
       */
     inline void finalize()
     {
+      if(m_innerNonZeros)
+        return;
       Index size = static_cast<Index>(m_data.size());
       Index i = m_outerSize;
       // find the last filled column
@@ -332,8 +499,8 @@ class SparseMatrix
       for (Index j=0; j<m_outerSize; ++j)
       {
         Index previousStart = m_outerIndex[j];
+        Index end = previousStart + innerNonZeros(j);
         m_outerIndex[j] = k;
-        Index end = m_outerIndex[j+1];
         for (Index i=previousStart; i<end; ++i)
         {
           if (!ei_isMuchSmallerThan(m_data.value(i), reference, epsilon))
@@ -346,6 +513,8 @@ class SparseMatrix
       }
       m_outerIndex[m_outerSize] = k;
       m_data.resize(k,0);
+      delete[] m_innerNonZeros;
+      m_innerNonZeros = 0;
     }
 
     /** Resizes the matrix to a \a rows x \a cols matrix and initializes it to zero
@@ -356,6 +525,8 @@ class SparseMatrix
       const Index outerSize = IsRowMajor ? rows : cols;
       m_innerSize = IsRowMajor ? cols : rows;
       m_data.clear();
+      delete[] m_innerNonZeros;
+      m_innerNonZeros = 0;
       if (m_outerSize != outerSize || m_outerSize==0)
       {
         delete[] m_outerIndex;
@@ -374,14 +545,14 @@ class SparseMatrix
 
     /** Default constructor yielding an empty \c 0 \c x \c 0 matrix */
     inline SparseMatrix()
-      : m_outerSize(-1), m_innerSize(0), m_outerIndex(0)
+      : m_outerSize(-1), m_innerSize(0), m_outerIndex(0), m_innerNonZeros(0)
     {
       resize(0, 0);
     }
 
     /** Constructs a \a rows \c x \a cols empty matrix */
     inline SparseMatrix(Index rows, Index cols)
-      : m_outerSize(0), m_innerSize(0), m_outerIndex(0)
+      : m_outerSize(0), m_innerSize(0), m_outerIndex(0), m_innerNonZeros(0)
     {
       resize(rows, cols);
     }
@@ -389,14 +560,14 @@ class SparseMatrix
     /** Constructs a sparse matrix from the sparse expression \a other */
     template<typename OtherDerived>
     inline SparseMatrix(const SparseMatrixBase<OtherDerived>& other)
-      : m_outerSize(0), m_innerSize(0), m_outerIndex(0)
+      : m_outerSize(0), m_innerSize(0), m_outerIndex(0), m_innerNonZeros(0)
     {
       *this = other.derived();
     }
 
     /** Copy constructor */
     inline SparseMatrix(const SparseMatrix& other)
-      : Base(), m_outerSize(0), m_innerSize(0), m_outerIndex(0)
+      : Base(), m_outerSize(0), m_innerSize(0), m_outerIndex(0), m_innerNonZeros(0)
     {
       *this = other.derived();
     }
@@ -406,6 +577,7 @@ class SparseMatrix
     {
       //EIGEN_DBG_SPARSE(std::cout << "SparseMatrix:: swap\n");
       std::swap(m_outerIndex, other.m_outerIndex);
+      std::swap(m_innerNonZeros, other.m_innerNonZeros);
       std::swap(m_innerSize, other.m_innerSize);
       std::swap(m_outerSize, other.m_outerSize);
       m_data.swap(other.m_data);
@@ -417,6 +589,13 @@ class SparseMatrix
       if (other.isRValue())
       {
         swap(other.const_cast_derived());
+        // like the copies, the result is compressed
+        makeCompressed();
+      }
+      else if (!other.isCompressed())
+      {
+        // the copy is compressed
+        Base::operator=(other);
       }
       else
       {
@@ -515,6 +694,7 @@ class SparseMatrix
     inline ~SparseMatrix()
     {
       delete[] m_outerIndex;
+      delete[] m_innerNonZeros;
     }
 
     /** Overloaded for performance */
@@ -576,12 +756,108 @@ class SparseMatrix
     EIGEN_DEPRECATED void endFill() { finalize(); }
 };
 
+/** Fills \c *this with the list of triplets defined by the iterator range \a begin - \a end.
+  *
+  * A \em triplet is a tuple (i,j,value) defining a non-zero element. The triplets can be given
+  * in any order, and the values of the triplets having the same coordinates are summed up. Any
+  * iterator whose value type provides the row(), col() and value() member functions, such as
+  * Triplet, is accepted, and the range is traversed twice.
+  *
+  * The current size of \c *this is kept, and its previous coefficients are removed. The triplets
+  * are sorted by a two-pass counting sort, first on the inner index and then on the outer one,
+  * such that the whole process runs in O(rows+cols+nnz), and the storage of \c *this is allocated
+  * only once. Building the matrix this way is much faster than a series of random insert().
+  *
+  * Example:
+  * \code
+  * typedef Triplet<double> T;
+  * std::vector<T> tripletList;
+  * tripletList.reserve(estimation_of_entries);
+  * for(...)
+  * {
+  *   // ...
+  *   tripletList.push_back(T(i,j,v_ij));
+  * }
+  * SparseMatrixType m(rows,cols);
+  * m.setFromTriplets(tripletList.begin(), tripletList.end());
+  * // m is ready to go!
+  * \endcode
+  */
+template<typename Scalar, int _Options, typename _Index>
+template<typename InputIterators>
+void SparseMatrix<Scalar,_Options,_Index>::setFromTriplets(const InputIterators& begin, const InputIterators& end)
+{
+  typedef Matrix<Index,Dynamic,1> IndexVector;
+
+  // count the triplets per inner and outer vectors
+  IndexVector innerStart = IndexVector::Zero(m_innerSize+1);
+  setZero();
+  Index nnz = 0;
+  for(InputIterators it(begin); it!=end; ++it, ++nnz)
+  {
+    ei_assert(it->row()>=0 && it->row()<rows() && it->col()>=0 && it->col()<cols());
+    ++m_outerIndex[(IsRowMajor ? it->row() : it->col())+1];
+    ++innerStart.coeffRef((IsRowMajor ? it->col() : it->row())+1);
+  }
+  for(Index j=0; j<m_outerSize; ++j)
+    m_outerIndex[j+1] += m_outerIndex[j];
+  for(Index i=0; i<m_innerSize; ++i)
+    innerStart.coeffRef(i+1) += innerStart.coeff(i);
+
+  // first pass: bucket the triplets by inner index
+  IndexVector tmpOuter(nnz);
+  Matrix<Scalar,Dynamic,1> tmpValue(nnz);
+  for(InputIterators it(begin); it!=end; ++it)
+  {
+    Index k = innerStart.coeffRef(IsRowMajor ? it->col() : it->row())++;
+    tmpOuter.coeffRef(k) = IsRowMajor ? it->row() : it->col();
+    tmpValue.coeffRef(k) = it->value();
+  }
+
+  // second pass: scatter the buckets into the outer vectors, such that the inner indices
+  // come sorted, and the duplicates are consecutive and summed up
+  m_data.resize(nnz);
+  IndexVector pos = Eigen::Map<IndexVector>(m_outerIndex, m_outerSize);
+  for(Index i=0, k=0; i<m_innerSize; ++i)
+  {
+    for(; k<innerStart.coeff(i); ++k)
+    {
+      const Index j = tmpOuter.coeff(k);
+      Index p = pos.coeff(j);
+      if(p>m_outerIndex[j] && m_data.index(p-1)==i)
+        m_data.value(p-1) += tmpValue.coeff(k);
+      else
+      {
+        m_data.index(p) = i;
+        m_data.value(p) = tmpValue.coeff(k);
+        pos.coeffRef(j) = p+1;
+      }
+    }
+  }
+
+  // remove the gaps left by the duplicates
+  Index count = 0;
+  for(Index j=0; j<m_outerSize; ++j)
+  {
+    Index start = m_outerIndex[j];
+    m_outerIndex[j] = count;
+    for(Index p=start; p<pos.coeff(j); ++p, ++count)
+    {
+      m_data.index(count) = m_data.index(p);
+      m_data.value(count) = m_data.value(p);
+    }
+  }
+  m_outerIndex[m_outerSize] = count;
+  m_data.resize(count);
+}
+
 template<typename Scalar, int _Options, typename _Index>
 class SparseMatrix<Scalar,_Options,_Index>::InnerIterator
 {
   public:
     InnerIterator(const SparseMatrix& mat, Index outer)
-      : m_values(mat._valuePtr()), m_indices(mat._innerIndexPtr()), m_outer(outer), m_id(mat.m_outerIndex[outer]), m_end(mat.m_outerIndex[outer+1])
+      : m_values(mat._valuePtr()), m_indices(mat._innerIndexPtr()), m_outer(outer), m_id(mat.m_outerIndex[outer]),
+        m_end(mat.m_innerNonZeros ? m_id + mat.m_innerNonZeros[outer] : mat.m_outerIndex[outer+1])
     {}
 
     inline InnerIterator& operator++() { m_id++; return *this; }
@@ -110,7 +110,7 @@ static void ei_sparse_product_impl2(const Lhs& lhs, const Rhs& rhs, ResultType&
 
 // perform a pseudo in-place sparse * sparse product assuming all matrices are col major
 template<typename Lhs, typename Rhs, typename ResultType>
-static void ei_sparse_product_impl(const Lhs& lhs, const Rhs& rhs, ResultType& res)
+static void ei_sparse_product_serial_impl(const Lhs& lhs, const Rhs& rhs, ResultType& res)
 {
 //   return ei_sparse_product_impl2(lhs,rhs,res);
 
@@ -131,7 +131,10 @@ static void ei_sparse_product_impl(const Lhs& lhs, const Rhs& rhs, ResultType& r
   float avgNnzPerRhsColumn = float(rhs.nonZeros())/float(cols);
   float ratioRes = std::min(ratioLhs * avgNnzPerRhsColumn, 1.f);
 
-  res.resize(rows, cols);
+  if(ei_traits<ResultType>::Flags&RowMajorBit)
+    res.resize(cols, rows);
+  else
+    res.resize(rows, cols);
   res.reserve(Index(ratioRes*rows*cols));
   for (Index j=0; j<cols; ++j)
   {
@@ -158,6 +161,203 @@ static void ei_sparse_product_impl(const Lhs& lhs, const Rhs& rhs, ResultType& r
   res.finalize();
 }
 
+/** \internal Computes a share of a two-phase sparse * sparse product.
+  *
+  * Each thread processes the outer vectors of the result between \a starts[id] and \a starts[id+1]-1.
+  * In the first phase, the number of nonzeros of each of them is computed into \a outer[j+1] using a
+  * marker array. In the second phase, the values are accumulated into an AmbiVector and written
+  * at their final position in \a inner and \a values, starting at \a outer[j]. Since small values
+  * are pruned, the number of actually written coefficients is stored into \a written[j].
+  */
+template<typename Lhs, typename Rhs, typename Scalar, typename Index>
+class ei_sparse_sparse_product_task
+{
+  public:
+    ei_sparse_sparse_product_task(const Lhs& lhs, const Rhs& rhs, Index rows, const Index* starts,
+                                  Index* outer, Index* inner, Scalar* values, Index* written, int phase)
+      : m_lhs(lhs), m_rhs(rhs), m_rows(rows), m_starts(starts),
+        m_outer(outer), m_inner(inner), m_values(values), m_written(written), m_phase(phase)
+    {}
+
+    void operator()(int id) const
+    {
+      const Index start = m_starts[id], end = m_starts[id+1];
+      if(start==end)
+        return;
+      if(m_phase==0)
+      {
+        std::vector<Index> mask(m_rows,-1);
+        for(Index j=start; j<end; ++j)
+        {
+          Index nnz = 0;
+          for(typename Rhs::InnerIterator rhsIt(m_rhs, j); rhsIt; ++rhsIt)
+            for(typename Lhs::InnerIterator lhsIt(m_lhs, rhsIt.index()); lhsIt; ++lhsIt)
+            {
+              const Index i = lhsIt.index();
+              if(mask[i]!=j)
+              {
+                mask[i] = j;
+                ++nnz;
+              }
+            }
+          m_outer[j+1] = nnz;
+        }
+      }
+      else
+      {
+        AmbiVector<Scalar,Index> tempVector(m_rows);
+        for(Index j=start; j<end; ++j)
+        {
+          // the exact number of nonzeros of the column tells which mode of the accumulator is best
+          tempVector.init(double(m_outer[j+1]-m_outer[j])/double(m_rows));
+          tempVector.setZero();
+          for(typename Rhs::InnerIterator rhsIt(m_rhs, j); rhsIt; ++rhsIt)
+          {
+            tempVector.restart();
+            Scalar x = rhsIt.value();
+            for(typename Lhs::InnerIterator lhsIt(m_lhs, rhsIt.index()); lhsIt; ++lhsIt)
+              tempVector.coeffRef(lhsIt.index()) += lhsIt.value() * x;
+          }
+          Index p = m_outer[j];
+          for(typename AmbiVector<Scalar,Index>::Iterator it(tempVector); it; ++it, ++p)
+          {
+            m_inner[p] = it.index();
+            m_values[p] = it.value();
+          }
+          m_written[j] = p - m_outer[j];
+        }
+      }
+    }
+
+  protected:
+    const Lhs& m_lhs;
+    const Rhs& m_rhs;
+    Index m_rows;
+    const Index* m_starts;
+    Index* m_outer;
+    Index* m_inner;
+    Scalar* m_values;
+    Index* m_written;
+    int m_phase;
+};
+
+template<typename Lhs, typename Rhs, typename ResultType>
+struct ei_sparse_product_two_phase
+{
+  // the result does not expose a compressed storage
+  static void run(const Lhs& lhs, const Rhs& rhs, ResultType& res)
+  {
+    ei_sparse_product_serial_impl<Lhs,Rhs,ResultType>(lhs, rhs, res);
+  }
+};
+
+/** \internal
+  * Two-phase sparse * sparse product into a SparseMatrix, assuming all matrices are col major.
+  *
+  * A symbolic phase computes the exact number of nonzeros of each outer vector of the result, such
+  * that its storage is allocated once, without any estimate. Then a numeric phase fills the outer
+  * vectors in place. Both phases split the outer vectors of the result among the threads such that
+  * each of them gets the same number of multiply-adds, using the ThreadPool if any, or OpenMP.
+  * When a single thread is used, this falls back to the one pass ei_sparse_product_serial_impl().
+  */
+template<typename Lhs, typename Rhs, typename Scalar, int Options, typename Index>
+struct ei_sparse_product_two_phase<Lhs,Rhs,SparseMatrix<Scalar,Options,Index> >
+{
+  typedef SparseMatrix<Scalar,Options,Index> ResultType;
+
+  static void run(const Lhs& lhs, const Rhs& rhs, ResultType& res)
+  {
+    // make sure to call innerSize/outerSize since we fake the storage order.
+    const Index rows = lhs.innerSize();
+    const Index cols = rhs.outerSize();
+    ei_assert(lhs.outerSize() == rhs.innerSize());
+
+    int threads = ei_parallel_threads();
+    Matrix<Index,Dynamic,1> starts;
+    if(threads>1 && cols>1)
+    {
+      // estimate the number of multiply-adds required by each outer vector of the result
+      const typename Lhs::Index* lhsOuter = ei_sparse_outer_index<Lhs>::get(lhs);
+      const double avgLhsNnz = lhsOuter ? 0. : double(lhs.nonZeros())/double(std::max<Index>(1,lhs.outerSize()));
+      std::vector<double> work(cols+1);
+      work[0] = 0;
+      for(Index j=0; j<cols; ++j)
+      {
+        double w = 1;
+        for(typename Rhs::InnerIterator rhsIt(rhs, j); rhsIt; ++rhsIt)
+          w += lhsOuter ? double(lhsOuter[rhsIt.index()+1]-lhsOuter[rhsIt.index()]) : avgLhsNnz;
+        work[j+1] = work[j] + w;
+      }
+      threads = int(std::min<double>(threads, std::max<double>(1, work[cols]/EIGEN_TUNE_PARALLEL_THREAD_COST)));
+      threads = std::min<int>(threads, cols);
+      starts.resize(threads+1);
+      starts[0] = 0;
+      for(int t=1; t<threads; ++t)
+      {
+        double target = (work[cols]*t)/threads;
+        starts[t] = std::max<Index>(starts[t-1], Index(std::lower_bound(work.begin()+1, work.end(), target) - work.begin()));
+        starts[t] = std::min<Index>(starts[t], cols);
+      }
+      starts[threads] = cols;
+    }
+    else
+      threads = 1;
+
+    // a single thread is better served by the one pass product
+    if(threads==1)
+    {
+      ei_sparse_product_serial_impl<Lhs,Rhs,ResultType>(lhs, rhs, res);
+      return;
+    }
+
+    if(ResultType::IsRowMajor)
+      res.resize(cols, rows);
+    else
+      res.resize(rows, cols);
+
+    Index* outer = res._outerIndexPtr();
+    std::vector<Index> written(cols);
+    for(int phase=0; phase<2; ++phase)
+    {
+      if(phase==1)
+      {
+        // allocate the exact storage
+        outer[0] = 0;
+        for(Index j=0; j<cols; ++j)
+          outer[j+1] += outer[j];
+        res.resizeNonZeros(outer[cols]);
+      }
+      ei_parallel_for(0, threads, ei_sparse_sparse_product_task<Lhs,Rhs,Scalar,Index>
+                                    (lhs, rhs, rows, starts.data(), outer, res._innerIndexPtr(), res._valuePtr(), &written[0], phase));
+    }
+
+    // squeeze out the room left by the pruned coefficients
+    Index nnz = 0;
+    for(Index j=0; j<cols; ++j)
+    {
+      const Index start = outer[j];
+      if(nnz!=start)
+      {
+        for(Index p=0; p<written[j]; ++p)
+        {
+          res._innerIndexPtr()[nnz+p] = res._innerIndexPtr()[start+p];
+          res._valuePtr()[nnz+p] = res._valuePtr()[start+p];
+        }
+      }
+      outer[j] = nnz;
+      nnz += written[j];
+    }
+    outer[cols] = nnz;
+    res.resizeNonZeros(nnz);
+  }
+};
+
+template<typename Lhs, typename Rhs, typename ResultType>
+static void ei_sparse_product_impl(const Lhs& lhs, const Rhs& rhs, ResultType& res)
+{
+  ei_sparse_product_two_phase<Lhs,Rhs,ResultType>::run(lhs, rhs, res);
+}
+
 template<typename Lhs, typename Rhs, typename ResultType,
   int LhsStorageOrder = ei_traits<Lhs>::Flags&RowMajorBit,
   int RhsStorageOrder = ei_traits<Rhs>::Flags&RowMajorBit,
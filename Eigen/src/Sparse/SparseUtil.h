@@ -88,6 +88,7 @@ template<typename _Scalar, int _Flags = 0, typename _Index = int>  class MappedS
 
 template<typename MatrixType, int Size>           class SparseInnerVectorSet;
 template<typename MatrixType, int Mode>           class SparseTriangularView;
+template<typename MatrixType, int Mode>           class LevelScheduledTriangularSolver;
 template<typename MatrixType, unsigned int UpLo>  class SparseSelfAdjointView;
 template<typename Lhs, typename Rhs>              class SparseDiagonalProduct;
 template<typename MatrixType> class SparseView;
@@ -123,4 +124,60 @@ template<typename T> struct ei_plain_matrix_type<T,Sparse>
     typedef SparseMatrix<_Scalar, _Flags> type;
 };
 
+/** \ingroup Sparse_Module
+  *
+  * \class Triplet
+  *
+  * \brief A small structure to hold a non zero as a triplet (i,j,value).
+  *
+  * \sa SparseMatrix::setFromTriplets()
+  */
+template<typename Scalar, typename Index=int>
+class Triplet
+{
+  public:
+    Triplet() : m_row(0), m_col(0), m_value(0) {}
+
+    Triplet(const Index& i, const Index& j, const Scalar& v = Scalar(0))
+      : m_row(i), m_col(j), m_value(v)
+    {}
+
+    /** \returns the row index of the element */
+    const Index& row() const { return m_row; }
+
+    /** \returns the column index of the element */
+    const Index& col() const { return m_col; }
+
+    /** \returns the value of the element */
+    const Scalar& value() const { return m_value; }
+
+  protected:
+    Index m_row, m_col;
+    Scalar m_value;
+};
+
+/** \internal \returns the outer index array of the compressed storage of \a mat, or a null
+  * pointer if \a mat is a generic sparse expression */
+template<typename MatrixType> struct ei_sparse_outer_index
+{
+  static const typename MatrixType::Index* get(const MatrixType&) { return 0; }
+};
+
+template<typename Scalar, int Options, typename Index> struct ei_sparse_outer_index<SparseMatrix<Scalar,Options,Index> >
+{
+  static const Index* get(const SparseMatrix<Scalar,Options,Index>& mat) { return mat.isCompressed() ? mat._outerIndexPtr() : 0; }
+};
+
+template<typename Scalar, int Options, typename Index> struct ei_sparse_outer_index<MappedSparseMatrix<Scalar,Options,Index> >
+{
+  static const Index* get(const MappedSparseMatrix<Scalar,Options,Index>& mat) { return mat._outerIndexPtr(); }
+};
+
+template<typename MatrixType> struct ei_sparse_outer_index<Transpose<MatrixType> >
+{
+  typedef typename ei_cleantype<MatrixType>::type _MatrixType;
+  static const typename _MatrixType::Index* get(const Transpose<MatrixType>& mat)
+  { return ei_sparse_outer_index<_MatrixType>::get(mat.nestedExpression()); }
+};
+
 #endif // EIGEN_SPARSEUTIL_H
@@ -160,6 +160,140 @@ struct ei_sparse_solve_triangular_selector<Lhs,Rhs,Mode,Upper,ColMajor>
   }
 };
 
+// Solvers processing a panel of right hand side columns stored by rows, such that each coefficient of
+// the sparse matrix is read once per panel, and the rows of the panel are updated with packets.
+template<typename Lhs, typename Panel, int Mode,
+  int UpLo = (Mode & Lower)
+           ? Lower
+           : (Mode & Upper)
+           ? Upper
+           : -1,
+  int StorageOrder = int(ei_traits<Lhs>::Flags) & RowMajorBit>
+struct ei_sparse_solve_triangular_panel_selector;
+
+// forward substitution, row-major
+template<typename Lhs, typename Panel, int Mode>
+struct ei_sparse_solve_triangular_panel_selector<Lhs,Panel,Mode,Lower,RowMajor>
+{
+  typedef typename Panel::Scalar Scalar;
+  static void run(const Lhs& lhs, Panel& other)
+  {
+    for(int i=0; i<lhs.rows(); ++i)
+    {
+      typename Panel::RowXpr row_i(other.row(i));
+      Scalar lastVal = 0;
+      int lastIndex = -1;
+      for(typename Lhs::InnerIterator it(lhs, i); it; ++it)
+      {
+        lastVal = it.value();
+        lastIndex = it.index();
+        if(lastIndex==i)
+          break;
+        row_i -= lastVal * other.row(lastIndex);
+      }
+      if (!(Mode & UnitDiag))
+      {
+        ei_assert(lastIndex==i);
+        row_i *= Scalar(1)/lastVal;
+      }
+    }
+  }
+};
+
+// backward substitution, row-major
+template<typename Lhs, typename Panel, int Mode>
+struct ei_sparse_solve_triangular_panel_selector<Lhs,Panel,Mode,Upper,RowMajor>
+{
+  typedef typename Panel::Scalar Scalar;
+  static void run(const Lhs& lhs, Panel& other)
+  {
+    for(int i=lhs.rows()-1 ; i>=0 ; --i)
+    {
+      typename Panel::RowXpr row_i(other.row(i));
+      typename Lhs::InnerIterator it(lhs, i);
+      Scalar diag = 1;
+      if (it && it.index() == i)
+      {
+        diag = it.value();
+        ++it;
+      }
+      else
+        ei_assert(Mode & UnitDiag);
+      for(; it; ++it)
+        row_i -= it.value() * other.row(it.index());
+      if (!(Mode & UnitDiag))
+        row_i *= Scalar(1)/diag;
+    }
+  }
+};
+
+// forward substitution, col-major
+template<typename Lhs, typename Panel, int Mode>
+struct ei_sparse_solve_triangular_panel_selector<Lhs,Panel,Mode,Lower,ColMajor>
+{
+  typedef typename Panel::Scalar Scalar;
+  typedef typename NumTraits<Scalar>::Real RealScalar;
+  static void run(const Lhs& lhs, Panel& other)
+  {
+    for(int i=0; i<lhs.cols(); ++i)
+    {
+      typename Panel::RowXpr row_i(other.row(i));
+      if (!row_i.isZero(RealScalar(0))) // optimization when other is actually sparse
+      {
+        typename Lhs::InnerIterator it(lhs, i);
+        if(!(Mode & UnitDiag))
+        {
+          ei_assert(it.index()==i);
+          row_i *= Scalar(1)/it.value();
+        }
+        if (it && it.index()==i)
+          ++it;
+        for(; it; ++it)
+          other.row(it.index()) -= it.value() * row_i;
+      }
+    }
+  }
+};
+
+// backward substitution, col-major
+template<typename Lhs, typename Panel, int Mode>
+struct ei_sparse_solve_triangular_panel_selector<Lhs,Panel,Mode,Upper,ColMajor>
+{
+  typedef typename Panel::Scalar Scalar;
+  typedef typename NumTraits<Scalar>::Real RealScalar;
+  static void run(const Lhs& lhs, Panel& other)
+  {
+    for(int i=lhs.cols()-1; i>=0; --i)
+    {
+      typename Panel::RowXpr row_i(other.row(i));
+      if (!row_i.isZero(RealScalar(0))) // optimization when other is actually sparse
+      {
+        if(!(Mode & UnitDiag))
+          row_i *= Scalar(1)/lhs.innerVector(i).lastCoeff();
+        typename Lhs::InnerIterator it(lhs, i);
+        for(; it && it.index()<i; ++it)
+          other.row(it.index()) -= it.value() * row_i;
+      }
+    }
+  }
+};
+
+/** \internal Solves in place the right hand sides \a other one column at a time */
+template<typename Lhs, int Mode, typename Other>
+void ei_sparse_solve_triangular_columns(const Lhs& lhs, Other& other)
+{
+  enum { copy = ei_traits<Other>::Flags & RowMajorBit };
+
+  typedef typename ei_meta_if<copy,
+    typename ei_plain_matrix_type_column_major<Other>::type, Other&>::ret OtherCopy;
+  OtherCopy otherCopy(other);
+
+  ei_sparse_solve_triangular_selector<Lhs, typename ei_unref<OtherCopy>::type, Mode>::run(lhs, otherCopy);
+
+  if (copy)
+    other = otherCopy;
+}
+
 template<typename ExpressionType,int Mode>
 template<typename OtherDerived>
 void SparseTriangularView<ExpressionType,Mode>::solveInPlace(MatrixBase<OtherDerived>& other) const
@@ -169,16 +303,34 @@ void SparseTriangularView<ExpressionType,Mode>::solveInPlace(MatrixBase<OtherDer
   ei_assert(!(Mode & ZeroDiag));
   ei_assert(Mode & (Upper|Lower));
 
-  enum { copy = ei_traits<OtherDerived>::Flags & RowMajorBit };
+  typedef typename OtherDerived::Index Index;
+  typedef typename OtherDerived::Scalar Scalar;
+  enum { PanelWidth = EIGEN_TUNE_SPARSE_PANEL_WIDTH };
 
-  typedef typename ei_meta_if<copy,
-    typename ei_plain_matrix_type_column_major<OtherDerived>::type, OtherDerived&>::ret OtherCopy;
-  OtherCopy otherCopy(other.derived());
+  // several right hand sides are solved by panels of columns, the remaining ones column by column
+  const Index panelCols = OtherDerived::ColsAtCompileTime==1 ? 0 : (other.cols()/PanelWidth)*PanelWidth;
+  if(panelCols==0)
+  {
+    ei_sparse_solve_triangular_columns<ExpressionType,Mode>(m_matrix, other.derived());
+    return;
+  }
 
-  ei_sparse_solve_triangular_selector<ExpressionType, typename ei_unref<OtherCopy>::type, Mode>::run(m_matrix, otherCopy);
+  typedef Map<Matrix<Scalar,Dynamic,PanelWidth,RowMajor>, Aligned> Panel;
+  Scalar* panelData = ei_aligned_stack_new(Scalar, other.rows()*PanelWidth);
+  Panel panel(panelData, other.rows(), int(PanelWidth));
+  for(Index c=0; c<panelCols; c+=PanelWidth)
+  {
+    panel = other.middleCols(c,PanelWidth);
+    ei_sparse_solve_triangular_panel_selector<ExpressionType, Panel, Mode>::run(m_matrix, panel);
+    other.middleCols(c,PanelWidth) = panel;
+  }
+  ei_aligned_stack_delete(Scalar, panelData, other.rows()*PanelWidth);
 
-  if (copy)
-    other = otherCopy;
+  if(panelCols<other.cols())
+  {
+    Block<OtherDerived> remaining(other.derived(), 0, panelCols, other.rows(), other.cols()-panelCols);
+    ei_sparse_solve_triangular_columns<ExpressionType,Mode>(m_matrix, remaining);
+  }
 }
 
 template<typename ExpressionType,int Mode>
@@ -304,6 +456,321 @@ void SparseTriangularView<ExpressionType,Mode>::solveInPlace(SparseMatrixBase<Ot
 //     other = otherCopy;
 }
 
+/** \internal
+  * Strictly triangular part of a sparse matrix accessed by rows, without copying it: the coefficients of the
+  * \a i-th row are the entries \a begin[i]+shift to \a end[i]-1 of \a inner and \a values, the latter being
+  * read through \a map if it is not null, and conjugated if \a Conjugate is true. This allows to solve with
+  * the rows of a factor stored by columns, or with a part of a factor sharing its storage with other ones.
+  */
+template<typename _Scalar, typename _Index, bool Conjugate = false>
+struct ei_sparse_triangular_rows
+{
+  typedef _Scalar Scalar;
+  typedef _Index Index;
+
+  ei_sparse_triangular_rows(const Index* _begin, const Index* _end, Index _shift, const Index* _inner,
+                            const Scalar* _values, const Index* _map = 0)
+    : begin(_begin), end(_end), shift(_shift), inner(_inner), values(_values), map(_map)
+  {}
+
+  inline Index first(Index i) const { return begin[i]+shift; }
+  inline Index last(Index i) const { return end[i]; }
+  inline Scalar value(Index p) const
+  {
+    const Scalar v = values[map ? map[p] : p];
+    return Conjugate ? ei_conj(v) : v;
+  }
+
+  const Index* begin;
+  const Index* end;
+  Index shift;
+  const Index* inner;
+  const Scalar* values;
+  const Index* map;
+};
+
+/** \internal Solves the \a i-th row of a triangular system whose strictly triangular part is \a strict,
+  * the diagonal being the identity if \a invDiag is null */
+template<typename Rows, typename Scalar, typename Dest>
+inline void ei_level_scheduled_solve_row(const Rows& strict, const Scalar* invDiag, typename Rows::Index i, Dest& other)
+{
+  typedef typename Rows::Index Index;
+  const Index first = strict.first(i), last = strict.last(i);
+  for(typename Dest::Index col=0; col<other.cols(); ++col)
+  {
+    Scalar tmp = other.coeff(i,col);
+    for(Index p=first; p<last; ++p)
+      tmp -= strict.value(p) * other.coeff(strict.inner[p],col);
+    other.coeffRef(i,col) = invDiag ? tmp * invDiag[i] : tmp;
+  }
+}
+
+/** \internal Solves the rows \a rows[begin] to \a rows[end-1] of a level scheduled triangular system */
+template<typename Rows, typename Scalar, typename Dest>
+void ei_level_scheduled_solve_rows(const Rows& strict, const Scalar* invDiag, const typename Rows::Index* rows,
+                                   typename Rows::Index begin, typename Rows::Index end, Dest& other)
+{
+  for(typename Rows::Index k=begin; k<end; ++k)
+    ei_level_scheduled_solve_row(strict, invDiag, rows[k], other);
+}
+
+/** \internal Solves the rows of one level of a level scheduled triangular system, each thread
+  * processing a contiguous share of them. */
+template<typename Rows, typename Scalar, typename Dest>
+class ei_level_scheduled_solve_task
+{
+    typedef typename Rows::Index Index;
+  public:
+    ei_level_scheduled_solve_task(const Rows& strict, const Scalar* invDiag, const Index* rows,
+                                  Index begin, Index end, Dest& other, int threads)
+      : m_strict(strict), m_invDiag(invDiag), m_rows(rows), m_begin(begin), m_end(end),
+        m_other(other), m_threads(threads)
+    {}
+
+    void operator()(int id) const
+    {
+      Index size = m_end - m_begin;
+      ei_level_scheduled_solve_rows(m_strict, m_invDiag, m_rows,
+                                    m_begin + (size*id)/m_threads, m_begin + (size*(id+1))/m_threads, m_other);
+    }
+
+  protected:
+    const Rows& m_strict;
+    const Scalar* m_invDiag;
+    const Index* m_rows;
+    Index m_begin, m_end;
+    Dest& m_other;
+    int m_threads;
+};
+
+/** \internal
+  * Level schedule of a sparse triangular system: the \a i-th unknown belongs to the level following the
+  * last level of the unknowns it depends on, such that all the unknowns of a level can be computed
+  * concurrently once the previous levels are solved. The schedule only depends on the sparsity pattern
+  * of the system, so that it can be reused by systems having the same pattern.
+  */
+template<typename Index>
+class ei_level_schedule
+{
+  public:
+    typedef Matrix<Index,Dynamic,1> IndexVector;
+
+    /** Analyzes the \a size x \a size system whose strictly triangular part is \a strict */
+    template<typename Rows>
+    void compute(const Rows& strict, Index size, bool isLower)
+    {
+      IndexVector level(size);
+      Index nbLevels = 0;
+      for(Index k=0; k<size; ++k)
+      {
+        const Index i = isLower ? k : size-1-k;
+        Index l = 0;
+        for(Index p=strict.first(i); p<strict.last(i); ++p)
+          l = std::max(l, level[strict.inner[p]]+1);
+        level[i] = l;
+        nbLevels = std::max(nbLevels, l+1);
+      }
+
+      // bucket sort of the unknowns by level
+      m_levelPtr.setZero(nbLevels+1);
+      for(Index i=0; i<size; ++i)
+        ++m_levelPtr[level[i]+1];
+      for(Index l=0; l<nbLevels; ++l)
+        m_levelPtr[l+1] += m_levelPtr[l];
+      m_levelRows.resize(size);
+      IndexVector fill = m_levelPtr.head(nbLevels);
+      for(Index i=0; i<size; ++i)
+        m_levelRows[fill[level[i]]++] = i;
+      m_isLower = isLower;
+    }
+
+    inline Index size() const { return m_levelRows.size(); }
+    inline Index levels() const { return m_levelPtr.size()-1; }
+    inline Index levelSize(Index l) const { return m_levelPtr[l+1]-m_levelPtr[l]; }
+
+    /** Solves in place the analyzed system, the diagonal being the identity if \a invDiag is null.
+      * When Eigen is allowed to use several threads, the levels having enough work are split among
+      * the threads. */
+    template<typename Rows, typename Scalar, typename OtherDerived>
+    void solveInPlace(const Rows& strict, const Scalar* invDiag, MatrixBase<OtherDerived>& other) const
+    {
+      ei_assert(other.rows()==size());
+
+      enum { copy = ei_traits<OtherDerived>::Flags & RowMajorBit };
+      typedef typename ei_meta_if<copy,
+        typename ei_plain_matrix_type_column_major<OtherDerived>::type, OtherDerived&>::ret OtherCopy;
+      typedef typename ei_cleantype<OtherCopy>::type Dest;
+      OtherCopy otherCopy(other.derived());
+      Dest& dest = otherCopy;
+
+      const int threads = ei_parallel_threads();
+      if(threads<=1)
+      {
+        // the natural order is a valid schedule with a better locality
+        for(Index k=0; k<size(); ++k)
+          ei_level_scheduled_solve_row(strict, invDiag, m_isLower ? k : size()-1-k, dest);
+        if (copy)
+          other = otherCopy;
+        return;
+      }
+
+      for(Index l=0; l<levels(); ++l)
+      {
+        const Index begin = m_levelPtr[l], end = m_levelPtr[l+1];
+        int levelThreads = 1;
+        if(end-begin>1)
+        {
+          double work = 0;
+          for(Index k=begin; k<end; ++k)
+            work += double(strict.last(m_levelRows[k])-strict.first(m_levelRows[k])+1);
+          work *= double(dest.cols());
+          levelThreads = int(std::min<double>(std::min<double>(threads, double(end-begin)),
+                                              std::max<double>(1, work/EIGEN_TUNE_PARALLEL_THREAD_COST)));
+        }
+        if(levelThreads<=1)
+        {
+          ei_level_scheduled_solve_rows(strict, invDiag, m_levelRows.data(), begin, end, dest);
+          continue;
+        }
+        ei_parallel_for(0, levelThreads, ei_level_scheduled_solve_task<Rows,Scalar,Dest>
+                                           (strict, invDiag, m_levelRows.data(), begin, end, dest, levelThreads));
+      }
+
+      if (copy)
+        other = otherCopy;
+    }
+
+  protected:
+    IndexVector m_levelPtr;     // position of the first unknown of each level in m_levelRows
+    IndexVector m_levelRows;    // the unknowns sorted by level
+    bool m_isLower;
+};
+
+/** \ingroup Sparse_Module
+  *
+  * \class LevelScheduledTriangularSolver
+  *
+  * \brief Parallel solver of sparse triangular systems based on level scheduling
+  *
+  * \param _MatrixType the type of the sparse triangular matrix
+  * \param _Mode either Lower or Upper, possibly combined with UnitDiag
+  *
+  * The unknowns of a triangular system are grouped into levels: the \a i-th unknown belongs to the
+  * level following the last level of the unknowns it depends on, such that all the unknowns of a
+  * level can be computed concurrently once the previous levels are solved.
+  *
+  * compute() performs this analysis once, and stores a row-major copy of the strictly triangular
+  * part of the matrix along with its inverted diagonal. solveInPlace() can then be called for as
+  * many right hand sides as needed. When Eigen is allowed to use several threads, the levels having
+  * enough work are split among the threads, using the ThreadPool if any, or OpenMP. Small levels are
+  * solved by the calling thread.
+  *
+  * Typical use cases are the repeated solves with the factors of an incomplete factorization:
+  * \code
+  * LevelScheduledTriangularSolver<SparseMatrix<double>, Lower> lower(L);
+  * lower.solveInPlace(x);
+  * \endcode
+  *
+  * \sa SparseTriangularView::solveInPlace()
+  */
+template<typename _MatrixType, int _Mode>
+class LevelScheduledTriangularSolver
+{
+  public:
+    typedef _MatrixType MatrixType;
+    typedef typename MatrixType::Scalar Scalar;
+    typedef typename MatrixType::Index Index;
+    typedef SparseMatrix<Scalar,RowMajor,Index> RowMajorMatrix;
+    typedef Matrix<Scalar,Dynamic,1> ScalarVector;
+    enum {
+      Mode = _Mode,
+      IsLower = (Mode&Lower)==Lower
+    };
+
+    LevelScheduledTriangularSolver() {}
+
+    LevelScheduledTriangularSolver(const MatrixType& matrix)
+    {
+      compute(matrix);
+    }
+
+    /** Analyzes the triangular part of \a matrix selected by \c Mode, and stores a copy of it. */
+    void compute(const MatrixType& matrix);
+
+    inline Index rows() const { return m_strict.rows(); }
+    inline Index cols() const { return m_strict.cols(); }
+
+    /** \returns the number of levels, i.e., the length of the critical path of the system */
+    inline Index levels() const { return m_schedule.levels(); }
+
+    /** \returns the number of unknowns of the level \a l */
+    inline Index levelSize(Index l) const { return m_schedule.levelSize(l); }
+
+    /** Solves the triangular system with the right hand sides \a other, in place. */
+    template<typename OtherDerived>
+    void solveInPlace(MatrixBase<OtherDerived>& other) const
+    {
+      ei_assert(other.rows()==rows());
+      m_schedule.solveInPlace(strictRows(), (Mode & UnitDiag) ? 0 : m_invDiag.data(), other);
+    }
+
+    /** \returns the solution of the triangular system with the right hand sides \a other */
+    template<typename OtherDerived>
+    typename ei_plain_matrix_type_column_major<OtherDerived>::type
+    solve(const MatrixBase<OtherDerived>& other) const
+    {
+      typename ei_plain_matrix_type_column_major<OtherDerived>::type res(other);
+      solveInPlace(res);
+      return res;
+    }
+
+  protected:
+    ei_sparse_triangular_rows<Scalar,Index> strictRows() const
+    {
+      const Index* outer = m_strict._outerIndexPtr();
+      return ei_sparse_triangular_rows<Scalar,Index>(outer, outer+1, 0, m_strict._innerIndexPtr(), m_strict._valuePtr());
+    }
+
+    RowMajorMatrix m_strict;    // strictly triangular part
+    ScalarVector m_invDiag;
+    ei_level_schedule<Index> m_schedule;
+};
+
+template<typename _MatrixType, int _Mode>
+void LevelScheduledTriangularSolver<_MatrixType,_Mode>::compute(const MatrixType& matrix)
+{
+  ei_assert(matrix.rows()==matrix.cols());
+  ei_assert((Mode & (Upper|Lower)) && !(Mode & ZeroDiag));
+  const Index size = matrix.rows();
+
+  // a row-major copy has sorted inner indices
+  const RowMajorMatrix rowMajor(matrix);
+
+  m_strict.resize(size, size);
+  m_strict.reserve(rowMajor.nonZeros());
+  m_invDiag.setOnes(size);
+  for(Index i=0; i<size; ++i)
+  {
+    m_strict.startVec(i);
+    bool hasDiag = false;
+    for(typename RowMajorMatrix::InnerIterator it(rowMajor, i); it; ++it)
+    {
+      if(it.index()==i)
+      {
+        m_invDiag[i] = Scalar(1) / it.value();
+        hasDiag = true;
+      }
+      else if(IsLower ? it.index()<i : it.index()>i)
+        m_strict.insertBack(i, it.index()) = it.value();
+    }
+    ei_assert((hasDiag || (Mode&UnitDiag)) && "the diagonal of the triangular matrix must be stored");
+    EIGEN_UNUSED_VARIABLE(hasDiag);
+  }
+  m_strict.finalize();
+
+  m_schedule.compute(strictRows(), size, IsLower);
+}
+
 #ifdef EIGEN2_SUPPORT
 
 // deprecated stuff:
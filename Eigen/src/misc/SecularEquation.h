@@ -0,0 +1,121 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Copyright (C) 2010 Gael Guennebaud <gael.guennebaud@inria.fr>
+//
+// Eigen is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// Alternatively, you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation; either version 2 of
+// the License, or (at your option) any later version.
+//
+// Eigen is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License or the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License and a copy of the GNU General Public License along with
+// Eigen. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef EIGEN_MISC_SECULAR_EQUATION_H
+#define EIGEN_MISC_SECULAR_EQUATION_H
+
+/** \internal Orders indices by increasing values of the referenced array */
+template<typename RealScalar, typename Index>
+struct ei_index_less
+{
+  ei_index_less(const RealScalar* values) : m_values(values) {}
+  bool operator()(Index a, Index b) const { return m_values[a] < m_values[b]; }
+  const RealScalar* m_values;
+};
+
+/** \internal
+  * Computes the root \f$ \tau \in ]lo,hi[ \f$ of the secular equation
+  *   \f[ 1/\rho + \sum_i z_i^2 / (\delta_i - \tau) = 0, \f]
+  * where the poles \a delta are increasing and shifted such that the root lies between \a delta[j]
+  * and \a delta[j+1] (or on the right of \a delta[k-1] if \a j is k-1), one of them being zero.
+  *
+  * The secular function is approximated by a rational function with two poles, and the iterations
+  * are safeguarded by bisection. If \a converged is not null, it is set to false when the maximal
+  * number of iterations is reached before convergence.
+  */
+template<typename RealScalar, typename Index>
+RealScalar ei_secular_equation_iterate(const RealScalar* delta, const RealScalar* z, Index k, RealScalar invRho,
+                                       Index j, RealScalar lo, RealScalar hi, bool* converged = 0)
+{
+  const RealScalar eps = NumTraits<RealScalar>::epsilon();
+  const int maxIterations = 100;
+
+  RealScalar tau = (lo+hi)/RealScalar(2);
+  int iter = 0;
+  for(; iter<maxIterations; ++iter)
+  {
+    // evaluate the secular function w = 1/rho + psi + phi, where psi gathers the poles on the left
+    // of the root, and phi the poles on its right, as well as their derivatives
+    RealScalar psi = 0, dpsi = 0, phi = 0, dphi = 0, absSum = 0;
+    for(Index i=0; i<=j; ++i)
+    {
+      RealScalar t = z[i] / (delta[i]-tau);
+      psi += z[i]*t;
+      dpsi += t*t;
+    }
+    for(Index i=j+1; i<k; ++i)
+    {
+      RealScalar t = z[i] / (delta[i]-tau);
+      phi += z[i]*t;
+      dphi += t*t;
+    }
+    absSum = invRho + ei_abs(psi) + ei_abs(phi);
+    RealScalar w = invRho + psi + phi;
+
+    if(w<0) lo = tau;
+    else    hi = tau;
+    if(ei_abs(w) <= RealScalar(8)*eps*absSum || hi-lo <= RealScalar(2)*eps*std::max(ei_abs(lo),ei_abs(hi)))
+      break;
+
+    // approximate psi by a + b/(delta_j-x) and phi by c + e/(delta_{j+1}-x), and solve
+    //   C (delta_j-x) (delta_{j+1}-x) + b (delta_{j+1}-x) + e (delta_j-x) = 0,  with C = 1/rho + a + c
+    RealScalar dj = delta[j] - tau;
+    RealScalar b = dpsi*dj*dj;
+    RealScalar C = invRho + psi - b/dj;
+    RealScalar e = 0, dnext = delta[j];
+    if(j<k-1)
+    {
+      RealScalar dj1 = delta[j+1] - tau;
+      e = dphi*dj1*dj1;
+      C += phi - e/dj1;
+      dnext = delta[j+1];
+    }
+    // one of delta[j] and dnext is zero, so that the constant term does not suffer from cancellation
+    RealScalar qa = C;
+    RealScalar qb = -(C*(delta[j]+dnext) + b + e);
+    RealScalar qc = C*delta[j]*dnext + b*dnext + e*delta[j];
+    RealScalar x;
+    if(qa==RealScalar(0))
+      x = -qc/qb;
+    else
+    {
+      RealScalar disc = std::max(RealScalar(0), qb*qb - RealScalar(4)*qa*qc);
+      RealScalar q = RealScalar(-0.5) * (qb + (qb<0 ? -ei_sqrt(disc) : ei_sqrt(disc)));
+      RealScalar x1 = q/qa;
+      RealScalar x2 = q==RealScalar(0) ? x1 : qc/q;
+      x = (x1>lo && x1<hi) ? x1 : x2;
+    }
+    if(!(x>lo && x<hi))
+      x = (lo+hi)/RealScalar(2);
+    if(x==tau)
+      break;
+    tau = x;
+  }
+
+  if(converged)
+    *converged = iter<maxIterations;
+  return tau;
+}
+
+#endif // EIGEN_MISC_SECULAR_EQUATION_H
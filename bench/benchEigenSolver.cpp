@@ -8,11 +8,13 @@
 //  -DREPEAT=100
 //  -DTRIES=10
 //  -DSCALAR=double
+//  -DBENCH_TRIDIAGONALIZATION  (blocked vs unblocked tridiagonalization, n = 500..4000)
 
 #include <iostream>
 
 #include <Eigen/Core>
 #include <Eigen/QR>
+#include <Eigen/Eigenvalues>
 #include <bench/BenchUtil.h>
 using namespace Eigen;
 
@@ -72,7 +74,7 @@ __attribute__ ((noinline)) void benchEigenSolver(const MatrixType& m)
       for (int k=0; k<stdRepeats; ++k)
       {
         ei.compute(covMat);
-        acc += ei.eigenvectors().coeff(r,c);
+        acc += ei_real(ei.eigenvectors().coeff(r,c));
       }
       timerStd.stop();
     }
@@ -186,8 +188,59 @@ __attribute__ ((noinline)) void benchEigenSolver(const MatrixType& m)
     std::cout << acc;
 }
 
+#ifdef BENCH_TRIDIAGONALIZATION
+// compares the blocked reduction used by Tridiagonalization (and SelfAdjointEigenSolver)
+// with the unblocked one, and measures the evaluation of Q
+template <typename MatrixType>
+__attribute__ ((noinline)) void benchTridiagonalization(int size)
+{
+  typedef typename MatrixType::Scalar Scalar;
+  typedef typename Tridiagonalization<MatrixType>::CoeffVectorType CoeffVectorType;
+  typedef typename Tridiagonalization<MatrixType>::HouseholderSequenceType HouseholderSequenceType;
+
+  MatrixType a = MatrixType::Random(size,size);
+  MatrixType symmA = a + a.adjoint();
+  MatrixType mat(size,size), q(size,size);
+  CoeffVectorType hCoeffs(size-1);
+
+  BenchTimer timerUnblocked, timerBlocked, timerQ;
+  for (int t=0; t<TRIES; ++t)
+  {
+    mat = symmA;
+    timerUnblocked.start();
+    ei_tridiagonalization_inplace_unblocked(mat, hCoeffs);
+    timerUnblocked.stop();
+
+    mat = symmA;
+    timerBlocked.start();
+    ei_tridiagonalization_inplace(mat, hCoeffs);
+    timerBlocked.stop();
+
+    timerQ.start();
+    q = HouseholderSequenceType(mat, hCoeffs.conjugate(), false, size-1, 1);
+    timerQ.stop();
+  }
+
+  std::cout << size << " \t"
+            << timerUnblocked.value() << "s \t"
+            << timerBlocked.value() << "s \t"
+            << "x" << timerUnblocked.value()/timerBlocked.value() << " \t"
+            << timerQ.value() << "s\n";
+}
+#endif
+
 int main(int argc, char* argv[])
 {
+  #ifdef BENCH_TRIDIAGONALIZATION
+  {
+    const int tridiagsizes[] = {500,1000,2000,3000,4000,0};
+    std::cout << "size    unblocked      blocked       speedup    Q\n";
+    for (uint i=0; tridiagsizes[i]>0; ++i)
+      benchTridiagonalization<Matrix<Scalar,Dynamic,Dynamic> >(tridiagsizes[i]);
+    return 0;
+  }
+  #endif
+
   const int dynsizes[] = {4,6,8,12,16,24,32,64,128,256,512,0};
   std::cout << "size            selfadjoint       generic";
   #ifdef BENCH_GMM
@@ -1,5 +1,6 @@
 
 // g++-4.4 bench_gemm.cpp -I .. -O2 -DNDEBUG -lrt -fopenmp && OMP_NUM_THREADS=2  ./a.out
+// g++-4.4 bench_gemm.cpp -I .. -O2 -DNDEBUG -lrt -DEIGEN_USE_PTHREADS -lpthread && ./a.out
 // icpc bench_gemm.cpp -I .. -O3 -DNDEBUG -lrt -openmp  && OMP_NUM_THREADS=2  ./a.out
 
 #include <iostream>
@@ -1,9 +1,17 @@
 
-// g++ -I.. sparse_lu.cpp -O3 -g0 -I /usr/include/superlu/ -lsuperlu -lgfortran -DSIZE=1000 -DDENSITY=.05 && ./a.out
+// g++ -I.. sparse_lu.cpp -O3 -g0 -DSIZE=1000 -DDENSITY=.05 && ./a.out
+// g++ -I.. sparse_lu.cpp -O3 -g0 -DGRID=100 && ./a.out
+// to compare with SuperLU and UmfPack, add:
+// -DEIGEN_SUPERLU_SUPPORT -I /usr/include/superlu/ -lsuperlu -lgfortran -DEIGEN_UMFPACK_SUPPORT -lumfpack -lamd -lblas
 
-#define EIGEN_SUPERLU_SUPPORT
-#define EIGEN_UMFPACK_SUPPORT
 #include <Eigen/Sparse>
+#include <unsupported/Eigen/SparseExtra>
+#ifdef EIGEN_SUPERLU_SUPPORT
+#include <unsupported/Eigen/SuperLUSupport>
+#endif
+#ifdef EIGEN_UMFPACK_SUPPORT
+#include <unsupported/Eigen/UmfPackSupport>
+#endif
 
 #define NOGMM
 #define NOMTL
@@ -66,13 +74,34 @@ void doEigen(const char* name, const EigenSparseMatrix& sm1, const VectorX& b, V
   else
     std::cout << "  solve:\t" << " FAILED" << endl;
 
-  //std::cout << x.transpose() << "\n";
+  std::cout << "  residual:\t" << (sm1*x-b).norm() / b.norm() << endl;
+}
+
+// unsymmetric 5-point stencil of a convection-diffusion problem on a n x n grid
+void fillConvectionDiffusion(int n, EigenSparseMatrix& dst)
+{
+  dst.resize(n*n,n*n);
+  dst.reserve(5*n*n);
+  for(int j = 0; j < n*n; j++)
+  {
+    int x = j%n, y = j/n;
+    if (y>0)   dst.insert(j-n,j) = -1.5;
+    if (x>0)   dst.insert(j-1,j) = -1.5;
+    dst.insert(j,j) = 4;
+    if (x<n-1) dst.insert(j+1,j) = -0.5;
+    if (y<n-1) dst.insert(j+n,j) = -0.5;
+  }
+  dst.finalize();
 }
 
 int main(int argc, char *argv[])
 {
+  #ifdef GRID
+  int rows = GRID*GRID;
+  #else
   int rows = SIZE;
-  int cols = SIZE;
+  #endif
+  int cols = rows;
   float density = DENSITY;
   BenchTimer timer;
 
@@ -85,7 +114,11 @@ int main(int argc, char *argv[])
 //   float density = 0.5;
   {
     EigenSparseMatrix sm1(rows, cols);
+    #ifdef GRID
+    fillConvectionDiffusion(GRID, sm1);
+    #else
     fillMatrix(density, rows, cols, sm1);
+    #endif
 
     // dense matrices
     #ifdef DENSEMATRIX
@@ -104,7 +137,7 @@ int main(int argc, char *argv[])
 
       timer.reset();
       timer.start();
-      lu.solve(b,&x);
+      x = lu.solve(b);
       timer.stop();
       std::cout << "  solve:\t" << timer.value() << endl;
 //       std::cout << b.transpose() << "\n";
@@ -112,6 +145,11 @@ int main(int argc, char *argv[])
     }
     #endif
 
+    x.setZero();
+    doEigen<Eigen::DefaultBackend>("Eigen/default (nat)", sm1, b, x, Eigen::NaturalOrdering);
+    doEigen<Eigen::DefaultBackend>("Eigen/default (MD AT+A)", sm1, b, x, Eigen::MinimumDegree_AT_PLUS_A);
+    doEigen<Eigen::DefaultBackend>("Eigen/default (MD ATA)", sm1, b, x, Eigen::MinimumDegree_ATA);
+
     #ifdef EIGEN_UMFPACK_SUPPORT
     x.setZero();
     doEigen<Eigen::UmfPack>("Eigen/UmfPack (auto)", sm1, b, x, 0);
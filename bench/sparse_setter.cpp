@@ -28,7 +28,9 @@
 #include <google/sparse_hash_map>
 #endif
 
+#include <iostream>
 #include "BenchSparseUtil.h"
+#include <unsupported/Eigen/SparseExtra>
 
 #define CHECK_MEM
 // #define CHECK_MEM  std/**/::cout << "check mem\n"; getchar();
@@ -46,6 +48,7 @@ typedef std::vector<float> Values;
 
 EIGEN_DONT_INLINE Scalar* setinnerrand_eigen(const Coordinates& coords, const Values& vals);
 EIGEN_DONT_INLINE Scalar* setrand_eigen_dynamic(const Coordinates& coords, const Values& vals);
+EIGEN_DONT_INLINE Scalar* setrand_eigen_triplets(const Coordinates& coords, const Values& vals);
 EIGEN_DONT_INLINE Scalar* setrand_eigen_compact(const Coordinates& coords, const Values& vals);
 EIGEN_DONT_INLINE Scalar* setrand_eigen_sumeq(const Coordinates& coords, const Values& vals);
 EIGEN_DONT_INLINE Scalar* setrand_eigen_gnu_hash(const Coordinates& coords, const Values& vals);
@@ -90,8 +93,8 @@ int main(int argc, char *argv[])
     values.reserve(n);
     for (int i=0; i<n; ++i)
     {
-      int i = ei_random<int>(0,pool.size());
-      coords.push_back(pool[i]);
+      int k = ei_random<int>(0,pool.size()-1);
+      coords.push_back(pool[k]);
       values.push_back(ei_random<Scalar>());
     }
   }
@@ -134,6 +137,10 @@ int main(int argc, char *argv[])
       std::cout << "Eigen sumeq\t" << timer.value() << "\n";
     }
     {
+      BENCH(setrand_eigen_triplets(coords,values);)
+      std::cout << "Eigen triplets\t" << timer.value() << "\n";
+    }
+    {
 //       BENCH(setrand_eigen_gnu_hash(coords,values);)
 //       std::cout << "Eigen std::map\t" << timer.value() << "\n";
     }
@@ -219,6 +226,19 @@ EIGEN_DONT_INLINE Scalar* setrand_eigen_dynamic(const Coordinates& coords, const
   return &mat.coeffRef(coords[0].x(), coords[0].y());
 }
 
+EIGEN_DONT_INLINE Scalar* setrand_eigen_triplets(const Coordinates& coords, const Values& vals)
+{
+  using namespace Eigen;
+  SparseMatrix<Scalar> mat(SIZE,SIZE);
+  std::vector<Triplet<Scalar> > triplets;
+  triplets.reserve(coords.size());
+  for (int i=0; i<coords.size(); ++i)
+    triplets.push_back(Triplet<Scalar>(coords[i].x(), coords[i].y(), vals[i]));
+  mat.setFromTriplets(triplets.begin(), triplets.end());
+  CHECK_MEM;
+  return &mat.coeffRef(coords[0].x(), coords[0].y());
+}
+
 EIGEN_DONT_INLINE Scalar* setrand_eigen_sumeq(const Coordinates& coords, const Values& vals)
 {
   using namespace Eigen;
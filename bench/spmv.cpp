@@ -1,12 +1,15 @@
 
 //g++-4.4 -DNOMTL  -Wl,-rpath /usr/local/lib/oski -L /usr/local/lib/oski/ -l oski -l oski_util -l oski_util_Tid  -DOSKI -I ~/Coding/LinearAlgebra/mtl4/  spmv.cpp  -I .. -O2 -DNDEBUG -lrt  -lm -l oski_mat_CSC_Tid  -loskilt && ./a.out r200000 c200000 n100 t1 p1
 
+// the multi-threaded kernels are enabled by -DEIGEN_USE_PTHREADS -lpthread, or by -fopenmp
+
 #define SCALAR double
 
 #include <iostream>
 #include <algorithm>
 #include "BenchTimer.h"
 #include "BenchSparseUtil.h"
+#include <unsupported/Eigen/SparseExtra>
 
 #define SPMV_BENCH(CODE) BENCH(t,tries,repeats,CODE);
 
@@ -113,6 +116,33 @@ int main(int argc, char *argv[])
       std::cout << t.value()/repeats << endl;
     }
 
+    // scalability of the eigen kernels, in GFLOP/s, for the column major (A*x) and
+    // row major (A^T*x) storage
+    {
+      double flops = 2. * double(sm.nonZeros()) * double(repeats) * 1e-9;
+      int maxThreads = nbThreads();
+      for(int threads = 1; threads <= maxThreads; threads = (threads == maxThreads ? threads+1 : std::min(2*threads, maxThreads)))
+      {
+        setNbThreads(threads);
+        SPMV_BENCH(res.noalias() += sm * dv; )
+        std::cout << "Eigen " << threads << " thr\t" << flops/t.value() << " GFLOP/s\t";
+
+        SPMV_BENCH(res.noalias() += sm.transpose() * dv; )
+        std::cout << flops/t.value() << " GFLOP/s" << endl;
+      }
+      setNbThreads(maxThreads);
+    }
+
+    // sliced ELLPACK storage of A and A^T
+    {
+      SlicedEllpackMatrix<Scalar> sell(sm), sellT(sm.transpose());
+      SPMV_BENCH(res.noalias() += sell * dv; )
+      std::cout << "Eigen SELL  " << t.value()/repeats << "\t";
+
+      SPMV_BENCH(res.noalias() += sellT * dv; )
+      std::cout << t.value()/repeats << "\t(padding " << double(sell.storedCoefficients())/sell.nonZeros()-1. << ")" << endl;
+    }
+
     // CSparse
     #ifdef CSPARSE
     {
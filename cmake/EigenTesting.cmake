@@ -182,6 +182,18 @@ macro(ei_testing_print_summary)
       message("SSE4.2:            Using architecture defaults")
     endif()
 
+    if(EIGEN_TEST_AVX)
+      message("AVX:               ON")
+    else()
+      message("AVX:               Using architecture defaults")
+    endif()
+
+    if(EIGEN_TEST_AVX2)
+      message("AVX2, FMA:         ON")
+    else()
+      message("AVX2, FMA:         Using architecture defaults")
+    endif()
+
     if(EIGEN_TEST_ALTIVEC)
       message("Altivec:           ON")
     else()
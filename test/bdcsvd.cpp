@@ -0,0 +1,120 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Copyright (C) 2010 Gael Guennebaud <gael.guennebaud@inria.fr>
+//
+// Eigen is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// Alternatively, you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation; either version 2 of
+// the License, or (at your option) any later version.
+//
+// Eigen is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License or the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License and a copy of the GNU General Public License along with
+// Eigen. If not, see <http://www.gnu.org/licenses/>.
+
+#include "main.h"
+#include <Eigen/SVD>
+
+template<typename MatrixType, unsigned int Options> void bdcsvd(const MatrixType& m = MatrixType(), bool pickrandom = true)
+{
+  typedef typename MatrixType::Index Index;
+  Index rows = m.rows();
+  Index cols = m.cols();
+  Index diagSize = std::min(rows, cols);
+
+  typedef typename MatrixType::Scalar Scalar;
+  typedef Matrix<Scalar, Dynamic, Dynamic> DynamicMatrixType;
+
+  MatrixType a;
+  if(pickrandom) a = MatrixType::Random(rows,cols);
+  else a = m;
+
+  BDCSVD<MatrixType,Options> svd(a);
+  VERIFY(svd.info() == Success);
+  if((Options & (SkipU|SkipV)) == 0)
+  {
+    DynamicMatrixType u = svd.matrixU();
+    DynamicMatrixType v = svd.matrixV();
+    VERIFY_IS_EQUAL(u.cols(), (Options & ThinU) ? diagSize : rows);
+    VERIFY_IS_EQUAL(v.cols(), (Options & ThinV) ? diagSize : cols);
+    DynamicMatrixType sigma = DynamicMatrixType::Zero(u.cols(),v.cols());
+    sigma.diagonal().head(diagSize) = svd.singularValues().template cast<Scalar>();
+
+    VERIFY_IS_APPROX(a, u * sigma * v.adjoint());
+    VERIFY_IS_UNITARY(u);
+    VERIFY_IS_UNITARY(v);
+  }
+
+  // same singular values as JacobiSVD, in decreasing order
+  JacobiSVD<MatrixType> jacobi(a);
+  VERIFY_IS_APPROX(svd.singularValues(), jacobi.singularValues());
+  for(Index i = 1; i < diagSize; ++i)
+    VERIFY(svd.singularValues()(i-1) >= svd.singularValues()(i));
+}
+
+template<typename MatrixType> void bdcsvd_rank_deficient(const MatrixType& m)
+{
+  typedef typename MatrixType::Index Index;
+  typedef typename MatrixType::Scalar Scalar;
+  Index rows = m.rows();
+  Index cols = m.cols();
+  Index rank = ei_random<Index>(1, std::min(rows, cols)-1);
+
+  // repeated columns and exact zero singular values exercise the deflations of the merges
+  MatrixType a = MatrixType::Random(rows, rank) * MatrixType::Random(rank, cols);
+  a.col(0) = a.col(cols-1);
+  BDCSVD<MatrixType> svd(a);
+  VERIFY(svd.info() == Success);
+  Matrix<Scalar,Dynamic,Dynamic> sigma = Matrix<Scalar,Dynamic,Dynamic>::Zero(rows, cols);
+  sigma.diagonal() = svd.singularValues().template cast<Scalar>();
+  VERIFY_IS_APPROX(a, svd.matrixU() * sigma * svd.matrixV().adjoint());
+  VERIFY_IS_UNITARY(svd.matrixU());
+  VERIFY_IS_UNITARY(svd.matrixV());
+  VERIFY(svd.singularValues().tail(std::min(rows, cols)-rank).norm() <= svd.singularValues()(0) * test_precision<Scalar>());
+
+  // singular values of the identity
+  MatrixType id = MatrixType::Identity(rows, cols);
+  BDCSVD<MatrixType> svdId(id);
+  typedef Matrix<typename MatrixType::RealScalar,Dynamic,1> RealVectorType;
+  VERIFY_IS_APPROX(svdId.singularValues(), RealVectorType::Ones(std::min(rows, cols)));
+}
+
+template<typename MatrixType> void bdcsvd_verify_assert()
+{
+  BDCSVD<MatrixType> svd;
+  VERIFY_RAISES_ASSERT(svd.matrixU())
+  VERIFY_RAISES_ASSERT(svd.singularValues())
+  VERIFY_RAISES_ASSERT(svd.matrixV())
+  VERIFY_RAISES_ASSERT(svd.info())
+}
+
+void test_bdcsvd()
+{
+  for(int i = 0; i < g_repeat; i++) {
+    // small sizes are handled by JacobiSVD
+    CALL_SUBTEST_1(( bdcsvd<Matrix3f,0>() ));
+    CALL_SUBTEST_2(( bdcsvd<MatrixXd,ThinU>(MatrixXd(10,4)) ));
+
+    int r = ei_random<int>(20,80), c = ei_random<int>(20,80);
+    CALL_SUBTEST_3(( bdcsvd<MatrixXd,0>(MatrixXd(r,c)) ));
+    CALL_SUBTEST_4(( bdcsvd<MatrixXcf,ThinU|ThinV>(MatrixXcf(r,c)) ));
+    CALL_SUBTEST_5(( bdcsvd_rank_deficient(MatrixXd(r,c)) ));
+  }
+  // large enough for several levels of recursion and for the blocked bidiagonalization
+  CALL_SUBTEST_6(( bdcsvd<MatrixXd,ThinU>(MatrixXd(400,170)) ));
+  CALL_SUBTEST_7(( bdcsvd<MatrixXcd,ThinV>(MatrixXcd(140,200)) ));
+  CALL_SUBTEST_8(( bdcsvd<MatrixXf,SkipU>(MatrixXf(150,150)) ));
+  CALL_SUBTEST_6(( bdcsvd_rank_deficient(MatrixXd(200,150)) ));
+
+  CALL_SUBTEST_3(( bdcsvd_verify_assert<MatrixXd>() ));
+}
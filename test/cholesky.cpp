@@ -49,7 +49,7 @@ template<typename MatrixType> void cholesky(const MatrixType& m)
 {
   typedef typename MatrixType::Index Index;
   /* this test covers the following files:
-     LLT.h LDLT.h
+     LLT.h LDLT.h BunchKaufmanLDLT.h
   */
   Index rows = m.rows();
   Index cols = m.cols();
@@ -230,6 +230,54 @@ template<typename MatrixType> void cholesky_cplx(const MatrixType& m)
 
 }
 
+template<typename MatrixType> void bunchkaufman(const MatrixType& m)
+{
+  typedef typename MatrixType::Index Index;
+  Index rows = m.rows();
+  Index cols = m.cols();
+
+  typedef typename MatrixType::Scalar Scalar;
+  typedef Matrix<Scalar, MatrixType::RowsAtCompileTime, 1> VectorType;
+
+  // an indefinite matrix
+  MatrixType a0 = MatrixType::Random(rows,cols);
+  MatrixType symm = a0 + a0.adjoint();
+  VectorType vecB = VectorType::Random(rows), vecX(rows);
+  MatrixType matB = MatrixType::Random(rows,cols), matX(rows,cols);
+
+  MatrixType symmUp = symm.template triangularView<Upper>();
+  MatrixType symmLo = symm.template triangularView<Lower>();
+
+  BunchKaufmanLDLT<MatrixType,Lower> bklo(symmLo);
+  VERIFY_IS_APPROX(symm, bklo.reconstructedMatrix());
+  vecX = bklo.solve(vecB);
+  VERIFY_IS_APPROX(symm * vecX, vecB);
+  matX = bklo.solve(matB);
+  VERIFY_IS_APPROX(symm * matX, matB);
+
+  BunchKaufmanLDLT<MatrixType,Upper> bkup(symmUp);
+  VERIFY_IS_APPROX(symm, bkup.reconstructedMatrix());
+  matX = bkup.solve(matB);
+  VERIFY_IS_APPROX(symm * matX, matB);
+
+  // a saddle point matrix, which has a zero diagonal
+  if(rows>=2)
+  {
+    Index half = rows/2;
+    Index rest = rows-half;
+    MatrixType saddle = MatrixType::Zero(rows,cols);
+    saddle.block(half,0,rest,half).setRandom();
+    saddle.block(0,half,half,rest) = saddle.block(half,0,rest,half).adjoint();
+    if(rest>half)
+      saddle.block(2*half,2*half,rest-half,rest-half) = MatrixType::Identity(rest-half,rest-half);
+
+    BunchKaufmanLDLT<MatrixType> bk(saddle);
+    VERIFY_IS_APPROX(saddle, bk.reconstructedMatrix());
+    matX = bk.solve(matB);
+    VERIFY_IS_APPROX(saddle * matX, matB);
+  }
+}
+
 template<typename MatrixType> void cholesky_verify_assert()
 {
   MatrixType tmp;
@@ -262,6 +310,14 @@ void test_cholesky()
     CALL_SUBTEST_2( cholesky(MatrixXd(s,s)) );
     s = ei_random<int>(1,100);
     CALL_SUBTEST_6( cholesky_cplx(MatrixXcd(s,s)) );
+    s = ei_random<int>(64,300);
+    CALL_SUBTEST_10( cholesky(MatrixXd(s,s)) );
+
+    CALL_SUBTEST_5( bunchkaufman(Matrix4d()) );
+    s = ei_random<int>(1,300);
+    CALL_SUBTEST_11( bunchkaufman(MatrixXd(s,s)) );
+    s = ei_random<int>(1,150);
+    CALL_SUBTEST_12( bunchkaufman(MatrixXcd(s,s)) );
   }
 
   CALL_SUBTEST_4( cholesky_verify_assert<Matrix3f>() );
@@ -272,4 +328,5 @@ void test_cholesky()
   // Test problem size constructors
   CALL_SUBTEST_9( LLT<MatrixXf>(10) );
   CALL_SUBTEST_9( LDLT<MatrixXf>(10) );
+  CALL_SUBTEST_9( BunchKaufmanLDLT<MatrixXf>(10) );
 }
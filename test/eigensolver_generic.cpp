@@ -112,6 +112,10 @@ void test_eigensolver_generic()
   CALL_SUBTEST_3( eigensolver_verify_assert(Matrix<double,1,1>()) );
   CALL_SUBTEST_4( eigensolver_verify_assert(Matrix2d()) );
 
+  // large enough for the blocked Hessenberg reduction and aggressive early deflation
+  int s = ei_random<int>(130,300); EIGEN_UNUSED_VARIABLE(s);
+  CALL_SUBTEST_6( eigensolver(MatrixXd(s,s)) );
+
   // Test problem size constructors
   CALL_SUBTEST_5(EigenSolver<MatrixXf>(10));
 }
@@ -117,6 +117,14 @@ template<typename MatrixType> void selfadjointeigensolver(const MatrixType& m)
   VERIFY_IS_EQUAL(eiSymmNoEivecs.info(), Success);
   VERIFY_IS_APPROX(eiSymm.eigenvalues(), eiSymmNoEivecs.eigenvalues());
 
+  // divide-and-conquer tridiagonal solver
+  SelfAdjointEigenSolver<MatrixType> eiSymmDC(symmA, ComputeEigenvectors|DivideAndConquer);
+  VERIFY_IS_EQUAL(eiSymmDC.info(), Success);
+  VERIFY((symmA.template selfadjointView<Lower>() * eiSymmDC.eigenvectors()).isApprox(
+          eiSymmDC.eigenvectors() * eiSymmDC.eigenvalues().asDiagonal(), largerEps));
+  VERIFY_IS_APPROX(eiSymm.eigenvalues(), eiSymmDC.eigenvalues());
+  VERIFY(MatrixType(eiSymmDC.eigenvectors().adjoint() * eiSymmDC.eigenvectors()).isIdentity(largerEps));
+
   // generalized eigen problem Ax = lBx
   eiSymmGen.compute(symmA, symmB,Ax_lBx);
   VERIFY_IS_EQUAL(eiSymmGen.info(), Success);
@@ -181,6 +189,12 @@ void test_eigensolver_selfadjoint()
     CALL_SUBTEST_7( selfadjointeigensolver(Matrix<double,2,2>()) );
   }
 
+  // large matrices go through the blocked tridiagonalization
+  int s = ei_random<int>(130,250);
+  CALL_SUBTEST_9( selfadjointeigensolver(MatrixXd(s,s)) );
+  s = ei_random<int>(130,200);
+  CALL_SUBTEST_10( selfadjointeigensolver(MatrixXcf(s,s)) );
+
   // Test problem size constructors
   CALL_SUBTEST_8(SelfAdjointEigenSolver<MatrixXf>(10));
   CALL_SUBTEST_8(Tridiagonalization<MatrixXf>(10));
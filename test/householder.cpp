@@ -130,4 +130,7 @@ void test_householder()
     CALL_SUBTEST_7( householder(MatrixXf(25,7)) );
     CALL_SUBTEST_8( householder(Matrix<double,1,1>()) );
   }
+  // large sequences are evaluated by blocks
+  CALL_SUBTEST_9( householder(MatrixXd(ei_random<int>(50,150),ei_random<int>(50,150))) );
+  CALL_SUBTEST_10( householder(MatrixXcf(ei_random<int>(50,120),ei_random<int>(50,120))) );
 }
@@ -114,11 +114,12 @@ template<typename Scalar> void packetmath()
   const int PacketSize = ei_packet_traits<Scalar>::size;
   typedef typename NumTraits<Scalar>::Real RealScalar;
 
-  const int size = PacketSize*4;
-  EIGEN_ALIGN16 Scalar data1[ei_packet_traits<Scalar>::size*4];
-  EIGEN_ALIGN16 Scalar data2[ei_packet_traits<Scalar>::size*4];
+  // ei_preduxp needs PacketSize packets
+  const int size = PacketSize*(PacketSize>4 ? PacketSize : 4);
+  EIGEN_ALIGN16 Scalar data1[size];
+  EIGEN_ALIGN16 Scalar data2[size];
   EIGEN_ALIGN16 Packet packets[PacketSize*2];
-  EIGEN_ALIGN16 Scalar ref[ei_packet_traits<Scalar>::size*4];
+  EIGEN_ALIGN16 Scalar ref[size];
   RealScalar refvalue = 0;
   for (int i=0; i<size; ++i)
   {
@@ -150,6 +151,10 @@ template<typename Scalar> void packetmath()
     else if (offset==1) ei_palign<1>(packets[0], packets[1]);
     else if (offset==2) ei_palign<2>(packets[0], packets[1]);
     else if (offset==3) ei_palign<3>(packets[0], packets[1]);
+    else if (offset==4) ei_palign<4>(packets[0], packets[1]);
+    else if (offset==5) ei_palign<5>(packets[0], packets[1]);
+    else if (offset==6) ei_palign<6>(packets[0], packets[1]);
+    else if (offset==7) ei_palign<7>(packets[0], packets[1]);
     ei_pstore(data2, packets[0]);
 
     for (int i=0; i<PacketSize; ++i)
@@ -159,6 +164,17 @@ template<typename Scalar> void packetmath()
     VERIFY(areApprox(ref, data2, PacketSize) && "ei_palign");
   }
 
+  {
+    int indices[PacketSize];
+    for (int i=0; i<PacketSize; ++i)
+    {
+      indices[i] = ei_random<int>(0,size-1);
+      ref[i] = data1[indices[i]];
+    }
+    ei_pstore(data2, ei_pgather<Packet>(data1, indices));
+    VERIFY(areApprox(ref, data2, PacketSize) && "ei_pgather");
+  }
+
   CHECK_CWISE2(REF_ADD,  ei_padd);
   CHECK_CWISE2(REF_SUB,  ei_psub);
   CHECK_CWISE2(REF_MUL,  ei_pmul);
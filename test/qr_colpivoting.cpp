@@ -118,6 +118,36 @@ template<typename MatrixType> void qr_invertible()
   VERIFY_IS_APPROX(ei_log(absdet), qr.logAbsDeterminant());
 }
 
+template<typename MatrixType> void qr_least_squares()
+{
+  // tall problems large enough to go through the blocked path
+  typedef typename MatrixType::Index Index;
+  typedef typename MatrixType::RealScalar RealScalar;
+  Index cols = ei_random<Index>(64,200), rows = ei_random<Index>(cols,3*cols);
+  Index rank = ei_random<Index>(cols/2, cols);
+
+  MatrixType m1;
+  createRandomPIMatrixOfRank(rank,rows,cols,m1);
+  ColPivHouseholderQR<MatrixType> qr(m1);
+  // the singular values of m1 are 0 or 1, but at these sizes the round-off errors of the
+  // zero pivots come close to the default threshold in single precision
+  qr.setThreshold(test_precision<RealScalar>());
+  VERIFY(rank == qr.rank());
+
+  MatrixType r = qr.matrixQR().template triangularView<Upper>();
+  MatrixType c = qr.householderQ() * r * qr.colsPermutation().inverse();
+  VERIFY_IS_APPROX(m1, c);
+
+  // the diagonal of R is non increasing
+  for(Index i = 1; i < qr.rank(); ++i)
+    VERIFY(ei_abs(r(i,i)) <= ei_abs(r(i-1,i-1)) * (1 + test_precision<typename MatrixType::RealScalar>()));
+
+  MatrixType m2 = MatrixType::Random(cols,3);
+  MatrixType m3 = m1*m2;
+  m2 = qr.solve(m3);
+  VERIFY_IS_APPROX(m3, m1*m2);
+}
+
 template<typename MatrixType> void qr_verify_assert()
 {
   MatrixType tmp;
@@ -141,6 +171,8 @@ void test_qr_colpivoting()
     CALL_SUBTEST_1( qr<MatrixXf>() );
     CALL_SUBTEST_2( qr<MatrixXd>() );
     CALL_SUBTEST_3( qr<MatrixXcd>() );
+    CALL_SUBTEST_10( qr_least_squares<MatrixXd>() );
+    CALL_SUBTEST_10( qr_least_squares<MatrixXcf>() );
     CALL_SUBTEST_4(( qr_fixedsize<Matrix<float,3,5>, 4 >() ));
     CALL_SUBTEST_5(( qr_fixedsize<Matrix<double,6,2>, 3 >() ));
     CALL_SUBTEST_5(( qr_fixedsize<Matrix<double,1,1>, 1 >() ));
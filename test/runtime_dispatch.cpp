@@ -0,0 +1,84 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Copyright (C) 2010 Gael Guennebaud <gael.guennebaud@inria.fr>
+//
+// Eigen is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// Alternatively, you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation; either version 2 of
+// the License, or (at your option) any later version.
+//
+// Eigen is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License or the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License and a copy of the GNU General Public License along with
+// Eigen. If not, see <http://www.gnu.org/licenses/>.
+
+// this file is compiled with EIGEN_DISPATCH_AVX2 and linked to runtime_dispatch_avx2.cpp
+#include "main.h"
+
+template<typename MatrixType> void dispatched_kernels(int rows, int cols, int depth)
+{
+  typedef typename MatrixType::Scalar Scalar;
+  typedef Matrix<Scalar,Dynamic,Dynamic,RowMajor> RowMajorMatrixType;
+  typedef Matrix<Scalar,Dynamic,1> VectorType;
+
+  MatrixType a = MatrixType::Random(rows,depth);
+  MatrixType b = MatrixType::Random(depth,cols);
+  MatrixType c = MatrixType::Random(rows,cols);
+  RowMajorMatrixType ar = a;
+  Scalar s = ei_random<Scalar>();
+
+  // matrix-matrix products, compared to the coefficient based ones
+  VERIFY_IS_APPROX((c.noalias() += s * a * b), (c + s * a.lazyProduct(b)).eval());
+  VERIFY_IS_APPROX((c.noalias() = ar * b), a.lazyProduct(b));
+  VERIFY_IS_APPROX((c.noalias() = a * b.adjoint().adjoint()), a.lazyProduct(b));
+  MatrixType at = a.adjoint();
+  VERIFY_IS_APPROX((c.noalias() = at.adjoint() * b), a.lazyProduct(b));
+  MatrixType bt = b.adjoint();
+  VERIFY_IS_APPROX((c.noalias() = a.conjugate() * bt.adjoint()), a.conjugate().lazyProduct(b));
+
+  // matrix-vector products
+  VectorType v = VectorType::Random(depth);
+  VERIFY_IS_APPROX((c.col(0).noalias() = a * v), a.lazyProduct(v));
+  VERIFY_IS_APPROX((c.col(0).noalias() = ar * v), a.lazyProduct(v));
+  VERIFY_IS_APPROX((c.col(0).noalias() = at.adjoint() * v), a.lazyProduct(v));
+
+  // triangular solves on both sides
+  // well conditioned triangular factors, even with a unit diagonal
+  MatrixType t = MatrixType::Random(rows,rows) / Scalar(rows);
+  t.diagonal().array() += Scalar(1);
+  MatrixType rhs = MatrixType::Random(rows,cols);
+  MatrixType x = t.template triangularView<Lower>().solve(rhs);
+  VERIFY_IS_APPROX(t.template triangularView<Lower>() * x, rhs);
+  x = t.adjoint().template triangularView<UnitUpper>().solve(rhs);
+  VERIFY_IS_APPROX(t.adjoint().template triangularView<UnitUpper>() * x, rhs);
+  MatrixType y = rhs.adjoint();
+  t.template triangularView<Upper>().template solveInPlace<OnTheRight>(y);
+  VERIFY_IS_APPROX(y * t.template triangularView<Upper>(), rhs.adjoint());
+}
+
+void test_runtime_dispatch()
+{
+  // the AVX2 kernels must be selected if and only if the machine supports them
+  typedef ei_dispatched_kernel_types<float,DenseIndex>::Gemm Gemm;
+  bool selected = ei_dispatched_kernel<Gemm,DispatchedGemm,0>()!=0;
+  const int required = ei_dispatch_instruction_sets_avx2;
+  VERIFY(selected == ((ei_instructionSets() & required)==required));
+  VERIFY((required & (InstructionSet::AVX2|InstructionSet::FMA))==(InstructionSet::AVX2|InstructionSet::FMA));
+
+  for(int i = 0; i < g_repeat; i++) {
+    CALL_SUBTEST_1( dispatched_kernels<MatrixXf>(ei_random<int>(1,320), ei_random<int>(1,320), ei_random<int>(1,320)) );
+    CALL_SUBTEST_2( dispatched_kernels<MatrixXd>(ei_random<int>(1,320), ei_random<int>(1,320), ei_random<int>(1,320)) );
+    CALL_SUBTEST_3( dispatched_kernels<MatrixXcf>(ei_random<int>(1,200), ei_random<int>(1,200), ei_random<int>(1,200)) );
+    CALL_SUBTEST_4( dispatched_kernels<MatrixXcd>(ei_random<int>(1,200), ei_random<int>(1,200), ei_random<int>(1,200)) );
+  }
+}
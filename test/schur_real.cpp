@@ -102,6 +102,9 @@ void test_schur_real()
   CALL_SUBTEST_2(( schur<MatrixXd>(ei_random<int>(1,50)) ));
   CALL_SUBTEST_3(( schur<Matrix<float, 1, 1> >() ));
   CALL_SUBTEST_4(( schur<Matrix<double, 3, 3, Eigen::RowMajor> >() ));
+  // large enough for aggressive early deflation
+  CALL_SUBTEST_6(( schur<MatrixXd>(ei_random<int>(120,300)) ));
+  CALL_SUBTEST_7(( schur<MatrixXf>(ei_random<int>(120,200)) ));
 
   // Test problem size constructors
   CALL_SUBTEST_5(RealSchur<MatrixXf>(10));
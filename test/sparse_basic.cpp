@@ -259,6 +259,139 @@ template<typename SparseMatrixType> void sparse_basic(const SparseMatrixType& re
   }
 }
 
+template<typename SparseMatrixType> void sparse_triplets(int rows, int cols)
+{
+  typedef typename SparseMatrixType::Scalar Scalar;
+  typedef typename SparseMatrixType::Index Index;
+  typedef Matrix<Scalar,Dynamic,Dynamic> DenseMatrix;
+  typedef Triplet<Scalar,Index> TripletType;
+
+  // unsorted triplets with many duplicates
+  std::vector<TripletType> triplets;
+  int ntriplets = ei_random<int>(0, 2*rows*cols);
+  triplets.reserve(ntriplets);
+  DenseMatrix refMat = DenseMatrix::Zero(rows,cols);
+  MatrixXi hits = MatrixXi::Zero(rows,cols);
+  for(int k=0; k<ntriplets; ++k)
+  {
+    Index i = ei_random<Index>(0,rows-1);
+    Index j = ei_random<Index>(0,cols-1);
+    Scalar v = ei_random<Scalar>();
+    triplets.push_back(TripletType(i,j,v));
+    refMat(i,j) += v;
+    hits(i,j)++;
+  }
+
+  SparseMatrixType m(rows,cols);
+  m.insert(0,0) = Scalar(1);
+  m.finalize();
+  m.setFromTriplets(triplets.begin(), triplets.end());
+  VERIFY_IS_APPROX(DenseMatrix(m), refMat);
+
+  // the inner indices are sorted and unique
+  Index nnz = 0;
+  for(Index j=0; j<m.outerSize(); ++j)
+  {
+    Index previous = -1;
+    for(typename SparseMatrixType::InnerIterator it(m,j); it; ++it, ++nnz)
+    {
+      VERIFY(it.index()>previous);
+      previous = it.index();
+    }
+  }
+  VERIFY(nnz==m.nonZeros());
+  VERIFY(nnz==(hits.array()>0).count());
+
+  // a plain array of triplets
+  if(ntriplets>0)
+  {
+    m.setFromTriplets(&triplets[0], &triplets[0]+ntriplets);
+    VERIFY_IS_APPROX(DenseMatrix(m), refMat);
+  }
+}
+
+template<typename SparseMatrixType> void sparse_uncompressed(int rows, int cols)
+{
+  typedef typename SparseMatrixType::Scalar Scalar;
+  typedef typename SparseMatrixType::Index Index;
+  typedef Matrix<Scalar,Dynamic,Dynamic> DenseMatrix;
+  typedef Matrix<Scalar,Dynamic,1> DenseVector;
+  enum { IsRowMajor = SparseMatrixType::IsRowMajor };
+
+  // fully random insertion, with too small estimates for some inner vectors
+  SparseMatrixType m(rows,cols);
+  DenseMatrix refMat = DenseMatrix::Zero(rows,cols);
+  VectorXi sizes(m.outerSize());
+  for(Index j=0; j<m.outerSize(); ++j)
+    sizes(j) = ei_random<int>(0,4);
+  m.reserve(sizes);
+  VERIFY(!m.isCompressed());
+  for(int k=0; k<rows*cols/2; ++k)
+  {
+    Index i = ei_random<Index>(0,rows-1);
+    Index j = ei_random<Index>(0,cols-1);
+    if(refMat(i,j)==Scalar(0))
+      m.insert(i,j) = refMat(i,j) = ei_random<Scalar>();
+    else
+      m.coeffRef(i,j) += Scalar(1);
+    refMat(i,j) = m.coeff(i,j);
+  }
+  m.finalize();
+  VERIFY(!m.isCompressed());
+  VERIFY(m.nonZeros()==(refMat.array()!=Scalar(0)).count());
+  VERIFY_IS_APPROX(m, refMat);
+
+  // read-only operations
+  DenseVector x = DenseVector::Random(cols);
+  VERIFY_IS_APPROX(m*x, refMat*x);
+  VERIFY_IS_APPROX(m.transpose()*DenseVector::Ones(rows), refMat.transpose()*DenseVector::Ones(rows));
+  VERIFY_IS_APPROX(m.sum(), refMat.sum());
+  VERIFY_IS_APPROX(DenseMatrix(m.transpose()), refMat.transpose());
+  Index j0 = ei_random<Index>(0,m.outerSize()-1);
+  VERIFY(m.innerVector(j0).nonZeros()==m.innerNonZeros(j0));
+
+  // the copies are compressed
+  SparseMatrixType m2(m);
+  VERIFY(m2.isCompressed());
+  VERIFY_IS_APPROX(m2, refMat);
+  // so are the uncompressed temporaries moved in
+  SparseMatrixType m3(m2), m4;
+  m3.reserve(VectorXi::Constant(m3.outerSize(), 2));
+  m4 = m3.markAsRValue();
+  VERIFY(m4.isCompressed());
+  VERIFY_IS_APPROX(m4, refMat);
+
+  // more insertions after reserving on a compressed matrix
+  m2.reserve(VectorXi::Constant(m2.outerSize(), 2));
+  VERIFY(!m2.isCompressed());
+  for(Index j=0; j<m2.outerSize(); ++j)
+  {
+    Index i = ei_random<Index>(0,m2.innerSize()-1);
+    Index r = IsRowMajor ? j : i, c = IsRowMajor ? i : j;
+    if(refMat(r,c)==Scalar(0))
+      m2.insert(r,c) = refMat(r,c) = ei_random<Scalar>();
+  }
+  VERIFY_IS_APPROX(m2, refMat);
+
+  // compression
+  DenseMatrix refM = DenseMatrix(m);
+  m.makeCompressed();
+  VERIFY(m.isCompressed());
+  VERIFY(m.nonZeros()==Index(m.data().size()));
+  VERIFY_IS_APPROX(m, refM);
+  m2.makeCompressed();
+  VERIFY_IS_APPROX(m2, refMat);
+
+  // prune and setZero get back to the compressed mode
+  m2.reserve(VectorXi::Constant(m2.outerSize(), 1));
+  m2.prune(Scalar(1));
+  VERIFY(m2.isCompressed());
+  VERIFY_IS_APPROX(m2, refMat);
+  m2.reserve(VectorXi::Constant(m2.outerSize(), 1));
+  m2.setZero();
+  VERIFY(m2.isCompressed() && m2.nonZeros()==0);
+}
+
 void test_sparse_basic()
 {
   for(int i = 0; i < g_repeat; i++) {
@@ -267,5 +400,12 @@ void test_sparse_basic()
     CALL_SUBTEST_1( sparse_basic(SparseMatrix<double>(33, 33)) );
 
     CALL_SUBTEST_3( sparse_basic(DynamicSparseMatrix<double>(8, 8)) );
+
+    CALL_SUBTEST_4(( sparse_triplets<SparseMatrix<double> >(ei_random<int>(1,50), ei_random<int>(1,50)) ));
+    CALL_SUBTEST_4(( sparse_triplets<SparseMatrix<double,RowMajor> >(ei_random<int>(1,50), ei_random<int>(1,50)) ));
+    CALL_SUBTEST_6(( sparse_uncompressed<SparseMatrix<double> >(ei_random<int>(1,60), ei_random<int>(1,60)) ));
+    CALL_SUBTEST_6(( sparse_uncompressed<SparseMatrix<double,RowMajor> >(ei_random<int>(1,60), ei_random<int>(1,60)) ));
+    CALL_SUBTEST_7(( sparse_uncompressed<SparseMatrix<std::complex<double>,ColMajor,long> >(ei_random<int>(1,60), ei_random<int>(1,60)) ));
+    CALL_SUBTEST_5(( sparse_triplets<SparseMatrix<std::complex<float>,RowMajor,long> >(ei_random<int>(1,50), ei_random<int>(1,50)) ));
   }
 }
@@ -74,6 +74,19 @@ template<typename SparseMatrixType> void sparse_product(const SparseMatrixType&
     VERIFY_IS_APPROX(dm4=m2*(refMat3+refMat3), refMat4=refMat2*(refMat3+refMat3));
     VERIFY_IS_APPROX(dm4=m2.transpose()*(refMat3+refMat5)*0.5, refMat4=refMat2.transpose()*(refMat3+refMat5)*0.5);
 
+    // sparse * dense with several panels of right hand side columns, in any storage order
+    {
+      typedef Matrix<Scalar,Dynamic,Dynamic,RowMajor> RowMajorDense;
+      int nrhs = ei_random<int>(2,3*EIGEN_TUNE_SPARSE_PANEL_WIDTH);
+      DenseMatrix b = DenseMatrix::Random(rows, nrhs), x = DenseMatrix::Random(rows, nrhs);
+      RowMajorDense br = b, xr = x;
+      DenseMatrix refX = x;
+      VERIFY_IS_APPROX(x.noalias() += m2*b, refX += refMat2*b);
+      VERIFY_IS_APPROX(xr.noalias() += m2*br, x);
+      VERIFY_IS_APPROX(x = m2.transpose()*br, refMat2.transpose()*b);
+      VERIFY_IS_APPROX(xr = s1*(m2.transpose()*b), s1*(refMat2.transpose()*b));
+    }
+
     // dense * sparse
     VERIFY_IS_APPROX(dm4=refMat2*m3, refMat4=refMat2*refMat3);
     VERIFY_IS_APPROX(dm4=refMat2*m3.transpose(), refMat4=refMat2*refMat3.transpose());
@@ -87,6 +100,25 @@ template<typename SparseMatrixType> void sparse_product(const SparseMatrixType&
     VERIFY_IS_APPROX(m3=m3*m3, refMat3=refMat3*refMat3);
   }
 
+  // test rectangular matrix-matrix products, in both storage orders
+  {
+    Index depth = ei_random<Index>(1,2*rows), cols2 = ei_random<Index>(1,2*rows);
+    DenseMatrix refA = DenseMatrix::Zero(rows, depth);
+    DenseMatrix refB = DenseMatrix::Zero(depth, cols2);
+    SparseMatrixType a(rows, depth), b(depth, cols2), c;
+    initSparse<Scalar>(density, refA, a);
+    initSparse<Scalar>(density, refB, b);
+    typedef SparseMatrix<Scalar,RowMajor> RowMajorSparse;
+    RowMajorSparse ar(a), br(b), cr;
+
+    VERIFY_IS_APPROX(c=a*b, refA*refB);
+    VERIFY_IS_APPROX(cr=ar*br, refA*refB);
+    VERIFY_IS_APPROX(c=ar*br, refA*refB);
+    VERIFY_IS_APPROX(cr=a*b, refA*refB);
+    VERIFY_IS_APPROX(c=b.transpose()*a.transpose(), (refA*refB).transpose());
+    VERIFY(c.nonZeros() <= c.rows()*c.cols());
+  }
+
   // test matrix - diagonal product
   {
     DenseMatrix refM2 = DenseMatrix::Zero(rows, rows);
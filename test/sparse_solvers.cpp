@@ -83,6 +83,38 @@ template<typename Scalar> void sparse_solvers(int rows, int cols)
     VERIFY_IS_APPROX(refMat2.transpose().template triangularView<Lower>().solve(vec2),
                      m2.transpose().template triangularView<Lower>().solve(vec3));
 
+    // several right hand sides, processed by panels of columns
+    {
+      typedef SparseMatrix<Scalar,RowMajor> RowMajorMatrix;
+      typedef Matrix<Scalar,Dynamic,Dynamic,RowMajor> RowMajorDense;
+      int nrhs = ei_random<int>(2,3*EIGEN_TUNE_SPARSE_PANEL_WIDTH);
+      DenseMatrix b = DenseMatrix::Random(rows, nrhs), x = b;
+      DenseMatrix refLo = DenseMatrix::Zero(rows, cols), refUp = DenseMatrix::Zero(rows, cols);
+      SparseMatrix<Scalar> mLo(rows, cols), mUp(rows, cols);
+      initSparse<Scalar>(density, refLo, mLo, ForceNonZeroDiag|MakeLowerTriangular);
+      initSparse<Scalar>(density, refUp, mUp, ForceNonZeroDiag|MakeUpperTriangular);
+      RowMajorMatrix mLoR(mLo), mUpR(mUp);
+      VERIFY_IS_APPROX(mLo.template triangularView<Lower>().solve(b), refLo.template triangularView<Lower>().solve(b));
+      VERIFY_IS_APPROX(mUp.template triangularView<Upper>().solve(b), refUp.template triangularView<Upper>().solve(b));
+      VERIFY_IS_APPROX(mLoR.template triangularView<Lower>().solve(b), refLo.template triangularView<Lower>().solve(b));
+      VERIFY_IS_APPROX(mUpR.template triangularView<Upper>().solve(b), refUp.template triangularView<Upper>().solve(b));
+      VERIFY_IS_APPROX(mLoR.template triangularView<UnitLower>().solve(b), refLo.template triangularView<UnitLower>().solve(b));
+      VERIFY_IS_APPROX(mUpR.template triangularView<UnitUpper>().solve(b), refUp.template triangularView<UnitUpper>().solve(b));
+      RowMajorDense xr = b;
+      mUp.template triangularView<Upper>().solveInPlace(xr);
+      refUp.template triangularView<Upper>().solveInPlace(x);
+      VERIFY_IS_APPROX(DenseMatrix(xr), x);
+      x = b;
+      Block<DenseMatrix> xBlock(x, 0, 1, rows, nrhs-1);
+      mLo.template triangularView<Lower>().solveInPlace(xBlock);
+      VERIFY_IS_APPROX(x.col(0), b.col(0));
+      VERIFY_IS_APPROX(DenseMatrix(x.rightCols(nrhs-1)), refLo.template triangularView<Lower>().solve(b.rightCols(nrhs-1)));
+      // the zero rows of the right hand sides are skipped
+      b.topRows(rows/2).setZero();
+      VERIFY_IS_APPROX(mLo.template triangularView<Lower>().solve(b), refLo.template triangularView<Lower>().solve(b));
+      VERIFY_IS_APPROX(mUp.template triangularView<Upper>().solve(b), refUp.template triangularView<Upper>().solve(b));
+    }
+
     SparseMatrix<Scalar> matB(rows, rows);
     DenseMatrix refMatB = DenseMatrix::Zero(rows, rows);
 
@@ -100,6 +132,30 @@ template<typename Scalar> void sparse_solvers(int rows, int cols)
     m2.template triangularView<Upper>().solveInPlace(matB);
     VERIFY_IS_APPROX(matB, refMatB);
 
+    // level scheduled solver, reading the selected triangular part of a full matrix
+    {
+      typedef SparseMatrix<Scalar,RowMajor> RowMajorMatrix;
+      initSparse<Scalar>(density, refMat2, m2, ForceNonZeroDiag);
+      DenseMatrix refB = DenseMatrix::Random(rows, 3);
+      LevelScheduledTriangularSolver<SparseMatrix<Scalar>, Lower> lower(m2);
+      VERIFY(lower.levels()>=1 && lower.levels()<=rows);
+      VERIFY_IS_APPROX(lower.solve(refB), refMat2.template triangularView<Lower>().solve(refB));
+      LevelScheduledTriangularSolver<SparseMatrix<Scalar>, Upper> upper(m2);
+      VERIFY_IS_APPROX(upper.solve(vec2), refMat2.template triangularView<Upper>().solve(vec2));
+      RowMajorMatrix m2r(m2);
+      LevelScheduledTriangularSolver<RowMajorMatrix, UnitLower> unitLower(m2r);
+      DenseMatrix x = refB;
+      unitLower.solveInPlace(x);
+      VERIFY_IS_APPROX(x, refMat2.template triangularView<UnitLower>().solve(refB));
+      // a diagonal matrix is solved in a single level
+      SparseMatrix<Scalar> d(rows, rows);
+      for (int i=0; i<rows; ++i)
+        d.insert(i,i) = Scalar(i+1);
+      d.finalize();
+      LevelScheduledTriangularSolver<SparseMatrix<Scalar>, Upper> diag(d);
+      VERIFY(diag.levels()==1 && diag.levelSize(0)==rows);
+    }
+
     // test deprecated API
     initSparse<Scalar>(density, refMat2, m2, ForceNonZeroDiag|MakeLowerTriangular, &zeroCoords, &nonzeroCoords);
     VERIFY_IS_APPROX(refMat2.template triangularView<Lower>().solve(vec2),
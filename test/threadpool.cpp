@@ -0,0 +1,340 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Copyright (C) 2010 Gael Guennebaud <gael.guennebaud@inria.fr>
+//
+// Eigen is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// Alternatively, you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation; either version 2 of
+// the License, or (at your option) any later version.
+//
+// Eigen is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License or the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License and a copy of the GNU General Public License along with
+// Eigen. If not, see <http://www.gnu.org/licenses/>.
+
+// evaluate the large coefficient-wise expressions by small chunks to exercise the parallel path
+#define EIGEN_PARALLELIZE_COEFFWISE
+#define EIGEN_TUNE_PARALLEL_COEFFWISE_THRESHOLD 2048
+#define EIGEN_TUNE_PARALLEL_COEFFWISE_CHUNK 512
+
+#include "sparse.h"
+
+// a task whose calls can only complete if they all run concurrently
+class ei_barrier_task : public ThreadPoolTask
+{
+  public:
+    ei_barrier_task(int* hits) : m_arrived(0), m_hits(hits) {}
+    void run(int id, int count) const
+    {
+      ei_atomic_fetch_and_add(&m_arrived, 1);
+      while(m_arrived<count) {}
+      ++m_hits[id];
+    }
+  protected:
+    mutable volatile int m_arrived;
+    int* m_hits;
+};
+
+// a task trying to re-enter the pool it is running on
+class ei_nested_task : public ThreadPoolTask
+{
+  public:
+    ei_nested_task(ThreadPool& pool, const ThreadPoolTask& inner, bool* accepted)
+      : m_pool(pool), m_inner(inner), m_accepted(accepted) {}
+    void run(int id, int) const
+    {
+      m_accepted[id] = m_pool.run(m_inner, 1);
+    }
+  protected:
+    ThreadPool& m_pool;
+    const ThreadPoolTask& m_inner;
+    bool* m_accepted;
+};
+
+void test_pool(PosixThreadPool& pool)
+{
+  int threads = pool.threads();
+
+  for(int count=1; count<=threads; ++count)
+  {
+    std::vector<int> hits(count,0);
+    // run a few jobs in a row to check the pool is properly recycled
+    for(int k=0; k<5; ++k)
+    {
+      ei_barrier_task task(&hits[0]);
+      VERIFY(pool.run(task, count));
+    }
+    for(int i=0; i<count; ++i)
+      VERIFY_IS_EQUAL(hits[i], 5);
+  }
+
+  std::vector<int> hits(1,0);
+  ei_barrier_task inner(&hits[0]);
+  bool accepted[2] = { true, true };
+  ei_nested_task nested(pool, inner, accepted);
+  VERIFY(pool.run(nested, std::min(2,threads)));
+  VERIFY(!accepted[0] && !(threads>1 && accepted[1]));
+  VERIFY_IS_EQUAL(hits[0], 0);
+}
+
+template<typename MatrixType> void parallel_product(int rows, int cols, int depth)
+{
+  typedef Matrix<typename MatrixType::Scalar,Dynamic,Dynamic> ColMajorMatrix;
+  typedef Matrix<typename MatrixType::Scalar,Dynamic,Dynamic,RowMajor> RowMajorMatrix;
+
+  ColMajorMatrix a = ColMajorMatrix::Random(rows,depth);
+  RowMajorMatrix b = RowMajorMatrix::Random(depth,cols);
+  MatrixType c = MatrixType::Random(rows,cols);
+  MatrixType ref = c;
+
+  // sequential reference
+  int oldThreads = nbThreads();
+  setNbThreads(1);
+  ref.noalias() += a * b;
+  setNbThreads(oldThreads);
+
+  c.noalias() += a * b;
+  VERIFY_IS_APPROX(c, ref);
+}
+
+template<typename Scalar> void parallel_sparse_dense_product(int rows, int cols, int rhsCols)
+{
+  typedef Matrix<Scalar,Dynamic,Dynamic> DenseMatrix;
+  typedef Matrix<Scalar,Dynamic,1> DenseVector;
+
+  // large enough for the product to be split among several threads
+  double density = std::max(8./(rows*cols), 0.02);
+  DenseMatrix refMat(rows,cols);
+  SparseMatrix<Scalar> m(rows,cols);
+  initSparse<Scalar>(density, refMat, m);
+  SparseMatrix<Scalar,RowMajor> mr(m);
+
+  DenseVector v = DenseVector::Random(cols), vt = DenseVector::Random(rows);
+  DenseMatrix b = DenseMatrix::Random(cols,rhsCols);
+  DenseVector res = DenseVector::Random(rows), ref = res;
+
+  res.noalias() += m * v;
+  ref.noalias() += refMat * v;
+  VERIFY_IS_APPROX(res, ref);
+
+  VERIFY_IS_APPROX(res = mr * v, ref = refMat * v);
+  VERIFY_IS_APPROX(res = m.transpose() * vt, ref = refMat.transpose() * vt);
+  VERIFY_IS_APPROX(res = mr.transpose() * vt, ref = refMat.transpose() * vt);
+
+  DenseMatrix resMat(rows,rhsCols), refMatRes(rows,rhsCols);
+  VERIFY_IS_APPROX(resMat = m * b, refMatRes = refMat * b);
+  VERIFY_IS_APPROX(resMat = mr * b, refMatRes = refMat * b);
+}
+
+template<typename Scalar> void parallel_sparse_sparse_product(int rows, int depth, int cols)
+{
+  typedef Matrix<Scalar,Dynamic,Dynamic> DenseMatrix;
+
+  DenseMatrix refA = DenseMatrix::Zero(rows,depth), refB = DenseMatrix::Zero(depth,cols);
+  SparseMatrix<Scalar> a(rows,depth), b(depth,cols);
+  initSparse<Scalar>(std::max(8./(rows*depth), 0.01), refA, a);
+  initSparse<Scalar>(std::max(8./(depth*cols), 0.01), refB, b);
+  SparseMatrix<Scalar,RowMajor> ar(a), br(b);
+
+  // sequential reference
+  int oldThreads = nbThreads();
+  setNbThreads(1);
+  SparseMatrix<Scalar> ref = a * b;
+  setNbThreads(oldThreads);
+
+  SparseMatrix<Scalar> c = a * b;
+  VERIFY_IS_EQUAL(c.nonZeros(), ref.nonZeros());
+  VERIFY_IS_APPROX(c, ref);
+  VERIFY_IS_APPROX(DenseMatrix(c), refA * refB);
+
+  SparseMatrix<Scalar,RowMajor> cr = ar * br;
+  VERIFY_IS_APPROX(DenseMatrix(cr), refA * refB);
+  VERIFY_IS_APPROX(c = a * a.transpose(), refA * refA.transpose());
+}
+
+template<typename Scalar> void parallel_level_scheduled_solve(int size, int rhsCols)
+{
+  typedef Matrix<Scalar,Dynamic,Dynamic> DenseMatrix;
+
+  // a very sparse triangular matrix has few and wide levels
+  DenseMatrix refMat = DenseMatrix::Zero(size,size);
+  SparseMatrix<Scalar> m(size,size);
+  initSparse<Scalar>(std::max(8./(size*size), 0.002), refMat, m, ForceNonZeroDiag|MakeLowerTriangular);
+  DenseMatrix b = DenseMatrix::Random(size,rhsCols);
+
+  LevelScheduledTriangularSolver<SparseMatrix<Scalar>, Lower> lower(m);
+  DenseMatrix x = lower.solve(b);
+  VERIFY_IS_APPROX(x, refMat.template triangularView<Lower>().solve(b));
+
+  SparseMatrix<Scalar> mt = m.adjoint();
+  LevelScheduledTriangularSolver<SparseMatrix<Scalar>, Upper> upper(mt);
+  VERIFY_IS_APPROX(upper.solve(b), refMat.adjoint().template triangularView<Upper>().solve(b));
+}
+
+template<typename Scalar> void parallel_coeffwise(int size)
+{
+  typedef Matrix<Scalar,Dynamic,1> Vector;
+  typedef typename NumTraits<Scalar>::Real RealScalar;
+
+  Vector a = Vector::Random(size), b = Vector::Random(size);
+  Vector c(size), ref(size);
+
+  // sequential references
+  int oldThreads = nbThreads();
+  setNbThreads(1);
+  ref = a + Scalar(2)*b;
+  Scalar sum = a.sum(), dot = a.dot(b);
+  RealScalar norm = a.norm();
+  setNbThreads(oldThreads);
+
+  c = a + Scalar(2)*b;
+  VERIFY((c.array()==ref.array()).all());
+
+  // the reductions do not depend on the number of threads
+  VERIFY(a.sum()==sum);
+  VERIFY(a.dot(b)==dot);
+  VERIFY(a.norm()==norm);
+
+  // the references are compared relatively to the sums of the absolute values because of the cancellations
+  Scalar refSum(0), refDot(0);
+  RealScalar absSum(0), absDot(0);
+  for(int i=0; i<size; ++i)
+  {
+    refSum += a(i);
+    refDot += ei_conj(a(i))*b(i);
+    absSum += ei_abs(a(i));
+    absDot += ei_abs(a(i))*ei_abs(b(i));
+  }
+  VERIFY_IS_MUCH_SMALLER_THAN(sum-refSum, absSum);
+  VERIFY_IS_MUCH_SMALLER_THAN(dot-refDot, absDot);
+  VERIFY_IS_APPROX(norm, ei_sqrt(ei_real(a.dot(a))));
+
+  // compound assignments, swap, and unaligned segments
+  c = a;
+  c += b;
+  c -= Scalar(3)*a;
+  for(int i=0; i<size; ++i)
+    ref(i) = b(i) - Scalar(2)*a(i);
+  VERIFY_IS_APPROX(c, ref);
+  c = a;
+  ref = b;
+  c.swap(ref);
+  VERIFY_IS_APPROX(c, b);
+  VERIFY_IS_APPROX(ref, a);
+  if(size>2)
+  {
+    c.segment(1,size-2) = a.tail(size-2) * Scalar(2);
+    for(int i=0; i<size-2; ++i)
+      VERIFY_IS_APPROX(c(i+1), Scalar(2)*a(i+2));
+    VERIFY_IS_MUCH_SMALLER_THAN(a.segment(1,size-2).sum() - (sum - a(0) - a(size-1)), absSum);
+  }
+}
+
+template<typename MatrixType> void parallel_visitor(int rows, int cols)
+{
+  typedef typename MatrixType::Scalar Scalar;
+  typedef typename MatrixType::Index Index;
+
+  MatrixType m = MatrixType::Random(rows,cols);
+  // introduce ties, the first occurrence in column-major order has to be reported
+  for(int k=0; k<2; ++k)
+  {
+    m(ei_random<Index>(0,rows-1), ei_random<Index>(0,cols-1)) = Scalar(2);
+    m(ei_random<Index>(0,rows-1), ei_random<Index>(0,cols-1)) = Scalar(-2);
+  }
+
+  Index minRow = 0, minCol = 0, maxRow = 0, maxCol = 0;
+  for(Index j=0; j<cols; ++j)
+    for(Index i=0; i<rows; ++i)
+    {
+      if(m(i,j) < m(minRow,minCol))
+      {
+        minRow = i;
+        minCol = j;
+      }
+      if(m(i,j) > m(maxRow,maxCol))
+      {
+        maxRow = i;
+        maxCol = j;
+      }
+    }
+
+  Index row, col;
+  VERIFY_IS_EQUAL(m.minCoeff(&row,&col), m(minRow,minCol));
+  VERIFY(row==minRow && col==minCol);
+  VERIFY_IS_EQUAL(m.maxCoeff(&row,&col), m(maxRow,maxCol));
+  VERIFY(row==maxRow && col==maxCol);
+  VERIFY_IS_EQUAL(m.minCoeff(), m(minRow,minCol));
+  VERIFY_IS_EQUAL(m.maxCoeff(), m(maxRow,maxCol));
+}
+
+void test_partition()
+{
+  typedef DenseIndex Index;
+  // tiny products are not worth a second thread
+  VERIFY_IS_EQUAL(ei_compute_gemm_partition<Index>(16, 16, 16, 16, 8).threads(), 1);
+  // large square products use all the threads in cooperative mode
+  GemmParallelPartition<Index> p = ei_compute_gemm_partition<Index>(2000, 2000, 2000, 256, 8);
+  VERIFY_IS_EQUAL(p.threads(), 8);
+  // tall and skinny products are split along the rows
+  p = ei_compute_gemm_partition<Index>(100000, 8, 256, 256, 16);
+  VERIFY(p.threads()>1 && p.colBlocks==1);
+  // short and wide products must be split along the columns
+  p = ei_compute_gemm_partition<Index>(16, 100000, 256, 256, 16);
+  VERIFY(p.threads()>2 && p.colBlocks>2);
+  // the grid never exceeds the allowed number of threads
+  for(int k=0; k<g_repeat; ++k)
+  {
+    Index maxThreads = ei_random<Index>(1,64);
+    p = ei_compute_gemm_partition<Index>(ei_random<Index>(1,5000), ei_random<Index>(1,5000), ei_random<Index>(1,5000), 256, maxThreads);
+    VERIFY(p.threads()>=1 && p.threads()<=maxThreads);
+  }
+}
+
+void test_threadpool()
+{
+  CALL_SUBTEST_6( test_partition() );
+
+  PosixThreadPool pool(4);
+  VERIFY(pool.threads()>=1 && pool.threads()<=4);
+  CALL_SUBTEST_1( test_pool(pool) );
+
+  setThreadPool(&pool);
+  VERIFY(threadPool()==&pool);
+  VERIFY(nbThreads()==pool.threads());
+  for(int i = 0; i < g_repeat; i++) {
+    CALL_SUBTEST_2( parallel_product<MatrixXf>(ei_random<int>(64,400), ei_random<int>(64,400), ei_random<int>(1,300)) );
+    CALL_SUBTEST_3( parallel_product<MatrixXd>(ei_random<int>(64,300), ei_random<int>(1,300), ei_random<int>(1,300)) );
+    CALL_SUBTEST_4( parallel_product<MatrixXcf>(ei_random<int>(64,200), ei_random<int>(64,200), ei_random<int>(1,200)) );
+    CALL_SUBTEST_5( (parallel_product<Matrix<double,Dynamic,Dynamic,RowMajor> >(ei_random<int>(1,300), ei_random<int>(64,300), ei_random<int>(1,300))) );
+    // tall-skinny and short-wide shapes
+    CALL_SUBTEST_6( parallel_product<MatrixXf>(ei_random<int>(2000,4000), ei_random<int>(1,16), ei_random<int>(1,100)) );
+    CALL_SUBTEST_6( parallel_product<MatrixXf>(ei_random<int>(1,16), ei_random<int>(2000,4000), ei_random<int>(1,100)) );
+    CALL_SUBTEST_6( (parallel_product<Matrix<float,Dynamic,Dynamic,RowMajor> >(ei_random<int>(1,16), ei_random<int>(2000,4000), ei_random<int>(1,100))) );
+    CALL_SUBTEST_6( (parallel_product<Matrix<float,Dynamic,Dynamic,RowMajor> >(ei_random<int>(2000,4000), ei_random<int>(1,16), ei_random<int>(1,100))) );
+    CALL_SUBTEST_7( parallel_sparse_dense_product<double>(ei_random<int>(1000,3000), ei_random<int>(1000,3000), ei_random<int>(1,8)) );
+    CALL_SUBTEST_7( parallel_sparse_dense_product<std::complex<float> >(ei_random<int>(1,3000), ei_random<int>(1,3000), ei_random<int>(1,8)) );
+    CALL_SUBTEST_8( parallel_sparse_sparse_product<double>(ei_random<int>(1,2000), ei_random<int>(1,2000), ei_random<int>(1,2000)) );
+    CALL_SUBTEST_8( parallel_sparse_sparse_product<std::complex<double> >(ei_random<int>(1,1000), ei_random<int>(1,1000), ei_random<int>(1,1000)) );
+    CALL_SUBTEST_9( parallel_level_scheduled_solve<double>(ei_random<int>(1,3000), ei_random<int>(16,64)) );
+    CALL_SUBTEST_9( parallel_level_scheduled_solve<std::complex<double> >(ei_random<int>(1,2000), ei_random<int>(1,4)) );
+    CALL_SUBTEST_10( parallel_coeffwise<float>(ei_random<int>(1,200000)) );
+    CALL_SUBTEST_10( parallel_coeffwise<double>(ei_random<int>(1,200000)) );
+    CALL_SUBTEST_10( parallel_coeffwise<std::complex<double> >(ei_random<int>(1,100000)) );
+    CALL_SUBTEST_10( parallel_visitor<MatrixXd>(ei_random<int>(1,500), ei_random<int>(1,500)) );
+    CALL_SUBTEST_10( (parallel_visitor<Matrix<float,Dynamic,Dynamic,RowMajor> >(ei_random<int>(1,500), ei_random<int>(1,500))) );
+    CALL_SUBTEST_10( parallel_visitor<VectorXf>(ei_random<int>(1,200000), 1) );
+  }
+  setThreadPool(0);
+  VERIFY(threadPool()==0);
+}
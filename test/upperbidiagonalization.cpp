@@ -53,4 +53,7 @@ void test_upperbidiagonalization()
    CALL_SUBTEST_6( upperbidiag(Matrix<float,5,5>()) );
    CALL_SUBTEST_7( upperbidiag(Matrix<double,4,3>()) );
   }
+  // large enough for the blocked algorithm
+  CALL_SUBTEST_8( upperbidiag(MatrixXd(300,200)) );
+  CALL_SUBTEST_9( upperbidiag(MatrixXcf(180,170)) );
 }
@@ -169,8 +169,14 @@ template<typename Scalar, bool Enable = ei_packet_traits<Scalar>::Vectorizable>
       VERIFY(test_assign(Matrix<Scalar,17,17>(),Matrix<Scalar,17,17>()+Matrix<Scalar,17,17>(),
         LinearTraversal,NoUnrolling));
 
+#ifdef EIGEN_VECTORIZE_AVX
+      // with 8 scalars per packet the (10,4) block would not fit in a 17x17 matrix
+      VERIFY(test_assign(Matrix11(),Matrix<Scalar,17,17>().template block<PacketSize,PacketSize>(2,3)+Matrix<Scalar,17,17>().template block<PacketSize,PacketSize>(8,4),
+      DefaultTraversal,PacketSize>4?InnerUnrolling:CompleteUnrolling));
+#else
       VERIFY(test_assign(Matrix11(),Matrix<Scalar,17,17>().template block<PacketSize,PacketSize>(2,3)+Matrix<Scalar,17,17>().template block<PacketSize,PacketSize>(10,4),
       DefaultTraversal,CompleteUnrolling));
+#endif
     }
 
     VERIFY(test_assign(MatrixXX(10,10),MatrixXX(20,20).block(10,10,2,3),
@@ -184,7 +190,11 @@ template<typename Scalar, bool Enable = ei_packet_traits<Scalar>::Vectorizable>
     VERIFY((test_assign<
             Map<Matrix22, Aligned, InnerStride<3*PacketSize> >,
             Matrix22
+#ifdef EIGEN_VECTORIZE_AVX
+            >(DefaultTraversal,4*PacketSize*PacketSize*NumTraits<Scalar>::ReadCost>EIGEN_UNROLLING_LIMIT?InnerUnrolling:CompleteUnrolling)));
+#else
             >(DefaultTraversal,CompleteUnrolling)));
+#endif
 
     VERIFY(test_redux(VectorX(10),
       LinearVectorizedTraversal,NoUnrolling));
@@ -201,8 +211,14 @@ template<typename Scalar, bool Enable = ei_packet_traits<Scalar>::Vectorizable>
     VERIFY(test_redux(Matrix44c().template block<2*PacketSize,1>(1,2),
       LinearVectorizedTraversal,CompleteUnrolling));
 
+#ifdef EIGEN_VECTORIZE_AVX
+    // a row of 2*8 scalars only fits in a 16 wide matrix from the first column
+    VERIFY(test_redux(Matrix44r().template block<1,2*PacketSize>(2,0),
+      LinearVectorizedTraversal,CompleteUnrolling));
+#else
     VERIFY(test_redux(Matrix44r().template block<1,2*PacketSize>(2,1),
       LinearVectorizedTraversal,CompleteUnrolling));
+#endif
   }
 };
 
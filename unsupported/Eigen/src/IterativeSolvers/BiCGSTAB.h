@@ -0,0 +1,164 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Copyright (C) 2010 Gael Guennebaud <gael.guennebaud@inria.fr>
+//
+// Eigen is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// Alternatively, you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation; either version 2 of
+// the License, or (at your option) any later version.
+//
+// Eigen is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License or the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License and a copy of the GNU General Public License along with
+// Eigen. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef EIGEN_BICGSTAB_H
+#define EIGEN_BICGSTAB_H
+
+/** \ingroup IterativeSolvers_Module
+  * Right preconditioned bi-conjugate gradient stabilized method (BiCGSTAB)
+  *
+  * Solves \f$ A x = b \f$ for a general square operator \a A, starting from the initial guess \a x.
+  * The iterations stop when \f$ \Vert b - A x \Vert \le \epsilon \Vert b \Vert \f$ where \f$ \epsilon \f$ is
+  * the maximal residual of \a iter, or when its maximal number of iterations is reached.
+  * When the shadow residual becomes orthogonal to the residual, the method is restarted from the current iterate.
+  *
+  * \param A the operator, see ei_linear_operator for the requirements on its type
+  * \param x on input the initial guess, on output the solution
+  * \param b the right hand side
+  * \param precond a preconditioner, see IdentityPreconditioner
+  * \param iter the iteration controller, see IterationController::converged() to check the convergence
+  *
+  * \returns \c Success if the iterations converged, \c NumericalIssue if the preconditioner failed, and
+  * \c NoConvergence otherwise, in particular when the method breaks down.
+  *
+  * All the work vectors are allocated once before the first iteration, the products by \a A possibly
+  * allocating their own temporaries (see ei_linear_operator).
+  */
+template<typename MatrixType, typename VectorX, typename VectorB, typename Preconditioner>
+ComputationInfo ei_bicgstab(const MatrixType& A, VectorX& x, const VectorB& b,
+                 const Preconditioner& precond, IterationController& iter)
+{
+  typedef typename VectorX::Scalar Scalar;
+  typedef typename NumTraits<Scalar>::Real RealScalar;
+  typedef Matrix<Scalar,Dynamic,1> TmpVec;
+  // without preconditioner, y and z would be copies of p and r
+  const bool precondIsIdentity = ei_is_same_type<Preconditioner,IdentityPreconditioner>::ret;
+
+  const typename VectorX::Index n = x.size();
+  TmpVec r(n), r0(n), p(n), v(n), y, z, t(n);
+  if (!precondIsIdentity)
+  {
+    y.resize(n);
+    z.resize(n);
+  }
+  const TmpVec& yk = precondIsIdentity ? p : y;
+  const TmpVec& zk = precondIsIdentity ? r : z;
+  // the iterate is updated along with the residual, by a fused kernel requiring a plain vector
+  TmpVec xk = x;
+
+  iter.setRhsNorm(b.norm());
+  if (iter.rhsNorm() == 0.0)
+  {
+    x.setZero();
+    iter.converged(0.0);
+    return Success;
+  }
+
+  ei_linear_operator<MatrixType>::run(A, xk, t);
+  r = b - t;
+  RealScalar eps2 = ei_abs2(NumTraits<Scalar>::epsilon() * iter.rhsNorm());
+  RealScalar rNorm2 = r.squaredNorm(), r0Norm2 = 0;
+  Scalar rho = 1, alpha = 1, omega = 1, r0DotR = 0;
+  bool restart = true;
+  ComputationInfo info = Success;
+
+  while (!iter.finished(ei_sqrt(rNorm2)))
+  {
+    bool restarted = restart;
+    if (restart)
+    {
+      r0 = r;
+      r0Norm2 = rNorm2;
+      r0DotR = rNorm2;
+      rho = alpha = omega = Scalar(1);
+      p.setZero();
+      v.setZero();
+      restart = false;
+    }
+
+    Scalar rho_1 = rho;
+    rho = r0DotR;
+    if (ei_abs2(rho) <= eps2 * r0Norm2)
+    {
+      // the shadow residual is (almost) orthogonal to the residual,
+      // there is nothing more to do if it has just been reset
+      if (restarted) break;
+      restart = true;
+      continue;
+    }
+    p = r + ((rho/rho_1)*(alpha/omega)) * (p - omega * v);
+
+    if (!precondIsIdentity)
+    {
+      y = p;
+      if (!precond.solveInPlace(y))
+      {
+        info = NumericalIssue;
+        break;
+      }
+    }
+    ei_linear_operator<MatrixType>::run(A, yk, v);
+    Scalar r0DotV = r0.dot(v);
+    if (r0DotV==Scalar(0))
+    {
+      // breakdown: the next iterate is not defined
+      info = NoConvergence;
+      break;
+    }
+    alpha = rho / r0DotV;
+    r -= alpha * v;
+
+    if (!precondIsIdentity)
+    {
+      z = r;
+      if (!precond.solveInPlace(z))
+      {
+        info = NumericalIssue;
+        break;
+      }
+    }
+    ei_linear_operator<MatrixType>::run(A, zk, t);
+    RealScalar tt;
+    Scalar ts = ei_fused_dot_norm(t, r, tt);
+    omega = tt==RealScalar(0) ? Scalar(0) : ts / tt;
+
+    // x += alpha*y + omega*z, r -= omega*t, and the reductions of the next iteration
+    rNorm2 = ei_fused_bicgstab_update(xk, alpha, yk, omega, zk, r, t, r0, r0DotR);
+    restart = omega==Scalar(0);
+    ++iter;
+  }
+  x = xk;
+  return info==Success && !iter.converged() ? NoConvergence : info;
+}
+
+/** \ingroup IterativeSolvers_Module
+  * Unpreconditioned BiCGSTAB, see ei_bicgstab(const MatrixType&, VectorX&, const VectorB&, const Preconditioner&, IterationController&)
+  */
+template<typename MatrixType, typename VectorX, typename VectorB>
+ComputationInfo ei_bicgstab(const MatrixType& A, VectorX& x, const VectorB& b, IterationController& iter)
+{
+  return ei_bicgstab(A, x, b, IdentityPreconditioner(), iter);
+}
+
+#endif // EIGEN_BICGSTAB_H
@@ -0,0 +1,128 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Copyright (C) 2010 Gael Guennebaud <gael.guennebaud@inria.fr>
+//
+// Eigen is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// Alternatively, you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation; either version 2 of
+// the License, or (at your option) any later version.
+//
+// Eigen is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License or the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License and a copy of the GNU General Public License along with
+// Eigen. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef EIGEN_CONJUGATE_GRADIENT_H
+#define EIGEN_CONJUGATE_GRADIENT_H
+
+/** \ingroup IterativeSolvers_Module
+  * Preconditioned conjugate gradient
+  *
+  * Solves \f$ A x = b \f$ for a selfadjoint positive definite operator \a A, starting from the initial guess \a x.
+  * The iterations stop when \f$ \Vert b - A x \Vert \le \epsilon \Vert b \Vert \f$ where \f$ \epsilon \f$ is
+  * the maximal residual of \a iter, or when its maximal number of iterations is reached.
+  *
+  * \param A the operator, see ei_linear_operator for the requirements on its type
+  * \param x on input the initial guess, on output the solution
+  * \param b the right hand side
+  * \param precond a preconditioner which must be selfadjoint positive definite, see IdentityPreconditioner
+  * \param iter the iteration controller, see IterationController::converged() to check the convergence
+  *
+  * \returns \c Success if the iterations converged, \c NumericalIssue if the preconditioner failed, and
+  * \c NoConvergence otherwise.
+  *
+  * All the work vectors are allocated once before the first iteration, the products by \a A possibly
+  * allocating their own temporaries (see ei_linear_operator).
+  */
+template<typename MatrixType, typename VectorX, typename VectorB, typename Preconditioner>
+ComputationInfo ei_conjugate_gradient(const MatrixType& A, VectorX& x, const VectorB& b,
+                           const Preconditioner& precond, IterationController& iter)
+{
+  typedef typename VectorX::Scalar Scalar;
+  typedef typename NumTraits<Scalar>::Real RealScalar;
+  typedef Matrix<Scalar,Dynamic,1> TmpVec;
+  // without preconditioner, z would be a copy of r
+  const bool precondIsIdentity = ei_is_same_type<Preconditioner,IdentityPreconditioner>::ret;
+
+  const typename VectorX::Index n = x.size();
+  TmpVec r(n), z, p(n), q(n);
+  if (!precondIsIdentity)
+    z.resize(n);
+  // the iterate is updated along with the residual, by a fused kernel requiring a plain vector
+  TmpVec xk = x;
+
+  iter.setRhsNorm(b.norm());
+  if (iter.rhsNorm() == 0.0)
+  {
+    x.setZero();
+    iter.converged(0.0);
+    return Success;
+  }
+
+  ei_linear_operator<MatrixType>::run(A, xk, q);
+  r = b - q;
+  RealScalar rNorm2 = r.squaredNorm(), rho, rho_1;
+  if (precondIsIdentity)
+  {
+    p = r;
+    rho = rNorm2;
+  }
+  else
+  {
+    z = r;
+    if (!precond.solveInPlace(z))
+      return NumericalIssue;
+    p = z;
+    rho = ei_real(r.dot(z));
+  }
+
+  ComputationInfo info = Success;
+  while (!iter.finished(ei_sqrt(rNorm2)))
+  {
+    ei_linear_operator<MatrixType>::run(A, p, q);
+    Scalar alpha = rho / p.dot(q);
+    rNorm2 = ei_fused_cg_update(xk, alpha, p, r, q);
+
+    rho_1 = rho;
+    if (precondIsIdentity)
+    {
+      rho = rNorm2;
+      p = r + (rho/rho_1) * p;
+    }
+    else
+    {
+      z = r;
+      if (!precond.solveInPlace(z))
+      {
+        info = NumericalIssue;
+        break;
+      }
+      rho = ei_real(r.dot(z));
+      p = z + (rho/rho_1) * p;
+    }
+    ++iter;
+  }
+  x = xk;
+  return info==Success && !iter.converged() ? NoConvergence : info;
+}
+
+/** \ingroup IterativeSolvers_Module
+  * Unpreconditioned conjugate gradient, see ei_conjugate_gradient(const MatrixType&, VectorX&, const VectorB&, const Preconditioner&, IterationController&)
+  */
+template<typename MatrixType, typename VectorX, typename VectorB>
+ComputationInfo ei_conjugate_gradient(const MatrixType& A, VectorX& x, const VectorB& b, IterationController& iter)
+{
+  return ei_conjugate_gradient(A, x, b, IdentityPreconditioner(), iter);
+}
+
+#endif // EIGEN_CONJUGATE_GRADIENT_H
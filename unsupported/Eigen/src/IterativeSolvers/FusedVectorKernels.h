@@ -0,0 +1,321 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Copyright (C) 2010 Gael Guennebaud <gael.guennebaud@inria.fr>
+//
+// Eigen is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// Alternatively, you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation; either version 2 of
+// the License, or (at your option) any later version.
+//
+// Eigen is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License or the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License and a copy of the GNU General Public License along with
+// Eigen. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef EIGEN_FUSED_VECTOR_KERNELS_H
+#define EIGEN_FUSED_VECTOR_KERNELS_H
+
+/** \internal
+  * Runs \a kernel over the coefficients [0,size) in a single pass. The kernel provides a coeff(i) method and,
+  * when its Vectorizable flag is set, a packet(i) method processing the coefficients [i,i+PacketSize) which is
+  * used for all the full packets. Kernels carrying reductions accumulate them into members.
+  *
+  * This is how the iterative solvers merge the updates of their work vectors with the reductions computed from
+  * the updated values, e.g., \c x \c += \c a*p, \c r \c -= \c a*q and \c r.squaredNorm(), which would otherwise
+  * stream the vectors once per expression.
+  */
+template<typename Kernel, bool Vectorize = Kernel::Vectorizable> struct ei_fused_vector_loop
+{
+  typedef typename Kernel::Index Index;
+  static inline void run(Kernel& kernel, Index size)
+  {
+    for(Index i=0; i<size; ++i)
+      kernel.coeff(i);
+    kernel.finalize();
+  }
+};
+
+template<typename Kernel> struct ei_fused_vector_loop<Kernel,true>
+{
+  typedef typename Kernel::Index Index;
+  enum { PacketSize = ei_packet_traits<typename Kernel::Scalar>::size };
+  static inline void run(Kernel& kernel, Index size)
+  {
+    const Index packetEnd = size - size%PacketSize;
+    for(Index i=0; i<packetEnd; i+=PacketSize)
+      kernel.packet(i);
+    for(Index i=packetEnd; i<size; ++i)
+      kernel.coeff(i);
+    kernel.finalize();
+  }
+};
+
+/** \internal common typedefs of the fused kernels */
+template<typename _Scalar, typename _Index> struct ei_fused_kernel_base
+{
+  typedef _Scalar Scalar;
+  typedef _Index Index;
+  typedef typename NumTraits<Scalar>::Real RealScalar;
+  typedef typename ei_packet_traits<Scalar>::type Packet;
+  enum {
+    // complex coefficients would need conjugate products, they are processed one at a time
+    Vectorizable = ei_packet_traits<Scalar>::Vectorizable && !NumTraits<Scalar>::IsComplex
+  };
+};
+
+/** \internal x += alpha*p, r -= alpha*q, and accumulates r.squaredNorm() */
+template<typename Scalar, typename Index>
+struct ei_fused_cg_update_kernel : ei_fused_kernel_base<Scalar,Index>
+{
+  typedef ei_fused_kernel_base<Scalar,Index> Base;
+  typedef typename Base::RealScalar RealScalar;
+  typedef typename Base::Packet Packet;
+
+  ei_fused_cg_update_kernel(Scalar alpha, const Scalar* p, const Scalar* q, Scalar* x, Scalar* r)
+    : m_alpha(alpha), m_p(p), m_q(q), m_x(x), m_r(r), m_palpha(ei_pset1<Packet>(alpha)), m_pacc(ei_pset1<Packet>(Scalar(0))), m_norm2(0)
+  {}
+
+  inline void coeff(Index i)
+  {
+    m_x[i] += m_alpha * m_p[i];
+    m_r[i] -= m_alpha * m_q[i];
+    m_norm2 += ei_abs2(m_r[i]);
+  }
+  inline void packet(Index i)
+  {
+    Packet r = ei_psub(ei_ploadu<Packet>(m_r+i), ei_pmul(m_palpha, ei_ploadu<Packet>(m_q+i)));
+    ei_pstoreu(m_x+i, ei_pmadd(m_palpha, ei_ploadu<Packet>(m_p+i), ei_ploadu<Packet>(m_x+i)));
+    ei_pstoreu(m_r+i, r);
+    m_pacc = ei_pmadd(r, r, m_pacc);
+  }
+  inline void finalize() { m_norm2 += ei_real(ei_predux(m_pacc)); }
+
+  Scalar m_alpha;
+  const Scalar* m_p; const Scalar* m_q;
+  Scalar* m_x; Scalar* m_r;
+  Packet m_palpha, m_pacc;
+  RealScalar m_norm2;
+};
+
+/** \internal x += alpha*y + omega*z, r -= omega*t, and accumulates r.squaredNorm() and r0.dot(r) */
+template<typename Scalar, typename Index>
+struct ei_fused_bicgstab_update_kernel : ei_fused_kernel_base<Scalar,Index>
+{
+  typedef ei_fused_kernel_base<Scalar,Index> Base;
+  typedef typename Base::RealScalar RealScalar;
+  typedef typename Base::Packet Packet;
+
+  ei_fused_bicgstab_update_kernel(Scalar alpha, Scalar omega, const Scalar* y, const Scalar* z, const Scalar* t,
+                                  const Scalar* r0, Scalar* x, Scalar* r)
+    : m_alpha(alpha), m_omega(omega), m_y(y), m_z(z), m_t(t), m_r0(r0), m_x(x), m_r(r),
+      m_palpha(ei_pset1<Packet>(alpha)), m_pomega(ei_pset1<Packet>(omega)), m_pnorm(ei_pset1<Packet>(Scalar(0))), m_pdot(ei_pset1<Packet>(Scalar(0))),
+      m_norm2(0), m_dot(0)
+  {}
+
+  // z may alias r, so x must be updated first
+  inline void coeff(Index i)
+  {
+    m_x[i] += m_alpha * m_y[i] + m_omega * m_z[i];
+    m_r[i] -= m_omega * m_t[i];
+    m_norm2 += ei_abs2(m_r[i]);
+    m_dot += ei_conj(m_r0[i]) * m_r[i];
+  }
+  inline void packet(Index i)
+  {
+    Packet x = ei_pmadd(m_palpha, ei_ploadu<Packet>(m_y+i), ei_ploadu<Packet>(m_x+i));
+    ei_pstoreu(m_x+i, ei_pmadd(m_pomega, ei_ploadu<Packet>(m_z+i), x));
+    Packet r = ei_psub(ei_ploadu<Packet>(m_r+i), ei_pmul(m_pomega, ei_ploadu<Packet>(m_t+i)));
+    ei_pstoreu(m_r+i, r);
+    m_pnorm = ei_pmadd(r, r, m_pnorm);
+    m_pdot = ei_pmadd(ei_ploadu<Packet>(m_r0+i), r, m_pdot);
+  }
+  inline void finalize()
+  {
+    m_norm2 += ei_real(ei_predux(m_pnorm));
+    m_dot += ei_predux(m_pdot);
+  }
+
+  Scalar m_alpha, m_omega;
+  const Scalar* m_y; const Scalar* m_z; const Scalar* m_t; const Scalar* m_r0;
+  Scalar* m_x; Scalar* m_r;
+  Packet m_palpha, m_pomega, m_pnorm, m_pdot;
+  RealScalar m_norm2;
+  Scalar m_dot;
+};
+
+/** \internal accumulates a.dot(b) and a.squaredNorm() */
+template<typename Scalar, typename Index>
+struct ei_fused_dot_norm_kernel : ei_fused_kernel_base<Scalar,Index>
+{
+  typedef ei_fused_kernel_base<Scalar,Index> Base;
+  typedef typename Base::RealScalar RealScalar;
+  typedef typename Base::Packet Packet;
+
+  ei_fused_dot_norm_kernel(const Scalar* a, const Scalar* b)
+    : m_a(a), m_b(b), m_pdot(ei_pset1<Packet>(Scalar(0))), m_pnorm(ei_pset1<Packet>(Scalar(0))), m_dot(0), m_norm2(0)
+  {}
+
+  inline void coeff(Index i)
+  {
+    m_dot += ei_conj(m_a[i]) * m_b[i];
+    m_norm2 += ei_abs2(m_a[i]);
+  }
+  inline void packet(Index i)
+  {
+    Packet a = ei_ploadu<Packet>(m_a+i);
+    m_pdot = ei_pmadd(a, ei_ploadu<Packet>(m_b+i), m_pdot);
+    m_pnorm = ei_pmadd(a, a, m_pnorm);
+  }
+  inline void finalize()
+  {
+    m_dot += ei_predux(m_pdot);
+    m_norm2 += ei_real(ei_predux(m_pnorm));
+  }
+
+  const Scalar* m_a; const Scalar* m_b;
+  Packet m_pdot, m_pnorm;
+  Scalar m_dot;
+  RealScalar m_norm2;
+};
+
+/** \internal y -= alpha*x, and accumulates y.squaredNorm() */
+template<typename Scalar, typename Index>
+struct ei_fused_axpy_norm_kernel : ei_fused_kernel_base<Scalar,Index>
+{
+  typedef ei_fused_kernel_base<Scalar,Index> Base;
+  typedef typename Base::RealScalar RealScalar;
+  typedef typename Base::Packet Packet;
+
+  ei_fused_axpy_norm_kernel(Scalar alpha, const Scalar* x, Scalar* y)
+    : m_alpha(alpha), m_x(x), m_y(y), m_palpha(ei_pset1<Packet>(alpha)), m_pnorm(ei_pset1<Packet>(Scalar(0))), m_norm2(0)
+  {}
+
+  inline void coeff(Index i)
+  {
+    m_y[i] -= m_alpha * m_x[i];
+    m_norm2 += ei_abs2(m_y[i]);
+  }
+  inline void packet(Index i)
+  {
+    Packet y = ei_psub(ei_ploadu<Packet>(m_y+i), ei_pmul(m_palpha, ei_ploadu<Packet>(m_x+i)));
+    ei_pstoreu(m_y+i, y);
+    m_pnorm = ei_pmadd(y, y, m_pnorm);
+  }
+  inline void finalize() { m_norm2 += ei_real(ei_predux(m_pnorm)); }
+
+  Scalar m_alpha;
+  const Scalar* m_x;
+  Scalar* m_y;
+  Packet m_palpha, m_pnorm;
+  RealScalar m_norm2;
+};
+
+/** \internal y -= alpha*x, and accumulates u.dot(y) */
+template<typename Scalar, typename Index>
+struct ei_fused_axpy_dot_kernel : ei_fused_kernel_base<Scalar,Index>
+{
+  typedef ei_fused_kernel_base<Scalar,Index> Base;
+  typedef typename Base::Packet Packet;
+
+  ei_fused_axpy_dot_kernel(Scalar alpha, const Scalar* x, const Scalar* u, Scalar* y)
+    : m_alpha(alpha), m_x(x), m_u(u), m_y(y), m_palpha(ei_pset1<Packet>(alpha)), m_pdot(ei_pset1<Packet>(Scalar(0))), m_dot(0)
+  {}
+
+  inline void coeff(Index i)
+  {
+    m_y[i] -= m_alpha * m_x[i];
+    m_dot += ei_conj(m_u[i]) * m_y[i];
+  }
+  inline void packet(Index i)
+  {
+    Packet y = ei_psub(ei_ploadu<Packet>(m_y+i), ei_pmul(m_palpha, ei_ploadu<Packet>(m_x+i)));
+    ei_pstoreu(m_y+i, y);
+    m_pdot = ei_pmadd(ei_ploadu<Packet>(m_u+i), y, m_pdot);
+  }
+  inline void finalize() { m_dot += ei_predux(m_pdot); }
+
+  Scalar m_alpha;
+  const Scalar* m_x; const Scalar* m_u;
+  Scalar* m_y;
+  Packet m_palpha, m_pdot;
+  Scalar m_dot;
+};
+
+/** \internal Performs \a x += \a alpha * \a p and \a r -= \a alpha * \a q in a single pass.
+  * \returns the squared norm of the updated \a r */
+template<typename VectorType>
+inline typename NumTraits<typename VectorType::Scalar>::Real
+ei_fused_cg_update(VectorType& x, typename VectorType::Scalar alpha, const VectorType& p,
+                   VectorType& r, const VectorType& q)
+{
+  typedef ei_fused_cg_update_kernel<typename VectorType::Scalar, typename VectorType::Index> Kernel;
+  Kernel kernel(alpha, p.data(), q.data(), x.data(), r.data());
+  ei_fused_vector_loop<Kernel>::run(kernel, x.size());
+  return kernel.m_norm2;
+}
+
+/** \internal Performs \a x += \a alpha * \a y + \a omega * \a z and \a r -= \a omega * \a t in a single pass.
+  * \returns the squared norm of the updated \a r, and stores \a r0.dot(r) into \a r0DotR */
+template<typename VectorType>
+inline typename NumTraits<typename VectorType::Scalar>::Real
+ei_fused_bicgstab_update(VectorType& x, typename VectorType::Scalar alpha, const VectorType& y,
+                         typename VectorType::Scalar omega, const VectorType& z,
+                         VectorType& r, const VectorType& t, const VectorType& r0,
+                         typename VectorType::Scalar& r0DotR)
+{
+  typedef ei_fused_bicgstab_update_kernel<typename VectorType::Scalar, typename VectorType::Index> Kernel;
+  Kernel kernel(alpha, omega, y.data(), z.data(), t.data(), r0.data(), x.data(), r.data());
+  ei_fused_vector_loop<Kernel>::run(kernel, x.size());
+  r0DotR = kernel.m_dot;
+  return kernel.m_norm2;
+}
+
+/** \internal \returns \a a.dot(b) and stores \a a.squaredNorm() into \a norm2, in a single pass */
+template<typename VectorType>
+inline typename VectorType::Scalar
+ei_fused_dot_norm(const VectorType& a, const VectorType& b, typename NumTraits<typename VectorType::Scalar>::Real& norm2)
+{
+  typedef ei_fused_dot_norm_kernel<typename VectorType::Scalar, typename VectorType::Index> Kernel;
+  Kernel kernel(a.data(), b.data());
+  ei_fused_vector_loop<Kernel>::run(kernel, a.size());
+  norm2 = kernel.m_norm2;
+  return kernel.m_dot;
+}
+
+/** \internal Performs \a y -= \a alpha * \a x in a single pass.
+  * \returns the squared norm of the updated \a y */
+template<typename VectorType, typename OtherVectorType>
+inline typename NumTraits<typename VectorType::Scalar>::Real
+ei_fused_axpy_norm(VectorType& y, typename VectorType::Scalar alpha, const OtherVectorType& x)
+{
+  ei_assert(x.innerStride()==1 && y.innerStride()==1);
+  typedef ei_fused_axpy_norm_kernel<typename VectorType::Scalar, typename VectorType::Index> Kernel;
+  Kernel kernel(alpha, x.data(), y.data());
+  ei_fused_vector_loop<Kernel>::run(kernel, y.size());
+  return kernel.m_norm2;
+}
+
+/** \internal Performs \a y -= \a alpha * \a x in a single pass.
+  * \returns the dot product of \a u with the updated \a y */
+template<typename VectorType, typename OtherVectorType>
+inline typename VectorType::Scalar
+ei_fused_axpy_dot(VectorType& y, typename VectorType::Scalar alpha, const OtherVectorType& x, const OtherVectorType& u)
+{
+  ei_assert(x.innerStride()==1 && u.innerStride()==1 && y.innerStride()==1);
+  typedef ei_fused_axpy_dot_kernel<typename VectorType::Scalar, typename VectorType::Index> Kernel;
+  Kernel kernel(alpha, x.data(), u.data(), y.data());
+  ei_fused_vector_loop<Kernel>::run(kernel, y.size());
+  return kernel.m_dot;
+}
+
+#endif // EIGEN_FUSED_VECTOR_KERNELS_H
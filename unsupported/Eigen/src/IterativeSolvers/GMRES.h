@@ -0,0 +1,152 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Copyright (C) 2010 Gael Guennebaud <gael.guennebaud@inria.fr>
+//
+// Eigen is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// Alternatively, you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation; either version 2 of
+// the License, or (at your option) any later version.
+//
+// Eigen is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License or the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License and a copy of the GNU General Public License along with
+// Eigen. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef EIGEN_GMRES_H
+#define EIGEN_GMRES_H
+
+/** \ingroup IterativeSolvers_Module
+  * Right preconditioned restarted generalized minimal residual method (GMRES(m))
+  *
+  * Solves \f$ A x = b \f$ for a general square operator \a A, starting from the initial guess \a x.
+  * The Krylov basis is orthogonalized by the modified Gram-Schmidt process and the least squares problems
+  * are updated by Givens rotations, such that the norm of the residual is known at each iteration without
+  * computing it. The iterations stop when \f$ \Vert b - A x \Vert \le \epsilon \Vert b \Vert \f$ where
+  * \f$ \epsilon \f$ is the maximal residual of \a iter, or when its maximal number of iterations is reached.
+  *
+  * \param A the operator, see ei_linear_operator for the requirements on its type
+  * \param x on input the initial guess, on output the solution
+  * \param b the right hand side
+  * \param precond a preconditioner, see IdentityPreconditioner
+  * \param iter the iteration controller, see IterationController::converged() to check the convergence
+  * \param restart the dimension \a m of the Krylov subspace after which the method is restarted
+  *
+  * \returns \c Success if the iterations converged, \c NumericalIssue if the preconditioner failed, and
+  * \c NoConvergence otherwise.
+  *
+  * All the work vectors, including the \a n x (\a m + 1) Krylov basis, are allocated once before the first iteration,
+  * the products by \a A possibly allocating their own temporaries (see ei_linear_operator).
+  */
+template<typename MatrixType, typename VectorX, typename VectorB, typename Preconditioner>
+ComputationInfo ei_gmres(const MatrixType& A, VectorX& x, const VectorB& b,
+              const Preconditioner& precond, IterationController& iter, int restart = 30)
+{
+  typedef typename VectorX::Scalar Scalar;
+  typedef typename NumTraits<Scalar>::Real RealScalar;
+  typedef typename VectorX::Index Index;
+  typedef Matrix<Scalar,Dynamic,1> TmpVec;
+  typedef Matrix<Scalar,Dynamic,Dynamic> TmpMat;
+
+  const Index n = x.size();
+  const Index m = std::max<Index>(1, std::min<Index>(restart, n));
+  TmpMat V(n, m+1), H(m+1, m);
+  // without preconditioner, z would be a copy of the last vector of the basis
+  const bool precondIsIdentity = ei_is_same_type<Preconditioner,IdentityPreconditioner>::ret;
+  TmpVec w(n), z, g(m+1);
+  if (!precondIsIdentity)
+    z.resize(n);
+  std::vector<PlanarRotation<Scalar> > rotations(m);
+
+  iter.setRhsNorm(b.norm());
+  if (iter.rhsNorm() == 0.0)
+  {
+    x.setZero();
+    iter.converged(0.0);
+    return Success;
+  }
+
+  while (true)
+  {
+    ei_linear_operator<MatrixType>::run(A, x, w);
+    w = b - w;
+    RealScalar beta = w.norm();
+    if (iter.finished(beta))
+      break;
+
+    V.col(0) = w / beta;
+    g.setZero();
+    g.coeffRef(0) = beta;
+
+    // Arnoldi process
+    Index k = 0;
+    bool breakdown = false;
+    while (k<m && !breakdown)
+    {
+      if (precondIsIdentity)
+        ei_linear_operator<MatrixType>::run(A, V.col(k), w);
+      else
+      {
+        z = V.col(k);
+        if (!precond.solveInPlace(z))
+          return NumericalIssue;
+        ei_linear_operator<MatrixType>::run(A, z, w);
+      }
+
+      // modified Gram-Schmidt, each update of w being fused with the next reduction
+      typename TmpMat::ColXpr h(H.col(k));
+      h.coeffRef(0) = V.col(0).dot(w);
+      for (Index i=0; i<k; ++i)
+        h.coeffRef(i+1) = ei_fused_axpy_dot(w, h.coeff(i), V.col(i), V.col(i+1));
+      RealScalar hnext = ei_sqrt(ei_fused_axpy_norm(w, h.coeff(k), V.col(k)));
+      h.coeffRef(k+1) = hnext;
+      breakdown = hnext <= NumTraits<Scalar>::epsilon() * h.head(k+1).norm();
+      if (!breakdown)
+        V.col(k+1) = w / hnext;
+
+      // reduce the new column of the Hessenberg matrix to the upper triangular form
+      for (Index i=0; i<k; ++i)
+        h.applyOnTheLeft(i, i+1, rotations[i].adjoint());
+      rotations[k].makeGivens(h.coeff(k), h.coeff(k+1), &h.coeffRef(k));
+      h.coeffRef(k+1) = Scalar(0);
+      g.applyOnTheLeft(k, k+1, rotations[k].adjoint());
+
+      ++k;
+      ++iter;
+      if (iter.finished(ei_abs(g.coeff(k))))
+        break;
+    }
+
+    // x += M^-1 V y with y = H^-1 g
+    for (Index i=k-1; i>=0; --i)
+    {
+      g.coeffRef(i) -= H.row(i).segment(i+1, k-i-1).transpose().cwiseProduct(g.segment(i+1, k-i-1)).sum();
+      g.coeffRef(i) /= H.coeff(i,i);
+    }
+    w.noalias() = V.leftCols(k) * g.head(k);
+    if (!precond.solveInPlace(w))
+      return NumericalIssue;
+    x += w;
+  }
+  return iter.converged() ? Success : NoConvergence;
+}
+
+/** \ingroup IterativeSolvers_Module
+  * Unpreconditioned GMRES(m), see ei_gmres(const MatrixType&, VectorX&, const VectorB&, const Preconditioner&, IterationController&, int)
+  */
+template<typename MatrixType, typename VectorX, typename VectorB>
+ComputationInfo ei_gmres(const MatrixType& A, VectorX& x, const VectorB& b, IterationController& iter, int restart = 30)
+{
+  return ei_gmres(A, x, b, IdentityPreconditioner(), iter, restart);
+}
+
+#endif // EIGEN_GMRES_H
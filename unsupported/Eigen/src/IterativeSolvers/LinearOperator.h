@@ -0,0 +1,129 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Copyright (C) 2010 Gael Guennebaud <gael.guennebaud@inria.fr>
+//
+// Eigen is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// Alternatively, you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation; either version 2 of
+// the License, or (at your option) any later version.
+//
+// Eigen is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License or the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License and a copy of the GNU General Public License along with
+// Eigen. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef EIGEN_LINEAR_OPERATOR_H
+#define EIGEN_LINEAR_OPERATOR_H
+
+/** \ingroup IterativeSolvers_Module
+  * \internal
+  *
+  * Evaluates \a dst = \a op * \a src for the operator \a op of an iterative solver.
+  *
+  * The default implementation works for any type for which \c dst.noalias() \c = \c op*src is valid,
+  * e.g., dense matrices, sparse matrices and selfadjoint views. Matrix-free operators are supported
+  * by specializing this class for their own type:
+  * \code
+  * template<> struct ei_linear_operator<MyOperator>
+  * {
+  *   template<typename Src, typename Dest>
+  *   static void run(const MyOperator& op, const Src& src, Dest& dst) { ... }
+  * };
+  * \endcode
+  * The iterative solvers only pass preallocated vectors as \a dst. The product itself may still allocate
+  * temporaries, e.g., the per-thread buffers of a parallel sparse product are taken from the heap when they
+  * exceed EIGEN_STACK_ALLOCATION_LIMIT.
+  */
+template<typename Operator> struct ei_linear_operator
+{
+  template<typename Src, typename Dest>
+  static inline void run(const Operator& op, const Src& src, Dest& dst)
+  {
+    dst.noalias() = op * src;
+  }
+};
+
+/** \ingroup IterativeSolvers_Module
+  * \class IdentityPreconditioner
+  *
+  * \brief A preconditioner which does nothing
+  *
+  * The preconditioners of the iterative solvers only have to provide a \c solveInPlace(b) method
+  * overwriting \a b by \f$ M^{-1} b \f$, and returning false on failure. Therefore, any sparse or dense
+  * decomposition offering such a method, e.g., SparseLLT, can be used as a preconditioner too.
+  *
+  * \sa class DiagonalPreconditioner
+  */
+class IdentityPreconditioner
+{
+  public:
+    IdentityPreconditioner() {}
+
+    template<typename MatrixType>
+    IdentityPreconditioner(const MatrixType&) {}
+
+    template<typename Derived>
+    inline bool solveInPlace(MatrixBase<Derived>&) const { return true; }
+};
+
+/** \ingroup IterativeSolvers_Module
+  * \class DiagonalPreconditioner
+  *
+  * \brief A preconditioner based on the inverse of the diagonal coefficients (Jacobi preconditioner)
+  *
+  * The diagonal is extracted with \c coeff(i,i) such that it works for both dense and sparse matrices.
+  * A zero diagonal coefficient is treated as a one.
+  *
+  * \sa class IdentityPreconditioner
+  */
+template<typename _Scalar>
+class DiagonalPreconditioner
+{
+  public:
+    typedef _Scalar Scalar;
+    typedef Matrix<Scalar,Dynamic,1> VectorType;
+    typedef typename VectorType::Index Index;
+
+    DiagonalPreconditioner() {}
+
+    template<typename MatrixType>
+    DiagonalPreconditioner(const MatrixType& mat)
+    {
+      compute(mat);
+    }
+
+    template<typename MatrixType>
+    DiagonalPreconditioner& compute(const MatrixType& mat)
+    {
+      ei_assert(mat.rows()==mat.cols());
+      m_invDiag.resize(mat.cols());
+      for(Index j=0; j<mat.cols(); ++j)
+      {
+        Scalar d = mat.coeff(j,j);
+        m_invDiag.coeffRef(j) = d==Scalar(0) ? Scalar(1) : Scalar(1)/d;
+      }
+      return *this;
+    }
+
+    template<typename Derived>
+    inline bool solveInPlace(MatrixBase<Derived>& b) const
+    {
+      b.array() *= m_invDiag.array();
+      return true;
+    }
+
+  protected:
+    VectorType m_invDiag;
+};
+
+#endif // EIGEN_LINEAR_OPERATOR_H
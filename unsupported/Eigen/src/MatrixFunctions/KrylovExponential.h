@@ -0,0 +1,295 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Copyright (C) 2010 Gael Guennebaud <gael.guennebaud@inria.fr>
+//
+// Eigen is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// Alternatively, you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation; either version 2 of
+// the License, or (at your option) any later version.
+//
+// Eigen is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License or the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License and a copy of the GNU General Public License along with
+// Eigen. If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef EIGEN_KRYLOV_EXPONENTIAL
+#define EIGEN_KRYLOV_EXPONENTIAL
+
+/** \internal Infinity norm of a sparse matrix, computed from its nonzeros. */
+template <typename MatrixType, typename StorageKind = typename ei_traits<MatrixType>::StorageKind>
+struct ei_krylov_exponential_norm
+{
+  typedef typename NumTraits<typename MatrixType::Scalar>::Real RealScalar;
+  static RealScalar run(const MatrixType& A)
+  {
+    Matrix<RealScalar,Dynamic,1> rowSums = Matrix<RealScalar,Dynamic,1>::Zero(A.rows());
+    for (typename MatrixType::Index j=0; j<A.outerSize(); ++j)
+      for (typename MatrixType::InnerIterator it(A,j); it; ++it)
+        rowSums(it.row()) += ei_abs(it.value());
+    return rowSums.maxCoeff();
+  }
+};
+
+template <typename MatrixType>
+struct ei_krylov_exponential_norm<MatrixType, Dense>
+{
+  typedef typename NumTraits<typename MatrixType::Scalar>::Real RealScalar;
+  static RealScalar run(const MatrixType& A)
+  {
+    return A.cwiseAbs().rowwise().sum().maxCoeff();
+  }
+};
+
+/** \ingroup MatrixFunctions_Module
+  * \brief Class for computing the action of the matrix exponential on a vector.
+  * \tparam MatrixType type of the matrix \f$ A \f$, either a dense or
+  * a sparse matrix.
+  *
+  * This class computes \f$ w = \exp(tA) v \f$ without forming
+  * \f$ \exp(tA) \f$, which is the only option when \f$ A \f$ is large
+  * and sparse. Only products of \f$ A \f$ with vectors are needed.
+  *
+  * The method is the Krylov subspace method of Expokit. The
+  * interval \f$ [0,t] \f$ is divided into steps. In each step, \f$ m \f$
+  * iterations of the Arnoldi process build an orthonormal basis of the
+  * Krylov subspace spanned by \f$ w, Aw, \ldots, A^{m-1}w \f$, and the
+  * exponential of the small \f$ (m+2) \times (m+2) \f$ Hessenberg
+  * matrix of the process is computed by MatrixExponential. The step
+  * sizes are adapted such that the local error estimates stay below
+  * tolerance(). The basis is stored in a \f$ n \times (m+1) \f$ matrix
+  * which is reused by the next calls to compute().
+  *
+  * Details of the algorithm can be found in: Roger B. Sidje, "Expokit:
+  * A software package for computing matrix exponentials," <em>ACM
+  * Trans. Math. Softw.</em>, <b>24</b>:130&ndash;156, 1998.
+  */
+template <typename MatrixType>
+class KrylovExponential {
+
+  public:
+
+    typedef typename MatrixType::Scalar Scalar;
+    typedef typename NumTraits<Scalar>::Real RealScalar;
+    typedef typename MatrixType::Index Index;
+    typedef Matrix<Scalar,Dynamic,1> VectorType;
+    typedef Matrix<Scalar,Dynamic,Dynamic> DenseMatrixType;
+
+    /** \brief Constructor.
+      *
+      * \param[in] krylovDim  dimension \f$ m \f$ of the Krylov subspaces, at least 2.
+      */
+    KrylovExponential(Index krylovDim = 30)
+      : m_krylovDim(krylovDim), m_tolerance(NumTraits<Scalar>::dummy_precision()), m_steps(0), m_error(0),
+        m_isInitialized(false)
+    {
+      ei_assert(krylovDim>=2);
+    }
+
+    /** \brief Sets the dimension of the Krylov subspaces, which must be at least 2. */
+    void setKrylovDim(Index krylovDim)
+    {
+      ei_assert(krylovDim>=2);
+      m_krylovDim = krylovDim;
+    }
+
+    /** \returns the dimension of the Krylov subspaces. */
+    Index krylovDim() const { return m_krylovDim; }
+
+    /** \brief Sets the requested accuracy of the result, relative to the norm of \p v. */
+    void setTolerance(RealScalar tolerance) { m_tolerance = tolerance; }
+
+    /** \returns the requested accuracy. */
+    RealScalar tolerance() const { return m_tolerance; }
+
+    /** \brief Computes \f$ w = \exp(tA) v \f$.
+      *
+      * \param[in]  A  square matrix.
+      * \param[in]  v  vector.
+      * \param[out] w  the vector \f$ \exp(tA) v \f$.
+      * \param[in]  t  time, which may be negative.
+      *
+      * \sa info()
+      */
+    template <typename Rhs, typename Dest>
+    void compute(const MatrixType& A, const Rhs& v, Dest& w, RealScalar t = RealScalar(1));
+
+    /** \returns the number of steps taken by the last call to compute(). */
+    Index steps() const { return m_steps; }
+
+    /** \returns the sum of the local error estimates of the last call to compute(). */
+    RealScalar error() const { return m_error; }
+
+    /** \brief Reports whether previous computation was successful.
+      *
+      * \returns \c Success if the local error estimates of all the steps met the tolerance,
+      * \c NoConvergence if a step was accepted with a larger error after too many step size
+      * reductions.
+      */
+    ComputationInfo info() const
+    {
+      ei_assert(m_isInitialized && "KrylovExponential is not initialized.");
+      return m_info;
+    }
+
+  private:
+
+    /** \brief Rounds the step size \p t to two significant digits, like Expokit. */
+    static RealScalar roundStep(RealScalar t)
+    {
+      RealScalar s = std::pow(RealScalar(10), std::floor(std::log10(t)) - 1);
+      return std::ceil(t / s) * s;
+    }
+
+    Index m_krylovDim;
+    RealScalar m_tolerance;
+    Index m_steps;
+    RealScalar m_error;
+    ComputationInfo m_info;
+    bool m_isInitialized;
+
+    /** \brief Orthonormal basis of the Krylov subspace. */
+    DenseMatrixType m_V;
+
+    /** \brief Hessenberg matrix of the Arnoldi process, augmented as in Expokit. */
+    DenseMatrixType m_H;
+
+    /** \brief Scaled leading block of \c m_H and its exponential. */
+    DenseMatrixType m_tH, m_expH;
+
+    /** \brief Used for temporary storage. */
+    VectorType m_p;
+
+    MatrixExponential<DenseMatrixType> m_exp;
+};
+
+template <typename MatrixType>
+template <typename Rhs, typename Dest>
+void KrylovExponential<MatrixType>::compute(const MatrixType& A, const Rhs& v, Dest& w, RealScalar t)
+{
+  ei_assert(A.rows()==A.cols() && A.cols()==v.size());
+  const Index n = A.rows();
+  const Index m = std::min(m_krylovDim, n);
+  const RealScalar btol = std::max(RealScalar(1e-7), 10*NumTraits<RealScalar>::epsilon()); // breakdown tolerance
+  const RealScalar gamma = RealScalar(0.9), delta = RealScalar(1.2);
+  const int maxRejections = 10;
+
+  m_steps = 0;
+  m_error = 0;
+  m_info = Success;
+  m_isInitialized = true;
+  w = v;
+  RealScalar beta = w.norm();
+  const RealScalar anorm = ei_krylov_exponential_norm<MatrixType>::run(A);
+  if (beta==RealScalar(0) || anorm==RealScalar(0) || t==RealScalar(0))
+    return;
+  const RealScalar tol = m_tolerance * beta;
+
+  const RealScalar tOut = ei_abs(t);
+  const RealScalar sgn = t<0 ? RealScalar(-1) : RealScalar(1);
+  RealScalar xm = RealScalar(1)/RealScalar(m);
+
+  // initial step size, computed in double precision since fact overflows in float
+  const double fact = std::pow((m+1)/std::exp(1.0), double(m+1)) * std::sqrt(2*3.14159265358979323846*(m+1));
+  RealScalar tNew = roundStep(RealScalar((1/double(anorm)) * std::pow((fact*tol)/(4*double(beta)*double(anorm)), double(xm))));
+  RealScalar tNow = 0;
+
+  m_V.resize(n, m+1);
+  m_H.resize(m+2, m+2);
+  m_p.resize(n);
+
+  while (tNow < tOut)
+  {
+    ++m_steps;
+    RealScalar tStep = std::min(tOut-tNow, tNew);
+
+    // Arnoldi process
+    m_V.col(0) = w / beta;
+    m_H.setZero();
+    Index mb = m;
+    int k1 = 2;
+    for (Index j=0; j<m; ++j)
+    {
+      m_p.noalias() = A * m_V.col(j);
+      for (Index i=0; i<=j; ++i)
+      {
+        m_H(i,j) = m_V.col(i).dot(m_p);
+        m_p -= m_H(i,j) * m_V.col(i);
+      }
+      RealScalar s = m_p.norm();
+      if (s < btol*anorm)
+      {
+        // happy breakdown: the Krylov subspace is invariant, the remaining interval is done at once
+        k1 = 0;
+        mb = j+1;
+        tStep = tOut-tNow;
+        break;
+      }
+      m_H(j+1,j) = s;
+      m_V.col(j+1) = m_p / s;
+    }
+    RealScalar avnorm = 0;
+    if (k1!=0)
+    {
+      m_H(m+1,m) = 1;
+      m_p.noalias() = A * m_V.col(m);
+      avnorm = m_p.norm();
+    }
+
+    // exponential of the Hessenberg matrix, shrinking the step until the error estimate is small enough
+    RealScalar errLoc = btol;
+    for (int rejections=0; ; ++rejections)
+    {
+      const Index mx = mb + k1;
+      m_tH = (sgn*tStep) * m_H.topLeftCorner(mx,mx);
+      m_exp.compute(m_tH, m_expH);
+      if (k1==0)
+        break;
+
+      RealScalar phi1 = ei_abs(beta*m_expH(m,0));
+      RealScalar phi2 = ei_abs(beta*m_expH(m+1,0)*avnorm);
+      if (phi1 > 10*phi2) {
+        errLoc = phi2;
+        xm = RealScalar(1)/RealScalar(m);
+      } else if (phi1 > phi2) {
+        errLoc = (phi1*phi2)/(phi1-phi2);
+        xm = RealScalar(1)/RealScalar(m);
+      } else {
+        errLoc = phi1;
+        xm = RealScalar(1)/RealScalar(m-1);
+      }
+      if (errLoc <= delta*tStep*tol)
+        break;
+      if (rejections==maxRejections)
+      {
+        // the step is kept, but the result does not meet the tolerance
+        m_info = NoConvergence;
+        break;
+      }
+      tStep = roundStep(gamma * tStep * std::pow(tStep*tol/errLoc, xm));
+    }
+
+    const Index mx = mb + std::max(0, k1-1);
+    w.noalias() = m_V.leftCols(mx) * (beta * m_expH.col(0).head(mx));
+    beta = w.norm();
+    tNow += tStep;
+
+    // Expokit bounds the error by the round-off level here, but then the steps shrink forever when
+    // tol is close to the machine precision: only avoid the division by zero
+    errLoc = std::max(errLoc, std::numeric_limits<RealScalar>::min());
+    tNew = roundStep(gamma * tStep * std::pow(tStep*tol/errLoc, xm));
+    m_error += errLoc;
+  }
+}
+
+#endif // EIGEN_KRYLOV_EXPONENTIAL
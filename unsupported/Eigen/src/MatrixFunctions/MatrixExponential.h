@@ -34,6 +34,12 @@
   * \brief Class for computing the matrix exponential.
   * \tparam MatrixType type of the argument of the exponential,
   * expected to be an instantiation of the Matrix class template.
+  *
+  * The temporaries of the Pad&eacute; approximant, of the LU
+  * decomposition and of the squarings are members of this class. When
+  * the exponentials of many matrices of the same size are needed, they
+  * can be computed by the same object using compute(const MatrixType&, ResultType&),
+  * such that no memory is allocated after the first call.
   */
 template <typename MatrixType>
 class MatrixExponential {
@@ -49,6 +55,12 @@ class MatrixExponential {
       */
     MatrixExponential(const MatrixType &M);
 
+    /** \brief Default constructor.
+      *
+      * The matrix is passed to compute(const MatrixType&, ResultType&).
+      */
+    MatrixExponential();
+
     /** \brief Computes the matrix exponential.
       *
       * \param[out] result  the matrix exponential of \p M in the constructor.
@@ -56,12 +68,24 @@ class MatrixExponential {
     template <typename ResultType> 
     void compute(ResultType &result);
 
+    /** \brief Computes the matrix exponential of \p M, reusing the
+      * workspace of the previous calls.
+      *
+      * \param[in]  M       matrix whose exponential is to be computed.
+      * \param[out] result  the matrix exponential of \p M.
+      */
+    template <typename ResultType>
+    void compute(const MatrixType &M, ResultType &result);
+
   private:
 
     // Prevent copying
     MatrixExponential(const MatrixExponential&);
     MatrixExponential& operator=(const MatrixExponential&);
 
+    /** \brief Binds \p M and resizes the workspace to its size. */
+    void init(const MatrixType &M);
+
     /** \brief Compute the (3,3)-Pad&eacute; approximant to the exponential.
      *
      *  After exit, \f$ (V+U)(V-U)^{-1} \f$ is the Pad&eacute;
@@ -131,8 +155,8 @@ class MatrixExponential {
     typedef typename ei_traits<MatrixType>::Scalar Scalar;
     typedef typename NumTraits<Scalar>::Real RealScalar;
 
-    /** \brief Reference to matrix whose exponential is to be computed. */
-    typename ei_nested<MatrixType>::type m_M;
+    /** \brief Pointer to matrix whose exponential is to be computed. */
+    const MatrixType* m_M;
 
     /** \brief Even-degree terms in numerator of Pad&eacute; approximant. */
     MatrixType m_U;
@@ -146,8 +170,14 @@ class MatrixExponential {
     /** \brief Used for temporary storage. */
     MatrixType m_tmp2;
 
-    /** \brief Identity matrix of the same size as \c m_M. */
-    MatrixType m_Id;
+    /** \brief Even powers of the argument of the Pad&eacute; approximant. */
+    MatrixType m_A2, m_A4, m_A6;
+
+    /** \brief Scaled matrix, when squarings are required. */
+    MatrixType m_scaled;
+
+    /** \brief LU decomposition of the denominator of the Pad&eacute; approximant. */
+    PartialPivLU<MatrixType> m_lu;
 
     /** \brief Number of squarings required in the last step. */
     int m_squarings;
@@ -158,18 +188,34 @@ class MatrixExponential {
 
 template <typename MatrixType>
 MatrixExponential<MatrixType>::MatrixExponential(const MatrixType &M) :
-  m_M(M),
-  m_U(M.rows(),M.cols()),
-  m_V(M.rows(),M.cols()),
-  m_tmp1(M.rows(),M.cols()),
-  m_tmp2(M.rows(),M.cols()),
-  m_Id(MatrixType::Identity(M.rows(), M.cols())),
+  m_M(0),
+  m_squarings(0),
+  m_l1norm(0)
+{
+  init(M);
+}
+
+template <typename MatrixType>
+MatrixExponential<MatrixType>::MatrixExponential() :
+  m_M(0),
   m_squarings(0),
-  m_l1norm(static_cast<float>(M.cwiseAbs().colwise().sum().maxCoeff()))
+  m_l1norm(0)
 {
   /* empty body */
 }
 
+template <typename MatrixType>
+void MatrixExponential<MatrixType>::init(const MatrixType &M)
+{
+  m_M = &M;
+  m_U.resize(M.rows(),M.cols());
+  m_V.resize(M.rows(),M.cols());
+  m_tmp1.resize(M.rows(),M.cols());
+  m_tmp2.resize(M.rows(),M.cols());
+  m_squarings = 0;
+  m_l1norm = static_cast<float>(M.cwiseAbs().colwise().sum().maxCoeff());
+}
+
 template <typename MatrixType>
 template <typename ResultType> 
 void MatrixExponential<MatrixType>::compute(ResultType &result)
@@ -177,9 +223,25 @@ void MatrixExponential<MatrixType>::compute(ResultType &result)
   computeUV(RealScalar());
   m_tmp1 = m_U + m_V;	// numerator of Pade approximant
   m_tmp2 = -m_U + m_V;	// denominator of Pade approximant
-  result = m_tmp2.partialPivLu().solve(m_tmp1);
-  for (int i=0; i<m_squarings; i++)
-    result *= result;		// undo scaling by repeated squaring
+  m_lu.compute(m_tmp2);
+  if (m_squarings==0) {
+    result = m_lu.solve(m_tmp1);
+    return;
+  }
+  m_U = m_lu.solve(m_tmp1);
+  for (int i=0; i<m_squarings; i++) {	// undo scaling by repeated squaring
+    m_V.noalias() = m_U * m_U;
+    m_U.swap(m_V);
+  }
+  result = m_U;
+}
+
+template <typename MatrixType>
+template <typename ResultType>
+void MatrixExponential<MatrixType>::compute(const MatrixType &M, ResultType &result)
+{
+  init(M);
+  compute(result);
 }
 
 template <typename MatrixType>
@@ -187,32 +249,38 @@ EIGEN_STRONG_INLINE void MatrixExponential<MatrixType>::pade3(const MatrixType &
 {
   const Scalar b[] = {120., 60., 12., 1.};
   m_tmp1.noalias() = A * A;
-  m_tmp2 = b[3]*m_tmp1 + b[1]*m_Id;
+  m_tmp2 = b[3]*m_tmp1;
+  m_tmp2.diagonal().array() += b[1];
   m_U.noalias() = A * m_tmp2;
-  m_V = b[2]*m_tmp1 + b[0]*m_Id;
+  m_V = b[2]*m_tmp1;
+  m_V.diagonal().array() += b[0];
 }
 
 template <typename MatrixType>
 EIGEN_STRONG_INLINE void MatrixExponential<MatrixType>::pade5(const MatrixType &A)
 {
   const Scalar b[] = {30240., 15120., 3360., 420., 30., 1.};
-  MatrixType A2 = A * A;
-  m_tmp1.noalias() = A2 * A2;
-  m_tmp2 = b[5]*m_tmp1 + b[3]*A2 + b[1]*m_Id;
+  m_A2.noalias() = A * A;
+  m_tmp1.noalias() = m_A2 * m_A2;
+  m_tmp2 = b[5]*m_tmp1 + b[3]*m_A2;
+  m_tmp2.diagonal().array() += b[1];
   m_U.noalias() = A * m_tmp2;
-  m_V = b[4]*m_tmp1 + b[2]*A2 + b[0]*m_Id;
+  m_V = b[4]*m_tmp1 + b[2]*m_A2;
+  m_V.diagonal().array() += b[0];
 }
 
 template <typename MatrixType>
 EIGEN_STRONG_INLINE void MatrixExponential<MatrixType>::pade7(const MatrixType &A)
 {
   const Scalar b[] = {17297280., 8648640., 1995840., 277200., 25200., 1512., 56., 1.};
-  MatrixType A2 = A * A;
-  MatrixType A4 = A2 * A2;
-  m_tmp1.noalias() = A4 * A2;
-  m_tmp2 = b[7]*m_tmp1 + b[5]*A4 + b[3]*A2 + b[1]*m_Id;
+  m_A2.noalias() = A * A;
+  m_A4.noalias() = m_A2 * m_A2;
+  m_tmp1.noalias() = m_A4 * m_A2;
+  m_tmp2 = b[7]*m_tmp1 + b[5]*m_A4 + b[3]*m_A2;
+  m_tmp2.diagonal().array() += b[1];
   m_U.noalias() = A * m_tmp2;
-  m_V = b[6]*m_tmp1 + b[4]*A4 + b[2]*A2 + b[0]*m_Id;
+  m_V = b[6]*m_tmp1 + b[4]*m_A4 + b[2]*m_A2;
+  m_V.diagonal().array() += b[0];
 }
 
 template <typename MatrixType>
@@ -220,13 +288,15 @@ EIGEN_STRONG_INLINE void MatrixExponential<MatrixType>::pade9(const MatrixType &
 {
   const Scalar b[] = {17643225600., 8821612800., 2075673600., 302702400., 30270240.,
   		      2162160., 110880., 3960., 90., 1.};
-  MatrixType A2 = A * A;
-  MatrixType A4 = A2 * A2;
-  MatrixType A6 = A4 * A2;
-  m_tmp1.noalias() = A6 * A2;
-  m_tmp2 = b[9]*m_tmp1 + b[7]*A6 + b[5]*A4 + b[3]*A2 + b[1]*m_Id;
+  m_A2.noalias() = A * A;
+  m_A4.noalias() = m_A2 * m_A2;
+  m_A6.noalias() = m_A4 * m_A2;
+  m_tmp1.noalias() = m_A6 * m_A2;
+  m_tmp2 = b[9]*m_tmp1 + b[7]*m_A6 + b[5]*m_A4 + b[3]*m_A2;
+  m_tmp2.diagonal().array() += b[1];
   m_U.noalias() = A * m_tmp2;
-  m_V = b[8]*m_tmp1 + b[6]*A6 + b[4]*A4 + b[2]*A2 + b[0]*m_Id;
+  m_V = b[8]*m_tmp1 + b[6]*m_A6 + b[4]*m_A4 + b[2]*m_A2;
+  m_V.diagonal().array() += b[0];
 }
 
 template <typename MatrixType>
@@ -235,30 +305,32 @@ EIGEN_STRONG_INLINE void MatrixExponential<MatrixType>::pade13(const MatrixType
   const Scalar b[] = {64764752532480000., 32382376266240000., 7771770303897600.,
   		      1187353796428800., 129060195264000., 10559470521600., 670442572800.,
   		      33522128640., 1323241920., 40840800., 960960., 16380., 182., 1.};
-  MatrixType A2 = A * A;
-  MatrixType A4 = A2 * A2;
-  m_tmp1.noalias() = A4 * A2;
-  m_V = b[13]*m_tmp1 + b[11]*A4 + b[9]*A2; // used for temporary storage
+  m_A2.noalias() = A * A;
+  m_A4.noalias() = m_A2 * m_A2;
+  m_tmp1.noalias() = m_A4 * m_A2;
+  m_V = b[13]*m_tmp1 + b[11]*m_A4 + b[9]*m_A2; // used for temporary storage
   m_tmp2.noalias() = m_tmp1 * m_V;
-  m_tmp2 += b[7]*m_tmp1 + b[5]*A4 + b[3]*A2 + b[1]*m_Id;
+  m_tmp2 += b[7]*m_tmp1 + b[5]*m_A4 + b[3]*m_A2;
+  m_tmp2.diagonal().array() += b[1];
   m_U.noalias() = A * m_tmp2;
-  m_tmp2 = b[12]*m_tmp1 + b[10]*A4 + b[8]*A2;
+  m_tmp2 = b[12]*m_tmp1 + b[10]*m_A4 + b[8]*m_A2;
   m_V.noalias() = m_tmp1 * m_tmp2;
-  m_V += b[6]*m_tmp1 + b[4]*A4 + b[2]*A2 + b[0]*m_Id;
+  m_V += b[6]*m_tmp1 + b[4]*m_A4 + b[2]*m_A2;
+  m_V.diagonal().array() += b[0];
 }
 
 template <typename MatrixType>
 void MatrixExponential<MatrixType>::computeUV(float)
 {
   if (m_l1norm < 4.258730016922831e-001) {
-    pade3(m_M);
+    pade3(*m_M);
   } else if (m_l1norm < 1.880152677804762e+000) {
-    pade5(m_M);
+    pade5(*m_M);
   } else {
     const float maxnorm = 3.925724783138660f;
     m_squarings = std::max(0, (int)ceil(log2(m_l1norm / maxnorm)));
-    MatrixType A = m_M / std::pow(Scalar(2), Scalar(static_cast<RealScalar>(m_squarings)));
-    pade7(A);
+    m_scaled = *m_M / std::pow(Scalar(2), Scalar(static_cast<RealScalar>(m_squarings)));
+    pade7(m_scaled);
   }
 }
 
@@ -266,21 +338,75 @@ template <typename MatrixType>
 void MatrixExponential<MatrixType>::computeUV(double)
 {
   if (m_l1norm < 1.495585217958292e-002) {
-    pade3(m_M);
+    pade3(*m_M);
   } else if (m_l1norm < 2.539398330063230e-001) {
-    pade5(m_M);
+    pade5(*m_M);
   } else if (m_l1norm < 9.504178996162932e-001) {
-    pade7(m_M);
+    pade7(*m_M);
   } else if (m_l1norm < 2.097847961257068e+000) {
-    pade9(m_M);
+    pade9(*m_M);
   } else {
     const double maxnorm = 5.371920351148152;
     m_squarings = std::max(0, (int)ceil(log2(m_l1norm / maxnorm)));
-    MatrixType A = m_M / std::pow(Scalar(2), Scalar(m_squarings));
-    pade13(A);
+    m_scaled = *m_M / std::pow(Scalar(2), Scalar(m_squarings));
+    pade13(m_scaled);
   }
 }
 
+/** \internal Computes a batch of matrix exponentials on several threads.
+  * The matrices are distributed dynamically, and each thread reuses the same workspace. */
+template <typename MatrixType>
+class ei_matrix_exponential_batch_task
+{
+  public:
+    ei_matrix_exponential_batch_task(const MatrixType* matrices, MatrixType* results, int count)
+      : m_matrices(matrices), m_results(results), m_count(count), m_next(0)
+    {}
+
+    void operator()(int) const
+    {
+      MatrixExponential<MatrixType> me;
+      for (int k = ei_atomic_fetch_and_add(&m_next, 1); k < m_count; k = ei_atomic_fetch_and_add(&m_next, 1))
+        me.compute(m_matrices[k], m_results[k]);
+    }
+
+  protected:
+    const MatrixType* m_matrices;
+    MatrixType* m_results;
+    int m_count;
+    mutable volatile int m_next;
+};
+
+/** \ingroup MatrixFunctions_Module
+  *
+  * \brief Computes the exponentials of a batch of matrices.
+  *
+  * \param[in]  matrices  array of \p count matrices whose exponentials are to be computed.
+  * \param[out] results   array of \p count matrices receiving the exponentials.
+  * \param[in]  count     number of matrices.
+  *
+  * This is equivalent to calling exp() on each matrix, but the
+  * workspace is allocated once per thread instead of once per matrix,
+  * which matters for small matrices. The matrices are split among the
+  * threads of the ThreadPool if any, or of OpenMP, as long as each
+  * thread gets at least EIGEN_TUNE_PARALLEL_THREAD_COST floating point
+  * operations. The matrices may have different sizes.
+  */
+template <typename MatrixType>
+void matrixExponentialBatch(const MatrixType* matrices, MatrixType* results, int count)
+{
+  if (count<=0)
+    return;
+
+  // about 20 n^3 flops per exponential, see MatrixBase::exp()
+  double work = 0;
+  for (int k=0; k<count; k++)
+    work += 20. * double(matrices[k].rows()) * double(matrices[k].rows()) * double(matrices[k].rows());
+  const int threads = std::min(ei_parallel_threads(work), count);
+
+  ei_parallel_for(0, threads, ei_matrix_exponential_batch_task<MatrixType>(matrices, results, count));
+}
+
 /** \ingroup MatrixFunctions_Module
   *
   * \brief Proxy for the matrix exponential of some matrix (expression).
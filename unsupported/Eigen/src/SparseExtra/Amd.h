@@ -0,0 +1,610 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Copyright (C) 2010 Gael Guennebaud <gael.guennebaud@inria.fr>
+//
+// Eigen is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// Alternatively, you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation; either version 2 of
+// the License, or (at your option) any later version.
+//
+// Eigen is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License or the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License and a copy of the GNU General Public License along with
+// Eigen. If not, see <http://www.gnu.org/licenses/>.
+
+/*
+
+NOTE: this routine has been adapted from the CSparse library:
+
+Copyright (c) 2006, Timothy A. Davis.
+http://www.cise.ufl.edu/research/sparse/CSparse
+
+CSparse is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+CSparse is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this Module; if not, write to the Free Software
+Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+*/
+
+#ifndef EIGEN_SPARSE_AMD_H
+#define EIGEN_SPARSE_AMD_H
+
+template<typename T> inline T ei_amd_flip(const T& i) { return -i-2; }
+
+/* clear w */
+template<typename Index>
+Index ei_cs_wclear(Index mark, Index lemax, Index* w, Index n)
+{
+  Index k;
+  if(mark < 2 || (mark + lemax < 0))
+  {
+    for(k = 0; k < n; k++)
+      if(w[k] != 0)
+        w[k] = 1;
+    mark = 2;
+  }
+  return (mark);     /* at this point, w[0..n-1] < mark holds */
+}
+
+/* depth-first search and postorder of a tree rooted at node j */
+template<typename Index>
+Index ei_cs_tdfs(Index j, Index k, Index* head, const Index* next, Index* post, Index* stack)
+{
+  Index i, p, top = 0;
+  if(!head || !next || !post || !stack) return (-1);    /* check inputs */
+  stack[0] = j;                 /* place j on the stack */
+  while (top >= 0)              /* while (stack is not empty) */
+  {
+    p = stack[top];             /* p = top of stack */
+    i = head[p];                /* i = youngest child of p */
+    if(i == -1)
+    {
+      top--;                    /* p has no unordered children left */
+      post[k++] = p;            /* node p is the kth postordered node */
+    }
+    else
+    {
+      head[p] = next[i];        /* remove i from children of p */
+      stack[++top] = i;         /* start dfs on child i */
+    }
+  }
+  return k;
+}
+
+/** \internal
+  * Computes the approximate minimum degree ordering of the symmetric pattern of \a mat,
+  * i.e., the pattern of \f$ A + A^T \f$, the diagonal being ignored. Only the pattern of
+  * the matrix is used, so that \a mat may store either the full matrix or only one of
+  * its triangular parts.
+  *
+  * On output the \a i-th row and column of \a mat are moved to the \c perm.indices()(i)-th
+  * position, i.e., \f$ P A P^T \f$ is the reordered matrix. This ordering reduces the
+  * fill-in of Cholesky factorizations.
+  */
+template<typename MatrixType>
+void ei_minimum_degree_ordering(const MatrixType& mat, PermutationMatrix<Dynamic>& perm)
+{
+  typedef typename MatrixType::Index Index;
+  typedef Matrix<Index,Dynamic,1> IndexVector;
+  ei_assert(mat.rows()==mat.cols());
+  const Index n = mat.cols();
+
+  /* --- Construct the pattern of C = A + A' without the diagonal --------- */
+  IndexVector Cp(n+1);
+  IndexVector count = IndexVector::Zero(n);
+  for(Index j = 0; j < n; ++j)
+    for(typename MatrixType::InnerIterator it(mat,j); it; ++it)
+      if(it.index()!=j)
+      {
+        ++count[j];
+        ++count[it.index()];
+      }
+  Cp[0] = 0;
+  for(Index j = 0; j < n; ++j)
+    Cp[j+1] = Cp[j] + count[j];
+  Index cnz = Cp[n];
+  Index nzmax = cnz + cnz/5 + 2*n;    /* add elbow room to C */
+  IndexVector Cbuffer(std::max<Index>(nzmax,1));
+  Index* Ci = Cbuffer.data();
+  for(Index j = 0; j < n; ++j)
+    count[j] = Cp[j];
+  for(Index j = 0; j < n; ++j)
+    for(typename MatrixType::InnerIterator it(mat,j); it; ++it)
+    {
+      Index i = it.index();
+      if(i!=j)
+      {
+        Ci[count[j]++] = i;
+        Ci[count[i]++] = j;
+      }
+    }
+  // remove the duplicates which occur when both triangular parts are stored
+  {
+    IndexVector tags = IndexVector::Constant(n,-1);
+    Index q = 0;
+    for(Index j = 0; j < n; ++j)
+    {
+      Index start = q;
+      for(Index p = Cp[j]; p < count[j]; ++p)
+      {
+        Index i = Ci[p];
+        if(tags[i]!=j)
+        {
+          tags[i] = j;
+          Ci[q++] = i;
+        }
+      }
+      Cp[j] = start;
+    }
+    Cp[n] = cnz = q;
+  }
+
+  Index *last, *W, *len, *nv, *next, *P, *head, *elen, *degree, *w, *hhead;
+  Index d, dk, dext, lemax = 0, e, elenk, eln, i, j, k, k1,
+        k2, k3, jlast, ln, dense, mindeg = 0, nvi, nvj, nvk, mark, wnvi,
+        ok, nel = 0, p, p1, p2, p3, p4, pj, pk, pk1, pk2, pn, q;
+  Index h;
+
+  dense = std::max<Index> (16, Index(10 * std::sqrt(double(n))));   /* find dense threshold */
+  dense = std::min<Index> (n-2, dense);
+
+  IndexVector Pbuffer(n+1);
+  IndexVector Wbuffer(8*(n+1));
+  P = Pbuffer.data();
+  W = Wbuffer.data();
+  len  = W;           nv     = W +   (n+1); next   = W + 2*(n+1);
+  head = W + 3*(n+1); elen   = W + 4*(n+1); degree = W + 5*(n+1);
+  w    = W + 6*(n+1); hhead  = W + 7*(n+1);
+  last = P;                                 /* use P as workspace for last */
+
+  /* --- Initialize quotient graph ---------------------------------------- */
+  for(k = 0; k < n; k++)
+    len[k] = Cp[k+1] - Cp[k];
+  len[n] = 0;
+
+  for(i = 0; i <= n; i++)
+  {
+    head[i]   = -1;                     // degree list i is empty
+    last[i]   = -1;
+    next[i]   = -1;
+    hhead[i]  = -1;                     // hash list i is empty
+    nv[i]     = 1;                      // node i is just one node
+    w[i]      = 1;                      // node i is alive
+    elen[i]   = 0;                      // Ek of node i is empty
+    degree[i] = len[i];                 // degree of node i
+  }
+  mark = ei_cs_wclear<Index>(0, 0, w, n);         /* clear w */
+  elen[n] = -2;                         /* n is a dead element */
+  Cp[n] = -1;                           /* n is a root of assembly tree */
+  w[n] = 0;                             /* n is a dead element */
+
+  /* --- Initialize degree lists ------------------------------------------ */
+  for(i = 0; i < n; i++)
+  {
+    d = degree[i];
+    if(d == 0)                         /* node i is empty */
+    {
+      elen[i] = -2;                 /* element i is dead */
+      nel++;
+      Cp[i] = -1;                   /* i is a root of assembly tree */
+      w[i] = 0;
+    }
+    else if(d > dense)                 /* node i is dense */
+    {
+      nv[i] = 0;                    /* absorb i into element n */
+      elen[i] = -1;                 /* node i is dead */
+      nel++;
+      Cp[i] = ei_amd_flip (n);
+      nv[n]++;
+    }
+    else
+    {
+      if(head[d] != -1) last[head[d]] = i;
+      next[i] = head[d];           /* put node i in degree list d */
+      head[d] = i;
+    }
+  }
+
+  while (nel < n)                         /* while (selecting pivots) do */
+  {
+    /* --- Select node of minimum approximate degree -------------------- */
+    for(k = -1; mindeg < n && (k = head[mindeg]) == -1; mindeg++) {}
+    if(next[k] != -1) last[next[k]] = -1;
+    head[mindeg] = next[k];          /* remove k from degree list */
+    elenk = elen[k];                  /* elenk = |Ek| */
+    nvk = nv[k];                      /* # of nodes k represents */
+    nel += nvk;                        /* nv[k] nodes of A eliminated */
+
+    /* --- Garbage collection ------------------------------------------- */
+    if(elenk > 0 && cnz + mindeg >= nzmax)
+    {
+      for(j = 0; j < n; j++)
+      {
+        if((p = Cp[j]) >= 0)      /* j is a live node or element */
+        {
+          Cp[j] = Ci[p];       /* save first entry of object */
+          Ci[p] = ei_amd_flip (j);  /* first entry is now ei_amd_flip(j) */
+        }
+      }
+      for(q = 0, p = 0; p < cnz; ) /* scan all of memory */
+      {
+        if((j = ei_amd_flip (Ci[p++])) >= 0)  /* found object j */
+        {
+          Ci[q] = Cp[j];       /* restore first entry of object */
+          Cp[j] = q++;          /* new pointer to object j */
+          for(k3 = 0; k3 < len[j]-1; k3++) Ci[q++] = Ci[p++];
+        }
+      }
+      cnz = q;                       /* Ci[cnz...nzmax-1] now free */
+    }
+
+    /* --- Construct new element ---------------------------------------- */
+    dk = 0;
+    nv[k] = -nvk;                     /* flag k as in Lk */
+    p = Cp[k];
+    pk1 = (elenk == 0) ? p : cnz;      /* do in place if elen[k] == 0 */
+    pk2 = pk1;
+    for(k1 = 1; k1 <= elenk + 1; k1++)
+    {
+      if(k1 > elenk)
+      {
+        e = k;                     /* search the nodes in k */
+        pj = p;                    /* list of nodes starts at Ci[pj]*/
+        ln = len[k] - elenk;      /* length of list of nodes in k */
+      }
+      else
+      {
+        e = Ci[p++];              /* search the nodes in e */
+        pj = Cp[e];
+        ln = len[e];              /* length of list of nodes in e */
+      }
+      for(k2 = 1; k2 <= ln; k2++)
+      {
+        i = Ci[pj++];
+        if((nvi = nv[i]) <= 0) continue; /* node i dead, or seen */
+        dk += nvi;                 /* degree[Lk] += size of node i */
+        nv[i] = -nvi;             /* negate nv[i] to denote i in Lk*/
+        Ci[pk2++] = i;            /* place i in Lk */
+        if(next[i] != -1) last[next[i]] = last[i];
+        if(last[i] != -1)         /* remove i from degree list */
+        {
+          next[last[i]] = next[i];
+        }
+        else
+        {
+          head[degree[i]] = next[i];
+        }
+      }
+      if(e != k)
+      {
+        Cp[e] = ei_amd_flip (k);      /* absorb e into k */
+        w[e] = 0;                 /* e is now a dead element */
+      }
+    }
+    if(elenk != 0) cnz = pk2;         /* Ci[cnz...nzmax] is free */
+    degree[k] = dk;                   /* external degree of k - |Lk\i| */
+    Cp[k] = pk1;                      /* element k is in Ci[pk1..pk2-1] */
+    len[k] = pk2 - pk1;
+    elen[k] = -2;                     /* k is now an element */
+
+    /* --- Find set differences ----------------------------------------- */
+    mark = ei_cs_wclear<Index>(mark, lemax, w, n);  /* clear w if necessary */
+    for(pk = pk1; pk < pk2; pk++)    /* scan 1: find |Le\Lk| */
+    {
+      i = Ci[pk];
+      if((eln = elen[i]) <= 0) continue;/* skip if elen[i] empty */
+      nvi = -nv[i];                      /* nv[i] was negated */
+      wnvi = mark - nvi;
+      for(p = Cp[i]; p <= Cp[i] + eln - 1; p++)  /* scan Ei */
+      {
+        e = Ci[p];
+        if(w[e] >= mark)
+        {
+          w[e] -= nvi;          /* decrement |Le\Lk| */
+        }
+        else if(w[e] != 0)        /* ensure e is a live element */
+        {
+          w[e] = degree[e] + wnvi; /* 1st time e seen in scan 1 */
+        }
+      }
+    }
+
+    /* --- Degree update ------------------------------------------------ */
+    for(pk = pk1; pk < pk2; pk++)    /* scan2: degree update */
+    {
+      i = Ci[pk];                   /* consider node i in Lk */
+      p1 = Cp[i];
+      p2 = p1 + elen[i] - 1;
+      pn = p1;
+      for(h = 0, d = 0, p = p1; p <= p2; p++)    /* scan Ei */
+      {
+        e = Ci[p];
+        if(w[e] != 0)             /* e is an unabsorbed element */
+        {
+          dext = w[e] - mark;   /* dext = |Le\Lk| */
+          if(dext > 0)
+          {
+            d += dext;         /* sum up the set differences */
+            Ci[pn++] = e;     /* keep e in Ei */
+            h += e;            /* compute the hash of node i */
+          }
+          else
+          {
+            Cp[e] = ei_amd_flip (k);  /* aggressive absorb. e->k */
+            w[e] = 0;             /* e is a dead element */
+          }
+        }
+      }
+      elen[i] = pn - p1 + 1;        /* elen[i] = |Ei| */
+      p3 = pn;
+      p4 = p1 + len[i];
+      for(p = p2 + 1; p < p4; p++) /* prune edges in Ai */
+      {
+        j = Ci[p];
+        if((nvj = nv[j]) <= 0) continue; /* node j dead or in Lk */
+        d += nvj;                  /* degree(i) += |j| */
+        Ci[pn++] = j;             /* place j in node list of i */
+        h += j;                    /* compute hash for node i */
+      }
+      if(d == 0)                     /* check for mass elimination */
+      {
+        Cp[i] = ei_amd_flip (k);      /* absorb i into k */
+        nvi = -nv[i];
+        dk -= nvi;                 /* |Lk| -= |i| */
+        nvk += nvi;                /* |k| += nv[i] */
+        nel += nvi;
+        nv[i] = 0;
+        elen[i] = -1;             /* node i is dead */
+      }
+      else
+      {
+        degree[i] = std::min<Index> (degree[i], d);   /* update degree(i) */
+        Ci[pn] = Ci[p3];         /* move first node to end */
+        Ci[p3] = Ci[p1];         /* move 1st el. to end of Ei */
+        Ci[p1] = k;               /* add k as 1st element in of Ei */
+        len[i] = pn - p1 + 1;     /* new len of adj. list of node i */
+        h = ((h<0) ? (-h):h) % n;  /* finalize hash of i */
+        next[i] = hhead[h];      /* place i in hash bucket */
+        hhead[h] = i;
+        last[i] = h;      /* save hash of i in last[i] */
+      }
+    }                                   /* scan2 is done */
+    degree[k] = dk;                   /* finalize |Lk| */
+    lemax = std::max<Index>(lemax, dk);
+    mark = ei_cs_wclear<Index>(mark+lemax, lemax, w, n);    /* clear w */
+
+    /* --- Supernode detection ------------------------------------------ */
+    for(pk = pk1; pk < pk2; pk++)
+    {
+      i = Ci[pk];
+      if(nv[i] >= 0) continue;         /* skip if i is dead */
+      h = last[i];                      /* scan hash bucket of node i */
+      i = hhead[h];
+      hhead[h] = -1;                    /* hash bucket will be empty */
+      for(; i != -1 && next[i] != -1; i = next[i], mark++)
+      {
+        ln = len[i];
+        eln = elen[i];
+        for(p = Cp[i] + 1; p <= Cp[i] + ln - 1; p++) w[Ci[p]] = mark;
+        jlast = i;
+        for(j = next[i]; j != -1; ) /* compare i with all j */
+        {
+          ok = (len[j] == ln) && (elen[j] == eln);
+          for(p = Cp[j] + 1; ok && p <= Cp[j] + ln - 1; p++)
+          {
+            if(w[Ci[p]] != mark) ok = 0;    /* compare i and j*/
+          }
+          if(ok)                     /* i and j are identical */
+          {
+            Cp[j] = ei_amd_flip (i);  /* absorb j into i */
+            nv[i] += nv[j];
+            nv[j] = 0;
+            elen[j] = -1;         /* node j is dead */
+            j = next[j];          /* delete j from hash bucket */
+            next[jlast] = j;
+          }
+          else
+          {
+            jlast = j;             /* j and i are different */
+            j = next[j];
+          }
+        }
+      }
+    }
+
+    /* --- Finalize new element------------------------------------------ */
+    for(p = pk1, pk = pk1; pk < pk2; pk++)   /* finalize Lk */
+    {
+      i = Ci[pk];
+      if((nvi = -nv[i]) <= 0) continue;/* skip if i is dead */
+      nv[i] = nvi;                      /* restore nv[i] */
+      d = degree[i] + dk - nvi;         /* compute external degree(i) */
+      d = std::min<Index> (d, n - nel - nvi);
+      if(head[d] != -1) last[head[d]] = i;
+      next[i] = head[d];               /* put i back in degree list */
+      last[i] = -1;
+      head[d] = i;
+      mindeg = std::min<Index> (mindeg, d);       /* find new minimum degree */
+      degree[i] = d;
+      Ci[p++] = i;                      /* place i in Lk */
+    }
+    nv[k] = nvk;                      /* # nodes absorbed into k */
+    if((len[k] = p-pk1) == 0)         /* length of adj list of element k*/
+    {
+      Cp[k] = -1;                   /* k is a root of the tree */
+      w[k] = 0;                     /* k is now a dead element */
+    }
+    if(elenk != 0) cnz = p;           /* free unused space in Lk */
+  }
+
+  /* --- Postordering ----------------------------------------------------- */
+  for(i = 0; i < n; i++) Cp[i] = ei_amd_flip (Cp[i]);/* fix assembly tree */
+  for(j = 0; j <= n; j++) head[j] = -1;
+  for(j = n; j >= 0; j--)              /* place unordered nodes in lists */
+  {
+    if(nv[j] > 0) continue;          /* skip if j is an element */
+    next[j] = head[Cp[j]];          /* place j in list of its parent */
+    head[Cp[j]] = j;
+  }
+  for(e = n; e >= 0; e--)              /* place elements in lists */
+  {
+    if(nv[e] <= 0) continue;         /* skip unless e is an element */
+    if(Cp[e] != -1)
+    {
+      next[e] = head[Cp[e]];      /* place e in list of its parent */
+      head[Cp[e]] = e;
+    }
+  }
+  for(k = 0, i = 0; i <= n; i++)       /* postorder the assembly tree */
+  {
+    if(Cp[i] == -1) k = ei_cs_tdfs<Index>(i, k, head, next, P, w);
+  }
+
+  // P[k] is the k-th pivot, the dummy node n being the last one
+  perm.indices().resize(n);
+  for(k = 0; k < n; ++k)
+    perm.indices()[P[k]] = k;
+}
+
+/** \internal
+  * Computes a column ordering of \a mat reducing the fill-in of its LU factorization, by
+  * applying the approximate minimum degree ordering to the pattern of \f$ A^T A \f$.
+  * Like COLAMD, the dense rows, having more than \f$ 10 \sqrt{n} \f$ nonzeros, are ignored.
+  *
+  * On output, the \a j-th column of \a mat is moved to the \c perm.indices()(j)-th position.
+  */
+template<typename MatrixType>
+void ei_column_minimum_degree_ordering(const MatrixType& mat, PermutationMatrix<Dynamic>& perm)
+{
+  typedef typename MatrixType::Index Index;
+  typedef typename MatrixType::Scalar Scalar;
+  typedef Matrix<Index,Dynamic,1> IndexVector;
+  ei_assert(!(MatrixType::Flags&RowMajorBit));
+  const Index rows = mat.rows();
+  const Index cols = mat.cols();
+  const Index dense = std::max<Index>(16, Index(10 * std::sqrt(double(cols))));
+
+  // row-wise copy of the pattern of mat
+  IndexVector rowPtr = IndexVector::Zero(rows+1);
+  for(Index j = 0; j < cols; ++j)
+    for(typename MatrixType::InnerIterator it(mat,j); it; ++it)
+      ++rowPtr[it.index()+1];
+  for(Index i = 0; i < rows; ++i)
+    rowPtr[i+1] += rowPtr[i];
+  IndexVector rowCols(rowPtr[rows]);
+  IndexVector fill = rowPtr.head(rows);
+  for(Index j = 0; j < cols; ++j)
+    for(typename MatrixType::InnerIterator it(mat,j); it; ++it)
+      rowCols[fill[it.index()]++] = j;
+
+  // pattern of the lower triangular part of A^T A
+  SparseMatrix<Scalar,ColMajor,Index> ata(cols,cols);
+  IndexVector tags = IndexVector::Constant(cols,-1);
+  std::vector<Index> pattern;
+  ata.reserve(mat.nonZeros());
+  for(Index j = 0; j < cols; ++j)
+  {
+    pattern.clear();
+    tags[j] = j;
+    for(typename MatrixType::InnerIterator it(mat,j); it; ++it)
+    {
+      Index r = it.index();
+      if(rowPtr[r+1]-rowPtr[r] > dense)
+        continue;
+      for(Index p = rowPtr[r]; p < rowPtr[r+1]; ++p)
+      {
+        Index c = rowCols[p];
+        if(c>j && tags[c]!=j)
+        {
+          tags[c] = j;
+          pattern.push_back(c);
+        }
+      }
+    }
+    std::sort(pattern.begin(), pattern.end());
+    ata.startVec(j);
+    for(size_t k = 0; k < pattern.size(); ++k)
+      ata.insertBack(pattern[k],j) = Scalar(1);
+  }
+  ata.finalize();
+  ei_minimum_degree_ordering(ata, perm);
+}
+
+/** \internal
+  * Stores into \a dest the \a DstUpLo triangular part of the symmetric permutation
+  * \f$ P A P^T \f$ of the selfadjoint matrix \a mat, of which only the \a SrcUpLo
+  * triangular part is referenced. The \a i-th row and column of \a mat are moved to the
+  * \a perm[i]-th position. If \a perm is null, the identity is used.
+  *
+  * The inner indices of \a dest are not sorted.
+  */
+template<int SrcUpLo, int DstUpLo, typename MatrixType, typename DestType>
+void ei_permute_symm_to_symm(const MatrixType& mat, const int* perm, DestType& dest)
+{
+  typedef typename MatrixType::Index Index;
+  ei_assert(mat.rows()==mat.cols() && !(DestType::Flags&RowMajorBit));
+  const Index size = mat.cols();
+  Matrix<Index,Dynamic,1> count = Matrix<Index,Dynamic,1>::Zero(size);
+  dest.resize(size,size);
+
+  // computes the number of coefficients per destination column
+  for(Index j = 0; j < size; ++j)
+  {
+    Index jp = perm ? perm[j] : j;
+    for(typename MatrixType::InnerIterator it(mat,j); it; ++it)
+    {
+      Index i = it.index();
+      if((SrcUpLo==Lower && i<j) || (SrcUpLo==Upper && i>j))
+        continue;
+      Index ip = perm ? perm[i] : i;
+      ++count[DstUpLo==Lower ? std::min(ip,jp) : std::max(ip,jp)];
+    }
+  }
+  dest._outerIndexPtr()[0] = 0;
+  for(Index j = 0; j < size; ++j)
+    dest._outerIndexPtr()[j+1] = dest._outerIndexPtr()[j] + count[j];
+  dest.resizeNonZeros(dest._outerIndexPtr()[size]);
+  for(Index j = 0; j < size; ++j)
+    count[j] = dest._outerIndexPtr()[j];
+
+  for(Index j = 0; j < size; ++j)
+  {
+    Index jp = perm ? perm[j] : j;
+    for(typename MatrixType::InnerIterator it(mat,j); it; ++it)
+    {
+      Index i = it.index();
+      if((SrcUpLo==Lower && i<j) || (SrcUpLo==Upper && i>j))
+        continue;
+      Index ip = perm ? perm[i] : i;
+      Index k = count[DstUpLo==Lower ? std::min(ip,jp) : std::max(ip,jp)]++;
+      dest._innerIndexPtr()[k] = DstUpLo==Lower ? std::max(ip,jp) : std::min(ip,jp);
+      // the coefficient (ip,jp) is stored as is if it remains in the destination triangle,
+      // otherwise its conjugate is stored at the symmetric position (jp,ip)
+      if((DstUpLo==Lower) == (ip>=jp))
+        dest._valuePtr()[k] = it.value();
+      else
+        dest._valuePtr()[k] = ei_conj(it.value());
+    }
+  }
+}
+
+#endif // EIGEN_SPARSE_AMD_H
@@ -58,6 +58,7 @@ template<typename MatrixType>
 cholmod_sparse ei_asCholmodMatrix(MatrixType& mat)
 {
   typedef typename MatrixType::Scalar Scalar;
+  ei_assert(mat.isCompressed() && "this function requires a compressed matrix, call makeCompressed() first");
   cholmod_sparse res;
   res.nzmax   = mat.nonZeros();
   res.nrow    = mat.rows();;
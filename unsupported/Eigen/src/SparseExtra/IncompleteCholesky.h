@@ -0,0 +1,252 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Copyright (C) 2010 Gael Guennebaud <gael.guennebaud@inria.fr>
+//
+// Eigen is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// Alternatively, you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation; either version 2 of
+// the License, or (at your option) any later version.
+//
+// Eigen is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License or the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License and a copy of the GNU General Public License along with
+// Eigen. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef EIGEN_INCOMPLETE_CHOLESKY_H
+#define EIGEN_INCOMPLETE_CHOLESKY_H
+
+/** \ingroup Sparse_Module
+  *
+  * \class IncompleteCholesky
+  *
+  * \brief Incomplete Cholesky factorization without fill-in, IC(0)
+  *
+  * \param _MatrixType the type of the selfadjoint sparse matrix to precondition
+  *
+  * Computes a lower triangular factor L having the sparsity pattern of the lower triangular part of the matrix,
+  * completed by its diagonal, such that \f$ L L^* \approx A \f$. Only the lower triangular part of the matrix is used.
+  *
+  * As for IncompleteLU, the factorization is split into analyzePattern() and factorize(), the latter reusing the
+  * pattern and the memory of the factor, as well as the level schedules of the triangular solves. Both solves
+  * read the factor in place, the rows of L being accessed through a transposed copy of its pattern. Since the incomplete factorization of a positive definite matrix can
+  * break down, factorize() retries with increasing diagonal shifts \f$ A + \alpha \, \mathrm{diag}(A) \f$ when a
+  * non positive pivot is encountered, see shift().
+  *
+  * Through solveInPlace(), this class can be used as the preconditioner of ei_conjugate_gradient():
+  * \code
+  * IncompleteCholesky<SparseMatrix<double> > ic(A);
+  * ei_conjugate_gradient(A, x, b, ic, iter);
+  * \endcode
+  *
+  * \sa class IncompleteLU, class SparseLLT
+  */
+template<typename _MatrixType>
+class IncompleteCholesky
+{
+  public:
+    typedef _MatrixType MatrixType;
+    typedef typename MatrixType::Scalar Scalar;
+    typedef typename MatrixType::Index Index;
+    typedef typename NumTraits<Scalar>::Real RealScalar;
+    typedef SparseMatrix<Scalar,ColMajor,Index> CholMatrixType;
+    typedef Matrix<Scalar,Dynamic,1> ScalarVector;
+    typedef Matrix<Index,Dynamic,1> IndexVector;
+
+    IncompleteCholesky() : m_shift(0), m_succeeded(false) {}
+
+    IncompleteCholesky(const MatrixType& matrix)
+      : m_shift(0), m_succeeded(false)
+    {
+      compute(matrix);
+    }
+
+    /** Computes the incomplete factorization of \a matrix */
+    bool compute(const MatrixType& matrix)
+    {
+      analyzePattern(matrix);
+      return factorize(matrix);
+    }
+
+    /** Builds the sparsity pattern of the factor from the lower triangular part of \a matrix.
+      *
+      * \sa factorize() */
+    void analyzePattern(const MatrixType& matrix);
+
+    /** Performs the numerical factorization of \a matrix which must have the same sparsity
+      * pattern as the matrix given to the last call to analyzePattern().
+      *
+      * \returns true if the factorization succeeded
+      * \sa analyzePattern() */
+    bool factorize(const MatrixType& matrix);
+
+    /** \returns the lower triangular factor L */
+    inline const CholMatrixType& matrixL() const { return m_matrix; }
+
+    /** \returns the relative diagonal shift \f$ \alpha \f$ used by the last factorization */
+    inline RealScalar shift() const { return m_shift; }
+
+    /** \returns true if the factorization succeeded */
+    inline bool succeeded() const { return m_succeeded; }
+
+    inline Index rows() const { return m_matrix.rows(); }
+    inline Index cols() const { return m_matrix.cols(); }
+
+    /** Overwrites \a b by \f$ L^{-*} L^{-1} b \f$, using level scheduled triangular solves */
+    template<typename Derived>
+    bool solveInPlace(MatrixBase<Derived>& b) const
+    {
+      ei_assert(b.rows()==rows());
+      if(!m_succeeded)
+        return false;
+      m_lowerSchedule.solveInPlace(_lowerRows(), m_invDiag.data(), b);
+      m_upperSchedule.solveInPlace(_upperRows(), m_invDiag.data(), b);
+      return true;
+    }
+
+  protected:
+    bool _numeric();
+
+    // the rows of L are read through its transposed pattern, and the rows of L^* are its columns
+    // without their first coefficient, which is the diagonal one
+    ei_sparse_triangular_rows<Scalar,Index> _lowerRows() const
+    {
+      return ei_sparse_triangular_rows<Scalar,Index>(m_rowOuter.data(), m_rowOuter.data()+1, 0, m_rowInner.data(),
+                                                     m_matrix._valuePtr(), m_rowMap.data());
+    }
+    ei_sparse_triangular_rows<Scalar,Index,true> _upperRows() const
+    {
+      const Index* outer = m_matrix._outerIndexPtr();
+      return ei_sparse_triangular_rows<Scalar,Index,true>(outer, outer+1, 1, m_matrix._innerIndexPtr(), m_matrix._valuePtr());
+    }
+
+    CholMatrixType m_matrix;
+    IndexVector m_map;    // position in m_matrix of each coefficient of the matrix
+    IndexVector m_work;
+    IndexVector m_rowOuter, m_rowInner, m_rowMap;   // pattern of the strictly lower part of L stored by rows
+    ScalarVector m_invDiag;
+    ei_level_schedule<Index> m_lowerSchedule, m_upperSchedule;
+    RealScalar m_shift;
+    bool m_succeeded;
+};
+
+template<typename _MatrixType>
+void IncompleteCholesky<_MatrixType>::analyzePattern(const MatrixType& matrix)
+{
+  ei_incomplete_factor_pattern(matrix, true, m_matrix, m_map);
+  const Index size = m_matrix.rows();
+  const Index* outer = m_matrix._outerIndexPtr();
+  const Index* inner = m_matrix._innerIndexPtr();
+  m_work.setConstant(size, -1);
+
+  // transpose the pattern of the strictly lower part, the columns being visited in increasing order
+  m_rowOuter.setZero(size+1);
+  for(Index j=0; j<size; ++j)
+    for(Index p=outer[j]+1; p<outer[j+1]; ++p)
+      ++m_rowOuter[inner[p]+1];
+  for(Index i=0; i<size; ++i)
+    m_rowOuter[i+1] += m_rowOuter[i];
+  m_rowInner.resize(m_rowOuter[size]);
+  m_rowMap.resize(m_rowOuter[size]);
+  IndexVector fill = m_rowOuter.head(size);
+  for(Index j=0; j<size; ++j)
+    for(Index p=outer[j]+1; p<outer[j+1]; ++p)
+    {
+      const Index q = fill[inner[p]]++;
+      m_rowInner[q] = j;
+      m_rowMap[q] = p;
+    }
+
+  m_lowerSchedule.compute(_lowerRows(), size, true);
+  m_upperSchedule.compute(_upperRows(), size, false);
+  m_succeeded = false;
+}
+
+template<typename _MatrixType>
+bool IncompleteCholesky<_MatrixType>::factorize(const MatrixType& matrix)
+{
+  ei_assert(matrix.rows()==m_matrix.rows() && "analyzePattern() must be called first");
+  const Index size = m_matrix.rows();
+  const Index* outer = m_matrix._outerIndexPtr();
+  Scalar* values = m_matrix._valuePtr();
+
+  m_shift = 0;
+  for(int attempt=0; attempt<32; ++attempt)
+  {
+    std::fill(values, values+outer[size], Scalar(0));
+    Index k = 0;
+    for(Index j=0; j<matrix.outerSize(); ++j)
+      for(typename MatrixType::InnerIterator it(matrix,j); it; ++it, ++k)
+        if(m_map[k]>=0)
+          values[m_map[k]] = it.value();
+    ei_assert(k==m_map.size() && "the sparsity pattern differs from the analyzed one");
+
+    // the diagonal coefficient is the first one of each column
+    if(m_shift>RealScalar(0))
+      for(Index j=0; j<size; ++j)
+        values[outer[j]] *= RealScalar(1) + m_shift;
+
+    if((m_succeeded = _numeric()))
+      break;
+    m_shift = m_shift==RealScalar(0) ? RealScalar(1e-3) : 2*m_shift;
+  }
+
+  if(m_succeeded)
+  {
+    m_invDiag.resize(size);
+    for(Index j=0; j<size; ++j)
+      m_invDiag[j] = Scalar(1) / values[outer[j]];
+  }
+  return m_succeeded;
+}
+
+/** \internal right-looking factorization restricted to the pattern of m_matrix */
+template<typename _MatrixType>
+bool IncompleteCholesky<_MatrixType>::_numeric()
+{
+  const Index size = m_matrix.rows();
+  const Index* outer = m_matrix._outerIndexPtr();
+  const Index* inner = m_matrix._innerIndexPtr();
+  Scalar* values = m_matrix._valuePtr();
+
+  for(Index k=0; k<size; ++k)
+  {
+    const Index diag = outer[k];
+    RealScalar d = ei_real(values[diag]);
+    if(!(d>RealScalar(0)))
+      return false;
+    d = ei_sqrt(d);
+    values[diag] = d;
+    for(Index p=diag+1; p<outer[k+1]; ++p)
+      values[p] /= d;
+
+    // update the columns i>k of the pattern with the k-th column
+    for(Index p=diag+1; p<outer[k+1]; ++p)
+    {
+      const Index i = inner[p];
+      const Scalar lik = ei_conj(values[p]);
+      for(Index q=outer[i]; q<outer[i+1]; ++q)
+        m_work[inner[q]] = q;
+      for(Index r=p; r<outer[k+1]; ++r)
+      {
+        const Index pos = m_work[inner[r]];
+        if(pos>=0)
+          values[pos] -= values[r] * lik;
+      }
+      for(Index q=outer[i]; q<outer[i+1]; ++q)
+        m_work[inner[q]] = -1;
+    }
+  }
+  return true;
+}
+
+#endif // EIGEN_INCOMPLETE_CHOLESKY_H
@@ -0,0 +1,475 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Copyright (C) 2010 Gael Guennebaud <gael.guennebaud@inria.fr>
+//
+// Eigen is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// Alternatively, you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation; either version 2 of
+// the License, or (at your option) any later version.
+//
+// Eigen is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License or the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License and a copy of the GNU General Public License along with
+// Eigen. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef EIGEN_INCOMPLETE_LU_H
+#define EIGEN_INCOMPLETE_LU_H
+
+template<typename Index> struct ei_incomplete_factor_entry
+{
+  Index outer, inner, pos;
+  bool operator<(const ei_incomplete_factor_entry& other) const
+  { return outer<other.outer || (outer==other.outer && inner<other.inner); }
+};
+
+/** \internal
+  * Builds in \a factor the sparsity pattern of \a mat, or of its lower triangular part if \a lowerOnly is true,
+  * completed by the diagonal, with sorted inner indices. The coefficients of \a factor are set to zero.
+  * map[k] is set to the position in \a factor of the k-th coefficient of \a mat, in the order of its
+  * InnerIterator, or to -1 if this coefficient is not part of the pattern.
+  */
+template<typename MatrixType, typename FactorType, typename IndexVector>
+void ei_incomplete_factor_pattern(const MatrixType& mat, bool lowerOnly, FactorType& factor, IndexVector& map)
+{
+  typedef typename MatrixType::Index Index;
+  typedef ei_incomplete_factor_entry<Index> Entry;
+  const bool rowMajor = FactorType::IsRowMajor;
+  const Index size = mat.rows();
+  ei_assert(mat.rows()==mat.cols());
+
+  std::vector<Entry> entries;
+  entries.reserve(mat.nonZeros()+size);
+  Index k = 0;
+  for(Index j=0; j<mat.outerSize(); ++j)
+    for(typename MatrixType::InnerIterator it(mat,j); it; ++it, ++k)
+      if(!lowerOnly || it.row()>=it.col())
+      {
+        Entry e = { rowMajor ? it.row() : it.col(), rowMajor ? it.col() : it.row(), k };
+        entries.push_back(e);
+      }
+  for(Index i=0; i<size; ++i)
+  {
+    Entry e = { i, i, -1 };
+    entries.push_back(e);
+  }
+  std::sort(entries.begin(), entries.end());
+
+  map.setConstant(k, -1);
+  factor.resize(size, size);
+  factor.reserve(Index(entries.size()));
+  Index outer = -1, nz = 0;
+  for(size_t e=0; e<entries.size(); ++e)
+  {
+    const Entry& entry = entries[e];
+    bool duplicate = e>0 && entry.outer==entries[e-1].outer && entry.inner==entries[e-1].inner;
+    if(!duplicate)
+    {
+      while(outer<entry.outer)
+        factor.startVec(++outer);
+      factor.insertBackByOuterInner(entry.outer, entry.inner) = 0;
+      ++nz;
+    }
+    if(entry.pos>=0)
+      map[entry.pos] = nz-1;
+  }
+  while(outer<size-1)
+    factor.startVec(++outer);
+  factor.finalize();
+}
+
+/** \internal
+  * Base class of the incomplete LU factorizations storing both the strictly lower part of the unit lower
+  * triangular factor L and the upper triangular factor U in a single row-major matrix. The level schedules of
+  * the triangular solves only depend on its pattern, and the solves read the factors in place.
+  */
+template<typename _MatrixType>
+class IncompleteLUBase
+{
+  public:
+    typedef _MatrixType MatrixType;
+    typedef typename MatrixType::Scalar Scalar;
+    typedef typename MatrixType::Index Index;
+    typedef typename NumTraits<Scalar>::Real RealScalar;
+    typedef SparseMatrix<Scalar,RowMajor,Index> LUMatrixType;
+    typedef Matrix<Scalar,Dynamic,1> ScalarVector;
+    typedef Matrix<Index,Dynamic,1> IndexVector;
+
+    IncompleteLUBase() : m_succeeded(false) {}
+
+    /** \returns the factors L and U stored in a single matrix, the unit diagonal of L being omitted */
+    inline const LUMatrixType& matrixLU() const { return m_lu; }
+
+    /** \returns true if the factorization succeeded */
+    inline bool succeeded() const { return m_succeeded; }
+
+    inline Index rows() const { return m_lu.rows(); }
+    inline Index cols() const { return m_lu.cols(); }
+
+    /** Overwrites \a b by \f$ U^{-1} L^{-1} b \f$.
+      * The triangular solves are level scheduled such that they run in parallel when it pays off.
+      */
+    template<typename Derived>
+    bool solveInPlace(MatrixBase<Derived>& b) const
+    {
+      ei_assert(b.rows()==rows());
+      if(!m_succeeded)
+        return false;
+      m_lowerSchedule.solveInPlace(_lowerRows(), static_cast<const Scalar*>(0), b);
+      m_upperSchedule.solveInPlace(_upperRows(), m_invDiag.data(), b);
+      return true;
+    }
+
+  protected:
+    typedef ei_sparse_triangular_rows<Scalar,Index> Rows;
+
+    // the rows of L end at the diagonal, and the ones of U start right after it
+    Rows _lowerRows() const
+    {
+      return Rows(m_lu._outerIndexPtr(), m_diag.data(), 0, m_lu._innerIndexPtr(), m_lu._valuePtr());
+    }
+    Rows _upperRows() const
+    {
+      return Rows(m_diag.data(), m_lu._outerIndexPtr()+1, 1, m_lu._innerIndexPtr(), m_lu._valuePtr());
+    }
+
+    /** \internal computes the level schedules of the triangular solves from the pattern of m_lu */
+    void _analyzeLevels()
+    {
+      m_lowerSchedule.compute(_lowerRows(), m_lu.rows(), true);
+      m_upperSchedule.compute(_upperRows(), m_lu.rows(), false);
+    }
+
+    /** \internal inverts the diagonal of U once it is factorized */
+    void _invertDiagonal()
+    {
+      const Scalar* values = m_lu._valuePtr();
+      m_invDiag.resize(m_lu.rows());
+      for(Index i=0; i<m_lu.rows(); ++i)
+        m_invDiag[i] = Scalar(1) / values[m_diag[i]];
+    }
+
+    LUMatrixType m_lu;
+    IndexVector m_diag;   // position of the diagonal coefficient of each row of m_lu
+    ScalarVector m_invDiag;
+    ei_level_schedule<Index> m_lowerSchedule, m_upperSchedule;
+    bool m_succeeded;
+};
+
+/** \ingroup Sparse_Module
+  *
+  * \class IncompleteLU
+  *
+  * \brief Incomplete LU factorization without fill-in, ILU(0)
+  *
+  * \param _MatrixType the type of the sparse matrix to precondition
+  *
+  * Computes a unit lower triangular factor L and an upper triangular factor U having the sparsity pattern of
+  * the lower and upper triangular parts of the matrix (completed by its diagonal) such that \f$ LU \approx A \f$.
+  * The factorization is split into analyzePattern(), which builds this pattern and the level schedules of the
+  * triangular solves, and factorize(), which only copies the coefficients and performs the elimination without any
+  * memory allocation of the factors. Matrices sharing the same sparsity pattern can therefore be refactorized for
+  * the price of the numerical factorization only.
+  *
+  * Through solveInPlace(), this class can be used as the preconditioner of the iterative solvers, e.g.:
+  * \code
+  * IncompleteLU<SparseMatrix<double> > ilu(A);
+  * ei_bicgstab(A, x, b, ilu, iter);
+  * \endcode
+  *
+  * \sa class IncompleteLUT, class IncompleteCholesky
+  */
+template<typename _MatrixType>
+class IncompleteLU : public IncompleteLUBase<_MatrixType>
+{
+    typedef IncompleteLUBase<_MatrixType> Base;
+    using Base::m_lu;
+    using Base::m_diag;
+    using Base::m_succeeded;
+  public:
+    typedef _MatrixType MatrixType;
+    typedef typename Base::Scalar Scalar;
+    typedef typename Base::Index Index;
+    typedef typename Base::IndexVector IndexVector;
+
+    IncompleteLU() {}
+
+    IncompleteLU(const MatrixType& matrix)
+    {
+      compute(matrix);
+    }
+
+    /** Computes the incomplete factorization of \a matrix */
+    bool compute(const MatrixType& matrix)
+    {
+      analyzePattern(matrix);
+      return factorize(matrix);
+    }
+
+    /** Builds the sparsity pattern of the factors from the one of \a matrix.
+      *
+      * \sa factorize() */
+    void analyzePattern(const MatrixType& matrix);
+
+    /** Performs the numerical factorization of \a matrix which must have the same sparsity
+      * pattern as the matrix given to the last call to analyzePattern().
+      *
+      * \returns true if the factorization succeeded, i.e., if no zero pivot has been encountered
+      * \sa analyzePattern() */
+    bool factorize(const MatrixType& matrix);
+
+  protected:
+    IndexVector m_map;    // position in m_lu of each coefficient of the matrix
+    IndexVector m_work;
+};
+
+template<typename _MatrixType>
+void IncompleteLU<_MatrixType>::analyzePattern(const MatrixType& matrix)
+{
+  ei_incomplete_factor_pattern(matrix, false, m_lu, m_map);
+  const Index size = m_lu.rows();
+  const Index* outer = m_lu._outerIndexPtr();
+  const Index* inner = m_lu._innerIndexPtr();
+  m_diag.resize(size);
+  for(Index i=0; i<size; ++i)
+    m_diag[i] = Index(std::lower_bound(inner+outer[i], inner+outer[i+1], i) - inner);
+  m_work.setConstant(size, -1);
+  Base::_analyzeLevels();
+  m_succeeded = false;
+}
+
+template<typename _MatrixType>
+bool IncompleteLU<_MatrixType>::factorize(const MatrixType& matrix)
+{
+  ei_assert(matrix.rows()==m_lu.rows() && "analyzePattern() must be called first");
+  const Index size = m_lu.rows();
+  const Index* outer = m_lu._outerIndexPtr();
+  const Index* inner = m_lu._innerIndexPtr();
+  Scalar* values = m_lu._valuePtr();
+
+  std::fill(values, values+outer[size], Scalar(0));
+  Index k = 0;
+  for(Index j=0; j<matrix.outerSize(); ++j)
+    for(typename MatrixType::InnerIterator it(matrix,j); it; ++it, ++k)
+      values[m_map[k]] = it.value();
+  ei_assert(k==m_map.size() && "the sparsity pattern differs from the analyzed one");
+
+  // IKJ variant of the Gaussian elimination restricted to the pattern of the matrix
+  m_succeeded = true;
+  for(Index i=0; i<size && m_succeeded; ++i)
+  {
+    for(Index p=outer[i]; p<outer[i+1]; ++p)
+      m_work[inner[p]] = p;
+    for(Index p=outer[i]; p<m_diag[i]; ++p)
+    {
+      const Index k = inner[p];
+      const Scalar lik = values[p] /= values[m_diag[k]];
+      for(Index q=m_diag[k]+1; q<outer[k+1]; ++q)
+      {
+        const Index pos = m_work[inner[q]];
+        if(pos>=0)
+          values[pos] -= lik * values[q];
+      }
+    }
+    for(Index p=outer[i]; p<outer[i+1]; ++p)
+      m_work[inner[p]] = -1;
+    m_succeeded = values[m_diag[i]]!=Scalar(0);
+  }
+
+  if(m_succeeded)
+    Base::_invertDiagonal();
+  return m_succeeded;
+}
+
+/** \ingroup Sparse_Module
+  *
+  * \class IncompleteLUT
+  *
+  * \brief Incomplete LU factorization with dual threshold dropping, ILUT
+  *
+  * \param _MatrixType the type of the sparse matrix to precondition
+  *
+  * This is the ILUT algorithm of Y. Saad: the rows of the factors are computed one after the other by a
+  * sparse Gaussian elimination during which the coefficients smaller than the drop tolerance times the norm
+  * of the current row of the matrix are discarded. Then, only the \a p largest coefficients of each row of L
+  * and U are kept, \a p being the fill factor times the average number of nonzeros per row of the matrix.
+  *
+  * Unlike IncompleteLU, the pattern of the factors depends on the values of the matrix, so that
+  * the factorization cannot be split into a symbolic and a numerical step. Zero pivots are replaced by a small
+  * multiple of the norm of the row such that the factorization always succeeds.
+  *
+  * \sa class IncompleteLU
+  */
+template<typename _MatrixType>
+class IncompleteLUT : public IncompleteLUBase<_MatrixType>
+{
+    typedef IncompleteLUBase<_MatrixType> Base;
+    using Base::m_lu;
+    using Base::m_diag;
+    using Base::m_succeeded;
+  public:
+    typedef _MatrixType MatrixType;
+    typedef typename Base::Scalar Scalar;
+    typedef typename Base::RealScalar RealScalar;
+    typedef typename Base::Index Index;
+    typedef typename Base::IndexVector IndexVector;
+    typedef typename Base::LUMatrixType LUMatrixType;
+
+    IncompleteLUT(RealScalar dropTolerance = RealScalar(1e-4), int fillFactor = 10)
+      : m_dropTolerance(dropTolerance), m_fillFactor(fillFactor)
+    {}
+
+    IncompleteLUT(const MatrixType& matrix, RealScalar dropTolerance = RealScalar(1e-4), int fillFactor = 10)
+      : m_dropTolerance(dropTolerance), m_fillFactor(fillFactor)
+    {
+      compute(matrix);
+    }
+
+    /** Sets the relative drop tolerance */
+    void setDropTolerance(RealScalar v) { m_dropTolerance = v; }
+    RealScalar dropTolerance() const { return m_dropTolerance; }
+
+    /** Sets the fill factor, i.e., the maximal number of coefficients of each row of L and U
+      * relative to the average number of nonzeros per row of the matrix */
+    void setFillFactor(int v) { m_fillFactor = v; }
+    int fillFactor() const { return m_fillFactor; }
+
+    /** Computes the incomplete factorization of \a matrix */
+    bool compute(const MatrixType& matrix);
+
+  protected:
+    /** \internal keeps the \a p largest coefficients of \a w whose indices are listed in \a indices, sorted */
+    static void _keepLargest(std::vector<Index>& indices, const Matrix<Scalar,Dynamic,1>& w, Index p);
+
+    struct LargerMagnitude
+    {
+      LargerMagnitude(const Matrix<Scalar,Dynamic,1>& w) : m_w(w) {}
+      bool operator()(Index a, Index b) const { return ei_abs2(m_w.coeff(a)) > ei_abs2(m_w.coeff(b)); }
+      const Matrix<Scalar,Dynamic,1>& m_w;
+    };
+
+    RealScalar m_dropTolerance;
+    int m_fillFactor;
+};
+
+template<typename _MatrixType>
+void IncompleteLUT<_MatrixType>::_keepLargest(std::vector<Index>& indices, const Matrix<Scalar,Dynamic,1>& w, Index p)
+{
+  if(Index(indices.size())>p)
+  {
+    std::nth_element(indices.begin(), indices.begin()+p, indices.end(), LargerMagnitude(w));
+    indices.resize(p);
+  }
+  std::sort(indices.begin(), indices.end());
+}
+
+template<typename _MatrixType>
+bool IncompleteLUT<_MatrixType>::compute(const MatrixType& matrix)
+{
+  ei_assert(matrix.rows()==matrix.cols());
+  const Index size = matrix.rows();
+  const LUMatrixType mat(matrix);
+  const Index p = std::max<Index>(1, Index((double(m_fillFactor) * mat.nonZeros()) / std::max<Index>(size,1)));
+
+  Matrix<Scalar,Dynamic,1> w = Matrix<Scalar,Dynamic,1>::Zero(size);
+  IndexVector marker = IndexVector::Constant(size, -1);
+  std::vector<Index> nonzeros, heap, lower, upper;
+  std::greater<Index> minHeap;
+
+  m_lu.resize(size, size);
+  m_lu.reserve(2*p*size + size);
+  m_diag.resize(size);
+  for(Index i=0; i<size; ++i)
+  {
+    // scatter the i-th row into the work vector
+    RealScalar rowNorm = 0;
+    nonzeros.clear();
+    heap.clear();
+    for(typename LUMatrixType::InnerIterator it(mat,i); it; ++it)
+    {
+      const Index j = it.index();
+      w[j] = it.value();
+      marker[j] = i;
+      nonzeros.push_back(j);
+      if(j<i)
+        heap.push_back(j);
+      rowNorm += ei_abs2(it.value());
+    }
+    rowNorm = ei_sqrt(rowNorm);
+    const RealScalar tol = m_dropTolerance * rowNorm;
+    std::make_heap(heap.begin(), heap.end(), minHeap);
+
+    // eliminate the lower part in increasing column order, fill-ins included
+    lower.clear();
+    const Index* outer = m_lu._outerIndexPtr();
+    const Index* inner = m_lu._innerIndexPtr();
+    const Scalar* values = m_lu._valuePtr();
+    while(!heap.empty())
+    {
+      std::pop_heap(heap.begin(), heap.end(), minHeap);
+      const Index k = heap.back();
+      heap.pop_back();
+      Scalar& wk = w[k];
+      wk /= values[m_diag[k]];
+      if(ei_abs(wk)<=tol)
+      {
+        wk = Scalar(0);
+        continue;
+      }
+      lower.push_back(k);
+      for(Index q=m_diag[k]+1; q<outer[k+1]; ++q)
+      {
+        const Index j = inner[q];
+        if(marker[j]!=i)
+        {
+          w[j] = Scalar(0);
+          marker[j] = i;
+          nonzeros.push_back(j);
+          if(j<i)
+            heap.push_back(j), std::push_heap(heap.begin(), heap.end(), minHeap);
+        }
+        w[j] -= wk * values[q];
+      }
+    }
+
+    // apply the dropping rules to the upper part
+    upper.clear();
+    for(size_t e=0; e<nonzeros.size(); ++e)
+      if(nonzeros[e]>i && ei_abs(w[nonzeros[e]])>tol)
+        upper.push_back(nonzeros[e]);
+    _keepLargest(lower, w, p);
+    _keepLargest(upper, w, p);
+
+    Scalar pivot = marker[i]==i ? w[i] : Scalar(0);
+    if(pivot==Scalar(0))
+      pivot = (RealScalar(1e-4) + m_dropTolerance) * (rowNorm==RealScalar(0) ? RealScalar(1) : rowNorm);
+
+    m_lu.startVec(i);
+    for(size_t e=0; e<lower.size(); ++e)
+      m_lu.insertBackByOuterInner(i, lower[e]) = w[lower[e]];
+    m_diag[i] = m_lu._outerIndexPtr()[i] + Index(lower.size());
+    m_lu.insertBackByOuterInner(i, i) = pivot;
+    for(size_t e=0; e<upper.size(); ++e)
+      m_lu.insertBackByOuterInner(i, upper[e]) = w[upper[e]];
+
+    for(size_t e=0; e<nonzeros.size(); ++e)
+      w[nonzeros[e]] = Scalar(0);
+  }
+  m_lu.finalize();
+
+  m_succeeded = true;
+  Base::_analyzeLevels();
+  Base::_invertDiagonal();
+  return m_succeeded;
+}
+
+#endif // EIGEN_INCOMPLETE_LU_H
@@ -224,9 +224,9 @@ class RandomSetter
     ~RandomSetter()
     {
       KeyType keyBitsMask = (1<<m_keyBitsOffset)-1;
+      mp_target->setZero();
       if (!SwapStorage) // also means the map is sorted
       {
-        mp_target->setZero();
         mp_target->reserve(nonZeros());
         Index prevOuter = -1;
         for (Index k=0; k<m_outerPackets; ++k)
@@ -0,0 +1,428 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Copyright (C) 2010 Gael Guennebaud <gael.guennebaud@inria.fr>
+//
+// Eigen is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// Alternatively, you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation; either version 2 of
+// the License, or (at your option) any later version.
+//
+// Eigen is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License or the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License and a copy of the GNU General Public License along with
+// Eigen. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef EIGEN_SLICED_ELLPACK_MATRIX_H
+#define EIGEN_SLICED_ELLPACK_MATRIX_H
+
+template<typename _Scalar, int _ChunkSize = 8, typename _Index = int> class SlicedEllpackMatrix;
+template<typename Lhs, typename Rhs> class SlicedEllpackTimeDenseProduct;
+
+/** \ingroup SparseExtra_Module
+  *
+  * \class SlicedEllpackMatrix
+  *
+  * \brief A read-only sparse matrix stored in the sliced ELLPACK (SELL-C-sigma) format
+  *
+  * \param _Scalar the scalar type, i.e. the type of the coefficients
+  * \param _ChunkSize the number of rows per chunk, \c C. The default is 8.
+  * \param _Index the type of the indices. Default is \c int.
+  *
+  * The rows are grouped in chunks of \c C consecutive rows. Each chunk is stored as a dense
+  * column-major \c C x \c w block of values and column indices, where \c w is the length of its
+  * longest row, and the shorter rows are padded with explicit zeros. In order to reduce the padding,
+  * the rows are first sorted by decreasing number of nonzeros within windows of \c sigma rows.
+  *
+  * With this layout, the \c C rows of a chunk are processed simultaneously by the matrix times dense
+  * product using the SIMD packets: the values are loaded with aligned loads and the matching
+  * coefficients of the right hand side are gathered. This is much faster than the product of a
+  * compressed SparseMatrix, at the price of a read-only storage. \c C should be a multiple of the
+  * packet size of \c _Scalar.
+  *
+  * \code
+  * SparseMatrix<double> A;
+  * // fill A
+  * SlicedEllpackMatrix<double> sellA(A);
+  * for(...) y = sellA * x;
+  * \endcode
+  *
+  * \sa SparseMatrix
+  */
+template<typename _Scalar, int _ChunkSize, typename _Index>
+struct ei_traits<SlicedEllpackMatrix<_Scalar, _ChunkSize, _Index> >
+{
+  typedef _Scalar Scalar;
+  typedef _Index Index;
+  typedef Sparse StorageKind;
+  typedef MatrixXpr XprKind;
+  enum {
+    RowsAtCompileTime = Dynamic,
+    ColsAtCompileTime = Dynamic,
+    MaxRowsAtCompileTime = Dynamic,
+    MaxColsAtCompileTime = Dynamic,
+    Flags = RowMajorBit | NestByRefBit,
+    CoeffReadCost = NumTraits<Scalar>::ReadCost,
+    SupportedAccessPatterns = InnerRandomAccessPattern
+  };
+};
+
+template<typename _Scalar, int _ChunkSize, typename _Index>
+class SlicedEllpackMatrix
+  : public SparseMatrixBase<SlicedEllpackMatrix<_Scalar, _ChunkSize, _Index> >
+{
+  public:
+    EIGEN_SPARSE_PUBLIC_INTERFACE(SlicedEllpackMatrix)
+
+    enum { ChunkSize = _ChunkSize };
+
+    class InnerIterator;
+
+    /** Default constructor, to be followed by a call to compute() */
+    SlicedEllpackMatrix() : m_rows(0), m_cols(0), m_nnz(0) {}
+
+    /** Builds the sliced ELLPACK representation of \a other, sorting the rows within windows of
+      * \a sigma rows. \sa compute() */
+    template<typename OtherDerived>
+    explicit SlicedEllpackMatrix(const SparseMatrixBase<OtherDerived>& other, Index sigma = 128)
+      : m_rows(0), m_cols(0), m_nnz(0)
+    {
+      compute(other, sigma);
+    }
+
+    template<typename OtherDerived>
+    SlicedEllpackMatrix& compute(const SparseMatrixBase<OtherDerived>& other, Index sigma = 128);
+
+    inline Index rows() const { return m_rows; }
+    inline Index cols() const { return m_cols; }
+    inline Index innerSize() const { return m_cols; }
+    inline Index outerSize() const { return m_rows; }
+
+    /** \returns the number of non zero coefficients, not counting the padding */
+    inline Index nonZeros() const { return m_nnz; }
+
+    /** \returns the number of stored coefficients, including the padding */
+    inline Index storedCoefficients() const { return m_values.size(); }
+
+    /** \returns the number of non zero coefficients of the row \a row */
+    inline Index innerNonZeros(Index row) const { return m_rowLength.coeff(row); }
+
+    /** \returns the number of chunks */
+    inline Index chunks() const { return m_chunkStart.size()-1; }
+
+    //----------------------------------------
+    // direct access interface
+    inline const Scalar* _valuePtr() const { return m_values.data(); }
+    inline const Index* _innerIndexPtr() const { return m_indices.data(); }
+    /** \internal position of the first coefficient of each chunk, plus the total size */
+    inline const Index* _chunkStartPtr() const { return m_chunkStart.data(); }
+    /** \internal row stored at each position of the chunks */
+    inline const Index* _rowOfSlotPtr() const { return m_rowOfSlot.data(); }
+    //----------------------------------------
+
+    Scalar coeff(Index row, Index col) const
+    {
+      for(InnerIterator it(*this,row); it; ++it)
+        if(it.index()==col)
+          return it.value();
+      return Scalar(0);
+    }
+
+  protected:
+    typedef Matrix<Index,Dynamic,1> IndexVector;
+
+    Index m_rows;
+    Index m_cols;
+    Index m_nnz;
+    Matrix<Scalar,Dynamic,1> m_values;
+    IndexVector m_indices;
+    IndexVector m_chunkStart;
+    IndexVector m_rowOfSlot;
+    IndexVector m_slotOfRow;
+    IndexVector m_rowLength;
+};
+
+/** Builds the sliced ELLPACK representation of the sparse matrix \a other.
+  *
+  * The rows are sorted by decreasing number of nonzeros within windows of \a sigma rows, \a sigma
+  * being rounded up to a multiple of the chunk size. A small window preserves the locality of the
+  * accesses to the right hand side while a large one minimizes the padding. Set \a sigma to 1 to
+  * keep the original row order.
+  */
+template<typename _Scalar, int _ChunkSize, typename _Index>
+template<typename OtherDerived>
+SlicedEllpackMatrix<_Scalar,_ChunkSize,_Index>&
+SlicedEllpackMatrix<_Scalar,_ChunkSize,_Index>::compute(const SparseMatrixBase<OtherDerived>& other, Index sigma)
+{
+  const SparseMatrix<Scalar,RowMajor,Index> mat(other.derived());
+  const Index C = ChunkSize;
+  m_rows = mat.rows();
+  m_cols = mat.cols();
+  m_nnz = mat.nonZeros();
+
+  m_rowLength.resize(m_rows);
+  for(Index i=0; i<m_rows; ++i)
+    m_rowLength.coeffRef(i) = mat.innerNonZeros(i);
+
+  // sort the rows by decreasing length within each window
+  m_rowOfSlot.resize(m_rows);
+  m_slotOfRow.resize(m_rows);
+  const Index window = sigma<=1 ? 1 : ((sigma+C-1)/C)*C;
+  std::vector<std::pair<Index,Index> > keys;
+  for(Index start=0; start<m_rows; start+=window)
+  {
+    const Index end = std::min(start+window, m_rows);
+    keys.resize(end-start);
+    for(Index i=start; i<end; ++i)
+      keys[i-start] = std::make_pair(-m_rowLength.coeff(i), i);
+    if(window>1)
+      std::sort(keys.begin(), keys.end());
+    for(Index i=start; i<end; ++i)
+    {
+      m_rowOfSlot.coeffRef(i) = keys[i-start].second;
+      m_slotOfRow.coeffRef(keys[i-start].second) = i;
+    }
+  }
+
+  // the width of a chunk is the length of its longest row
+  const Index nbChunks = (m_rows+C-1)/C;
+  m_chunkStart.resize(nbChunks+1);
+  m_chunkStart.coeffRef(0) = 0;
+  for(Index c=0; c<nbChunks; ++c)
+  {
+    Index width = 0;
+    for(Index s=c*C; s<std::min((c+1)*C, m_rows); ++s)
+      width = std::max(width, m_rowLength.coeff(m_rowOfSlot.coeff(s)));
+    m_chunkStart.coeffRef(c+1) = m_chunkStart.coeff(c) + width*C;
+  }
+
+  // the padding coefficients repeat the last column index of their row to keep the gathers local
+  m_values.setZero(m_chunkStart.coeff(nbChunks));
+  m_indices.setZero(m_chunkStart.coeff(nbChunks));
+  for(Index s=0; s<m_rows; ++s)
+  {
+    const Index row = m_rowOfSlot.coeff(s);
+    const Index width = (m_chunkStart.coeff(s/C+1)-m_chunkStart.coeff(s/C))/C;
+    Index pos = m_chunkStart.coeff(s/C) + s%C;
+    Index lastCol = 0;
+    for(typename SparseMatrix<Scalar,RowMajor,Index>::InnerIterator it(mat,row); it; ++it, pos+=C)
+    {
+      m_values.coeffRef(pos) = it.value();
+      m_indices.coeffRef(pos) = lastCol = it.index();
+    }
+    for(Index k=m_rowLength.coeff(row); k<width; ++k, pos+=C)
+      m_indices.coeffRef(pos) = lastCol;
+  }
+  return *this;
+}
+
+template<typename Scalar, int _ChunkSize, typename _Index>
+class SlicedEllpackMatrix<Scalar,_ChunkSize,_Index>::InnerIterator
+{
+  public:
+    InnerIterator(const SlicedEllpackMatrix& mat, Index outer)
+      : m_matrix(mat), m_outer(outer)
+    {
+      const Index slot = mat.m_slotOfRow.coeff(outer);
+      m_id = mat.m_chunkStart.coeff(slot/ChunkSize) + slot%ChunkSize;
+      m_end = m_id + mat.m_rowLength.coeff(outer)*ChunkSize;
+    }
+
+    inline InnerIterator& operator++() { m_id += ChunkSize; return *this; }
+
+    inline Scalar value() const { return m_matrix.m_values.coeff(m_id); }
+
+    inline Index index() const { return m_matrix.m_indices.coeff(m_id); }
+    inline Index row() const { return m_outer; }
+    inline Index col() const { return index(); }
+
+    inline operator bool() const { return m_id < m_end; }
+
+  protected:
+    const SlicedEllpackMatrix& m_matrix;
+    const Index m_outer;
+    Index m_id;
+    Index m_end;
+};
+
+/***************************************************************************
+* Product with dense matrices
+***************************************************************************/
+
+/** \internal Computes \a res[r] = sum_k values[k*C+r] * x[indices[k*C+r]] for the \c C rows of a chunk */
+template<typename Scalar, int C, bool Vectorize = ei_packet_traits<Scalar>::Vectorizable
+                                              && (C % ei_packet_traits<Scalar>::size == 0)>
+struct ei_sliced_ellpack_chunk_kernel
+{
+  template<typename Index>
+  static EIGEN_STRONG_INLINE void run(const Scalar* values, const Index* indices, Index width, const Scalar* x, Scalar* res)
+  {
+    for(int r=0; r<C; ++r)
+      res[r] = Scalar(0);
+    for(Index k=0; k<width; ++k, values+=C, indices+=C)
+      for(int r=0; r<C; ++r)
+        res[r] += values[r] * x[indices[r]];
+  }
+};
+
+template<typename Scalar, int C>
+struct ei_sliced_ellpack_chunk_kernel<Scalar,C,true>
+{
+  typedef typename ei_packet_traits<Scalar>::type Packet;
+  enum { PacketSize = ei_packet_traits<Scalar>::size, NbPackets = C/PacketSize };
+
+  template<typename Index>
+  static EIGEN_STRONG_INLINE void run(const Scalar* values, const Index* indices, Index width, const Scalar* x, Scalar* res)
+  {
+    Packet acc[NbPackets];
+    for(int p=0; p<NbPackets; ++p)
+      acc[p] = ei_pset1<Packet>(Scalar(0));
+    // the chunks start at multiples of C coefficients, hence the aligned loads
+    for(Index k=0; k<width; ++k, values+=C, indices+=C)
+      for(int p=0; p<NbPackets; ++p)
+        acc[p] = ei_pmadd(ei_pload<Packet>(values+p*PacketSize), ei_pgather<Packet>(x, indices+p*PacketSize), acc[p]);
+    for(int p=0; p<NbPackets; ++p)
+      ei_pstoreu(res+p*PacketSize, acc[p]);
+  }
+};
+
+/** \internal dest.col(j) += alpha * lhs * x restricted to the chunks \a start to \a end-1 */
+template<typename Scalar, int C, typename Index, typename Dest>
+void ei_sliced_ellpack_product_chunks(const SlicedEllpackMatrix<Scalar,C,Index>& lhs, const Scalar* x,
+                                      Dest& dest, Index j, Scalar alpha, Index start, Index end)
+{
+  const Index* chunkStart = lhs._chunkStartPtr();
+  const Index* rowOfSlot = lhs._rowOfSlotPtr();
+  Scalar res[C];
+  for(Index c=start; c<end; ++c)
+  {
+    ei_sliced_ellpack_chunk_kernel<Scalar,C>::run(lhs._valuePtr()+chunkStart[c], lhs._innerIndexPtr()+chunkStart[c],
+                                                  (chunkStart[c+1]-chunkStart[c])/C, x, res);
+    const Index size = std::min<Index>(C, lhs.rows()-c*C);
+    for(Index r=0; r<size; ++r)
+      dest.coeffRef(rowOfSlot[c*C+r], j) += alpha * res[r];
+  }
+}
+
+/** \internal provides the columns of the right hand side of a product as contiguous arrays,
+  * evaluating it into a temporary when needed */
+template<typename Rhs, bool Direct = (int(Rhs::Flags)&DirectAccessBit) && !(int(Rhs::Flags)&RowMajorBit)
+                                    && int(Rhs::InnerStrideAtCompileTime)==1>
+struct ei_sliced_ellpack_rhs
+{
+  typedef typename ei_plain_matrix_type_column_major<Rhs>::type PlainType;
+  ei_sliced_ellpack_rhs(const Rhs& rhs) : m_rhs(rhs) {}
+  const typename Rhs::Scalar* col(typename Rhs::Index j) const { return m_rhs.data() + j*m_rhs.rows(); }
+  PlainType m_rhs;
+};
+
+template<typename Rhs>
+struct ei_sliced_ellpack_rhs<Rhs,true>
+{
+  ei_sliced_ellpack_rhs(const Rhs& rhs) : m_rhs(rhs) {}
+  const typename Rhs::Scalar* col(typename Rhs::Index j) const { return m_rhs.data() + j*m_rhs.outerStride(); }
+  const Rhs& m_rhs;
+};
+
+/** \internal Computes a share of the chunks of a sliced ELLPACK times dense product.
+  * The chunks write distinct rows of the destination, so that no reduction is needed. */
+template<typename Lhs, typename RhsEval, typename Dest>
+class ei_sliced_ellpack_task
+{
+    typedef typename Lhs::Index Index;
+    typedef typename Lhs::Scalar Scalar;
+  public:
+    ei_sliced_ellpack_task(const Lhs& lhs, const RhsEval& rhs, Index rhsCols, Dest& dest, Scalar alpha, const Index* starts)
+      : m_lhs(lhs), m_rhs(rhs), m_rhsCols(rhsCols), m_dest(dest), m_alpha(alpha), m_starts(starts)
+    {}
+
+    void operator()(int id) const
+    {
+      for(Index j=0; j<m_rhsCols; ++j)
+        ei_sliced_ellpack_product_chunks(m_lhs, m_rhs.col(j), m_dest, j, m_alpha, m_starts[id], m_starts[id+1]);
+    }
+
+  protected:
+    const Lhs& m_lhs;
+    const RhsEval& m_rhs;
+    Index m_rhsCols;
+    Dest& m_dest;
+    Scalar m_alpha;
+    const Index* m_starts;
+};
+
+template<typename Lhs, typename Rhs>
+struct ei_traits<SlicedEllpackTimeDenseProduct<Lhs,Rhs> >
+ : ei_traits<ProductBase<SlicedEllpackTimeDenseProduct<Lhs,Rhs>, Lhs, Rhs> >
+{
+  typedef Dense StorageKind;
+  typedef MatrixXpr XprKind;
+};
+
+template<typename Lhs, typename Rhs>
+class SlicedEllpackTimeDenseProduct
+  : public ProductBase<SlicedEllpackTimeDenseProduct<Lhs,Rhs>, Lhs, Rhs>
+{
+  public:
+    EIGEN_PRODUCT_PUBLIC_INTERFACE(SlicedEllpackTimeDenseProduct)
+
+    SlicedEllpackTimeDenseProduct(const Lhs& lhs, const Rhs& rhs) : Base(lhs,rhs)
+    {
+      EIGEN_STATIC_ASSERT((ei_is_same_type<typename Lhs::Scalar, typename _RhsNested::Scalar>::ret),
+        YOU_MIXED_DIFFERENT_NUMERIC_TYPES__YOU_NEED_TO_USE_THE_CAST_METHOD_OF_MATRIXBASE_TO_CAST_NUMERIC_TYPES_EXPLICITLY)
+    }
+
+    /** \internal
+      * The chunks are split among the threads such that each of them gets the same number of stored
+      * coefficients, using the ThreadPool if any, or OpenMP, as the sparse times dense product does.
+      */
+    template<typename Dest> void scaleAndAddTo(Dest& dest, Scalar alpha) const
+    {
+      typedef typename _LhsNested::Index LhsIndex;
+      const ei_sliced_ellpack_rhs<_RhsNested> rhs(m_rhs);
+      const LhsIndex rhsCols = m_rhs.cols();
+      const LhsIndex nbChunks = m_lhs.chunks();
+      const LhsIndex* chunkStart = m_lhs._chunkStartPtr();
+      const int threads = ei_parallel_threads(double(chunkStart[nbChunks]) * double(rhsCols));
+
+      if(threads<=1)
+      {
+        for(LhsIndex j=0; j<rhsCols; ++j)
+          ei_sliced_ellpack_product_chunks(m_lhs, rhs.col(j), dest, j, alpha, LhsIndex(0), nbChunks);
+        return;
+      }
+
+      LhsIndex* starts = ei_aligned_stack_new(LhsIndex, threads+1);
+      starts[0] = 0;
+      for(int t=1; t<threads; ++t)
+      {
+        LhsIndex target = LhsIndex((double(chunkStart[nbChunks])*t)/threads);
+        starts[t] = std::max<LhsIndex>(starts[t-1], LhsIndex(std::lower_bound(chunkStart, chunkStart+nbChunks, target) - chunkStart));
+      }
+      starts[threads] = nbChunks;
+
+      ei_parallel_for(0, threads, ei_sliced_ellpack_task<_LhsNested,ei_sliced_ellpack_rhs<_RhsNested>,Dest>
+                                    (m_lhs, rhs, rhsCols, dest, alpha, starts));
+      ei_aligned_stack_delete(LhsIndex, starts, threads+1);
+    }
+
+  private:
+    SlicedEllpackTimeDenseProduct& operator=(const SlicedEllpackTimeDenseProduct&);
+};
+
+template<typename Scalar, int C, typename Index, typename Rhs>
+struct SparseDenseProductReturnType<SlicedEllpackMatrix<Scalar,C,Index>,Rhs,Dynamic>
+{
+  typedef SlicedEllpackTimeDenseProduct<SlicedEllpackMatrix<Scalar,C,Index>,Rhs> Type;
+};
+
+#endif // EIGEN_SLICED_ELLPACK_MATRIX_H
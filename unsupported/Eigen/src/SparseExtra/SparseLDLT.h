@@ -73,6 +73,12 @@ LDL License:
   *
   * \warning the upper triangular part has to be specified. The rest of the matrix is not used. The input matrix must be column major.
   *
+  * The rows and columns of the matrix are first reordered to reduce the fill-in, using by default
+  * an approximate minimum degree ordering (see setFlags()). The factorization is then split into a
+  * symbolic analysis of the sparsity pattern, analyzePattern(), and the actual numerical
+  * factorization, factorize(). Matrices sharing the same sparsity pattern can thus be factorized
+  * many times for the price of a single analysis.
+  *
   * \sa class LDLT, class LDLT
   */
 template<typename MatrixType, int Backend = DefaultBackend>
@@ -82,7 +88,7 @@ class SparseLDLT
     typedef typename MatrixType::Scalar Scalar;
     typedef typename MatrixType::Index Index;
     typedef typename NumTraits<typename MatrixType::Scalar>::Real RealScalar;
-    typedef SparseMatrix<Scalar> CholMatrixType;
+    typedef SparseMatrix<Scalar,ColMajor,Index> CholMatrixType;
     typedef Matrix<Scalar,MatrixType::ColsAtCompileTime,1> VectorType;
 
     enum {
@@ -139,23 +145,43 @@ class SparseLDLT
       *  - SupernodalLeftLooking    (implies a complete factorization  if supported by the backend,
       *                              overloads the MemoryEfficient flags)
       *
+      * and one of the following ordering methods:
+      *  - MinimumDegree_AT_PLUS_A  (the default for the DefaultBackend)
+      *  - NaturalOrdering          (no reordering)
+      *
+      * The DefaultBackend implements both supernodal flags by a supernodal left-looking
+      * factorization relying on dense matrix kernels, which is much faster for matrices
+      * having a large fill-in such as those arising from 3D meshes.
+      *
       * \sa flags() */
-    void settags(int f) { m_flags = f; }
+    void setFlags(int f) { m_flags = f; }
+    /** \deprecated use setFlags() */
+    inline void settags(int f) { setFlags(f); }
     /** \returns the current flags */
     int flags() const { return m_flags; }
 
     /** Computes/re-computes the LDLT factorization */
     void compute(const MatrixType& matrix);
 
-    /** Perform a symbolic factorization */
-    void _symbolic(const MatrixType& matrix);
-    /** Perform the actual factorization using the previously
-      * computed symbolic factorization */
-    bool _numeric(const MatrixType& matrix);
+    /** Computes the fill-reducing ordering and the symbolic factorization of \a matrix.
+      * Only the sparsity pattern of \a matrix is used.
+      *
+      * \sa factorize() */
+    void analyzePattern(const MatrixType& matrix);
 
-    /** \returns the lower triangular matrix L */
+    /** Performs the numerical factorization of \a matrix which must have the same sparsity
+      * pattern as the matrix given to the last call to analyzePattern().
+      *
+      * \returns true if the factorization succeeded
+      * \sa analyzePattern() */
+    bool factorize(const MatrixType& matrix);
+
+    /** \returns the lower triangular matrix L of the reordered matrix \f$ P A P^T \f$ */
     inline const CholMatrixType& matrixL(void) const { return m_matrix; }
 
+    /** \returns the fill-reducing permutation P */
+    inline const PermutationMatrix<Dynamic>& permutationP() const { return m_P; }
+
     /** \returns the coefficients of the diagonal matrix D */
     inline VectorType vectorD(void) const { return m_diag; }
 
@@ -166,10 +192,30 @@ class SparseLDLT
     inline bool succeeded(void) const { return m_succeeded; }
 
   protected:
+    /** Perform a symbolic factorization of the already reordered matrix \a ap */
+    void _symbolic(const CholMatrixType& ap);
+    /** Perform the actual factorization of \a ap using the previously
+      * computed symbolic factorization */
+    bool _numeric(const CholMatrixType& ap);
+
+    /** Computes the fill-reducing permutation P of \a a according to the flags */
+    void _ordering(const MatrixType& a);
+    /** Stores into \a ap the triangular part of \f$ P A P^T \f$ used by the numerical
+      * factorization: the lower part for the supernodal algorithms, the upper part otherwise */
+    void _permute(const MatrixType& a, CholMatrixType& ap) const;
+    /** Computes the ordering of \a a, stores the reordered matrix into \a ap and
+      * performs the symbolic factorization */
+    void _analyze(const MatrixType& a, CholMatrixType& ap);
+    /** Performs the numerical factorization of the reordered matrix \a ap */
+    bool _factorize(const CholMatrixType& ap);
+    inline bool _supernodal() const { return m_flags&(SupernodalLeftLooking|SupernodalMultifrontal); }
+
     CholMatrixType m_matrix;
+    PermutationMatrix<Dynamic> m_P;
     VectorType m_diag;
-    VectorXi m_parent; // elimination tree
-    VectorXi m_nonZerosPerCol;
+    Matrix<Index,Dynamic,1> m_parent; // elimination tree
+    Matrix<Index,Dynamic,1> m_nonZerosPerCol;
+    ei_supernodal_cholesky<Scalar,Index,true> m_supernodal;
 //     VectorXi m_w; // workspace
     RealScalar m_precision;
     int m_flags;
@@ -183,12 +229,83 @@ class SparseLDLT
 template<typename MatrixType, int Backend>
 void SparseLDLT<MatrixType,Backend>::compute(const MatrixType& a)
 {
-  _symbolic(a);
-  m_succeeded = _numeric(a);
+  CholMatrixType ap;
+  _analyze(a, ap);
+  _factorize(ap);
+}
+
+template<typename MatrixType, int Backend>
+void SparseLDLT<MatrixType,Backend>::analyzePattern(const MatrixType& a)
+{
+  CholMatrixType ap;
+  _analyze(a, ap);
 }
 
 template<typename MatrixType, int Backend>
-void SparseLDLT<MatrixType,Backend>::_symbolic(const MatrixType& a)
+bool SparseLDLT<MatrixType,Backend>::factorize(const MatrixType& a)
+{
+  ei_assert(a.rows()==m_P.size() && "analyzePattern() must be called first");
+  CholMatrixType ap;
+  _permute(a, ap);
+  return _factorize(ap);
+}
+
+template<typename MatrixType, int Backend>
+void SparseLDLT<MatrixType,Backend>::_analyze(const MatrixType& a, CholMatrixType& ap)
+{
+  _ordering(a);
+  _permute(a, ap);
+  if (_supernodal())
+  {
+    // the elimination tree is computed from the upper pattern
+    _symbolic(CholMatrixType(ap.transpose()));
+    m_supernodal.analyze(ap, m_parent.data(), m_nonZerosPerCol.data());
+  }
+  else
+    _symbolic(ap);
+}
+
+template<typename MatrixType, int Backend>
+bool SparseLDLT<MatrixType,Backend>::_factorize(const CholMatrixType& ap)
+{
+  if (_supernodal())
+  {
+    m_succeeded = m_supernodal.factorize(ap);
+    if (m_succeeded)
+    {
+      m_supernodal.extractL(m_matrix);
+      m_diag = m_supernodal.vectorD();
+    }
+  }
+  else
+    m_succeeded = _numeric(ap);
+  return m_succeeded;
+}
+
+template<typename MatrixType, int Backend>
+void SparseLDLT<MatrixType,Backend>::_ordering(const MatrixType& a)
+{
+  ei_assert(a.rows()==a.cols());
+  const int ordering = m_flags&OrderingMask;
+  ei_assert((ordering==0 || ordering==NaturalOrdering || ordering==MinimumDegree_AT_PLUS_A)
+            && "ordering method not supported by the default backend");
+  if (ordering==NaturalOrdering)
+    m_P.setIdentity(a.rows());
+  else
+    ei_minimum_degree_ordering(a, m_P);
+}
+
+template<typename MatrixType, int Backend>
+void SparseLDLT<MatrixType,Backend>::_permute(const MatrixType& a, CholMatrixType& ap) const
+{
+  if (_supernodal())
+    ei_permute_symm_to_symm<Upper,Lower>(a, m_P.indices().data(), ap);
+  else
+    ei_permute_symm_to_symm<Upper,Upper>(a, m_P.indices().data(), ap);
+}
+
+template<typename MatrixType, int Backend>
+void SparseLDLT<MatrixType,Backend>::_symbolic(const CholMatrixType& a)
 {
   assert(a.rows()==a.cols());
   const Index size = a.rows();
@@ -200,27 +317,17 @@ void SparseLDLT<MatrixType,Backend>::_symbolic(const MatrixType& a)
   const Index* Ap = a._outerIndexPtr();
   const Index* Ai = a._innerIndexPtr();
   Index* Lp = m_matrix._outerIndexPtr();
-  const Index* P = 0;
-  Index* Pinv = 0;
-
-  if (P)
-  {
-    /* If P is present then compute Pinv, the inverse of P */
-    for (Index k = 0; k < size; ++k)
-      Pinv[P[k]] = k;
-  }
   for (Index k = 0; k < size; ++k)
   {
     /* L(k,:) pattern: all nodes reachable in etree from nz in A(0:k-1,k) */
     m_parent[k] = -1;             /* parent of k is not yet known */
     tags[k] = k;                  /* mark node k as visited */
     m_nonZerosPerCol[k] = 0;      /* count of nonzeros in column k of L */
-    Index kk = P ? P[k] : k;      /* kth original, or permuted, column */
-    Index p2 = Ap[kk+1];
-    for (Index p = Ap[kk]; p < p2; ++p)
+    Index p2 = Ap[k+1];
+    for (Index p = Ap[k]; p < p2; ++p)
     {
-      /* A (i,k) is nonzero (original or permuted A) */
-      Index i = Pinv ? Pinv[Ai[p]] : Ai[p];
+      /* A (i,k) is nonzero */
+      Index i = Ai[p];
       if (i < k)
       {
         /* follow path from i to root of etree, stop at flagged node */
@@ -245,7 +352,7 @@ void SparseLDLT<MatrixType,Backend>::_symbolic(const MatrixType& a)
 }
 
 template<typename MatrixType, int Backend>
-bool SparseLDLT<MatrixType,Backend>::_numeric(const MatrixType& a)
+bool SparseLDLT<MatrixType,Backend>::_numeric(const CholMatrixType& a)
 {
   assert(a.rows()==a.cols());
   const Index size = a.rows();
@@ -264,8 +371,6 @@ bool SparseLDLT<MatrixType,Backend>::_numeric(const MatrixType& a)
   Index * pattern = ei_aligned_stack_new(Index, size);
   Index * tags = ei_aligned_stack_new(Index, size);
 
-  const Index* P = 0;
-  const Index* Pinv = 0;
   bool ok = true;
 
   for (Index k = 0; k < size; ++k)
@@ -275,11 +380,10 @@ bool SparseLDLT<MatrixType,Backend>::_numeric(const MatrixType& a)
     Index top = size;               /* stack for pattern is empty */
     tags[k] = k;                    /* mark node k as visited */
     m_nonZerosPerCol[k] = 0;        /* count of nonzeros in column k of L */
-    Index kk = (P) ? (P[k]) : (k);  /* kth original, or permuted, column */
-    Index p2 = Ap[kk+1];
-    for (Index p = Ap[kk]; p < p2; ++p)
+    Index p2 = Ap[k+1];
+    for (Index p = Ap[k]; p < p2; ++p)
     {
-      Index i = Pinv ? Pinv[Ai[p]] : Ai[p]; /* get A(i,k) */
+      Index i = Ai[p];                /* get A(i,k) */
       if (i <= k)
       {
         y[i] += ei_conj(Ax[p]);            /* scatter A(i,k) into Y (sum duplicates) */
@@ -336,11 +440,13 @@ bool SparseLDLT<MatrixType, Backend>::solveInPlace(MatrixBase<Derived> &b) const
   if (!m_succeeded)
     return false;
 
+  b.derived() = m_P * b.derived();
   if (m_matrix.nonZeros()>0) // otherwise L==I
     m_matrix.template triangularView<UnitLower>().solveInPlace(b);
   b = b.cwiseQuotient(m_diag);
   if (m_matrix.nonZeros()>0) // otherwise L==I
     m_matrix.adjoint().template triangularView<UnitUpper>().solveInPlace(b);
+  b.derived() = m_P.transpose() * b.derived();
 
   return true;
 }
@@ -33,6 +33,14 @@
   *
   * \param MatrixType the type of the matrix of which we are computing the LLT Cholesky decomposition
   *
+  * \warning the lower triangular part has to be specified. The rest of the matrix is not used. The input matrix must be column major.
+  *
+  * With the DefaultBackend, the rows and columns of the matrix are first reordered to reduce the
+  * fill-in, using by default an approximate minimum degree ordering (see setFlags()). The
+  * factorization is then split into a symbolic analysis of the sparsity pattern, analyzePattern(),
+  * and the actual numerical factorization, factorize(), such that matrices sharing the same
+  * sparsity pattern can be factorized many times for the price of a single analysis.
+  *
   * \sa class LLT, class LDLT
   */
 template<typename MatrixType, int Backend = DefaultBackend>
@@ -42,7 +50,7 @@ class SparseLLT
     typedef typename MatrixType::Scalar Scalar;
     typedef typename MatrixType::Index Index;
     typedef typename NumTraits<typename MatrixType::Scalar>::Real RealScalar;
-    typedef SparseMatrix<Scalar> CholMatrixType;
+    typedef SparseMatrix<Scalar,ColMajor,Index> CholMatrixType;
 
     enum {
       SupernodalFactorIsDirty      = 0x10000,
@@ -96,6 +104,16 @@ class SparseLLT
       *  - SupernodalLeftLooking    (implies a complete factorization  if supported by the backend,
       *                              overloads the MemoryEfficient flags)
       *
+      * and one of the following ordering methods:
+      *  - MinimumDegree_AT_PLUS_A  (the default for the DefaultBackend)
+      *  - NaturalOrdering          (no reordering)
+      *
+      * The DefaultBackend implements both supernodal flags by a supernodal left-looking
+      * factorization relying on dense matrix kernels, which is much faster for matrices
+      * having a large fill-in such as those arising from 3D meshes.
+      *
+      * The IncompleteFactorization of the DefaultBackend does not reorder the matrix.
+      *
       * \sa flags() */
     void setFlags(int f) { m_flags = f; }
     /** \returns the current flags */
@@ -104,9 +122,25 @@ class SparseLLT
     /** Computes/re-computes the LLT factorization */
     void compute(const MatrixType& matrix);
 
-    /** \returns the lower triangular matrix L */
+    /** Computes the fill-reducing ordering and the symbolic factorization of \a matrix.
+      * Only the sparsity pattern of \a matrix is used.
+      *
+      * \sa factorize() */
+    void analyzePattern(const MatrixType& matrix);
+
+    /** Performs the numerical factorization of \a matrix which must have the same sparsity
+      * pattern as the matrix given to the last call to analyzePattern().
+      *
+      * \returns true if the factorization succeeded
+      * \sa analyzePattern() */
+    bool factorize(const MatrixType& matrix);
+
+    /** \returns the lower triangular matrix L of the reordered matrix \f$ P A P^T \f$ */
     inline const CholMatrixType& matrixL(void) const { return m_matrix; }
 
+    /** \returns the fill-reducing permutation P */
+    inline const PermutationMatrix<Dynamic>& permutationP() const { return m_P; }
+
     template<typename Derived>
     bool solveInPlace(MatrixBase<Derived> &b) const;
 
@@ -114,7 +148,23 @@ class SparseLLT
     inline bool succeeded(void) const { return m_succeeded; }
 
   protected:
+    /** Computes the fill-reducing permutation P of \a a according to the flags */
+    void _ordering(const MatrixType& a);
+    /** Stores into \a ap the upper triangular part of \f$ P A P^T \f$ */
+    void _permute(const MatrixType& a, CholMatrixType& ap) const;
+    /** Perform a symbolic factorization of the already reordered matrix \a ap */
+    void _symbolic(const CholMatrixType& ap);
+    /** Perform the actual factorization of \a ap using the previously
+      * computed symbolic factorization */
+    bool _numeric(const CholMatrixType& ap);
+    /** Computes an incomplete factorization of \a a without reordering */
+    void _incomplete(const MatrixType& a);
+
     CholMatrixType m_matrix;
+    PermutationMatrix<Dynamic> m_P;
+    Matrix<Index,Dynamic,1> m_parent; // elimination tree
+    Matrix<Index,Dynamic,1> m_nonZerosPerCol;
+    ei_supernodal_cholesky<Scalar,Index,false> m_supernodal;
     RealScalar m_precision;
     int m_flags;
     mutable int m_status;
@@ -126,10 +176,194 @@ class SparseLLT
   */
 template<typename MatrixType, int Backend>
 void SparseLLT<MatrixType,Backend>::compute(const MatrixType& a)
+{
+  if (m_flags&IncompleteFactorization)
+  {
+    _incomplete(a);
+    return;
+  }
+  analyzePattern(a);
+  factorize(a);
+}
+
+template<typename MatrixType, int Backend>
+void SparseLLT<MatrixType,Backend>::analyzePattern(const MatrixType& a)
+{
+  ei_assert(!(m_flags&IncompleteFactorization) && "the incomplete factorization has no symbolic phase");
+  CholMatrixType ap;
+  _ordering(a);
+  _permute(a, ap);
+  _symbolic(ap);
+  if (m_flags&(SupernodalLeftLooking|SupernodalMultifrontal))
+  {
+    CholMatrixType al;
+    ei_permute_symm_to_symm<Lower,Lower>(a, m_P.indices().data(), al);
+    m_supernodal.analyze(al, m_parent.data(), m_nonZerosPerCol.data());
+  }
+}
+
+template<typename MatrixType, int Backend>
+bool SparseLLT<MatrixType,Backend>::factorize(const MatrixType& a)
+{
+  ei_assert(a.rows()==m_P.size() && "analyzePattern() must be called first");
+  if (m_flags&(SupernodalLeftLooking|SupernodalMultifrontal))
+  {
+    CholMatrixType al;
+    ei_permute_symm_to_symm<Lower,Lower>(a, m_P.indices().data(), al);
+    m_succeeded = m_supernodal.factorize(al);
+    if (m_succeeded)
+    {
+      m_supernodal.extractL(m_matrix);
+    }
+  }
+  else
+  {
+    CholMatrixType ap;
+    _permute(a, ap);
+    m_succeeded = _numeric(ap);
+  }
+  return m_succeeded;
+}
+
+template<typename MatrixType, int Backend>
+void SparseLLT<MatrixType,Backend>::_ordering(const MatrixType& a)
+{
+  ei_assert(a.rows()==a.cols());
+  const int ordering = m_flags&OrderingMask;
+  ei_assert((ordering==0 || ordering==NaturalOrdering || ordering==MinimumDegree_AT_PLUS_A)
+            && "ordering method not supported by the default backend");
+  if (ordering==NaturalOrdering)
+    m_P.setIdentity(a.rows());
+  else
+    ei_minimum_degree_ordering(a, m_P);
+}
+
+template<typename MatrixType, int Backend>
+void SparseLLT<MatrixType,Backend>::_permute(const MatrixType& a, CholMatrixType& ap) const
+{
+  ei_permute_symm_to_symm<Lower,Upper>(a, m_P.indices().data(), ap);
+}
+
+/** \internal computes the elimination tree and the column counts of L,
+  * the diagonal coefficients being stored first in each column */
+template<typename MatrixType, int Backend>
+void SparseLLT<MatrixType,Backend>::_symbolic(const CholMatrixType& a)
+{
+  const Index size = a.rows();
+  m_matrix.resize(size, size);
+  m_parent.resize(size);
+  m_nonZerosPerCol.resize(size);
+  Index * tags = ei_aligned_stack_new(Index, size);
+
+  const Index* Ap = a._outerIndexPtr();
+  const Index* Ai = a._innerIndexPtr();
+  Index* Lp = m_matrix._outerIndexPtr();
+  for (Index k = 0; k < size; ++k)
+  {
+    // L(k,:) pattern: all nodes reachable in etree from nz in A(0:k-1,k)
+    m_parent[k] = -1;
+    tags[k] = k;
+    m_nonZerosPerCol[k] = 1;
+    for (Index p = Ap[k]; p < Ap[k+1]; ++p)
+    {
+      // follow path from i to root of etree, stop at flagged node
+      for (Index i = Ai[p]; i < k && tags[i] != k; i = m_parent[i])
+      {
+        if (m_parent[i] == -1)
+          m_parent[i] = k;
+        ++m_nonZerosPerCol[i];        // L(k,i) is nonzero
+        tags[i] = k;
+      }
+    }
+  }
+  Lp[0] = 0;
+  for (Index k = 0; k < size; ++k)
+    Lp[k+1] = Lp[k] + m_nonZerosPerCol[k];
+
+  m_matrix.resizeNonZeros(Lp[size]);
+  ei_aligned_stack_delete(Index, tags, size);
+}
+
+/** \internal up-looking factorization: the k-th row of L is obtained from
+  * a sparse triangular solve with the k-th column of \a a. */
+template<typename MatrixType, int Backend>
+bool SparseLLT<MatrixType,Backend>::_numeric(const CholMatrixType& a)
+{
+  const Index size = a.rows();
+  ei_assert(m_parent.size()==size && m_nonZerosPerCol.size()==size);
+
+  const Index* Ap = a._outerIndexPtr();
+  const Index* Ai = a._innerIndexPtr();
+  const Scalar* Ax = a._valuePtr();
+  const Index* Lp = m_matrix._outerIndexPtr();
+  Index* Li = m_matrix._innerIndexPtr();
+  Scalar* Lx = m_matrix._valuePtr();
+
+  Scalar * y = ei_aligned_stack_new(Scalar, size);
+  Index * pattern = ei_aligned_stack_new(Index, size);
+  Index * tags = ei_aligned_stack_new(Index, size);
+
+  bool ok = true;
+  for (Index k = 0; k < size; ++k)
+  {
+    // compute the nonzero pattern of the k-th row of L, in topological order
+    y[k] = Scalar(0);
+    Index top = size;
+    tags[k] = k;
+    for (Index p = Ap[k]; p < Ap[k+1]; ++p)
+    {
+      Index i = Ai[p];
+      y[i] += Ax[p];                  // scatter A(i,k) into y (sum duplicates)
+      Index len;
+      for (len = 0; tags[i] != k; i = m_parent[i])
+      {
+        pattern[len++] = i;
+        tags[i] = k;
+      }
+      while (len > 0)
+        pattern[--top] = pattern[--len];
+    }
+
+    // compute the numerical values of the k-th row of L
+    RealScalar d = ei_real(y[k]);
+    y[k] = Scalar(0);
+    for (; top < size; ++top)
+    {
+      Index i = pattern[top];
+      Scalar l_ki = y[i] / Lx[Lp[i]];
+      y[i] = Scalar(0);
+      Index p2 = Lp[i] + m_nonZerosPerCol[i];
+      for (Index p = Lp[i]+1; p < p2; ++p)
+        y[Li[p]] -= Lx[p] * l_ki;
+      d -= ei_abs2(l_ki);
+      Li[p2] = k;                     // store L(k,i) in column form of L
+      Lx[p2] = ei_conj(l_ki);
+      ++m_nonZerosPerCol[i];
+    }
+    if (d <= RealScalar(0))
+    {
+      ok = false;                     // not positive definite
+      break;
+    }
+    Li[Lp[k]] = k;
+    Lx[Lp[k]] = ei_sqrt(d);
+    m_nonZerosPerCol[k] = 1;
+  }
+
+  ei_aligned_stack_delete(Scalar, y, size);
+  ei_aligned_stack_delete(Index, pattern, size);
+  ei_aligned_stack_delete(Index, tags, size);
+
+  return ok;
+}
+
+template<typename MatrixType, int Backend>
+void SparseLLT<MatrixType,Backend>::_incomplete(const MatrixType& a)
 {
   assert(a.rows()==a.cols());
   const Index size = a.rows();
   m_matrix.resize(size, size);
+  m_P.setIdentity(size);
 
   // allocate a temporary vector for accumulations
   AmbiVector<Scalar,Index> tempVector(size);
@@ -184,6 +418,7 @@ void SparseLLT<MatrixType,Backend>::compute(const MatrixType& a)
     }
   }
   m_matrix.finalize();
+  m_succeeded = true;
 }
 
 /** Computes b = L^-T L^-1 b */
@@ -194,8 +429,13 @@ bool SparseLLT<MatrixType, Backend>::solveInPlace(MatrixBase<Derived> &b) const
   const Index size = m_matrix.rows();
   ei_assert(size==b.rows());
 
+  // the factors computed by the external backends are not reordered
+  if (m_P.size()>0)
+    b.derived() = m_P * b.derived();
   m_matrix.template triangularView<Lower>().solveInPlace(b);
   m_matrix.adjoint().template triangularView<Upper>().solveInPlace(b);
+  if (m_P.size()>0)
+    b.derived() = m_P.transpose() * b.derived();
 
   return true;
 }
@@ -39,6 +39,13 @@ enum {
   *
   * \param MatrixType the type of the matrix of which we are computing the LU factorization
   *
+  * The default backend computes a left-looking LU factorization \f$ P A Q = L U \f$ with
+  * threshold partial pivoting, following the Gilbert-Peierls algorithm: each column of
+  * \f$ L \f$ and \f$ U \f$ is obtained by a sparse triangular solve whose cost is proportional
+  * to the number of floating point operations. The column permutation \f$ Q \f$ is a fill
+  * reducing ordering chosen at compute time (see setOrderingMethod()), and the row
+  * permutation \f$ P \f$ results from the pivoting.
+  *
   * \sa class FullPivLU, class SparseLLT
   */
 template<typename MatrixType, int Backend = DefaultBackend>
@@ -46,8 +53,9 @@ class SparseLU
 {
   protected:
     typedef typename MatrixType::Scalar Scalar;
+    typedef typename MatrixType::Index Index;
     typedef typename NumTraits<typename MatrixType::Scalar>::Real RealScalar;
-    typedef SparseMatrix<Scalar> LUMatrixType;
+    typedef SparseMatrix<Scalar,ColMajor,Index> LUMatrixType;
 
     enum {
       MatrixLUIsDirty             = 0x10000
@@ -57,7 +65,7 @@ class SparseLU
 
     /** Creates a dummy LU factorization object with flags \a flags. */
     SparseLU(int flags = 0)
-      : m_flags(flags), m_status(0)
+      : m_flags(flags), m_status(0), m_succeeded(false), m_pivotThreshold(1)
     {
       m_precision = RealScalar(0.1) * Eigen::NumTraits<RealScalar>::dummy_precision();
     }
@@ -65,7 +73,7 @@ class SparseLU
     /** Creates a LU object and compute the respective factorization of \a matrix using
       * flags \a flags. */
     SparseLU(const MatrixType& matrix, int flags = 0)
-      : /*m_matrix(matrix.rows(), matrix.cols()),*/ m_flags(flags), m_status(0)
+      : /*m_matrix(matrix.rows(), matrix.cols()),*/ m_flags(flags), m_status(0), m_succeeded(false), m_pivotThreshold(1)
     {
       m_precision = RealScalar(0.1) * Eigen::NumTraits<RealScalar>::dummy_precision();
       compute(matrix);
@@ -88,6 +96,25 @@ class SparseLU
       * \sa setPrecision() */
     RealScalar precision() const { return m_precision; }
 
+    /** Sets the partial pivoting threshold \a tol of the default backend, in ]0,1].
+      *
+      * At the \a k-th step, the diagonal entry of the permuted matrix is kept as the pivot as
+      * long as its magnitude is at least \a tol times the largest magnitude of the candidate
+      * pivots. Lower values preserve the fill reducing ordering better, at the expense of
+      * stability. The default, 1, is plain partial pivoting.
+      *
+      * \sa pivotThreshold() */
+    void setPivotThreshold(RealScalar tol)
+    {
+      ei_assert(tol>RealScalar(0) && tol<=RealScalar(1));
+      m_pivotThreshold = tol;
+    }
+
+    /** \returns the current partial pivoting threshold
+      *
+      * \sa setPivotThreshold() */
+    RealScalar pivotThreshold() const { return m_pivotThreshold; }
+
     /** Sets the flags. Possible values are:
       *  - CompleteFactorization
       *  - IncompleteFactorization
@@ -100,6 +127,13 @@ class SparseLU
     /** \returns the current flags */
     int flags() const { return m_flags; }
 
+    /** Sets the fill reducing column ordering. The default backend supports:
+      *  - ColApproxMinimumDegree and MinimumDegree_ATA (the default): approximate minimum
+      *    degree ordering of the pattern of \f$ A^T A \f$,
+      *  - MinimumDegree_AT_PLUS_A: approximate minimum degree ordering of the pattern of
+      *    \f$ A + A^T \f$, well suited to matrices with a nearly symmetric structure,
+      *  - NaturalOrdering: no column permutation.
+      */
     void setOrderingMethod(int m)
     {
       ei_assert( (m&~OrderingMask) == 0 && m!=0 && "invalid ordering method");
@@ -114,11 +148,19 @@ class SparseLU
     /** Computes/re-computes the LU factorization */
     void compute(const MatrixType& matrix);
 
-    /** \returns the lower triangular matrix L */
-    //inline const MatrixType& matrixL() const { return m_matrixL; }
+    /** \returns the lower triangular matrix L. Its unit diagonal is not stored. */
+    inline const LUMatrixType& matrixL() const { return m_l; }
 
     /** \returns the upper triangular matrix U */
-    //inline const MatrixType& matrixU() const { return m_matrixU; }
+    inline const LUMatrixType& matrixU() const { return m_u; }
+
+    /** \returns the row permutation P */
+    inline const PermutationMatrix<Dynamic>& permutationP() const { return m_p; }
+
+    /** \returns the column permutation Q */
+    inline const PermutationMatrix<Dynamic>& permutationQ() const { return m_q; }
+
+    Scalar determinant() const;
 
     template<typename BDerived, typename XDerived>
     bool solve(const MatrixBase<BDerived> &b, MatrixBase<XDerived>* x,
@@ -132,15 +174,229 @@ class SparseLU
     int m_flags;
     mutable int m_status;
     bool m_succeeded;
+    RealScalar m_pivotThreshold;
+    LUMatrixType m_l;
+    LUMatrixType m_u;
+    PermutationMatrix<Dynamic> m_p;
+    PermutationMatrix<Dynamic> m_q;
 };
 
 /** Computes / recomputes the LU decomposition of matrix \a a
   * using the default algorithm.
   */
 template<typename MatrixType, int Backend>
-void SparseLU<MatrixType,Backend>::compute(const MatrixType& )
+void SparseLU<MatrixType,Backend>::compute(const MatrixType& a)
 {
-  ei_assert(false && "not implemented yet");
+  ei_assert(a.rows()==a.cols() && "the default backend only supports square matrices");
+  ei_assert((MatrixType::Flags&RowMajorBit)==0);
+  const Index size = a.cols();
+  m_succeeded = false;
+
+  // fill reducing column ordering: the k-th column of A Q is the column q[k] of A
+  PermutationMatrix<Dynamic> ordering;
+  const int method = orderingMethod();
+  if(method==NaturalOrdering)
+    ordering.setIdentity(size);
+  else if(method==MinimumDegree_AT_PLUS_A)
+    ei_minimum_degree_ordering(a, ordering);
+  else
+  {
+    ei_assert((method==0 || method==ColApproxMinimumDegree || method==MinimumDegree_ATA)
+              && "ordering method not supported by the default backend");
+    ei_column_minimum_degree_ordering(a, ordering);
+  }
+  m_q.resize(size);
+  Index* q = m_q.indices().data();
+  for(Index j = 0; j < size; ++j)
+    q[ordering.indices().coeff(j)] = j;
+
+  // the factors grow as the columns are computed, the rows of L being the original ones
+  std::vector<Index> Lp(size+1), Li, Up(size+1), Ui;
+  std::vector<Scalar> Lx, Ux;
+  const Index estimate = 4*a.nonZeros() + size;
+  Li.reserve(estimate); Lx.reserve(estimate);
+  Ui.reserve(estimate); Ux.reserve(estimate);
+  Lp[0] = Up[0] = 0;
+
+  std::vector<Index> pinv(size,-1);     // step at which each row has been chosen as pivot
+  std::vector<Index> marks(size,-1);
+  std::vector<Index> reach(size);       // the nonzero pattern of the current column, in topological order
+  std::vector<Index> stack(size), stackPos(size);
+
+  // dense accumulator of the current column, which is cleared along the reached pattern only
+  AmbiVector<Scalar,Index> x(size);
+  x.init(IsDense);
+  x.setBounds(0,size);
+  x.setZero();
+
+  for(Index k = 0; k < size; ++k)
+  {
+    const Index col = q[k];
+
+    // Symbolic step: the rows reachable from the pattern of A(:,col) in the graph of L
+    // form the pattern of the current column. Each of them is pushed once its
+    // descendants are all visited, which yields a topological order.
+    Index top = size;
+    for(typename MatrixType::InnerIterator it(a,col); it; ++it)
+    {
+      if(marks[it.index()]==k)
+        continue;
+      Index head = 0;
+      stack[0] = it.index();
+      while(head>=0)
+      {
+        const Index j = stack[head];
+        const Index jstep = pinv[j];
+        if(marks[j]!=k)
+        {
+          marks[j] = k;
+          stackPos[head] = jstep<0 ? 0 : Lp[jstep];
+        }
+        bool done = true;
+        const Index end = jstep<0 ? 0 : Lp[jstep+1];
+        for(Index p = stackPos[head]; p < end; ++p)
+        {
+          const Index i = Li[p];
+          if(marks[i]==k)
+            continue;
+          stackPos[head] = p+1;
+          stack[++head] = i;
+          done = false;
+          break;
+        }
+        if(done)
+        {
+          --head;
+          reach[--top] = j;
+        }
+      }
+    }
+
+    // Numerical step: sparse triangular solve with the already computed columns of L
+    for(typename MatrixType::InnerIterator it(a,col); it; ++it)
+      x.coeffRef(it.index()) = it.value();
+    for(Index p = top; p < size; ++p)
+    {
+      const Index j = reach[p];
+      const Index jstep = pinv[j];
+      if(jstep<0)
+        continue;
+      const Scalar xj = x.coeffRef(j);
+      for(Index lp = Lp[jstep]; lp < Lp[jstep+1]; ++lp)
+        x.coeffRef(Li[lp]) -= Lx[lp] * xj;
+    }
+
+    // the entries of the pivotal rows go to U, the largest remaining one is the pivot
+    Index pivot = -1;
+    RealScalar maxAbs = -1;
+    for(Index p = top; p < size; ++p)
+    {
+      const Index i = reach[p];
+      if(pinv[i]<0)
+      {
+        RealScalar v = ei_abs(x.coeffRef(i));
+        if(v>maxAbs)
+        {
+          maxAbs = v;
+          pivot = i;
+        }
+      }
+      else
+      {
+        Ui.push_back(pinv[i]);
+        Ux.push_back(x.coeffRef(i));
+      }
+    }
+    if(pivot<0 || maxAbs<=RealScalar(0))
+    {
+      for(Index p = top; p < size; ++p)
+        x.coeffRef(reach[p]) = Scalar(0);
+      return;
+    }
+    // prefer the diagonal entry to preserve the column ordering
+    if(pinv[col]<0 && marks[col]==k && ei_abs(x.coeffRef(col)) >= m_pivotThreshold*maxAbs)
+      pivot = col;
+
+    const Scalar pivotValue = x.coeffRef(pivot);
+    pinv[pivot] = k;
+    Ui.push_back(k);
+    Ux.push_back(pivotValue);
+    Up[k+1] = Ui.size();
+
+    for(Index p = top; p < size; ++p)
+    {
+      const Index i = reach[p];
+      if(pinv[i]<0)
+      {
+        Li.push_back(i);
+        Lx.push_back(x.coeffRef(i) / pivotValue);
+      }
+      x.coeffRef(i) = Scalar(0);
+    }
+    Lp[k+1] = Li.size();
+  }
+
+  // renumber the rows of L with the pivoting order, and copy the factors
+  m_p.resize(size);
+  for(Index i = 0; i < size; ++i)
+    m_p.indices().coeffRef(i) = pinv[i];
+
+  m_l.resize(size,size);
+  m_l.resizeNonZeros(Lp[size]);
+  m_u.resize(size,size);
+  m_u.resizeNonZeros(Up[size]);
+  for(Index j = 0; j <= size; ++j)
+  {
+    m_l._outerIndexPtr()[j] = Lp[j];
+    m_u._outerIndexPtr()[j] = Up[j];
+  }
+  for(Index p = 0; p < Lp[size]; ++p)
+  {
+    m_l._innerIndexPtr()[p] = pinv[Li[p]];
+    m_l._valuePtr()[p] = Lx[p];
+  }
+  for(Index p = 0; p < Up[size]; ++p)
+  {
+    m_u._innerIndexPtr()[p] = Ui[p];
+    m_u._valuePtr()[p] = Ux[p];
+  }
+  // the inner indices are not sorted yet, a transposed copy sorts them
+  m_l = SparseMatrix<Scalar,RowMajor,Index>(m_l);
+  m_u = SparseMatrix<Scalar,RowMajor,Index>(m_u);
+
+  m_succeeded = true;
+}
+
+/** \returns the determinant of the matrix, computed from the diagonal of U and the
+  * signatures of the permutations P and Q.
+  */
+template<typename MatrixType, int Backend>
+typename SparseLU<MatrixType,Backend>::Scalar SparseLU<MatrixType,Backend>::determinant() const
+{
+  ei_assert(m_succeeded);
+  Scalar det = Scalar(1);
+  for(Index j = 0; j < m_u.cols(); ++j)
+    det *= m_u.innerVector(j).lastCoeff();
+
+  // each cycle of length c of a permutation contributes (-1)^(c-1) to its signature
+  const PermutationMatrix<Dynamic>* perms[2] = { &m_p, &m_q };
+  for(int k = 0; k < 2; ++k)
+  {
+    const PermutationMatrix<Dynamic>& perm = *perms[k];
+    std::vector<bool> visited(perm.size(), false);
+    for(Index i = 0; i < perm.size(); ++i)
+    {
+      if(visited[i])
+        continue;
+      visited[i] = true;
+      for(Index j = perm.indices().coeff(i); j != i; j = perm.indices().coeff(j))
+      {
+        visited[j] = true;
+        det = -det;
+      }
+    }
+  }
+  return det;
 }
 
 /** Computes *x = U^-1 L^-1 b
@@ -153,10 +409,35 @@ void SparseLU<MatrixType,Backend>::compute(const MatrixType& )
   */
 template<typename MatrixType, int Backend>
 template<typename BDerived, typename XDerived>
-bool SparseLU<MatrixType,Backend>::solve(const MatrixBase<BDerived> &, MatrixBase<XDerived>* , const int ) const
+bool SparseLU<MatrixType,Backend>::solve(const MatrixBase<BDerived> &b, MatrixBase<XDerived>* x, const int transposed) const
 {
-  ei_assert(false && "not implemented yet");
-  return false;
+  ei_assert(m_succeeded);
+  ei_assert(b.rows()==m_l.rows());
+  typedef Matrix<Scalar,Dynamic,Dynamic> DenseMatrix;
+
+  if(transposed==SvNoTrans)
+  {
+    // A = P^T L U Q^T
+    DenseMatrix y = m_p * b.derived();
+    m_l.template triangularView<UnitLower>().solveInPlace(y);
+    m_u.template triangularView<Upper>().solveInPlace(y);
+    x->derived() = m_q * y;
+  }
+  else if(transposed==SvTranspose)
+  {
+    DenseMatrix y = m_q.transpose() * b.derived();
+    m_u.transpose().template triangularView<Lower>().solveInPlace(y);
+    m_l.transpose().template triangularView<UnitUpper>().solveInPlace(y);
+    x->derived() = m_p.transpose() * y;
+  }
+  else
+  {
+    DenseMatrix y = m_q.transpose() * b.derived();
+    m_u.adjoint().template triangularView<Lower>().solveInPlace(y);
+    m_l.adjoint().template triangularView<UnitUpper>().solveInPlace(y);
+    x->derived() = m_p.transpose() * y;
+  }
+  return true;
 }
 
 #endif // EIGEN_SPARSELU_H
@@ -185,6 +185,7 @@ struct SluMatrix : SuperMatrix
 
     res.Mtype     = SLU_GE;
 
+    ei_assert(mat.derived().isCompressed() && "this function requires a compressed matrix, call makeCompressed() first");
     res.storage.nnz       = mat.nonZeros();
     res.storage.values    = mat.derived()._valuePtr();
     res.storage.innerInd  = mat.derived()._innerIndexPtr();
@@ -243,6 +244,7 @@ struct SluMatrixMapHelper<SparseMatrixBase<Derived> >
 
     res.Mtype     = SLU_GE;
 
+    ei_assert(mat.isCompressed() && "this function requires a compressed matrix, call makeCompressed() first");
     res.storage.nnz       = mat.nonZeros();
     res.storage.values    = mat._valuePtr();
     res.storage.innerInd  = mat._innerIndexPtr();
@@ -0,0 +1,370 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Copyright (C) 2010 Gael Guennebaud <gael.guennebaud@inria.fr>
+//
+// Eigen is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// Alternatively, you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation; either version 2 of
+// the License, or (at your option) any later version.
+//
+// Eigen is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License or the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License and a copy of the GNU General Public License along with
+// Eigen. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef EIGEN_SUPERNODAL_CHOLESKY_H
+#define EIGEN_SUPERNODAL_CHOLESKY_H
+
+/** \internal
+  * In place LDLT factorization without pivoting of the lower triangular part of \a mat.
+  * The strictly lower part of \a mat is overwritten by the unit lower factor L, and the
+  * diagonal matrix D is stored into \a diag.
+  * \returns false if a zero pivot has been encountered
+  */
+template<typename MatrixType, typename DiagType>
+bool ei_ldlt_nopivot_inplace(MatrixType& mat, DiagType& diag)
+{
+  typedef typename MatrixType::Scalar Scalar;
+  typedef typename MatrixType::Index Index;
+  const Index size = mat.rows();
+  Matrix<Scalar,Dynamic,1> tmp(size);
+  for(Index k = 0; k < size; ++k)
+  {
+    Index rs = size-k-1; // remaining size
+    Block<MatrixType,Dynamic,1> A21(mat,k+1,k,rs,1);
+    Block<MatrixType,Dynamic,Dynamic> A20(mat,k+1,0,rs,k);
+
+    // tmp = D(0:k) * L(k,0:k)^*
+    tmp.head(k) = diag.head(k).cwiseProduct(mat.row(k).head(k).adjoint());
+    Scalar x = mat.coeff(k,k);
+    if (k>0) x -= mat.row(k).head(k).transpose().cwiseProduct(tmp.head(k)).sum();
+    if (x==Scalar(0))
+      return false;
+    diag.coeffRef(k) = x;
+    if (k>0 && rs>0) A21.noalias() -= A20 * tmp.head(k);
+    if (rs>0) A21 *= Scalar(1)/x;
+  }
+  return true;
+}
+
+/** \internal
+  * \class ei_supernodal_cholesky
+  *
+  * \brief Supernodal left-looking numerical factorization of a sparse selfadjoint matrix
+  *
+  * Consecutive columns of the factor forming a chain in the elimination tree and having nearly
+  * the same sparsity pattern are grouped into supernodes. Each supernode is stored as a dense
+  * column major block, such that the factorization is carried out by the dense LLT (or LDLT
+  * without pivoting) and matrix products.
+  *
+  * This is the backend of SparseLLT and SparseLDLT when the SupernodalLeftLooking or
+  * SupernodalMultifrontal flag is set. The matrix has to be already reordered, and the
+  * elimination tree and column counts have to be computed beforehand.
+  *
+  * \param IsLDLT selects between the \f$ L L^* \f$ and \f$ L D L^* \f$ factorizations.
+  */
+template<typename Scalar, typename Index, bool IsLDLT>
+class ei_supernodal_cholesky
+{
+    typedef Matrix<Index,Dynamic,1> IndexVector;
+    typedef Matrix<Scalar,Dynamic,1> ScalarVector;
+    typedef Matrix<Scalar,Dynamic,Dynamic> DenseMatrix;
+    typedef SparseMatrix<Scalar,ColMajor,Index> SparseType;
+
+  public:
+
+    /** Computes the supernodes and their row structures.
+      * \param a the lower triangular part of the reordered matrix
+      * \param parent the elimination tree
+      * \param colCount the number of nonzeros of each column of L, including the diagonal for the LLT,
+      *        excluding it for the LDLT */
+    void analyze(const SparseType& a, const Index* parent, const Index* colCount);
+
+    /** Computes the numerical factorization of \a a which must have the pattern given to analyze().
+      * \returns false if the matrix is not positive definite, or if a zero pivot is encountered */
+    bool factorize(const SparseType& a);
+
+    /** Copies the factor L into the sparse matrix \a dest. For the LDLT the unit diagonal is not stored. */
+    void extractL(SparseType& dest) const;
+
+    /** \returns the diagonal matrix D of the LDLT factorization */
+    const ScalarVector& vectorD() const { return m_diag; }
+
+    /** \returns the number of supernodes */
+    Index supernodes() const { return m_super.size()-1; }
+
+  protected:
+    inline Index colCount(const Index* colCount, Index j) const { return colCount[j] + (IsLDLT ? 1 : 0); }
+
+    IndexVector m_super;        // first column of each supernode
+    IndexVector m_colToSuper;   // supernode of each column
+    IndexVector m_rowPtr;       // position of the row structure of each supernode
+    IndexVector m_rows;         // row indices, starting with the columns of the supernode
+    IndexVector m_valuePtr;     // position of the dense block of each supernode
+    ScalarVector m_values;
+    ScalarVector m_diag;
+    Index m_maxUpdateSize;
+};
+
+template<typename Scalar, typename Index, bool IsLDLT>
+void ei_supernodal_cholesky<Scalar,Index,IsLDLT>::analyze(const SparseType& a, const Index* parent, const Index* counts)
+{
+  const Index size = a.cols();
+
+  // relaxed supernode detection: column j+1 is merged into the supernode ending at column j
+  // if j+1 is the parent of j and if the merge does not introduce too many explicit zeros
+  std::vector<Index> super(1,0);
+  double ncols = 1, trueNnz = size>0 ? double(colCount(counts,0)) : 0.;
+  for(Index j = 0; j+1 < size; ++j)
+  {
+    bool merge = false;
+    if(parent[j]==j+1)
+    {
+      double c = double(colCount(counts,j+1));
+      double nrows = ncols + c;
+      double stored = (ncols+1)*nrows - ncols*(ncols+1)/2;
+      double zeros = stored - (trueNnz + c);
+      double fraction = zeros / stored;
+      merge = zeros==0 || ncols+1<=4
+           || (ncols+1<=16 && fraction<0.8)
+           || (ncols+1<=48 && fraction<0.1)
+           || fraction<0.05;
+      if(merge)
+      {
+        ncols += 1;
+        trueNnz += c;
+      }
+    }
+    if(!merge)
+    {
+      super.push_back(j+1);
+      ncols = 1;
+      trueNnz = double(colCount(counts,j+1));
+    }
+  }
+  if(size>0)
+    super.push_back(size);
+  const Index nsuper = Index(super.size())-1;
+  m_super.resize(nsuper+1);
+  std::copy(super.begin(), super.end(), m_super.data());
+
+  m_colToSuper.resize(size);
+  m_rowPtr.resize(nsuper+1);
+  m_valuePtr.resize(nsuper+1);
+  m_rowPtr[0] = 0;
+  m_valuePtr[0] = 0;
+  Index maxRows = 0, maxCols = 0;
+  for(Index s = 0; s < nsuper; ++s)
+  {
+    Index nc = m_super[s+1] - m_super[s];
+    // the structure of a supernode is the one of its last column
+    Index nr = nc - 1 + colCount(counts,m_super[s+1]-1);
+    for(Index j = m_super[s]; j < m_super[s+1]; ++j)
+      m_colToSuper[j] = s;
+    m_rowPtr[s+1] = m_rowPtr[s] + nr;
+    m_valuePtr[s+1] = m_valuePtr[s] + nr*nc;
+    maxRows = std::max(maxRows, nr);
+    maxCols = std::max(maxCols, nc);
+  }
+  m_maxUpdateSize = maxRows*maxCols;
+
+  // compute the row structures from the pattern of A and of the children supernodes
+  m_rows.resize(m_rowPtr[nsuper]);
+  IndexVector tags = IndexVector::Constant(size,-1);
+  IndexVector head = IndexVector::Constant(nsuper,-1);
+  IndexVector next(nsuper);
+  for(Index s = 0; s < nsuper; ++s)
+  {
+    const Index first = m_super[s];
+    const Index last = m_super[s+1]-1;
+    Index* rows = m_rows.data() + m_rowPtr[s];
+    Index k = 0;
+    for(Index j = first; j <= last; ++j)
+    {
+      rows[k++] = j;
+      tags[j] = s;
+    }
+    Index start = k;
+    for(Index j = first; j <= last; ++j)
+      for(typename SparseType::InnerIterator it(a,j); it; ++it)
+        if(it.index()>last && tags[it.index()]!=s)
+        {
+          tags[it.index()] = s;
+          rows[k++] = it.index();
+        }
+    for(Index c = head[s]; c != -1; c = next[c])
+    {
+      for(Index p = m_rowPtr[c]; p < m_rowPtr[c+1]; ++p)
+      {
+        Index i = m_rows[p];
+        if(i>last && tags[i]!=s)
+        {
+          tags[i] = s;
+          rows[k++] = i;
+        }
+      }
+    }
+    ei_assert(k==m_rowPtr[s+1]-m_rowPtr[s] && "invalid column counts");
+    std::sort(rows+start, rows+k);
+    if(k>start)
+    {
+      Index p = m_colToSuper[rows[start]];
+      next[s] = head[p];
+      head[p] = s;
+    }
+  }
+  m_values.resize(m_valuePtr[nsuper]);
+}
+
+template<typename Scalar, typename Index, bool IsLDLT>
+bool ei_supernodal_cholesky<Scalar,Index,IsLDLT>::factorize(const SparseType& a)
+{
+  typedef Map<DenseMatrix> BlockType;
+  const Index size = a.cols();
+  const Index nsuper = supernodes();
+  ei_assert(m_colToSuper.size()==size && "analyze() must be called first");
+
+  m_values.setZero();
+  if(IsLDLT)
+    m_diag.resize(size);
+  IndexVector relpos(size);
+  IndexVector head = IndexVector::Constant(nsuper,-1);
+  IndexVector next(nsuper);
+  IndexVector pos(nsuper);
+  ScalarVector workspace(m_maxUpdateSize);
+  DenseMatrix scaled;
+
+  for(Index s = 0; s < nsuper; ++s)
+  {
+    const Index first = m_super[s];
+    const Index last = m_super[s+1]-1;
+    const Index nc = last-first+1;
+    const Index nr = m_rowPtr[s+1]-m_rowPtr[s];
+    const Index* rows = m_rows.data() + m_rowPtr[s];
+    BlockType ls(m_values.data()+m_valuePtr[s], nr, nc);
+
+    for(Index k = 0; k < nr; ++k)
+      relpos[rows[k]] = k;
+
+    // scatter the columns of A
+    for(Index j = first; j <= last; ++j)
+      for(typename SparseType::InnerIterator it(a,j); it; ++it)
+        if(it.index()>=j)
+          ls.coeffRef(relpos[it.index()], j-first) += it.value();
+
+    // apply the updates of the descendant supernodes having nonzeros in the rows first..last
+    for(Index d = head[s], nextd; d != -1; d = nextd)
+    {
+      nextd = next[d];
+      const Index* drows = m_rows.data() + m_rowPtr[d];
+      const Index dnr = m_rowPtr[d+1]-m_rowPtr[d];
+      const Index dnc = m_super[d+1]-m_super[d];
+      BlockType ld(m_values.data()+m_valuePtr[d], dnr, dnc);
+      Index p = pos[d];
+      Index q = 0;
+      while(p+q<dnr && drows[p+q]<=last)
+        ++q;
+      const Index m = dnr-p;
+
+      Map<DenseMatrix> w(workspace.data(), m, q);
+      if(IsLDLT)
+      {
+        scaled = m_diag.segment(m_super[d],dnc).asDiagonal() * ld.block(p,0,q,dnc).adjoint();
+        w.noalias() = ld.bottomRows(m) * scaled;
+      }
+      else
+        w.noalias() = ld.bottomRows(m) * ld.block(p,0,q,dnc).adjoint();
+
+      for(Index c = 0; c < q; ++c)
+      {
+        Index col = drows[p+c]-first;
+        for(Index r = c; r < m; ++r)
+          ls.coeffRef(relpos[drows[p+r]], col) -= w.coeff(r,c);
+      }
+
+      // move d to the list of the next supernode it updates
+      pos[d] = p+q;
+      if(p+q<dnr)
+      {
+        Index t = m_colToSuper[drows[p+q]];
+        next[d] = head[t];
+        head[t] = d;
+      }
+    }
+
+    // factorize the supernode
+    Block<BlockType,Dynamic,Dynamic> diagBlock(ls,0,0,nc,nc);
+    if(IsLDLT)
+    {
+      VectorBlock<ScalarVector> diag(m_diag,first,nc);
+      if(!ei_ldlt_nopivot_inplace(diagBlock, diag))
+        return false;
+      if(nr>nc)
+      {
+        diagBlock.adjoint().template triangularView<UnitUpper>().template solveInPlace<OnTheRight>(ls.bottomRows(nr-nc));
+        for(Index c = 0; c < nc; ++c)
+          ls.col(c).tail(nr-nc) /= diag.coeff(c);
+      }
+    }
+    else
+    {
+      if(!ei_llt_inplace<Lower>::blocked(diagBlock))
+        return false;
+      if(nr>nc)
+        diagBlock.adjoint().template triangularView<Upper>().template solveInPlace<OnTheRight>(ls.bottomRows(nr-nc));
+    }
+
+    pos[s] = nc;
+    if(nr>nc)
+    {
+      Index t = m_colToSuper[rows[nc]];
+      next[s] = head[t];
+      head[t] = s;
+    }
+  }
+  return true;
+}
+
+template<typename Scalar, typename Index, bool IsLDLT>
+void ei_supernodal_cholesky<Scalar,Index,IsLDLT>::extractL(SparseType& dest) const
+{
+  const Index size = m_colToSuper.size();
+  const Index nsuper = supernodes();
+  const Index skip = IsLDLT ? 1 : 0;
+  dest.resize(size,size);
+  Index* outer = dest._outerIndexPtr();
+  outer[0] = 0;
+  for(Index s = 0; s < nsuper; ++s)
+  {
+    Index nr = m_rowPtr[s+1]-m_rowPtr[s];
+    for(Index j = m_super[s]; j < m_super[s+1]; ++j)
+      outer[j+1] = outer[j] + nr - (j-m_super[s]) - skip;
+  }
+  dest.resizeNonZeros(outer[size]);
+  for(Index s = 0; s < nsuper; ++s)
+  {
+    const Index nr = m_rowPtr[s+1]-m_rowPtr[s];
+    const Index* rows = m_rows.data() + m_rowPtr[s];
+    const Scalar* values = m_values.data() + m_valuePtr[s];
+    for(Index j = m_super[s]; j < m_super[s+1]; ++j)
+    {
+      Index c = j-m_super[s];
+      Index len = nr - c - skip;
+      std::copy(rows + c + skip, rows + nr, dest._innerIndexPtr() + outer[j]);
+      std::copy(values + c*nr + c + skip, values + (c+1)*nr, dest._valuePtr() + outer[j]);
+      ei_internal_assert(outer[j]+len==outer[j+1]);
+    }
+  }
+}
+
+#endif // EIGEN_SUPERNODAL_CHOLESKY_H
@@ -30,6 +30,7 @@ taucs_ccs_matrix ei_asTaucsMatrix(MatrixType& mat)
 {
   typedef typename MatrixType::Scalar Scalar;
 enum { Flags = MatrixType::Flags };
+  ei_assert(mat.isCompressed() && "this function requires a compressed matrix, call makeCompressed() first");
   taucs_ccs_matrix res;
   res.n         = mat.cols();
   res.m         = mat.rows();
@@ -204,6 +204,7 @@ void SparseLU<MatrixType,UmfPack>::compute(const MatrixType& a)
   const Index rows = a.rows();
   const Index cols = a.cols();
   ei_assert((MatrixType::Flags&RowMajorBit)==0 && "Row major matrices are not supported yet");
+  ei_assert(a.isCompressed() && "this function requires a compressed matrix, call makeCompressed() first");
 
   m_matrixRef = &a;
 
@@ -0,0 +1,352 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Copyright (C) 2010 Gael Guennebaud <gael.guennebaud@inria.fr>
+//
+// Eigen is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// Alternatively, you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation; either version 2 of
+// the License, or (at your option) any later version.
+//
+// Eigen is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License or the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License and a copy of the GNU General Public License along with
+// Eigen. If not, see <http://www.gnu.org/licenses/>.
+
+#include "sparse.h"
+#include <Eigen/SparseExtra>
+#include <unsupported/Eigen/IterativeSolvers>
+
+// a matrix-free operator applying the 1D Laplacian with Dirichlet boundary conditions
+struct Laplacian1D
+{
+  Laplacian1D(int n) : m_n(n) {}
+  int rows() const { return m_n; }
+  int cols() const { return m_n; }
+  int m_n;
+};
+
+namespace Eigen {
+template<> struct ei_linear_operator<Laplacian1D>
+{
+  template<typename Src, typename Dest>
+  static void run(const Laplacian1D& op, const Src& src, Dest& dst)
+  {
+    for(int i=0; i<op.rows(); ++i)
+      dst.coeffRef(i) = 2*src.coeff(i) - (i>0 ? src.coeff(i-1) : 0) - (i+1<op.rows() ? src.coeff(i+1) : 0);
+  }
+};
+}
+
+// a preconditioner whose solves always fail
+struct FailingPreconditioner
+{
+  template<typename Derived>
+  bool solveInPlace(MatrixBase<Derived>&) const { return false; }
+};
+
+template<typename Scalar> void iterative_solvers(int size)
+{
+  typedef typename NumTraits<Scalar>::Real RealScalar;
+  typedef Matrix<Scalar,Dynamic,Dynamic> DenseMatrix;
+  typedef Matrix<Scalar,Dynamic,1> DenseVector;
+  double density = std::max(8./(size*size), 0.01);
+  RealScalar tol = test_precision<Scalar>();
+
+  // a diagonally dominant general matrix
+  DenseMatrix refMat = DenseMatrix::Zero(size, size);
+  SparseMatrix<Scalar> m(size, size);
+  initSparse<Scalar>(density, refMat, m, ForceNonZeroDiag);
+  for(int j=0; j<size; ++j)
+    refMat(j,j) += Scalar(RealScalar(1) + refMat.col(j).cwiseAbs().sum() + refMat.row(j).cwiseAbs().sum());
+  m = refMat.sparseView();
+
+  // a selfadjoint positive definite one
+  DenseMatrix refSpd = refMat.adjoint() * refMat;
+  SparseMatrix<Scalar> spd = refSpd.sparseView();
+
+  DenseVector b = DenseVector::Random(size), x(size);
+  RealScalar bnorm = b.norm();
+
+  // conjugate gradient
+  {
+    IterationController iter(tol/100);
+    x.setZero();
+    VERIFY(ei_conjugate_gradient(spd, x, b, iter)==Success);
+    VERIFY(iter.converged());
+    VERIFY((refSpd*x-b).norm() <= tol*bnorm);
+
+    iter.init();
+    x.setRandom();
+    ei_conjugate_gradient(spd, x, b, DiagonalPreconditioner<Scalar>(spd), iter);
+    VERIFY(iter.converged());
+    VERIFY((refSpd*x-b).norm() <= tol*bnorm);
+
+    // a complete factorization is an exact preconditioner
+    iter.init();
+    x.setZero();
+    ei_conjugate_gradient(refSpd, x, b, refSpd.llt(), iter);
+    VERIFY(iter.converged() && iter.iteration()<=2);
+    VERIFY((refSpd*x-b).norm() <= tol*bnorm);
+  }
+
+  // BiCGSTAB
+  {
+    IterationController iter(tol/100);
+    x.setZero();
+    VERIFY(ei_bicgstab(m, x, b, iter)==Success);
+    VERIFY(iter.converged());
+    VERIFY((refMat*x-b).norm() <= tol*bnorm);
+
+    iter.init();
+    x.setRandom();
+    ei_bicgstab(m, x, b, DiagonalPreconditioner<Scalar>(m), iter);
+    VERIFY(iter.converged());
+    VERIFY((refMat*x-b).norm() <= tol*bnorm);
+  }
+
+  // GMRES, with and without restart
+  {
+    IterationController iter(tol/100);
+    x.setZero();
+    VERIFY(ei_gmres(m, x, b, iter, size)==Success);
+    VERIFY(iter.converged());
+    VERIFY((refMat*x-b).norm() <= tol*bnorm);
+
+    iter.init();
+    x.setRandom();
+    ei_gmres(m, x, b, DiagonalPreconditioner<Scalar>(m), iter, ei_random<int>(1,5));
+    VERIFY(iter.converged());
+    VERIFY((refMat*x-b).norm() <= tol*bnorm);
+
+    iter.init();
+    ei_gmres(refMat, x, b, iter);
+    VERIFY(iter.converged() && iter.iteration()<=1);
+
+    // the solution of a zero rhs is zero
+    iter.init();
+    DenseVector zero = DenseVector::Zero(size);
+    ei_gmres(m, x, zero, iter);
+    VERIFY(iter.converged() && x.isZero());
+  }
+
+  // a failing preconditioner stops the iterations
+  {
+    IterationController iter(tol/100);
+    x.setZero();
+    VERIFY(ei_conjugate_gradient(spd, x, b, FailingPreconditioner(), iter)==NumericalIssue);
+    iter.init();
+    VERIFY(ei_bicgstab(m, x, b, FailingPreconditioner(), iter)==NumericalIssue);
+    iter.init();
+    VERIFY(ei_gmres(m, x, b, FailingPreconditioner(), iter)==NumericalIssue);
+    iter.init();
+    iter.setMaxIterations(1);
+    x.setZero();
+    VERIFY(size==1 || ei_gmres(m, x, b, iter, 1)==NoConvergence);
+  }
+
+  // BiCGSTAB breaks down on a skew symmetric matrix since r0.dot(A r0) is zero
+  if(size>=2)
+  {
+    DenseMatrix skew = DenseMatrix::Zero(2,2);
+    skew(0,1) = 1;
+    skew(1,0) = -1;
+    DenseVector b2 = DenseVector::Ones(2), x2 = DenseVector::Zero(2);
+    IterationController iter(tol/100);
+    VERIFY(ei_bicgstab(skew, x2, b2, iter)==NoConvergence);
+    VERIFY(!iter.converged());
+  }
+}
+
+void iterative_solvers_matrix_free(int size)
+{
+  Laplacian1D op(size);
+  MatrixXd refMat = MatrixXd::Zero(size,size);
+  VectorXd b = VectorXd::Random(size), x(size), tmp(size);
+  for(int i=0; i<size; ++i)
+  {
+    x.setZero(); x(i) = 1;
+    ei_linear_operator<Laplacian1D>::run(op, x, tmp);
+    refMat.col(i) = tmp;
+  }
+  double tol = test_precision<double>();
+
+  IterationController iter(tol/100);
+  x.setZero();
+  ei_conjugate_gradient(op, x, b, iter);
+  VERIFY(iter.converged());
+  VERIFY((refMat*x-b).norm() <= tol*b.norm());
+
+  iter.init();
+  x.setZero();
+  ei_bicgstab(op, x, b, iter);
+  VERIFY(iter.converged());
+  VERIFY((refMat*x-b).norm() <= tol*b.norm());
+
+  iter.init();
+  x.setZero();
+  ei_gmres(op, x, b, iter, 10);
+  VERIFY(iter.converged());
+  VERIFY((refMat*x-b).norm() <= tol*b.norm());
+}
+
+template<typename Scalar> void fused_vector_kernels(int size)
+{
+  typedef typename NumTraits<Scalar>::Real RealScalar;
+  typedef Matrix<Scalar,Dynamic,1> DenseVector;
+  DenseVector x = DenseVector::Random(size), p = DenseVector::Random(size), r = DenseVector::Random(size),
+              q = DenseVector::Random(size), r0 = DenseVector::Random(size);
+  Scalar alpha = ei_random<Scalar>(), omega = ei_random<Scalar>();
+
+  DenseVector refX = x + alpha*p, refR = r - alpha*q;
+  RealScalar norm2 = ei_fused_cg_update(x, alpha, p, r, q);
+  VERIFY_IS_APPROX(x, refX);
+  VERIFY_IS_APPROX(r, refR);
+  VERIFY_IS_APPROX(norm2, refR.squaredNorm());
+
+  Scalar dot;
+  refX = x + alpha*p + omega*r;
+  refR = r - omega*q;
+  norm2 = ei_fused_bicgstab_update(x, alpha, p, omega, r, r, q, r0, dot);
+  VERIFY_IS_APPROX(x, refX);
+  VERIFY_IS_APPROX(r, refR);
+  VERIFY_IS_APPROX(norm2, refR.squaredNorm());
+  VERIFY_IS_APPROX(dot, r0.dot(refR));
+
+  dot = ei_fused_dot_norm(p, q, norm2);
+  VERIFY_IS_APPROX(dot, p.dot(q));
+  VERIFY_IS_APPROX(norm2, p.squaredNorm());
+
+  refR = r - alpha*p;
+  dot = ei_fused_axpy_dot(r, alpha, p, q);
+  VERIFY_IS_APPROX(r, refR);
+  VERIFY_IS_APPROX(dot, q.dot(refR));
+
+  refR = r - alpha*p;
+  norm2 = ei_fused_axpy_norm(r, alpha, p);
+  VERIFY_IS_APPROX(r, refR);
+  VERIFY_IS_APPROX(norm2, refR.squaredNorm());
+}
+
+// 5-point discretization of -laplacian(u) + c * du/dx on a n x n grid
+template<typename Scalar> SparseMatrix<Scalar> convection_diffusion(int n, Scalar c)
+{
+  SparseMatrix<Scalar> mat(n*n, n*n);
+  mat.reserve(5*n*n);
+  for(int j=0; j<n*n; ++j)
+  {
+    mat.startVec(j);
+    if(j>=n)        mat.insertBack(j-n,j) = -1;
+    if(j%n!=0)      mat.insertBack(j-1,j) = Scalar(-1) + c;
+                    mat.insertBack(j,j)   = 4;
+    if(j%n!=n-1)    mat.insertBack(j+1,j) = Scalar(-1) - c;
+    if(j+n<n*n)     mat.insertBack(j+n,j) = -1;
+  }
+  mat.finalize();
+  return mat;
+}
+
+template<typename Scalar> void incomplete_factorizations(int n)
+{
+  typedef typename NumTraits<Scalar>::Real RealScalar;
+  typedef Matrix<Scalar,Dynamic,Dynamic> DenseMatrix;
+  typedef Matrix<Scalar,Dynamic,1> DenseVector;
+  RealScalar tol = test_precision<Scalar>();
+
+  SparseMatrix<Scalar> spd = convection_diffusion<Scalar>(n, 0), mat = convection_diffusion<Scalar>(n, Scalar(0.5));
+  DenseMatrix refSpd(spd), refMat(mat);
+  DenseVector b = DenseVector::Random(n*n), x(n*n);
+  RealScalar bnorm = b.norm();
+
+  // IC(0): L L^* matches the matrix on its pattern
+  IncompleteCholesky<SparseMatrix<Scalar> > ic(spd);
+  VERIFY(ic.succeeded() && ic.shift()==RealScalar(0));
+  DenseMatrix L(ic.matrixL());
+  DenseMatrix LLt = L * L.adjoint();
+  for(int j=0; j<n*n; ++j)
+    for(int i=j; i<n*n; ++i)
+      if(refSpd(i,j)!=Scalar(0))
+        VERIFY(ei_abs(LLt(i,j)-refSpd(i,j)) <= tol);
+
+  IterationController iter(tol/100);
+  x.setZero();
+  ei_conjugate_gradient(spd, x, b, iter);
+  size_t plainIterations = iter.iteration();
+  iter.init();
+  x.setZero();
+  ei_conjugate_gradient(spd, x, b, ic, iter);
+  VERIFY(iter.converged() && iter.iteration()<=plainIterations);
+  VERIFY((refSpd*x-b).norm() <= tol*bnorm);
+
+  // ILU(0): L U matches the matrix on its pattern
+  IncompleteLU<SparseMatrix<Scalar> > ilu(mat);
+  VERIFY(ilu.succeeded());
+  DenseMatrix LU(ilu.matrixLU());
+  DenseMatrix lu = DenseMatrix(LU.template triangularView<UnitLower>()) * DenseMatrix(LU.template triangularView<Upper>());
+  for(int j=0; j<n*n; ++j)
+    for(int i=0; i<n*n; ++i)
+      if(refMat(i,j)!=Scalar(0))
+        VERIFY(ei_abs(lu(i,j)-refMat(i,j)) <= tol);
+
+  iter.init();
+  x.setZero();
+  ei_bicgstab(mat, x, b, ilu, iter);
+  VERIFY(iter.converged());
+  VERIFY((refMat*x-b).norm() <= tol*bnorm);
+
+  // refactorization of a matrix with the same pattern
+  SparseMatrix<Scalar> mat2 = convection_diffusion<Scalar>(n, Scalar(0.25)), spd2 = spd * Scalar(2);
+  VERIFY(ilu.factorize(mat2));
+  VERIFY_IS_APPROX(DenseMatrix(ilu.matrixLU()), DenseMatrix(IncompleteLU<SparseMatrix<Scalar> >(mat2).matrixLU()));
+  VERIFY(ic.factorize(spd2));
+  VERIFY_IS_APPROX(DenseMatrix(ic.matrixL()), DenseMatrix(L*ei_sqrt(RealScalar(2))));
+
+  // the triangular solves reuse the analyzed schedules with the refreshed factors
+  DenseMatrix L2(ic.matrixL()), LU2(ilu.matrixLU());
+  x = b;
+  VERIFY(ic.solveInPlace(x));
+  VERIFY_IS_APPROX(x, DenseMatrix(L2.adjoint()).template triangularView<Upper>().solve(L2.template triangularView<Lower>().solve(b)));
+  x = b;
+  VERIFY(ilu.solveInPlace(x));
+  VERIFY_IS_APPROX(x, LU2.template triangularView<Upper>().solve(LU2.template triangularView<UnitLower>().solve(b)));
+
+  // ILUT without dropping is a complete LU factorization
+  IncompleteLUT<SparseMatrix<Scalar> > ilut(mat, 0, n*n);
+  VERIFY(ilut.succeeded());
+  x = b;
+  ilut.solveInPlace(x);
+  VERIFY((refMat*x-b).norm() <= tol*bnorm);
+
+  ilut.setDropTolerance(RealScalar(1e-2));
+  ilut.setFillFactor(2);
+  ilut.compute(mat);
+  iter.init();
+  x.setZero();
+  ei_gmres(mat, x, b, ilut, iter);
+  VERIFY(iter.converged());
+  VERIFY((refMat*x-b).norm() <= tol*bnorm);
+}
+
+void test_iterative_solvers()
+{
+  for(int i = 0; i < g_repeat; i++) {
+    CALL_SUBTEST_1( iterative_solvers<double>(ei_random<int>(1,300)) );
+    CALL_SUBTEST_2( iterative_solvers<float>(ei_random<int>(1,100)) );
+    CALL_SUBTEST_3( iterative_solvers<std::complex<double> >(ei_random<int>(1,200)) );
+    CALL_SUBTEST_4( iterative_solvers_matrix_free(ei_random<int>(1,100)) );
+    CALL_SUBTEST_7( fused_vector_kernels<float>(ei_random<int>(1,100)) );
+    CALL_SUBTEST_7( fused_vector_kernels<double>(ei_random<int>(1,100)) );
+    CALL_SUBTEST_7( fused_vector_kernels<std::complex<double> >(ei_random<int>(1,100)) );
+    CALL_SUBTEST_5( incomplete_factorizations<double>(ei_random<int>(4,16)) );
+    CALL_SUBTEST_6( incomplete_factorizations<std::complex<double> >(ei_random<int>(4,12)) );
+  }
+}
@@ -24,6 +24,7 @@
 
 #include "main.h"
 #include <unsupported/Eigen/MatrixFunctions>
+#include <Eigen/Sparse>
 
 double binom(int n, int k)
 {
@@ -142,6 +143,112 @@ void randomTest(const MatrixType& m, double tol)
   }
 }
 
+template<typename MatrixType>
+void testWorkspaceReuse(double tol)
+{
+  typedef typename NumTraits<typename MatrixType::Scalar>::Real RealScalar;
+  MatrixExponential<MatrixType> expm;
+  MatrixType result;
+  for (int k=0; k<10; ++k)
+  {
+    // varying sizes and norms, such that both the Pade degree and the number of squarings change
+    int size = ei_random<int>(1,30);
+    MatrixType A = MatrixType::Random(size,size) * RealScalar(std::pow(10., ei_random<double>(-3,1.5)));
+    expm.compute(A, result);
+    MatrixType ref = A.exp();
+    VERIFY(result.isApprox(ref, static_cast<RealScalar>(tol)));
+  }
+
+  int count = ei_random<int>(1,20);
+  std::vector<MatrixType> matrices(count), results(count);
+  for (int k=0; k<count; ++k)
+  {
+    int size = ei_random<int>(1,20);
+    matrices[k] = MatrixType::Random(size,size);
+  }
+  matrixExponentialBatch(&matrices[0], &results[0], count);
+  for (int k=0; k<count; ++k)
+    VERIFY(results[k].isApprox(matrices[k].exp(), static_cast<RealScalar>(tol)));
+}
+
+#ifdef EIGEN_HAS_PTHREADS
+template<typename MatrixType>
+void testBatchOnThreadPool(double tol)
+{
+  typedef typename NumTraits<typename MatrixType::Scalar>::Real RealScalar;
+
+  // enough matrices, and large enough, to be split among the threads of the pool
+  int count = ei_random<int>(8,32);
+  std::vector<MatrixType> matrices(count), results(count);
+  for (int k=0; k<count; ++k)
+  {
+    int size = ei_random<int>(20,40);
+    matrices[k] = MatrixType::Random(size,size);
+  }
+
+  PosixThreadPool pool(4);
+  setThreadPool(&pool);
+  VERIFY(nbThreads()==pool.threads());
+  matrixExponentialBatch(&matrices[0], &results[0], count);
+  setThreadPool(0);
+
+  for (int k=0; k<count; ++k)
+    VERIFY(results[k].isApprox(matrices[k].exp(), static_cast<RealScalar>(tol)));
+}
+#endif
+
+template<typename Scalar>
+void testKrylov(int size, double tol)
+{
+  typedef typename NumTraits<Scalar>::Real RealScalar;
+  typedef Matrix<Scalar,Dynamic,Dynamic> DenseMatrix;
+  typedef Matrix<Scalar,Dynamic,1> DenseVector;
+
+  DenseMatrix A = DenseMatrix::Random(size,size) * RealScalar(4) / RealScalar(std::sqrt(double(size)));
+  DenseVector v = DenseVector::Random(size), w;
+  RealScalar t = RealScalar(ei_random<double>(-2,2));
+
+  KrylovExponential<DenseMatrix> krylov(ei_random<int>(5,30));
+  krylov.setTolerance(static_cast<RealScalar>(tol)/10);
+  VERIFY_RAISES_ASSERT(krylov.info());
+  krylov.compute(A, v, w, t);
+  DenseVector ref = (t*A).exp() * v;
+  VERIFY(w.isApprox(ref, static_cast<RealScalar>(tol)));
+  VERIFY(krylov.steps()>=1);
+  VERIFY(krylov.info()==Success);
+
+  // the workspace is reused for another vector
+  v.setRandom();
+  krylov.compute(A, v, w, t);
+  ref = (t*A).exp() * v;
+  VERIFY(w.isApprox(ref, static_cast<RealScalar>(tol)));
+
+  // sparse generator of a Markov chain, for which the Krylov subspace is much smaller than the matrix
+  DenseMatrix Q = DenseMatrix::Zero(size,size);
+  for (int i=0; i<size; ++i)
+  {
+    for (int k=0; k<3; ++k)
+      Q(i, ei_random<int>(0,size-1)) = ei_abs(ei_random<Scalar>());
+    Q(i,i) = 0;
+    Q(i,i) = -Q.row(i).sum();
+  }
+  SparseMatrix<Scalar> sQ = Q.transpose().sparseView();
+  DenseVector p = DenseVector::Zero(size);
+  p(0) = 1;
+  KrylovExponential<SparseMatrix<Scalar> > skrylov(ei_random<int>(5,30));
+  skrylov.setTolerance(static_cast<RealScalar>(tol)/10);
+  skrylov.compute(sQ, p, w, ei_abs(t));
+  ref = (ei_abs(t)*Q.transpose()).exp() * p;
+  VERIFY(w.isApprox(ref, static_cast<RealScalar>(tol)));
+  VERIFY(skrylov.info()==Success);
+
+  // trivial cases
+  krylov.compute(A, DenseVector::Zero(size), w, t);
+  VERIFY(w.isZero());
+  krylov.compute(A, v, w, RealScalar(0));
+  VERIFY(w.isApprox(v));
+}
+
 void test_matrix_exponential()
 {
   CALL_SUBTEST_2(test2dRotation<double>(1e-13));
@@ -158,4 +265,14 @@ void test_matrix_exponential()
   CALL_SUBTEST_5(randomTest(Matrix3cf(), 1e-4));
   CALL_SUBTEST_1(randomTest(Matrix4f(), 1e-4));
   CALL_SUBTEST_6(randomTest(MatrixXf(8,8), 1e-4));
+  for(int i = 0; i < g_repeat; i++) {
+    CALL_SUBTEST_8(testWorkspaceReuse<MatrixXd>(1e-12));
+    CALL_SUBTEST_8(testWorkspaceReuse<MatrixXcd>(1e-12));
+    CALL_SUBTEST_9(testKrylov<double>(ei_random<int>(1,100), 1e-9));
+    CALL_SUBTEST_9(testKrylov<std::complex<double> >(ei_random<int>(1,100), 1e-9));
+#ifdef EIGEN_HAS_PTHREADS
+    CALL_SUBTEST_10(testBatchOnThreadPool<MatrixXd>(1e-12));
+    CALL_SUBTEST_10(testBatchOnThreadPool<MatrixXcd>(1e-12));
+#endif
+  }
 }
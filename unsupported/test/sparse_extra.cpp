@@ -142,6 +142,54 @@ template<typename SparseMatrixType> void sparse_extra(const SparseMatrixType& re
 
 }
 
+template<typename Scalar, int ChunkSize> void sliced_ellpack(int rows, int cols)
+{
+  typedef Matrix<Scalar,Dynamic,Dynamic> DenseMatrix;
+  typedef Matrix<Scalar,Dynamic,1> DenseVector;
+  double density = std::max(8./(rows*cols), 0.05);
+
+  DenseMatrix refMat = DenseMatrix::Zero(rows, cols);
+  SparseMatrix<Scalar> m(rows, cols);
+  initSparse<Scalar>(density, refMat, m);
+  // add a few dense rows and empty a few other ones to get irregular row lengths
+  for(int k=0; k<3; ++k)
+  {
+    refMat.row(ei_random<int>(0,rows-1)).setRandom();
+    refMat.row(ei_random<int>(0,rows-1)).setZero();
+  }
+  m = refMat.sparseView();
+
+  int sigma = ei_random<int>(1,2*rows);
+  SlicedEllpackMatrix<Scalar,ChunkSize> sell(m, sigma);
+  VERIFY(sell.nonZeros()==m.nonZeros());
+  VERIFY(sell.storedCoefficients()>=sell.nonZeros());
+  VERIFY_IS_APPROX(DenseMatrix(sell), refMat);
+  for(int i=0; i<rows; ++i)
+    VERIFY(sell.innerNonZeros(i)==(refMat.row(i).array()!=Scalar(0)).count());
+
+  // products with vectors and matrices
+  DenseVector x = DenseVector::Random(cols);
+  DenseVector y = DenseVector::Random(rows);
+  DenseVector refY = y;
+  VERIFY_IS_APPROX(y = sell*x, refY = refMat*x);
+  VERIFY_IS_APPROX(y += sell*x, refY = refY + refMat*x);
+  VERIFY_IS_APPROX(y.noalias() -= Scalar(2)*(sell*x), refY -= Scalar(2)*(refMat*x));
+
+  DenseMatrix X = DenseMatrix::Random(cols, 3);
+  DenseMatrix Y = DenseMatrix::Random(rows, 3);
+  VERIFY_IS_APPROX(Y = sell*X, refMat*X);
+  VERIFY_IS_APPROX(Y.col(1) = sell*X.col(2), refMat*X.col(2));
+  DenseMatrix Xt = X.transpose();
+  VERIFY_IS_APPROX(y = sell*Xt.row(1).transpose(), refMat*X.col(1));
+
+  // building from a row major or uncompressed matrix
+  SparseMatrix<Scalar,RowMajor> mr(m);
+  SlicedEllpackMatrix<Scalar,ChunkSize> sell2(mr, 1);
+  VERIFY_IS_APPROX(y = sell2*x, refMat*x);
+  sell2.compute(DynamicSparseMatrix<Scalar>(m));
+  VERIFY_IS_APPROX(Y = sell2*X, refMat*X);
+}
+
 void test_sparse_extra()
 {
   for(int i = 0; i < g_repeat; i++) {
@@ -150,5 +198,11 @@ void test_sparse_extra()
     CALL_SUBTEST_1( sparse_extra(SparseMatrix<double>(33, 33)) );
 
     CALL_SUBTEST_3( sparse_extra(DynamicSparseMatrix<double>(8, 8)) );
+
+    CALL_SUBTEST_4(( sliced_ellpack<double,8>(ei_random<int>(1,300), ei_random<int>(1,300)) ));
+    CALL_SUBTEST_4(( sliced_ellpack<double,4>(ei_random<int>(1,300), ei_random<int>(1,300)) ));
+    CALL_SUBTEST_5(( sliced_ellpack<float,8>(ei_random<int>(1,300), ei_random<int>(1,300)) ));
+    CALL_SUBTEST_5(( sliced_ellpack<float,3>(ei_random<int>(1,50), ei_random<int>(1,50)) ));
+    CALL_SUBTEST_6(( sliced_ellpack<std::complex<double>,4>(ei_random<int>(1,200), ei_random<int>(1,200)) ));
   }
 }
@@ -56,6 +56,42 @@ template<typename Scalar> void sparse_ldlt(int rows, int cols)
 
   VERIFY_IS_APPROX(refMat2.template selfadjointView<Upper>() * x, b);
   VERIFY(refX.isApprox(x,test_precision<Scalar>()) && "LDLT: default");
+
+  // the natural ordering does not reduce the growth of the unpivoted factorization,
+  // so it is checked on a diagonally dominant matrix
+  SparseMatrix<Scalar> m4 = m2;
+  DenseMatrix refMat4 = refMat2;
+  for(int i=0; i<rows; ++i)
+    m4.coeffRef(i,i) = refMat4(i,i) = refMat2(i,i) + Scalar(rows);
+  x = b;
+  SparseLDLT<SparseSelfAdjointMatrix> ldlt2(m4, NaturalOrdering);
+  VERIFY(ldlt2.succeeded());
+  ldlt2.solveInPlace(x);
+  VERIFY(x.isApprox(refMat4.template selfadjointView<Upper>().ldlt().solve(b),test_precision<Scalar>()) && "LDLT: natural ordering");
+
+  x = b;
+  SparseLDLT<SparseSelfAdjointMatrix> ldlt4(m2, SupernodalLeftLooking);
+  VERIFY(ldlt4.succeeded());
+  ldlt4.solveInPlace(x);
+  VERIFY(refX.isApprox(x,test_precision<Scalar>()) && "LDLT: supernodal");
+  VERIFY_IS_APPROX(ldlt4.vectorD(), ldlt.vectorD());
+
+  // factorize several matrices sharing the same pattern
+  SparseLDLT<SparseSelfAdjointMatrix> ldlt3;
+  ldlt3.analyzePattern(m2);
+  SparseMatrix<Scalar> m3 = m2 * Scalar(3);
+  VERIFY(ldlt3.factorize(m3));
+  x = b;
+  ldlt3.solveInPlace(x);
+  VERIFY(refX.isApprox(Scalar(3)*x,test_precision<Scalar>()) && "LDLT: factorize");
+  VERIFY(ldlt3.factorize(m2));
+  x = b;
+  ldlt3.solveInPlace(x);
+  VERIFY(refX.isApprox(x,test_precision<Scalar>()) && "LDLT: analyzePattern/factorize");
+
+  // the deprecated settags() forwards to setFlags()
+  ldlt3.settags(NaturalOrdering);
+  VERIFY(ldlt3.flags()==NaturalOrdering);
 }
 
 void test_sparse_ldlt()
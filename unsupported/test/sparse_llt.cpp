@@ -51,11 +51,45 @@ template<typename Scalar> void sparse_llt(int rows, int cols)
       m2.coeffRef(i,i) = refMat2(i,i) = ei_abs(ei_real(refMat2(i,i)));
 
     refX = refMat2.template selfadjointView<Lower>().llt().solve(b);
-    if (!NumTraits<Scalar>::IsComplex)
+    // the complex random matrices are not always positive definite
+    bool isSpd = refMat2.template selfadjointView<Lower>().llt().info()==Success;
+    if (isSpd)
     {
       x = b;
       SparseLLT<SparseMatrix<Scalar> > (m2).solveInPlace(x);
       VERIFY(refX.isApprox(x,test_precision<Scalar>()) && "LLT: default");
+      x = b;
+      SparseLLT<SparseMatrix<Scalar> > (m2,NaturalOrdering).solveInPlace(x);
+      VERIFY(refX.isApprox(x,test_precision<Scalar>()) && "LLT: natural ordering");
+      x = b;
+      SparseLLT<SparseMatrix<Scalar> > (m2,SupernodalLeftLooking).solveInPlace(x);
+      VERIFY(refX.isApprox(x,test_precision<Scalar>()) && "LLT: supernodal");
+    }
+    if (!NumTraits<Scalar>::IsComplex)
+    {
+      x = b;
+      SparseLLT<SparseMatrix<Scalar> > (m2,IncompleteFactorization).solveInPlace(x);
+      VERIFY(refX.isApprox(x,test_precision<Scalar>()) && "LLT: incomplete");
+    }
+
+    // factorize several matrices sharing the same pattern
+    if (isSpd)
+    {
+      SparseLLT<SparseMatrix<Scalar> > llt;
+      llt.analyzePattern(m2);
+      VERIFY(llt.factorize(m2));
+      x = b;
+      llt.solveInPlace(x);
+      VERIFY(refX.isApprox(x,test_precision<Scalar>()) && "LLT: analyzePattern/factorize");
+
+      SparseMatrix<Scalar> m3 = m2 * Scalar(2);
+      VERIFY(llt.factorize(m3));
+      x = b;
+      llt.solveInPlace(x);
+      VERIFY(refX.isApprox(Scalar(2)*x,test_precision<Scalar>()) && "LLT: factorize");
+      DenseMatrix refL = DenseMatrix(llt.matrixL());
+      DenseMatrix refM3 = llt.permutationP() * DenseMatrix(refMat2.template selfadjointView<Lower>()) * llt.permutationP().transpose();
+      VERIFY_IS_APPROX(refL * refL.adjoint(), Scalar(2) * refM3);
     }
     #ifdef EIGEN_CHOLMOD_SUPPORT
     x = b;
@@ -81,6 +115,57 @@ template<typename Scalar> void sparse_llt(int rows, int cols)
     #endif
 }
 
+template<typename Scalar> void sparse_llt_ordering(int n)
+{
+  typedef Matrix<Scalar,Dynamic,1> DenseVector;
+  // 2D Laplacian on a n x n grid
+  const int size = n*n;
+  SparseMatrix<Scalar> m(size,size);
+  m.reserve(3*size);
+  for(int j=0; j<size; ++j)
+  {
+    m.startVec(j);
+    m.insertBack(j,j) = Scalar(4);
+    if(j%n+1<n) m.insertBack(j+1,j) = Scalar(-1);
+    if(j+n<size) m.insertBack(j+n,j) = Scalar(-1);
+  }
+  m.finalize();
+
+  PermutationMatrix<Dynamic> perm;
+  ei_minimum_degree_ordering(m, perm);
+  VERIFY(perm.size()==size);
+  VectorXi mask = VectorXi::Zero(size);
+  for(int i=0; i<size; ++i)
+    mask[perm.indices()[i]]++;
+  VERIFY((mask.array()==1).all());
+
+  DenseVector b = DenseVector::Random(size), x1 = b, x2 = b;
+  SparseLLT<SparseMatrix<Scalar> > amd(m), natural(m,NaturalOrdering);
+  VERIFY(amd.succeeded() && natural.succeeded());
+  VERIFY(amd.matrixL().nonZeros() < natural.matrixL().nonZeros());
+  amd.solveInPlace(x1);
+  natural.solveInPlace(x2);
+  VERIFY_IS_APPROX(x1, x2);
+  VERIFY_IS_APPROX(m.template selfadjointView<Lower>() * x1, b);
+
+  // the supernodal factor has the same coefficients, up to the explicit zeros of the relaxed supernodes
+  SparseLLT<SparseMatrix<Scalar> > supernodal;
+  supernodal.setFlags(SupernodalLeftLooking);
+  supernodal.analyzePattern(m);
+  VERIFY(supernodal.factorize(m));
+  VERIFY(supernodal.matrixL().nonZeros() >= amd.matrixL().nonZeros());
+  typedef Matrix<Scalar,Dynamic,Dynamic> DenseMatrix;
+  VERIFY_IS_APPROX(DenseMatrix(supernodal.matrixL()), DenseMatrix(amd.matrixL()));
+  x2 = b;
+  supernodal.solveInPlace(x2);
+  VERIFY_IS_APPROX(x1, x2);
+  SparseMatrix<Scalar> m2 = m * Scalar(4);
+  VERIFY(supernodal.factorize(m2));
+  x2 = b;
+  supernodal.solveInPlace(x2);
+  VERIFY_IS_APPROX(x1, Scalar(4)*x2);
+}
+
 void test_sparse_llt()
 {
   for(int i = 0; i < g_repeat; i++) {
@@ -89,4 +174,6 @@ void test_sparse_llt()
     CALL_SUBTEST_2(sparse_llt<std::complex<double> >(s,s) );
     CALL_SUBTEST_1(sparse_llt<double>(s,s) );
   }
+  CALL_SUBTEST_3(sparse_llt_ordering<double>(30) );
+  CALL_SUBTEST_3(sparse_llt_ordering<std::complex<double> >(ei_random<int>(10,20)) );
 }
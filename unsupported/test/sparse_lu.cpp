@@ -55,12 +55,47 @@ template<typename Scalar> void sparse_lu(int rows, int cols)
 
     FullPivLU<DenseMatrix> refLu(refMat2);
     refX = refLu.solve(b);
-    #if defined(EIGEN_SUPERLU_SUPPORT) || defined(EIGEN_UMFPACK_SUPPORT)
     Scalar refDet = refLu.determinant();
-    #endif
     x.setZero();
-    // // SparseLU<SparseMatrix<Scalar> > (m2).solve(b,&x);
-    // // VERIFY(refX.isApprox(x,test_precision<Scalar>()) && "LU: default");
+    {
+      SparseLU<SparseMatrix<Scalar> > slu(m2);
+      if (refLu.isInvertible())
+      {
+        VERIFY(slu.succeeded());
+        VERIFY(slu.solve(b,&x));
+        VERIFY(refX.isApprox(x,test_precision<Scalar>()) && "LU: default");
+        VERIFY(slu.solve(b, &x, SvTranspose));
+        VERIFY(b.isApprox(m2.transpose() * x, test_precision<Scalar>()));
+        VERIFY(slu.solve(b, &x, SvAdjoint));
+        VERIFY(b.isApprox(m2.adjoint() * x, test_precision<Scalar>()));
+        if (count==0) {
+          VERIFY_IS_APPROX(refDet,slu.determinant());
+        }
+
+        // check the factors: P A Q = L U
+        DenseMatrix L = DenseMatrix(slu.matrixL()) + DenseMatrix::Identity(rows,cols);
+        DenseMatrix U(slu.matrixU());
+        VERIFY(L.isLowerTriangular() && U.isUpperTriangular());
+        VERIFY_IS_APPROX(DenseMatrix(slu.permutationP() * refMat2 * slu.permutationQ()), L * U);
+      }
+    }
+    {
+      // other orderings, and a relaxed pivoting
+      int orderings[] = { NaturalOrdering, MinimumDegree_AT_PLUS_A };
+      for (int k=0; k<2; ++k)
+      {
+        SparseLU<SparseMatrix<Scalar> > slu;
+        slu.setOrderingMethod(orderings[k]);
+        slu.setPivotThreshold(0.1);
+        slu.compute(m2);
+        if (refLu.isInvertible())
+        {
+          VERIFY(slu.succeeded());
+          VERIFY(slu.solve(b,&x));
+          VERIFY(b.isApprox(m2 * x, test_precision<Scalar>()));
+        }
+      }
+    }
     #ifdef EIGEN_SUPERLU_SUPPORT
     {
       x.setZero();